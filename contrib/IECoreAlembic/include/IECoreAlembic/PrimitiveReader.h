@@ -41,8 +41,11 @@
 
 #include "IECore/Canceller.h"
 
+#include "Alembic/Abc/IArrayProperty.h"
 #include "Alembic/AbcGeom/GeometryScope.h"
 
+#include <functional>
+
 namespace IECoreAlembic
 {
 
@@ -61,6 +64,20 @@ class PrimitiveReader : public ObjectReader
 
 		IECoreScene::PrimitiveVariable::Interpolation interpolation( Alembic::AbcGeom::GeometryScope scope ) const;
 
+		/// Reads the sample from `property` and converts it to `DataType`.
+		/// Conversions are cached using the Alembic sample key (a digest
+		/// of the sample's contents), so that identical samples from any
+		/// time or location share storage and are only converted once.
+		/// The result is a shallow copy of the cached data, so may be
+		/// modified freely by the caller.
+		template<typename DataType, typename Property>
+		static typename DataType::Ptr readArraySample( const Property &property, const Alembic::Abc::ISampleSelector &sampleSelector );
+
+	private :
+
+		using SampleConverter = std::function<IECore::DataPtr ()>;
+		static IECore::ConstDataPtr cachedArraySample( const Alembic::Abc::IArrayProperty &property, const Alembic::Abc::ISampleSelector &sampleSelector, IECore::TypeId dataType, const SampleConverter &converter );
+
 };
 
 } // namespace IECoreAlembic
@@ -95,9 +95,7 @@ template<typename T>
 void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive, const std::string &primitiveVariableName ) const
 {
 
-	typedef typename T::prop_type::sample_ptr_type SamplePtr;
 	typedef typename IGeomParamTraits<T>::DataType DataType;
-	typedef typename T::sample_type GeomParamSample;
 
 	if( param.getArrayExtent() > 1 )
 	{
@@ -111,23 +109,9 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 		return;
 	}
 
-	SamplePtr sample;
-	Alembic::Abc::UInt32ArraySamplePtr indices;
-
-	if( param.isIndexed() )
-	{
-		GeomParamSample geomParamSample = param.getIndexedValue( sampleSelector );
-		sample = geomParamSample.getVals();
-		indices = geomParamSample.getIndices();
-	}
-	else
-	{
-		sample = param.getExpandedValue( sampleSelector ).getVals();
-	}
-
-	typename DataType::Ptr data = new DataType();
-	data->writable().resize( sample->size() );
-	std::copy( sample->get(), sample->get() + sample->size(), data->writable().begin() );
+	// Note : for non-indexed params, the value property holds the expanded
+	// values, so this is equivalent to `getExpandedValue()`.
+	typename DataType::Ptr data = readArraySample<DataType>( param.getValueProperty(), sampleSelector );
 
 	Private::ApplyGeometricInterpretation<DataType, T>::apply( data.get(), param.getHeader() );
 
@@ -137,10 +121,7 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 
 	if( param.isIndexed() )
 	{
-		IECore::IntVectorDataPtr indexData = new IECore::IntVectorData();
-		indexData->writable().resize( indices->size() );
-		std::copy( indices->get(), indices->get() + indices->size(), indexData->writable().begin() );
-		pv.indices = indexData;
+		pv.indices = readArraySample<IECore::IntVectorData>( param.getIndexProperty(), sampleSelector );
 	}
 
 	if( primitive->isPrimitiveVariableValid( pv ) )
@@ -160,6 +141,24 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 	}
 }
 
+template<typename DataType, typename Property>
+typename DataType::Ptr PrimitiveReader::readArraySample( const Property &property, const Alembic::Abc::ISampleSelector &sampleSelector )
+{
+	IECore::ConstDataPtr data = cachedArraySample(
+		property, sampleSelector, DataType::staticTypeId(),
+		[&] () -> IECore::DataPtr {
+			typename Property::sample_ptr_type sample;
+			property.get( sample, sampleSelector );
+			typename DataType::Ptr result = new DataType();
+			result->writable().resize( sample->size() );
+			std::copy( sample->get(), sample->get() + sample->size(), result->writable().begin() );
+			return result;
+		}
+	);
+
+	return boost::static_pointer_cast<DataType>( data->copy() );
+}
+
 } // namespace IECoreAlembic
 
 #endif // IECOREALEMBIC_PRIMITIVEREADER_INL
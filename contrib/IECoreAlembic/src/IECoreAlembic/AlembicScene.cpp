@@ -61,11 +61,13 @@
 
 #include "boost/tokenizer.hpp"
 
-#include "tbb/spin_mutex.h"
-
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 
 using namespace Alembic::Abc;
@@ -121,6 +123,24 @@ GeometricData::Interpretation convertInterpretation( const std::string &interpre
 	return GeometricData::Interpretation::None;
 }
 
+// Ogawa reads via a pool of streams, each with its own file handle and
+// lock, so the number of streams limits the number of threads that can
+// read from an archive concurrently. We match the hardware concurrency,
+// but cap it to avoid running out of file handles when many archives are
+// open at once. The `IECOREALEMBIC_OGAWA_STREAMS` environment variable
+// may be used to override the default.
+size_t numOgawaStreams()
+{
+	static const size_t g_numStreams = [] () -> size_t {
+		if( const char *c = getenv( "IECOREALEMBIC_OGAWA_STREAMS" ) )
+		{
+			return std::max( 1, atoi( c ) );
+		}
+		return std::clamp<size_t>( std::thread::hardware_concurrency(), 4, 16 );
+	}();
+	return g_numStreams;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -156,18 +176,7 @@ class AlembicScene::AlembicReader : public AlembicIO
 		AlembicReader( const std::string &fileName )
 		{
 			IFactory factory;
-			// Increasing the number of streams gives better
-			// multithreaded performance, because Ogawa locks
-			// around the stream. But each stream consumes an
-			// additional file handle, so we choose a fairly
-			// conservative number of streams, rather than simply
-			// matching the core count.
-			//
-			// I believe that Alembic 1.7.2 removes the locking
-			// entirely at which point the number of streams is
-			// irrelevant - see https://github.com/alembic/alembic/issues/124
-			// for more details.
-			factory.setOgawaNumStreams( 4 );
+			factory.setOgawaNumStreams( numOgawaStreams() );
 			m_archive = std::make_shared<IArchive>( factory.getArchive( fileName ) );
 			if( !m_archive->valid() )
 			{
@@ -175,6 +184,18 @@ class AlembicScene::AlembicReader : public AlembicIO
 				// be applied when it fails to load an archive - instead it returns an invalid archive.
 				throw IECore::Exception( fmt::format( "Unable to open file \"{}\"", fileName ) );
 			}
+			initChildren();
+		}
+
+		~AlembicReader() override
+		{
+			for( size_t i = 0, s = m_numChildSlots; i < s; ++i )
+			{
+				if( AlembicReader *c = m_children[i].load( std::memory_order_relaxed ) )
+				{
+					c->removeRef();
+				}
+			}
 		}
 
 		// AlembicIO implementation
@@ -226,19 +247,8 @@ class AlembicScene::AlembicReader : public AlembicIO
 
 		AlembicIOPtr child( const IECoreScene::SceneInterface::Name &name, SceneInterface::MissingBehaviour missingBehaviour ) override
 		{
-			ChildMapMutex::scoped_lock lock( m_childrenMutex );
-
-			const std::pair<ChildMap::iterator, bool> insertion = m_children.insert( ChildMap::value_type( name, nullptr ) );
-			if( insertion.second )
-			{
-				IObject c = m_xform ? m_xform.getChild( name ) : m_archive->getTop().getChild( name );
-				if( c && IXform::matches( c.getMetaData() ) )
-				{
-					insertion.first->second = new AlembicReader( m_archive, IXform( c, kWrapExisting ) );
-				}
-			}
-
-			if( !insertion.first->second )
+			const auto it = m_childIndices.find( name );
+			if( it == m_childIndices.end() )
 			{
 				switch( missingBehaviour )
 				{
@@ -251,7 +261,25 @@ class AlembicScene::AlembicReader : public AlembicIO
 				}
 			}
 
-			return insertion.first->second;
+			// Children are created lazily, and published to other threads
+			// with a compare-and-swap rather than a lock. If we lose a race
+			// with another thread we discard our child and use theirs.
+
+			std::atomic<AlembicReader *> &slot = m_children[it->second];
+			AlembicReader *result = slot.load( std::memory_order_acquire );
+			if( !result )
+			{
+				IObject parent = m_xform ? IObject( m_xform ) : m_archive->getTop();
+				AlembicReaderPtr newChild = new AlembicReader( m_archive, IXform( parent.getChild( it->second ), kWrapExisting ) );
+				if( slot.compare_exchange_strong( result, newChild.get(), std::memory_order_acq_rel, std::memory_order_acquire ) )
+				{
+					// Slot now owns a reference.
+					newChild->addRef();
+					result = newChild.get();
+				}
+			}
+
+			return result;
 		}
 
 		ConstAlembicIOPtr child( const IECoreScene::SceneInterface::Name &name, SceneInterface::MissingBehaviour missingBehaviour ) const
@@ -1169,17 +1197,27 @@ class AlembicScene::AlembicReader : public AlembicIO
 		AlembicReader( const std::shared_ptr<IArchive> &archive, const IXform &xform = IXform() )
 			:	m_archive( archive ), m_xform( xform )
 		{
-			if( !m_xform )
-			{
-				return;
-			}
-			for( size_t i = 0, s = m_xform.getNumChildren(); i < s; ++i )
+			initChildren();
+		}
+
+		// Indexes the child transforms, and creates the reader for our
+		// object, if we have one.
+		void initChildren()
+		{
+			IObject o = m_xform ? IObject( m_xform ) : m_archive->getTop();
+			m_numChildSlots = o.getNumChildren();
+			m_children.reset( new std::atomic<AlembicReader *>[m_numChildSlots] );
+			for( size_t i = 0; i < m_numChildSlots; ++i )
 			{
-				const AbcA::ObjectHeader &childHeader = m_xform.getChildHeader( i );
-				if( !IXform::matches( childHeader ) )
+				m_children[i].store( nullptr, std::memory_order_relaxed );
+				const AbcA::ObjectHeader &childHeader = o.getChildHeader( i );
+				if( IXform::matches( childHeader ) )
+				{
+					m_childIndices[childHeader.getName()] = i;
+				}
+				else if( m_xform && !m_objectReader )
 				{
 					m_objectReader = ObjectReader::create( m_xform.getChild( i ) );
-					return;
 				}
 			}
 		}
@@ -1310,10 +1348,13 @@ class AlembicScene::AlembicReader : public AlembicIO
 		IXform m_xform; // Empty when we're at the root
 		std::unique_ptr<IECoreAlembic::ObjectReader> m_objectReader; // Null when there's no object
 
-		typedef std::unordered_map<IECoreScene::SceneInterface::Name, AlembicReaderPtr> ChildMap;
-		ChildMap m_children;
-		typedef tbb::spin_mutex ChildMapMutex;
-		ChildMapMutex m_childrenMutex;
+		// Maps from the name of each child transform to the index of its
+		// header, which is also the index of its slot in `m_children`.
+		// Immutable after construction, so safe to read concurrently.
+		std::unordered_map<IECoreScene::SceneInterface::Name, size_t> m_childIndices;
+		// Lazily created children, each holding a reference when non-null.
+		std::unique_ptr<std::atomic<AlembicReader *>[]> m_children;
+		size_t m_numChildSlots = 0;
 
 };
 
@@ -57,37 +57,17 @@ class MeshReader : public PrimitiveReader
 		template<typename Schema>
 		IECoreScene::MeshPrimitivePtr readTypedSample( const Schema &schema, const Alembic::Abc::ISampleSelector &sampleSelector, const Canceller *canceller = nullptr ) const
 		{
-			Abc::Int32ArraySamplePtr faceCountsSample;
-			Canceller::check( canceller );
-			schema.getFaceCountsProperty().get( faceCountsSample, sampleSelector );
+			// Topology is typically constant, in which case `readArraySample()`
+			// will share it between all samples rather than converting it again.
 
 			Canceller::check( canceller );
-			IntVectorDataPtr verticesPerFace = new IntVectorData();
-			verticesPerFace->writable().insert(
-				verticesPerFace->writable().begin(),
-				faceCountsSample->get(),
-				faceCountsSample->get() + faceCountsSample->size()
-			);
-
-			Abc::Int32ArraySamplePtr faceIndicesSample;
-			Canceller::check( canceller );
-			schema.getFaceIndicesProperty().get( faceIndicesSample, sampleSelector );
+			IntVectorDataPtr verticesPerFace = readArraySample<IntVectorData>( schema.getFaceCountsProperty(), sampleSelector );
 
 			Canceller::check( canceller );
-			IntVectorDataPtr vertexIds = new IntVectorData();
-			vertexIds->writable().insert(
-				vertexIds->writable().begin(),
-				faceIndicesSample->get(),
-				faceIndicesSample->get() + faceIndicesSample->size()
-			);
-
-			Abc::P3fArraySamplePtr positionsSample;
-			Canceller::check( canceller );
-			schema.getPositionsProperty().get( positionsSample, sampleSelector );
+			IntVectorDataPtr vertexIds = readArraySample<IntVectorData>( schema.getFaceIndicesProperty(), sampleSelector );
 
-			V3fVectorDataPtr points = new V3fVectorData();
 			Canceller::check( canceller );
-			points->writable().insert( points->writable().end(), positionsSample->get(), positionsSample->get() + positionsSample->size() );
+			V3fVectorDataPtr points = readArraySample<V3fVectorData>( schema.getPositionsProperty(), sampleSelector );
 
 			MeshPrimitivePtr result = new IECoreScene::MeshPrimitive( verticesPerFace, vertexIds, "linear", points );
 
@@ -98,12 +78,7 @@ class MeshReader : public PrimitiveReader
 			if( schema.getVelocitiesProperty().valid() )
 			{
 				Canceller::check( canceller );
-				Abc::V3fArraySamplePtr velocitySample;
-				schema.getVelocitiesProperty().get( velocitySample, sampleSelector );
-
-				V3fVectorDataPtr velocityData = new V3fVectorData();
-				velocityData->writable().insert( velocityData->writable().end(), velocitySample->get(), velocitySample->get() + velocitySample->size() );
-
+				V3fVectorDataPtr velocityData = readArraySample<V3fVectorData>( schema.getVelocitiesProperty(), sampleSelector );
 				velocityData->setInterpretation( GeometricData::Vector );
 				result->variables["velocity"] = PrimitiveVariable( PrimitiveVariable::Vertex, velocityData );
 			}
@@ -123,31 +98,13 @@ class MeshReader : public PrimitiveReader
 				return;
 			}
 
-			typedef IV2fArrayProperty::sample_ptr_type SamplePtr;
-			auto uvParam = uvs.getIndexedValue( sampleSelector );
-			SamplePtr sample = uvParam.getVals();
-			size_t uvSize = sample->size();
-			V2fVectorDataPtr uvData = new V2fVectorData;
+			V2fVectorDataPtr uvData = readArraySample<V2fVectorData>( uvs.getValueProperty(), sampleSelector );
 			uvData->setInterpretation( GeometricData::UV );
-			std::vector<Imath::V2f> &uvValues = uvData->writable();
-			uvValues.reserve( uvSize );
-			for( size_t i=0; i<uvSize; ++i )
-			{
-				uvValues.push_back( (*sample)[i] );
-			}
 
 			IntVectorDataPtr indexData = nullptr;
-			if( uvParam.isIndexed() )
+			if( uvs.isIndexed() )
 			{
-				UInt32ArraySamplePtr indices = uvParam.getIndices();
-				size_t indexSize = indices->size();
-				indexData = new IntVectorData;
-				std::vector<int> &indexValues = indexData->writable();
-				indexValues.reserve( indexSize );
-				for( size_t i = 0; i < indexSize; ++i )
-				{
-					indexValues.push_back( (*indices)[i] );
-				}
+				indexData = readArraySample<IntVectorData>( uvs.getIndexProperty(), sampleSelector );
 			}
 
 			const PrimitiveVariable primitiveVariable( PrimitiveReader::interpolation( uvs.getScope() ), uvData, indexData );
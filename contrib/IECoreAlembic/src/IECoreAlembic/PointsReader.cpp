@@ -79,24 +79,21 @@ class PointsReader : public PrimitiveReader
 		IECore::ObjectPtr readSample( const Alembic::Abc::ISampleSelector &sampleSelector, const Canceller *canceller ) const override
 		{
 			const IPointsSchema &pointsSchema = m_points.getSchema();
-			const IPointsSchema::Sample sample = pointsSchema.getValue( sampleSelector );
 
 			Canceller::check( canceller );
-			V3fVectorDataPtr p = new V3fVectorData();
-			p->writable().insert( p->writable().end(), sample.getPositions()->get(), sample.getPositions()->get() + sample.getPositions()->size() );
+			V3fVectorDataPtr p = readArraySample<V3fVectorData>( pointsSchema.getPositionsProperty(), sampleSelector );
 
 			PointsPrimitivePtr result = new PointsPrimitive( p );
 
 			Canceller::check( canceller );
-			UInt64VectorDataPtr id = new UInt64VectorData;
-			id->writable().insert( id->writable().end(), sample.getIds()->get(), sample.getIds()->get() + sample.getIds()->size() );
+			UInt64VectorDataPtr id = readArraySample<UInt64VectorData>( pointsSchema.getIdsProperty(), sampleSelector );
 			result->variables["id"] = PrimitiveVariable( PrimitiveVariable::Vertex, id );
 
-			if( Alembic::Abc::V3fArraySamplePtr velocities = sample.getVelocities() )
+			const IV3fArrayProperty &velocitiesProperty = pointsSchema.getVelocitiesProperty();
+			if( velocitiesProperty.valid() && velocitiesProperty.getNumSamples() )
 			{
 				Canceller::check( canceller );
-				V3fVectorDataPtr velocityData = new V3fVectorData;
-				velocityData->writable().insert( velocityData->writable().begin(), velocities->get(), velocities->get() + velocities->size() );
+				V3fVectorDataPtr velocityData = readArraySample<V3fVectorData>( velocitiesProperty, sampleSelector );
 				velocityData->setInterpretation( GeometricData::Vector );
 				result->variables["velocity"] = PrimitiveVariable( PrimitiveVariable::Vertex, velocityData );
 			}
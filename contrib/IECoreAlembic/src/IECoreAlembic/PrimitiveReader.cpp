@@ -37,14 +37,88 @@
 
 #include "IECoreAlembic/IGeomParamTraits.h"
 
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
 
+#include "boost/lexical_cast.hpp"
+
+#include <cstdlib>
+
 using namespace Alembic::Abc;
 using namespace Alembic::AbcGeom;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace IECoreAlembic;
 
+//////////////////////////////////////////////////////////////////////////
+// Sample cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Hashes the sample key and target type for use as the cache key, and
+// provides access to the converter for use by the getter.
+struct SampleCacheGetterKey
+{
+
+	SampleCacheGetterKey( const AbcA::ArraySampleKey &sampleKey, IECore::TypeId dataType, const std::function<DataPtr ()> &converter )
+		:	converter( converter )
+	{
+		hash.append( sampleKey.digest.words, 2 );
+		hash.append( (uint64_t)sampleKey.numBytes );
+		hash.append( (int)sampleKey.origPOD );
+		hash.append( (int)sampleKey.readPOD );
+		hash.append( (int)dataType );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const std::function<DataPtr ()> &converter;
+	IECore::MurmurHash hash;
+
+};
+
+using SampleCache = IECore::LRUCache<IECore::MurmurHash, IECore::ConstDataPtr, IECore::LRUCachePolicy::Parallel, SampleCacheGetterKey>;
+
+SampleCache &sampleCache()
+{
+	static SampleCache *g_cache = [] () {
+		const char *m = getenv( "IECOREALEMBIC_SAMPLE_CACHE_MEMORY" );
+		const size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+		return new SampleCache(
+			[] ( const SampleCacheGetterKey &key, size_t &cost ) -> ConstDataPtr {
+				DataPtr result = key.converter();
+				cost = result->memoryUsage();
+				return result;
+			},
+			1024 * 1024 * mi
+		);
+	}();
+	return *g_cache;
+}
+
+} // namespace
+
+IECore::ConstDataPtr PrimitiveReader::cachedArraySample( const Alembic::Abc::IArrayProperty &property, const Alembic::Abc::ISampleSelector &sampleSelector, IECore::TypeId dataType, const SampleConverter &converter )
+{
+	AbcA::ArraySampleKey sampleKey;
+	if( !property.getKey( sampleKey, sampleSelector ) )
+	{
+		// No key available, so we can't cache.
+		return converter();
+	}
+
+	return sampleCache().get( SampleCacheGetterKey( sampleKey, dataType, converter ) );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// PrimitiveReader
+//////////////////////////////////////////////////////////////////////////
+
 void PrimitiveReader::readArbGeomParams( const Alembic::Abc::ICompoundProperty &params, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive, const Canceller *canceller ) const
 {
 	if( !params.valid() )
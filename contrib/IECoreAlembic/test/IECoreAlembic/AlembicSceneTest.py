@@ -394,6 +394,25 @@ class AlembicSceneTest( unittest.TestCase ) :
 			self.assertEqual( mesh.verticesPerFace, mesh2.verticesPerFace )
 			self.assertNotEqual( mesh["P"], mesh2["P"] )
 
+	def testModifyingObjectDoesntAffectSubsequentReads( self ) :
+
+		a = IECoreScene.SceneInterface.create( os.path.join( os.path.dirname( __file__ ), "data", "animatedCube.abc" ), IECore.IndexedIO.OpenMode.Read )
+		m = a.child( "pCube1" )
+
+		mesh = m.readObjectAtSample( 0 )
+		originalMesh = mesh.copy()
+
+		mesh["P"].data[0] = imath.V3f( 100 )
+		mesh["N"].data[0] = imath.V3f( 0, 1, 0 )
+
+		mesh2 = m.readObjectAtSample( 0 )
+		self.assertEqual( mesh2, originalMesh )
+
+		# Reading via a separate scene should share the same cached
+		# samples, and still not see the modifications.
+		b = IECoreScene.SceneInterface.create( os.path.join( os.path.dirname( __file__ ), "data", "animatedCube.abc" ), IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( b.child( "pCube1" ).readObjectAtSample( 0 ), originalMesh )
+
 	def testConvertInterpolated( self ) :
 
 		a = IECoreScene.SceneInterface.create( os.path.join( os.path.dirname( __file__ ), "data", "animatedCube.abc" ), IECore.IndexedIO.OpenMode.Read )
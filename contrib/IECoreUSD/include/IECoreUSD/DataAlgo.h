@@ -62,7 +62,8 @@ namespace DataAlgo
 template<typename T>
 typename USDTypeTraits<T>::CortexType fromUSD( const T &value );
 
-/// Converts USD `array` to Cortex VectorData.
+/// Converts USD `array` to Cortex VectorData. This requires a single
+/// copy, because VectorData must own its storage.
 template<typename T>
 boost::intrusive_ptr< typename USDTypeTraits<T>::CortexVectorDataType > fromUSD( const pxr::VtArray<T> &array );
 
@@ -90,6 +91,12 @@ typename CortexTypeTraits<T>::USDType toUSD( const T &value, typename std::enabl
 /// If `arrayRequired` is true, then even simple types will be converted to
 /// a VtArray containing a single element. Returns an empty VtValue
 /// if no conversion is available.
+///
+/// Where the Cortex and USD types are bitwise equivalent, the VtArray
+/// shares memory with `data` rather than copying it, and keeps it alive
+/// for as long as the array exists. Both sides remain free to modify
+/// their values, with copy-on-write ensuring that neither modification
+/// is visible to the other.
 IECOREUSD_API pxr::VtValue toUSD( const IECore::Data *data, bool arrayRequired = false );
 
 /// Returns the Sdf type for `data`. This augments the type of
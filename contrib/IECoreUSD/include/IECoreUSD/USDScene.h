@@ -35,7 +35,9 @@
 #ifndef IECOREUSD_USDSCENE_H
 #define IECOREUSD_USDSCENE_H
 
-#include "TypeIds.h"
+#include "IECoreUSD/TypeIds.h"
+
+#include "IECoreUSD/Export.h"
 
 #include "IECoreScene/SceneInterface.h"
 #include "IECoreScene/ShaderNetwork.h"
@@ -54,7 +56,7 @@ IECORE_POP_DEFAULT_VISIBILITY
 namespace IECoreUSD
 {
 
-class USDScene : public IECoreScene::SceneInterface
+class IECOREUSD_API USDScene : public IECoreScene::SceneInterface
 {
 	public:
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( USDScene, IECoreUSD::USDSceneTypeId, IECoreScene::SceneInterface )
@@ -101,6 +103,12 @@ class USDScene : public IECoreScene::SceneInterface
 		IECoreScene::ConstSceneInterfacePtr scene( const Path &path, MissingBehaviour missingBehaviour ) const override;
 		void hash( HashType hashType, double time, IECore::MurmurHash &h ) const override;
 
+		/// Reads the objects at several locations at once, converting them in
+		/// parallel. Paths are relative to this location, and `nullptr` is
+		/// returned for locations without an object. Throws if any path does
+		/// not exist.
+		std::vector<IECore::ConstObjectPtr> readObjects( const std::vector<Path> &paths, double time, const IECore::Canceller *canceller = nullptr ) const;
+
 		static IECoreScene::SceneInterface::Path fromUSD( const pxr::SdfPath &path );
 		static pxr::SdfPath toUSD( const IECoreScene::SceneInterface::Path &path, const bool relative = false );
 
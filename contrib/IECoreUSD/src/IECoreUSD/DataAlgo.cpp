@@ -142,7 +142,7 @@ IECore::DataPtr dataFromValue( const pxr::VtValue &value, GeometricData::Interpr
 template<typename T>
 IECore::DataPtr dataFromArray( const pxr::VtValue &value, GeometricData::Interpretation interpretation, bool arrayAccepted )
 {
-	auto a = value.Get<VtArray<T>>();
+	const auto &a = value.Get<VtArray<T>>();
 	if( !arrayAccepted )
 	{
 		if( a.size() != 1 )
@@ -400,6 +400,43 @@ IECore::DataPtr IECoreUSD::DataAlgo::fromUSD( const pxr::UsdAttribute &attribute
 namespace
 {
 
+// Allows a VtArray to reference the memory owned by Cortex VectorData,
+// keeping the data alive until the last VtArray referencing it is destroyed.
+// We hold a copy of the original data rather than the original itself. This
+// is cheap because the copy shares the underlying storage, but it means that
+// any subsequent call to `writable()` on the original will trigger a
+// copy-on-write instead of modifying the memory referenced by the VtArray.
+// VtArray considers foreign data to be shared, so it too will copy before
+// making any modifications.
+class DataForeignSource : public Vt_ArrayForeignDataSource
+{
+
+	public :
+
+		template<typename T>
+		DataForeignSource( const IECore::TypedData<vector<T>> *data )
+			:	Vt_ArrayForeignDataSource( &detached ), m_data( data->copy() )
+		{
+		}
+
+		template<typename T>
+		const vector<T> &readable() const
+		{
+			return static_cast<const IECore::TypedData<vector<T>> *>( m_data.get() )->readable();
+		}
+
+	private :
+
+		// Called by VtArray when the last array referencing us is destroyed.
+		static void detached( Vt_ArrayForeignDataSource *self )
+		{
+			delete static_cast<DataForeignSource *>( self );
+		}
+
+		IECore::ConstDataPtr m_data;
+
+};
+
 struct VtValueFromData
 {
 
@@ -408,12 +445,22 @@ struct VtValueFromData
 	{
 		using USDType = typename CortexTypeTraits<T>::USDType;
 		using ArrayType = VtArray<USDType>;
-		ArrayType array;
-		array.assign(
-			reinterpret_cast<const USDType *>( data->readable().data() ),
-			reinterpret_cast<const USDType *>( data->readable().data() + data->readable().size() )
+		if( data->readable().empty() )
+		{
+			return VtValue( ArrayType() );
+		}
+
+		// Share memory with `data` rather than copying it.
+		DataForeignSource *source = new DataForeignSource( data );
+		const vector<T> &v = source->readable<T>();
+		return VtValue(
+			ArrayType(
+				source,
+				// Cast is safe because VtArray never modifies foreign data in place.
+				const_cast<USDType *>( reinterpret_cast<const USDType *>( v.data() ) ),
+				v.size()
+			)
 		);
-		return VtValue( array );
 	}
 
 	template<typename T>
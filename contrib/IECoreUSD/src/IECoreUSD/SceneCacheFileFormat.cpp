@@ -36,9 +36,9 @@
 
 #include "SceneCacheData.h"
 #include "SdfFileFormatSharedSceneWriters.h"
-#include "USDScene.h"
 
 #include "IECoreUSD/SceneCacheDataAlgo.h"
+#include "IECoreUSD/USDScene.h"
 
 #include "IECoreScene/LinkedScene.h"
 
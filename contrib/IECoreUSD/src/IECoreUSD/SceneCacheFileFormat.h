@@ -35,7 +35,7 @@
 #ifndef IECOREUSD_SCENECACHEFILEFORMAT_H
 #define IECOREUSD_SCENECACHEFILEFORMAT_H
 
-#include "USDScene.h"
+#include "IECoreUSD/USDScene.h"
 
 #include "IECoreScene/SceneInterface.h"
 
@@ -32,7 +32,7 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "USDScene.h"
+#include "IECoreUSD/USDScene.h"
 
 #include "IECoreUSD/AttributeAlgo.h"
 #include "IECoreUSD/DataAlgo.h"
@@ -51,8 +51,11 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "pxr/base/gf/matrix3f.h"
 #include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/gf/matrix4f.h"
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
 #include "pxr/usd/usd/collectionAPI.h"
 #include "pxr/usd/usd/modelAPI.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usdGeom/bboxCache.h"
 #include "pxr/usd/usdGeom/camera.h"
@@ -65,6 +68,7 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "pxr/usd/usdGeom/scope.h"
 #include "pxr/usd/usdGeom/tokens.h"
 #include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdGeom/xformCache.h"
 #include "pxr/usd/usdLux/lightAPI.h"
 #include "pxr/usd/usdShade/material.h"
 #include "pxr/usd/usdShade/materialBindingAPI.h"
@@ -83,9 +87,12 @@ IECORE_POP_DEFAULT_VISIBILITY
 #include "boost/functional/hash.hpp"
 
 #include "tbb/concurrent_hash_map.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
 
 #include "fmt/format.h"
 
+#include <atomic>
 #include <filesystem>
 #include <iostream>
 #include <mutex>
@@ -572,18 +579,15 @@ class ShaderNetworkMightBeTimeVaryingCache : public LRUCache<ShaderNetworkCacheK
 
 };
 
-Imath::M44d localTransform( const pxr::UsdPrim &prim, pxr::UsdTimeCode time )
+Imath::M44d localTransform( const pxr::UsdPrim &prim, pxr::UsdGeomXformCache &xformCache )
 {
-	pxr::UsdGeomXformable transformable( prim );
-	if( !transformable )
+	if( !prim.IsA<pxr::UsdGeomXformable>() )
 	{
 		return Imath::M44d();
 	}
 
-	pxr::GfMatrix4d transform;
 	bool reset = false;
-	transformable.GetLocalTransformation( &transform, &reset, time );
-	Imath::M44d result = DataAlgo::fromUSD( transform );
+	Imath::M44d result = DataAlgo::fromUSD( xformCache.GetLocalTransformation( prim, &reset ) );
 
 	if( reset )
 	{
@@ -592,7 +596,7 @@ Imath::M44d localTransform( const pxr::UsdPrim &prim, pxr::UsdTimeCode time )
 		pxr::UsdPrim parentPrim = prim.GetParent();
 		while( parentPrim )
 		{
-			parentWorldTransform = parentWorldTransform * localTransform( parentPrim, time );
+			parentWorldTransform = parentWorldTransform * localTransform( parentPrim, xformCache );
 			parentPrim = parentPrim.GetParent();
 		}
 		result = result * parentWorldTransform.inverse();
@@ -658,7 +662,7 @@ class USDScene::Location : public RefCounted
 		pxr::UsdPrim prim;
 };
 
-class USDScene::IO : public RefCounted
+class USDScene::IO : public RefCounted, public pxr::TfWeakBase
 {
 
 	public :
@@ -684,10 +688,14 @@ class USDScene::IO : public RefCounted
 			m_usdBindingsCaches[pxr::UsdShadeTokens->allPurpose];
 			m_usdBindingsCaches[pxr::UsdShadeTokens->full];
 			m_usdBindingsCaches[pxr::UsdShadeTokens->preview];
+
+			m_objectsChangedKey = pxr::TfNotice::Register( pxr::TfCreateWeakPtr( this ), &IO::objectsChanged, pxr::UsdStageWeakPtr( m_stage ) );
 		}
 
 		~IO() override
 		{
+			pxr::TfNotice::Revoke( m_objectsChangedKey );
+
 			if( m_openMode == IndexedIO::Write )
 			{
 				for( auto &tagSet : tagSets )
@@ -744,6 +752,32 @@ class USDScene::IO : public RefCounted
 			return timeCode;
 		}
 
+		// Transforms
+		// ==========
+		//
+		// `UsdGeomXformCache` caches the `XformQuery` for each prim, so that
+		// `xformOpOrder` and the ops themselves are resolved only once rather
+		// than on every call to `readTransform()`, and ancestors visited to
+		// handle `resetXformStack` are shared between descendants. The cache
+		// isn't thread-safe, so we keep one per thread, each tracking the time
+		// most recently queried on that thread. The caches are owned by the IO,
+		// so are freed along with the scene, and are cleared whenever the stage
+		// is edited, since the queries they hold may then be stale.
+
+		pxr::UsdGeomXformCache &xformCache( pxr::UsdTimeCode timeCode )
+		{
+			XformCache &result = m_xformCaches.local();
+			const uint64_t stageGeneration = m_stageGeneration.load( std::memory_order_acquire );
+			if( result.stageGeneration != stageGeneration )
+			{
+				result.cache.Clear();
+				result.stageGeneration = stageGeneration;
+			}
+			// Note : `SetTime()` is a no-op if the time is unchanged.
+			result.cache.SetTime( timeCode );
+			return result.cache;
+		}
+
 		// Tags
 		// ====
 		//
@@ -833,6 +867,14 @@ class USDScene::IO : public RefCounted
 
 	private :
 
+		void objectsChanged( const pxr::UsdNotice::ObjectsChanged & )
+		{
+			// We can't clear the caches of other threads safely, so we
+			// just invalidate them, and each thread clears its own cache
+			// on next use.
+			m_stageGeneration.fetch_add( 1, std::memory_order_release );
+		}
+
 		static pxr::UsdStageRefPtr makeStage( const std::string &fileName, IndexedIO::OpenMode openMode )
 		{
 			pxr::UsdStageRefPtr stage;
@@ -884,6 +926,15 @@ class USDScene::IO : public RefCounted
 		ShaderNetworkCache m_shaderNetworkCache;
 		ShaderNetworkMightBeTimeVaryingCache m_shaderNetworkMightBeTimeVaryingCache;
 
+		struct XformCache
+		{
+			pxr::UsdGeomXformCache cache;
+			uint64_t stageGeneration = 0;
+		};
+		tbb::enumerable_thread_specific<XformCache> m_xformCaches;
+		std::atomic<uint64_t> m_stageGeneration = 0;
+		pxr::TfNotice::Key m_objectsChangedKey;
+
 		// Used to identify a file uniquely ( including between different openings of the same filename,
 		// since closing and reopening a file may cause USD to shuffle the contents ).
 		const int m_uniqueId;
@@ -1008,7 +1059,7 @@ ConstDataPtr USDScene::readTransform( double time ) const
 
 Imath::M44d USDScene::readTransformAsMatrix( double time ) const
 {
-	return localTransform( m_location->prim, m_root->timeCode( time ) );
+	return localTransform( m_location->prim, m_root->xformCache( m_root->timeCode( time ) ) );
 }
 
 ConstObjectPtr USDScene::readObject( double time, const Canceller *canceller ) const
@@ -1016,6 +1067,50 @@ ConstObjectPtr USDScene::readObject( double time, const Canceller *canceller ) c
 	return ObjectAlgo::readObject( m_location->prim, m_root->timeCode( time ), canceller );
 }
 
+std::vector<ConstObjectPtr> USDScene::readObjects( const std::vector<Path> &paths, double time, const Canceller *canceller ) const
+{
+	// Resolve all the prims up front, so that we throw for invalid
+	// paths before doing any expensive conversions.
+	std::vector<pxr::UsdPrim> prims;
+	prims.reserve( paths.size() );
+	for( const auto &path : paths )
+	{
+		pxr::UsdPrim prim = m_location->prim;
+		for( const auto &name : path )
+		{
+			pxr::UsdPrim childPrim = prim.GetChild( pxr::TfToken( name.string() ) );
+			if( !isSceneChild( childPrim ) )
+			{
+				throw IOException( "USDScene::readObjects : UsdPrim \"" + prim.GetPath().GetAsString() + "\" has no child named \"" + name.string() + "\"" );
+			}
+			prim = childPrim;
+		}
+		prims.push_back( prim );
+	}
+
+	const pxr::UsdTimeCode timeCode = m_root->timeCode( time );
+	std::vector<ConstObjectPtr> result( prims.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, prims.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Canceller::check( canceller );
+				if( ObjectAlgo::canReadObject( prims[i] ) )
+				{
+					result[i] = ObjectAlgo::readObject( prims[i], timeCode, canceller );
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
 SceneInterface::Name USDScene::name() const
 {
 	return SceneInterface::Name( m_location->prim.GetName() );
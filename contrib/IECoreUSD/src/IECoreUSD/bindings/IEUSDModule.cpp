@@ -34,9 +34,13 @@
 
 #include "IECoreUSD/DataAlgo.h"
 #include "IECoreUSD/SceneCacheDataAlgo.h"
+#include "IECoreUSD/USDScene.h"
 
 #include "IECoreScene/SceneInterface.h"
 
+#include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "IECore/IndexedIO.h"
 
 #if PXR_VERSION >= 2505
@@ -90,6 +94,30 @@ static list fromInternalPath( list l )
 	return vectorToList( path );
 }
 
+list readObjects( const USDScene &scene, list pythonPaths, double time, const IECore::Canceller *canceller )
+{
+	std::vector<SceneInterface::Path> paths;
+	paths.reserve( len( pythonPaths ) );
+	for( int i = 0; i < len( pythonPaths ); ++i )
+	{
+		list l = extract<list>( pythonPaths[i] );
+		paths.push_back( listToVector( l ) );
+	}
+
+	std::vector<ConstObjectPtr> objects;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		objects = scene.readObjects( paths, time, canceller );
+	}
+
+	list result;
+	for( const auto &o : objects )
+	{
+		result.append( o ? o->copy() : ObjectPtr() );
+	}
+	return result;
+}
+
 #if PXR_VERSION >= 2505
 
 // Registers `boost::python` converters for types
@@ -131,6 +159,11 @@ BOOST_PYTHON_MODULE( _IECoreUSD )
 	PxrBoostConverter<pxr::SdfValueTypeName>::registerConverters();
 #endif
 
+	IECorePython::RunTimeTypedClass<USDScene>()
+		.def( init<const std::string &, IECore::IndexedIO::OpenMode>() )
+		.def( "readObjects", &readObjects, ( arg( "paths" ), arg( "time" ), arg( "canceller" ) = object() ) )
+	;
+
 	{
 		object dataAlgoModule( handle<>( borrowed( PyImport_AddModule( "IECoreUSD.DataAlgo" ) ) ) );
 		scope().attr( "DataAlgo" ) = dataAlgoModule;
@@ -35,6 +35,7 @@
 import unittest
 import imath
 
+import pxr.Gf
 import pxr.Sdf
 
 import IECore
@@ -87,6 +88,39 @@ class DataAlgoTest( unittest.TestCase ) :
 		] :
 			self.assertEqual( IECoreUSD.DataAlgo.toUSD( data ), value )
 
+	def testToUSDSharesMemory( self ) :
+
+		data = IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 1000 ) ], IECore.GeometricData.Interpretation.Point )
+		array = IECoreUSD.DataAlgo.toUSD( data )
+		self.assertEqual( len( array ), 1000 )
+		self.assertEqual( array[10], pxr.Gf.Vec3f( 10 ) )
+
+		# Modifying the source must not affect the array,
+		# even though they initially share memory.
+
+		data[10] = imath.V3f( -1 )
+		self.assertEqual( array[10], pxr.Gf.Vec3f( 10 ) )
+
+		# And modifying the array must not affect the source.
+
+		array2 = IECoreUSD.DataAlgo.toUSD( data )
+		array2[20] = pxr.Gf.Vec3f( -2 )
+		self.assertEqual( data[20], imath.V3f( 20 ) )
+		self.assertEqual( array[20], pxr.Gf.Vec3f( 20 ) )
+
+		# The arrays must remain valid after the source
+		# has been destroyed, including arrays converted
+		# from a temporary.
+
+		del data
+		self.assertEqual( array[999], pxr.Gf.Vec3f( 999 ) )
+		self.assertEqual( array2[10], pxr.Gf.Vec3f( -1 ) )
+
+		array3 = IECoreUSD.DataAlgo.toUSD( IECore.IntVectorData( range( 0, 1000 ) ) )
+		self.assertEqual( list( array3 ), list( range( 0, 1000 ) ) )
+
+		self.assertEqual( len( IECoreUSD.DataAlgo.toUSD( IECore.V3fVectorData() ) ), 0 )
+
 	def testToFromInternalName( self ) :
 
 		a = "a-name(that-is-bad)"
@@ -2930,6 +2930,77 @@ class USDSceneTest( unittest.TestCase ) :
 		for t in ( 1.0, 1.5, 2.0 ) :
 			self.assertEqual( child.readBound( t ), imath.Box3d( imath.V3d( -t ), imath.V3d( t ) ) )
 
+	def testAnimatedWriteRoundTrip( self ) :
+
+		times = [ 1.0, 2.0, 3.0 ]
+
+		def mesh( t ) :
+			result = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( t ) ), imath.V2i( 2 ) )
+			result["Cs"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.Color3fVectorData( [ imath.Color3f( t ) ] * result.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) )
+			)
+			return result
+
+		def curves( t ) :
+			result = IECoreScene.CurvesPrimitive(
+				IECore.IntVectorData( [ 4, 4 ] ), IECore.CubicBasisf.linear(), False,
+				IECore.V3fVectorData( [ imath.V3f( x, t, c ) for c in range( 0, 2 ) for x in range( 0, 4 ) ] )
+			)
+			result["width"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.FloatVectorData( [ t ] * 8 ),
+			)
+			return result
+
+		def points( t ) :
+			return IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, t, 0 ) for x in range( 0, 10 ) ] ) )
+
+		def transform( t ) :
+			return IECore.M44dData( imath.M44d().translate( imath.V3d( t, 0, 0 ) ).rotate( imath.V3d( 0, t, 0 ) ) )
+
+		def bound( t ) :
+			return imath.Box3d( imath.V3d( -t ), imath.V3d( t ) )
+
+		fileName = os.path.join( self.temporaryDirectory(), "roundTrip.usda" )
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Write )
+		meshLocation = root.createChild( "mesh" )
+		curvesLocation = root.createChild( "curves" )
+		pointsLocation = root.createChild( "points" )
+
+		for t in times :
+			meshLocation.writeObject( mesh( t ), t )
+			meshLocation.writeTransform( transform( t ), t )
+			meshLocation.writeBound( bound( t ), t )
+			curvesLocation.writeObject( curves( t ), t )
+			curvesLocation.writeBound( bound( t ), t )
+			pointsLocation.writeObject( points( t ), t )
+			pointsLocation.writeTransform( transform( t ), t )
+
+		del meshLocation, curvesLocation, pointsLocation, root
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+		meshLocation = root.child( "mesh" )
+		curvesLocation = root.child( "curves" )
+		pointsLocation = root.child( "points" )
+
+		for t in times :
+
+			readMesh = meshLocation.readObject( t )
+			self.assertEqual( readMesh.verticesPerFace, mesh( t ).verticesPerFace )
+			self.assertEqual( readMesh.vertexIds, mesh( t ).vertexIds )
+			self.assertEqual( readMesh["P"].data, mesh( t )["P"].data )
+			self.assertEqual( readMesh["Cs"], mesh( t )["Cs"] )
+			self.assertTrue( meshLocation.readTransformAsMatrix( t ).equalWithAbsError( transform( t ).value, 1e-6 ) )
+			self.assertEqual( meshLocation.readBound( t ), bound( t ) )
+
+			self.assertEqual( curvesLocation.readObject( t ), curves( t ) )
+			self.assertEqual( curvesLocation.readBound( t ), bound( t ) )
+
+			readPoints = pointsLocation.readObject( t )
+			self.assertEqual( readPoints["P"].data, points( t )["P"].data )
+			self.assertTrue( pointsLocation.readTransformAsMatrix( t ).equalWithAbsError( transform( t ).value, 1e-6 ) )
+
 	def testShaders( self ) :
 
 		# Write shaders
@@ -4526,6 +4597,48 @@ class USDSceneTest( unittest.TestCase ) :
 		self.assertEqual( root.childNames(), [ "sphere" ] )
 		self.assertIsInstance( root.child( "sphere" ).readObject( 0 ), IECoreScene.SpherePrimitive )
 
+	def testTransformsUpdateAfterStageEdits( self ) :
+
+		stage = pxr.Usd.Stage.CreateInMemory()
+		xform = pxr.UsdGeom.Xform.Define( stage, "/group" )
+		translateOp = xform.AddTranslateOp()
+		translateOp.Set( pxr.Gf.Vec3d( 1, 2, 3 ) )
+		pxr.UsdGeom.Xform.Define( stage, "/group/child" )
+		id = pxr.UsdUtils.StageCache.Get().Insert( stage )
+
+		root = IECoreScene.SceneInterface.create( "stageCache:{}.usd".format( id.ToString() ), IECore.IndexedIO.OpenMode.Read )
+		group = root.child( "group" )
+		self.assertEqual( group.readTransformAsMatrix( 0 ), imath.M44d().translate( imath.V3d( 1, 2, 3 ) ) )
+
+		# Edit a value.
+
+		translateOp.Set( pxr.Gf.Vec3d( 4, 5, 6 ) )
+		self.assertEqual( group.readTransformAsMatrix( 0 ), imath.M44d().translate( imath.V3d( 4, 5, 6 ) ) )
+
+		# Edit the op order, which changes the queries cached by
+		# `UsdGeomXformCache`.
+
+		xform.AddScaleOp().Set( pxr.Gf.Vec3f( 2 ) )
+		self.assertEqual(
+			group.readTransformAsMatrix( 0 ),
+			imath.M44d().scale( imath.V3d( 2 ) ) * imath.M44d().translate( imath.V3d( 4, 5, 6 ) )
+		)
+
+		# And make the child reset the transform stack, which changes
+		# which ancestors are visited.
+
+		child = pxr.UsdGeom.Xform( stage.GetPrimAtPath( "/group/child" ) )
+		child.AddTranslateOp().Set( pxr.Gf.Vec3d( 1, 0, 0 ) )
+		self.assertEqual( group.child( "child" ).readTransformAsMatrix( 0 ), imath.M44d().translate( imath.V3d( 1, 0, 0 ) ) )
+
+		child.SetResetXformStack( True )
+		self.assertEqual(
+			group.child( "child" ).readTransformAsMatrix( 0 ),
+			imath.M44d().translate( imath.V3d( 1, 0, 0 ) ) * ( imath.M44d().scale( imath.V3d( 2 ) ) * imath.M44d().translate( imath.V3d( 4, 5, 6 ) ) ).inverse()
+		)
+
+		pxr.UsdUtils.StageCache.Get().Erase( id )
+
 	def testRoundTripArnoldLight( self ) :
 
 		lightShader = IECoreScene.ShaderNetwork(
@@ -5040,5 +5153,71 @@ class USDSceneTest( unittest.TestCase ) :
 					self.assertEqual( loadedShaderNetwork.getShader( "scale" ).name, "floatAttribute" )
 					self.assertEqual( loadedShaderNetwork.getShader( "scale" ).type, "osl:shader" )
 
+	def testReadObjects( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "readObjects.usda" )
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Write )
+		group = root.createChild( "group" )
+		for i in range( 0, 20 ) :
+			for t in ( 0, 1 ) :
+				group.createChild( "mesh{}".format( i ) ).writeObject(
+					IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( i + t + 1 ) ) ), t
+				)
+		del root, group
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+		self.assertIsInstance( root, IECoreUSD.USDScene )
+
+		paths = [ [ "group", "mesh{}".format( i ) ] for i in range( 0, 20 ) ] + [ [ "group" ] ]
+		for t in ( 0, 1 ) :
+			objects = root.readObjects( paths, t )
+			self.assertEqual( len( objects ), len( paths ) )
+			for path, o in zip( paths, objects ) :
+				if root.scene( path ).hasObject() :
+					self.assertEqual( o, root.scene( path ).readObject( t ) )
+				else :
+					self.assertIsNone( o )
+
+		# Paths are relative to the location.
+
+		group = root.child( "group" )
+		self.assertEqual( group.readObjects( [ [ "mesh1" ] ], 0 )[0], group.child( "mesh1" ).readObject( 0 ) )
+		self.assertEqual( group.readObjects( [], 0 ), [] )
+
+		with self.assertRaisesRegex( RuntimeError, 'USDScene::readObjects : UsdPrim "/group" has no child named "notHere"' ) :
+			root.readObjects( [ [ "group", "mesh1" ], [ "group", "notHere" ] ], 0 )
+
+	def testTransformsAtAlternatingTimes( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "alternatingTimes.usda" )
+		stage = pxr.Usd.Stage.CreateNew( fileName )
+
+		g1 = pxr.UsdGeom.Xform.Define( stage, "/g1" )
+		translateOp = g1.AddTranslateOp()
+		translateOp.Set( pxr.Gf.Vec3d( 1, 0, 0 ), 0 )
+		translateOp.Set( pxr.Gf.Vec3d( 2, 0, 0 ), 24 )
+
+		g2 = pxr.UsdGeom.Xform.Define( stage, "/g1/g2" )
+		g2.AddTranslateOp().Set( pxr.Gf.Vec3d( 0, 1, 0 ) )
+		g2.SetResetXformStack( True )
+
+		stage.GetRootLayer().Save()
+		del stage
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+		g1 = root.child( "g1" )
+		g2 = g1.child( "g2" )
+
+		# Each query must see the right time, even though the transforms
+		# are cached internally.
+		for i in range( 0, 3 ) :
+			for t in ( 0, 1 ) :
+				self.assertEqual( g1.readTransformAsMatrix( t ), imath.M44d().translate( imath.V3d( t + 1, 0, 0 ) ) )
+				self.assertEqual(
+					g2.readTransformAsMatrix( t ) * g1.readTransformAsMatrix( t ),
+					imath.M44d().translate( imath.V3d( 0, 1, 0 ) )
+				)
+
 if __name__ == "__main__":
 	unittest.main()
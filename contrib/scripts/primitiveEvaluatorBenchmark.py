@@ -0,0 +1,132 @@
+import sys
+import json
+import inspect
+import argparse
+
+import imath
+
+import IECore
+import IECoreScene
+
+parser = argparse.ArgumentParser(
+	description = inspect.cleandoc(
+	"""
+	Benchmarks construction of a `MeshPrimitiveEvaluator`
+	for a synthetic sphere mesh, followed by closest point
+	and ray intersection queries against it. The fastest
+	time for each is reported.
+
+	To compare two builds of Cortex, run the script
+	once with each build, using `--output` with the
+	first and `--compare` with the second.
+
+	Example usage :
+
+	> python contrib/scripts/primitiveEvaluatorBenchmark.py --divisions 1000 --queries 100000
+	> python contrib/scripts/primitiveEvaluatorBenchmark.py --output before.json
+	> python contrib/scripts/primitiveEvaluatorBenchmark.py --compare before.json
+	""" ),
+	formatter_class = argparse.RawTextHelpFormatter
+)
+
+parser.add_argument(
+	"--divisions",
+	help = "The number of divisions in each direction of the sphere mesh.",
+	type = int,
+	default = 500,
+)
+
+parser.add_argument(
+	"--queries",
+	help = "The number of queries of each type to perform.",
+	type = int,
+	default = 10000,
+)
+
+parser.add_argument(
+	"--repeats",
+	help = "The number of times to run each benchmark. The fastest time is reported.",
+	type = int,
+	default = 3,
+)
+
+parser.add_argument(
+	"--output",
+	help = "A JSON file in which to store the results, for use with `--compare`.",
+)
+
+parser.add_argument(
+	"--compare",
+	help = "A JSON file written by a previous run with `--output`.",
+)
+
+args = parser.parse_args()
+
+mesh = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( args.divisions ) )
+mesh = IECoreScene.MeshAlgo.triangulate( mesh )
+
+rand = imath.Rand48( 0 )
+points = [ rand.nextSolidSphere( imath.V3f() ) * 2 for i in range( 0, args.queries ) ]
+directions = [ rand.nextHollowSphere( imath.V3f() ) for i in range( 0, args.queries ) ]
+
+def construct() :
+
+	return IECoreScene.MeshPrimitiveEvaluator( mesh )
+
+evaluator = construct()
+result = evaluator.createResult()
+
+def closestPoint() :
+
+	for p in points :
+		evaluator.closestPoint( p, result )
+
+def intersectionPoint() :
+
+	for p, d in zip( points, directions ) :
+		evaluator.intersectionPoint( p, d, result )
+
+def intersectionPoints() :
+
+	for p, d in zip( points, directions ) :
+		evaluator.intersectionPoints( p, d )
+
+def benchmark( f ) :
+
+	best = None
+	for i in range( 0, args.repeats ) :
+
+		timer = IECore.Timer( True, IECore.Timer.WallClock )
+		f()
+		time = timer.stop()
+
+		if best is None or time < best :
+			best = time
+
+	return best
+
+print( "{0} triangles, {1} queries\n".format( mesh.numFaces(), args.queries ) )
+
+results = {}
+for f in ( construct, closestPoint, intersectionPoint, intersectionPoints ) :
+	time = benchmark( f )
+	print( "{0:<20} {1:>12.6f}s".format( f.__name__, time ) )
+	results[f.__name__] = { "time" : time }
+print( "" )
+
+if args.compare :
+	with open( args.compare ) as f :
+		previous = json.load( f )
+	print( "{0:<20} {1:>12} {2:>12} {3:>8}".format( "", "A (s)", "B (s)", "B / A" ) )
+	for name, result in results.items() :
+		if name in previous :
+			a = previous[name]["time"]
+			b = result["time"]
+			ratio = "{0:.3f}".format( b / a ) if a > 0 else "-"
+			print( "{0:<20} {1:>12.6f} {2:>12.6f} {3:>8}".format( name, a, b, ratio ) )
+		else :
+			sys.stderr.write( "No previous result for \"{0}\"\n".format( name ) )
+
+if args.output :
+	with open( args.output, "w" ) as f :
+		json.dump( results, f, indent = 4 )
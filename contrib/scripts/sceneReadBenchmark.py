@@ -0,0 +1,166 @@
+import os
+import sys
+import json
+import inspect
+import argparse
+
+import IECore
+import IECoreScene
+
+parser = argparse.ArgumentParser(
+	description = inspect.cleandoc(
+	"""
+	Benchmarks reading of scene files using
+	`IECoreScene.SceneAlgo.parallelReadAll()`, and
+	reports the slowest locations and components.
+
+	Two files may be given to compare them against
+	each other. To compare two builds of Cortex, run
+	the script once with each build, using `--output`
+	with the first and `--compare` with the second.
+
+	Example usage :
+
+	> python contrib/scripts/sceneReadBenchmark.py a.scc b.scc
+	> python contrib/scripts/sceneReadBenchmark.py a.scc --output before.json
+	> python contrib/scripts/sceneReadBenchmark.py a.scc --compare before.json
+	""" ),
+	formatter_class = argparse.RawTextHelpFormatter
+)
+
+parser.add_argument(
+	"files",
+	help = "The scene files to read.",
+	nargs = "+",
+)
+
+parser.add_argument(
+	"--frames",
+	help = "The range of frames to read.",
+	nargs = 2,
+	type = int,
+	default = [ 1, 1 ],
+)
+
+parser.add_argument(
+	"--frameRate",
+	help = "The frame rate used to convert frames to times.",
+	type = float,
+	default = 24.0,
+)
+
+parser.add_argument(
+	"--repeats",
+	help = "The number of times to read each file. The fastest time is reported.",
+	type = int,
+	default = 3,
+)
+
+parser.add_argument(
+	"--top",
+	help = "The number of slowest locations to report.",
+	type = int,
+	default = 10,
+)
+
+parser.add_argument(
+	"--trace",
+	help = "A directory in which to write a Chrome trace for each file.",
+)
+
+parser.add_argument(
+	"--output",
+	help = "A JSON file in which to store the results, for use with `--compare`.",
+)
+
+parser.add_argument(
+	"--compare",
+	help = "A JSON file written by a previous run with `--output`.",
+)
+
+args = parser.parse_args()
+
+def benchmark( fileName ) :
+
+	IECoreScene.SharedSceneInterfaces.clear()
+
+	best = None
+	for i in range( 0, args.repeats ) :
+
+		scene = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+		profile = IECoreScene.SceneAlgo.ReadProfile()
+
+		timer = IECore.Timer( True, IECore.Timer.WallClock )
+		stats = IECoreScene.SceneAlgo.parallelReadAll(
+			scene, args.frames[0], args.frames[1], args.frameRate,
+			IECoreScene.SceneAlgo.ProcessFlags.All, profile
+		)
+		time = timer.stop()
+
+		if best is None or time < best[0] :
+			best = ( time, stats, profile )
+
+	return best
+
+results = {}
+for fileName in args.files :
+
+	time, stats, profile = benchmark( fileName )
+
+	print( "== {0} ==\n".format( fileName ) )
+	print( "Total time : {0:.6f}s\n".format( time ) )
+	print( profile.report( args.top ) )
+
+	if args.trace :
+		traceFileName = os.path.join( args.trace, os.path.basename( fileName ) + ".json" )
+		profile.writeChromeTrace( traceFileName )
+		print( "Wrote trace to \"{0}\"\n".format( traceFileName ) )
+
+	componentTimes = {}
+	for event in profile.events() :
+		component = str( event.component )
+		componentTimes[component] = componentTimes.get( component, 0.0 ) + event.duration
+
+	results[fileName] = {
+		"time" : time,
+		"stats" : dict( stats ),
+		"componentTimes" : componentTimes,
+	}
+
+def printComparison( nameA, resultA, nameB, resultB ) :
+
+	print( "== {0} vs {1} ==\n".format( nameA, nameB ) )
+	print( "{0:<24} {1:>12} {2:>12} {3:>8}".format( "", "A (s)", "B (s)", "B / A" ) )
+
+	def printRow( name, a, b ) :
+		ratio = "{0:.3f}".format( b / a ) if a > 0 else "-"
+		print( "{0:<24} {1:>12.6f} {2:>12.6f} {3:>8}".format( name, a, b, ratio ) )
+
+	printRow( "Total", resultA["time"], resultB["time"] )
+	for component in sorted( set( resultA["componentTimes"] ) | set( resultB["componentTimes"] ) ) :
+		printRow(
+			component,
+			resultA["componentTimes"].get( component, 0.0 ),
+			resultB["componentTimes"].get( component, 0.0 )
+		)
+
+	if resultA["stats"] != resultB["stats"] :
+		print( "\nWARNING : Stats differ : {0} vs {1}".format( resultA["stats"], resultB["stats"] ) )
+
+	print( "" )
+
+if len( args.files ) == 2 :
+	printComparison( args.files[0], results[args.files[0]], args.files[1], results[args.files[1]] )
+
+if args.compare :
+	with open( args.compare ) as f :
+		previous = json.load( f )
+	for fileName, result in results.items() :
+		if fileName in previous :
+			printComparison( fileName + " (previous)", previous[fileName], fileName, result )
+		else :
+			sys.stderr.write( "No previous result for \"{0}\"\n".format( fileName ) )
+
+if args.output :
+	with open( args.output, "w" ) as f :
+		json.dump( results, f, indent = 4 )
@@ -42,6 +42,8 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "Imath/ImathBox.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
+#include "tbb/task_group.h"
+
 #include <vector>
 
 namespace IECore
@@ -74,6 +76,7 @@ class BoundedKDTree
 		/// Builds the tree for the specified bounds - the iterator range
 		/// must remain valid and unchanged as long as the tree is in use.
 		/// This method can be called again to rebuild the tree at any time.
+		/// Large trees are built in parallel.
 		/// \threading This can't be called while other threads are
 		/// making queries.
 		void init( BoundIterator first, BoundIterator last, int maxLeafSize=4 );
@@ -84,6 +87,15 @@ class BoundedKDTree
 		template<typename S>
 		unsigned int intersectingBounds( const S &b, std::vector<BoundIterator> &bounds ) const;
 
+		/// Performs an intersectingBounds() query for each of the specified bounds
+		/// or points, running in parallel. The results are stored in compressed sparse
+		/// row form : those for `b[i]` are in the range `[offsets[i], offsets[i+1])`
+		/// of `bounds`, and `offsets` has one more element than `b`.
+		/// \threading May be called by multiple concurrent threads provided they each
+		/// use different vectors for the results.
+		template<typename S>
+		void intersectingBounds( const std::vector<S> &b, std::vector<size_t> &offsets, std::vector<BoundIterator> &bounds ) const;
+
 		/// Returns the number of nodes in the tree.
 		inline NodeIndex numNodes() const;
 
@@ -108,8 +120,7 @@ class BoundedKDTree
 		class AxisSort;
 
 		unsigned char majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast );
-		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast );
-		void bound( NodeIndex nodeIndex );
+		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast, tbb::task_group_context &taskGroupContext );
 
 		template<typename S>
 		void intersectingBoundsWalk( NodeIndex nodeIndex, const S &p, std::vector<BoundIterator> &bounds ) const;
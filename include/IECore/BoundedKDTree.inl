@@ -33,6 +33,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/BoxOps.h"
+#include "IECore/KDTreeDetail.h"
 #include "IECore/VectorOps.h"
 #include "IECore/VectorTraits.h"
 
@@ -148,7 +149,7 @@ unsigned char BoundedKDTree<BoundIterator>::majorAxis( PermutationConstIterator
 			{
 				VectorTraits<BaseType>::set(min, i, VectorTraits<BaseType>::get(center, i) );
 			}
-			if( VectorTraits<BaseType>::get(center, i) > VectorTraits<BaseType>::get(min, i) )
+			if( VectorTraits<BaseType>::get(center, i) > VectorTraits<BaseType>::get(max, i) )
 			{
 				VectorTraits<BaseType>::set(max, i, VectorTraits<BaseType>::get(center, i) );
 			}
@@ -169,7 +170,7 @@ unsigned char BoundedKDTree<BoundIterator>::majorAxis( PermutationConstIterator
 }
 
 template<class BoundIterator>
-void BoundedKDTree<BoundIterator>::bound( NodeIndex nodeIndex  )
+void BoundedKDTree<BoundIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast, tbb::task_group_context &taskGroupContext )
 {
 	assert( nodeIndex < m_nodes.size() );
 
@@ -177,42 +178,6 @@ void BoundedKDTree<BoundIterator>::bound( NodeIndex nodeIndex  )
 
 	assert( BoxTraits<Bound>::isEmpty( node.bound() ) );
 
-	if( node.isLeaf() )
-	{
-		BoundIterator *permLast = node.permLast();
-		for( BoundIterator *perm = node.permFirst(); perm!=permLast; perm++ )
-		{
-			boxExtend( node.bound(), **perm );
-		}
-	}
-	else
-	{
-		assert( node.isBranch() );
-
-		assert( lowChildIndex( nodeIndex ) < m_nodes.size() );
-		assert( highChildIndex( nodeIndex ) < m_nodes.size() );
-
-		bound( lowChildIndex( nodeIndex ) );
-		bound( highChildIndex( nodeIndex ) );
-		boxExtend( node.bound(), m_nodes[lowChildIndex( nodeIndex )].bound() );
-		boxExtend( node.bound(), m_nodes[highChildIndex( nodeIndex )].bound() );
-	}
-}
-
-
-template<class BoundIterator>
-void BoundedKDTree<BoundIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast )
-{
-	// make room for the new node
-	if( nodeIndex>=m_nodes.size() )
-	{
-		m_nodes.resize( nodeIndex+1 );
-	}
-
-	assert( nodeIndex < m_nodes.size() );
-
-	Node &node = m_nodes[nodeIndex];
-
 	if( permLast - permFirst > m_maxLeafSize )
 	{
 		unsigned int cutAxis = majorAxis( permFirst, permLast );
@@ -222,13 +187,26 @@ void BoundedKDTree<BoundIterator>::build( NodeIndex nodeIndex, PermutationIterat
 		// insert node
 		node.makeBranch( cutAxis );
 
-		build( lowChildIndex( nodeIndex ), permFirst, permMid );
-		build( highChildIndex( nodeIndex ), permMid, permLast );
+		Detail::kdTreeBuildChildren(
+			permLast - permFirst,
+			[&] { build( lowChildIndex( nodeIndex ), permFirst, permMid, taskGroupContext ); },
+			[&] { build( highChildIndex( nodeIndex ), permMid, permLast, taskGroupContext ); },
+			taskGroupContext
+		);
+
+		// The children are complete, so we can compute our
+		// bound without a separate pass over the tree.
+		boxExtend( node.bound(), m_nodes[lowChildIndex( nodeIndex )].bound() );
+		boxExtend( node.bound(), m_nodes[highChildIndex( nodeIndex )].bound() );
 	}
 	else
 	{
 		// leaf node
 		node.makeLeaf( permFirst, permLast );
+		for( PermutationIterator it = permFirst; it != permLast; ++it )
+		{
+			boxExtend( node.bound(), **it );
+		}
 	}
 }
 
@@ -256,9 +234,14 @@ void BoundedKDTree<BoundIterator>::init( BoundIterator first, BoundIterator last
 		m_perm[i++] = it;
 	}
 
-	/// \todo Can we reserve() enough space for m_nodes before doing this?
-	build( rootIndex(), m_perm.begin(), m_perm.end() );
-	bound( rootIndex() );
+	m_nodes.clear();
+	m_nodes.resize( Detail::kdTreeNumNodes( m_perm.size(), m_maxLeafSize ) );
+
+	Detail::kdTreeBuild(
+		[this]( tbb::task_group_context &taskGroupContext ) {
+			build( rootIndex(), m_perm.begin(), m_perm.end(), taskGroupContext );
+		}
+	);
 }
 
 template<class BoundIterator>
@@ -305,6 +288,18 @@ unsigned int BoundedKDTree<BoundIterator>::intersectingBounds( const S &b, std::
 	return bounds.size();
 }
 
+template<class BoundIterator>
+template<typename S>
+void BoundedKDTree<BoundIterator>::intersectingBounds( const std::vector<S> &b, std::vector<size_t> &offsets, std::vector<BoundIterator> &bounds ) const
+{
+	Detail::kdTreeBatchQuery(
+		b.size(), offsets, bounds,
+		[&]( size_t i, std::vector<BoundIterator> &result ) {
+			intersectingBoundsWalk( rootIndex(), b[i], result );
+		}
+	);
+}
+
 template<class BoundIterator>
 template<typename S>
 void BoundedKDTree<BoundIterator>::intersectingBoundsWalk(  NodeIndex nodeIndex, const S &b, std::vector<BoundIterator> &bounds ) const
@@ -42,6 +42,8 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "Imath/ImathVec.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
+#include "tbb/task_group.h"
+
 #include <set>
 #include <vector>
 
@@ -72,14 +74,18 @@ class KDTree
 		/// Note that the tree does not own the passed points -
 		/// it is up to you to ensure that they remain valid and
 		/// unchanged as long as the KDTree is in use.
-		KDTree( PointIterator first, PointIterator last, int maxLeafSize=4 );
+		KDTree( PointIterator first, PointIterator last, int maxLeafSize=4, bool contiguousPoints=false );
 
 		/// Builds the tree for the specified points - the iterator range
 		/// must remain valid and unchanged as long as the tree is in use.
 		/// This method can be called again to rebuild the tree at any time.
+		/// Large trees are built in parallel. If `contiguousPoints` is true,
+		/// the tree also stores a copy of the points ordered by leaf, so that
+		/// queries read contiguous memory. This makes queries faster, but uses
+		/// as much memory again as the points themselves.
 		/// \threading This can't be called while other threads are
 		/// making queries.
-		void init( PointIterator first, PointIterator last, int maxLeafSize=4  );
+		void init( PointIterator first, PointIterator last, int maxLeafSize=4, bool contiguousPoints=false );
 
 		/// Returns an iterator to the nearest neighbour to the point p.
 		/// \threading May be called by multiple concurrent threads.
@@ -109,6 +115,27 @@ class KDTree
 		template<typename Box, typename OutputIterator>
 		void enclosedPoints( const Box &bound, OutputIterator it ) const;
 
+		//! @name Batch queries
+		/// These perform one query for each of the specified points, running
+		/// in parallel. Queries which may return a variable number of results
+		/// store them in compressed sparse row form : the results for `points[i]`
+		/// are stored in the range `[offsets[i], offsets[i+1])` of the output
+		/// vector, and `offsets` has one more element than `points`. The output
+		/// vectors contain only the results found, without padding.
+		/// \threading May be called by multiple concurrent threads provided they
+		/// are each using different vectors for the results.
+		//////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Fills `nearest` with the nearest neighbour to each point.
+		void nearestNeighbour( const std::vector<Point> &points, std::vector<PointIterator> &nearest ) const;
+		/// Finds the neighbours of each point which are closer than radius r.
+		void nearestNeighbours( const std::vector<Point> &points, BaseType r, std::vector<size_t> &offsets, std::vector<PointIterator> &nearNeighbours ) const;
+		/// Finds the N closest neighbours to each point, sorted with the closest first.
+		/// Every query finds `min( numNeighbours, numPoints )` neighbours, where
+		/// `numPoints` is the size of the tree, so the offsets have a fixed stride.
+		void nearestNNeighbours( const std::vector<Point> &points, unsigned int numNeighbours, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const;
+		//@}
+
 		/// Returns the number of nodes in the tree.
 		inline NodeIndex numNodes() const;
 		/// Returns the specified Node of the tree. See rootIndex(), lowChildIndex() and highChildIndex() for
@@ -133,7 +160,7 @@ class KDTree
 		class AxisSort;
 
 		unsigned char majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast );
-		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast );
+		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast, tbb::task_group_context &taskGroupContext );
 
 		void nearestNeighbourWalk( NodeIndex nodeIndex, const Point &p, PointIterator &closestPoint, BaseType &distSquared ) const;
 
@@ -144,7 +171,14 @@ class KDTree
 
 		void nearestNNeighboursWalk( NodeIndex nodeIndex, const Point &p, unsigned int numNeighbours, std::vector<Neighbour> &nearNeighbours, BaseType &maxDistSquared ) const;
 
+		// Returns the point referenced by `m_perm[i]`.
+		inline const Point &point( size_t i ) const;
+
 		Permutation m_perm;
+		// Optional copy of the points, in the same order as `m_perm`, so
+		// that the points in each leaf are contiguous in memory. Empty
+		// unless requested by `init()`.
+		std::vector<Point> m_points;
 		NodeVector m_nodes;
 		int m_maxLeafSize;
 		PointIterator m_lastPoint;
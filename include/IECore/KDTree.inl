@@ -33,6 +33,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/BoxOps.h"
+#include "IECore/KDTreeDetail.h"
 #include "IECore/VectorOps.h"
 
 #include <algorithm>
@@ -116,25 +117,56 @@ KDTree<PointIterator>::KDTree()
 }
 
 template<class PointIterator>
-KDTree<PointIterator>::KDTree( PointIterator first, PointIterator last, int maxLeafSize )
+KDTree<PointIterator>::KDTree( PointIterator first, PointIterator last, int maxLeafSize, bool contiguousPoints )
 {
-	init( first, last, maxLeafSize );
+	init( first, last, maxLeafSize, contiguousPoints );
 }
 
 template<class PointIterator>
-void KDTree<PointIterator>::init( PointIterator first, PointIterator last, int maxLeafSize  )
+void KDTree<PointIterator>::init( PointIterator first, PointIterator last, int maxLeafSize, bool contiguousPoints )
 {
 	m_maxLeafSize = maxLeafSize;
 	m_lastPoint = last;
-	m_perm.resize( last - first );
+
+	const size_t numPoints = last - first;
+	m_perm.resize( numPoints );
 	unsigned int i=0;
 	for( PointIterator it=first; it!=last; it++ )
 	{
 		m_perm[i++] = it;
 	}
 
-	/// \todo Can we reserve() enough space for m_nodes before doing this?
-	build( rootIndex(), m_perm.begin(), m_perm.end() );
+	m_nodes.clear();
+	m_nodes.resize( Detail::kdTreeNumNodes( numPoints, m_maxLeafSize ) );
+	m_points.clear();
+	m_points.shrink_to_fit();
+	if( contiguousPoints )
+	{
+		m_points.resize( numPoints );
+	}
+
+	Detail::kdTreeBuild(
+		[this, numPoints]( tbb::task_group_context &taskGroupContext ) {
+			build( rootIndex(), m_perm.begin(), m_perm.end(), taskGroupContext );
+
+			if( m_points.empty() )
+			{
+				return;
+			}
+
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, numPoints ),
+				[this]( const tbb::blocked_range<size_t> &range )
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						m_points[i] = *m_perm[i];
+					}
+				},
+				taskGroupContext
+			);
+		}
+	);
 }
 
 template<class PointIterator>
@@ -172,14 +204,8 @@ unsigned char KDTree<PointIterator>::majorAxis( PermutationConstIterator permFir
 }
 
 template<class PointIterator>
-void KDTree<PointIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast )
+void KDTree<PointIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast, tbb::task_group_context &taskGroupContext )
 {
-	// make room for the new node
-	if( nodeIndex>=m_nodes.size() )
-	{
-		m_nodes.resize( nodeIndex+1 );
-	}
-
 	if( permLast - permFirst > m_maxLeafSize )
 	{
 		unsigned int cutAxis = majorAxis( permFirst, permLast );
@@ -189,8 +215,12 @@ void KDTree<PointIterator>::build( NodeIndex nodeIndex, PermutationIterator perm
 		// insert node
 		m_nodes[nodeIndex].makeBranch( cutAxis, cutValue );
 
-		build( lowChildIndex( nodeIndex ), permFirst, permMid );
-		build( highChildIndex( nodeIndex ), permMid, permLast );
+		Detail::kdTreeBuildChildren(
+			permLast - permFirst,
+			[&] { build( lowChildIndex( nodeIndex ), permFirst, permMid, taskGroupContext ); },
+			[&] { build( highChildIndex( nodeIndex ), permMid, permLast, taskGroupContext ); },
+			taskGroupContext
+		);
 	}
 	else
 	{
@@ -250,22 +280,86 @@ unsigned int KDTree<PointIterator>::nearestNNeighbours( const Point &p, unsigned
 	return nearNeighbours.size();
 }
 
+template<class PointIterator>
+void KDTree<PointIterator>::nearestNeighbour( const std::vector<Point> &points, std::vector<PointIterator> &nearest ) const
+{
+	nearest.resize( points.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				nearest[i] = nearestNeighbour( points[i] );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+template<class PointIterator>
+void KDTree<PointIterator>::nearestNeighbours( const std::vector<Point> &points, BaseType r, std::vector<size_t> &offsets, std::vector<PointIterator> &nearNeighbours ) const
+{
+	Detail::kdTreeBatchQuery(
+		points.size(), offsets, nearNeighbours,
+		[&]( size_t i, std::vector<PointIterator> &result ) {
+			nearestNeighboursWalk( rootIndex(), points[i], r*r, result );
+		}
+	);
+}
+
+template<class PointIterator>
+void KDTree<PointIterator>::nearestNNeighbours( const std::vector<Point> &points, unsigned int numNeighbours, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const
+{
+	// `nearestNNeighboursWalk()` accepts every point until it has found
+	// `numNeighbours`, so every query finds exactly `numFound` neighbours.
+	// This means we know the offsets in advance, and can write the results
+	// directly into place. The initial value given to `resize()` is just
+	// because Neighbour has no default constructor - it is always overwritten.
+	const size_t numFound = std::min<size_t>( numNeighbours, m_perm.size() );
+	offsets.resize( points.size() + 1 );
+	nearNeighbours.resize( points.size() * numFound, Neighbour( m_lastPoint, 0 ) );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			// Reused for every query, to avoid allocations.
+			std::vector<Neighbour> neighbours;
+			neighbours.reserve( numFound );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				nearestNNeighbours( points[i], numNeighbours, neighbours );
+				assert( neighbours.size() == numFound );
+				std::copy( neighbours.begin(), neighbours.end(), nearNeighbours.begin() + i * numFound );
+				offsets[i] = i * numFound;
+			}
+		},
+		taskGroupContext
+	);
+
+	offsets.back() = points.size() * numFound;
+}
+
 template<class PointIterator>
 void KDTree<PointIterator>::nearestNeighbourWalk( NodeIndex nodeIndex, const Point &p, PointIterator &closestPoint, BaseType &distSquared ) const
 {
 	const Node &node = m_nodes[nodeIndex];
 	if( node.isLeaf() )
 	{
-		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const size_t first = node.permFirst() - m_perm.data();
+		const size_t last = node.permLast() - m_perm.data();
+		for( size_t i = first; i != last; ++i )
 		{
-			const Point &pp = **perm;
-			BaseType dist2 = vecDistance2( p, pp );
+			BaseType dist2 = vecDistance2( p, point( i ) );
 
 			if( dist2 < distSquared )
 			{
 				distSquared = dist2;
-				closestPoint = *perm;
+				closestPoint = m_perm[i];
 			}
 		}
 	}
@@ -299,15 +393,15 @@ void KDTree<PointIterator>::nearestNeighboursWalk( NodeIndex nodeIndex, const Po
 	const Node &node = m_nodes[nodeIndex];
 	if( node.isLeaf() )
 	{
-		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const size_t first = node.permFirst() - m_perm.data();
+		const size_t last = node.permLast() - m_perm.data();
+		for( size_t i = first; i != last; ++i )
 		{
-			const Point &pp = **perm;
-			BaseType dist2 = vecDistance2( p, pp );
+			BaseType dist2 = vecDistance2( p, point( i ) );
 
 			if (dist2 < r2 )
 			{
-				nearNeighbours.push_back( *perm );
+				nearNeighbours.push_back( m_perm[i] );
 			}
 		}
 	}
@@ -341,15 +435,15 @@ void KDTree<PointIterator>::nearestNNeighboursWalk( NodeIndex nodeIndex, const P
 	const Node &node = m_nodes[nodeIndex];
 	if( node.isLeaf() )
 	{
-		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const size_t first = node.permFirst() - m_perm.data();
+		const size_t last = node.permLast() - m_perm.data();
+		for( size_t i = first; i != last; ++i )
 		{
-			const Point &pp = **perm;
-			BaseType dist2 = vecDistance2( p, pp );
+			BaseType dist2 = vecDistance2( p, point( i ) );
 
 			if( dist2 < maxDistSquared || nearNeighbours.size() < numNeighbours )
 			{
-				Neighbour n( *perm, dist2 );
+				Neighbour n( m_perm[i], dist2 );
 				assert( nearNeighbours.size() <= numNeighbours );
 
 				if( nearNeighbours.size() == numNeighbours )
@@ -405,13 +499,13 @@ void KDTree<PointIterator>::enclosedPointsWalk( NodeIndex nodeIndex, const Box &
 
 	if( node.isLeaf() )
 	{
-		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const size_t first = node.permFirst() - m_perm.data();
+		const size_t last = node.permLast() - m_perm.data();
+		for( size_t i = first; i != last; ++i )
 		{
-			const Point &pp = **perm;
-			if( boxIntersects( bound, pp ) )
+			if( boxIntersects( bound, point( i ) ) )
 			{
-				*it++ = *perm;
+				*it++ = m_perm[i];
 			}
 		}
 	}
@@ -428,6 +522,12 @@ void KDTree<PointIterator>::enclosedPointsWalk( NodeIndex nodeIndex, const Box &
 	}
 }
 
+template<class PointIterator>
+inline const typename KDTree<PointIterator>::Point &KDTree<PointIterator>::point( size_t i ) const
+{
+	return m_points.empty() ? *m_perm[i] : m_points[i];
+}
+
 template<class PointIterator>
 inline typename KDTree<PointIterator>::NodeIndex KDTree<PointIterator>::numNodes() const
 {
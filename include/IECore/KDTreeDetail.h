@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_KDTREEDETAIL_H
+#define IECORE_KDTREEDETAIL_H
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace IECore
+{
+
+/// Implementation details shared by KDTree and BoundedKDTree. These are
+/// not intended for use elsewhere.
+namespace Detail
+{
+
+/// Returns the number of nodes needed to store a tree of `numElements`
+/// elements in an implicit binary heap, where each branch splits its
+/// elements at the median. Such trees are balanced, so their depth is
+/// known in advance, and sizing the nodes up front allows subtrees to
+/// be built concurrently.
+inline size_t kdTreeNumNodes( size_t numElements, int maxLeafSize )
+{
+	size_t depth = 0;
+	for( size_t maxSize = numElements; maxSize > (size_t)std::max( maxLeafSize, 1 ); maxSize -= maxSize / 2 )
+	{
+		++depth;
+	}
+	return size_t( 2 ) << depth;
+}
+
+/// Runs a tree build function. Callers commonly build trees lazily while
+/// holding a lock, so the build is isolated to prevent a waiting thread
+/// from stealing an unrelated task which then attempts to take the same
+/// lock.
+template<typename F>
+void kdTreeBuild( F &&f )
+{
+	tbb::this_task_arena::isolate(
+		[&f] {
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			f( taskGroupContext );
+		}
+	);
+}
+
+/// Builds the two children of a branch containing `numElements` elements.
+/// Partitioning a subtree costs time linear in its size, and small subtrees
+/// take less time to build than it takes to spawn and steal a task, so only
+/// subtrees with more than 10000 elements are built in parallel.
+template<typename LowFunction, typename HighFunction>
+void kdTreeBuildChildren( size_t numElements, LowFunction &&low, HighFunction &&high, tbb::task_group_context &taskGroupContext )
+{
+	if( numElements > 10000 )
+	{
+		tbb::parallel_invoke( low, high, taskGroupContext );
+	}
+	else
+	{
+		low();
+		high();
+	}
+}
+
+/// Runs `query( i, results )` for each `i` in `[0, numQueries)` in parallel,
+/// where `query` appends any number of results to `results`. The results are
+/// returned in compressed sparse row form : those for query `i` are in the
+/// range `[offsets[i], offsets[i+1])` of `results`.
+template<typename T, typename Query>
+void kdTreeBatchQuery( size_t numQueries, std::vector<size_t> &offsets, std::vector<T> &results, Query &&query )
+{
+	// The number of results per query isn't known in advance, so we
+	// gather them separately for fixed blocks of queries, counting
+	// them in `offsets` as we go. Then we convert the counts into
+	// offsets and concatenate the blocks.
+
+	const size_t blockSize = 1024;
+	const size_t numBlocks = ( numQueries + blockSize - 1 ) / blockSize;
+	std::vector<std::vector<T>> blockResults( numBlocks );
+	offsets.resize( numQueries + 1 );
+	offsets[0] = 0;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t block = range.begin(); block != range.end(); ++block )
+			{
+				std::vector<T> &blockResult = blockResults[block];
+				const size_t end = std::min( ( block + 1 ) * blockSize, numQueries );
+				for( size_t i = block * blockSize; i < end; ++i )
+				{
+					const size_t size = blockResult.size();
+					query( i, blockResult );
+					offsets[i+1] = blockResult.size() - size;
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+
+	results.resize( offsets.back() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t block = range.begin(); block != range.end(); ++block )
+			{
+				std::copy(
+					blockResults[block].begin(), blockResults[block].end(),
+					results.begin() + offsets[block * blockSize]
+				);
+			}
+		},
+		taskGroupContext
+	);
+}
+
+} // namespace Detail
+
+} // namespace IECore
+
+#endif // IECORE_KDTREEDETAIL_H
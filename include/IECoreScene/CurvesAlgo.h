@@ -64,6 +64,11 @@ IECORESCENE_API CurvesPrimitivePtr deleteCurves( const CurvesPrimitive *curvesPr
 /// completely segmententing the curves based on the unique values in a primitive variable.
 IECORESCENE_API std::vector<CurvesPrimitivePtr> segment( const CurvesPrimitive *curves, const PrimitiveVariable &primitiveVariable, const IECore::Data *segmentValues = nullptr, const IECore::Canceller *canceller = nullptr  );
 
+/// Reorders the curves along a space filling curve through their centroids, so that
+/// curves which are close in space are also close in memory. The order of the vertices
+/// within each curve is unchanged. All primitive variables are updated to match.
+IECORESCENE_API void reorderForLocality( CurvesPrimitive *curves, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
+
 /// Returns true if wrap is pinned and basis is BSpline or CatmullRom.
 IECORESCENE_API bool isPinned( const CurvesPrimitive *curves );
 
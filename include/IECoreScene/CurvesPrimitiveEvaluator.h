@@ -182,6 +182,9 @@ class IECORESCENE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		friend struct PrimitiveEvaluator::Description<CurvesPrimitiveEvaluator>;
 		static PrimitiveEvaluator::Description<CurvesPrimitiveEvaluator> g_evaluatorDescription;
 
+		/// Adds "curveIndex" and "v" outputs.
+		BatchOutputFunction addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const override;
+
 	private :
 
 		friend class Result;
@@ -194,10 +197,9 @@ class IECORESCENE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		std::vector<int> m_varyingDataOffsets; // one value per curve
 		PrimitiveVariable m_p;
 
+		// Builds the tree. Called at most once, via `m_treeOnceFlag`.
 		void buildTree();
-		bool m_haveTree;
-		typedef std::mutex TreeMutex;
-		TreeMutex m_treeMutex;
+		mutable std::once_flag m_treeOnceFlag;
 		IECore::Box3fTree m_tree;
 		std::vector<Imath::Box3f> m_treeBounds;
 		struct Line;
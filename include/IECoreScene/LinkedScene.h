@@ -98,6 +98,16 @@ class IECORESCENE_API LinkedScene : public  SampledSceneInterface
 		/// \param time Specifies the time that should be used to query the given scene
 		static IECore::CompoundDataPtr linkAttributeData( const SceneInterface *scene, double time );
 
+		/// Resolves all the links below this location in parallel, opening the linked
+		/// files via SharedSceneInterfaces. Links are resolved lazily on first access
+		/// anyway, so this is purely an optimisation for clients that are about to
+		/// traverse a large part of the scene. Resolved links are stored in a cache
+		/// shared by all locations created from the same root, and links within linked
+		/// LinkedScenes are resolved recursively. The linked scenes themselves are not
+		/// held by the cache, and remain subject to the SharedSceneInterfaces limit.
+		/// Only valid in read mode.
+		void resolveLinks( const IECore::Canceller *canceller = nullptr ) const;
+
 		/*
 		 * virtual functions defined in SceneInterface.
 		 */
@@ -162,9 +172,20 @@ class IECORESCENE_API LinkedScene : public  SampledSceneInterface
 
 	private :
 
-		LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, IECore::PathMatcherDataPtr linkLocationsData, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped );
+		IE_CORE_FORWARDDECLARE( Link );
+		IE_CORE_FORWARDDECLARE( LinkCache );
+
+		LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, LinkCachePtr linkCache, ConstLinkPtr link, IECore::PathMatcherDataPtr linkLocationsData, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped );
 
-		ConstSceneInterfacePtr expandLink( const IECore::StringData *fileName, const IECore::InternedStringVectorData *root, int &linkDepth );
+		ConstSceneInterfacePtr expandLink( const IECore::StringData *fileName, const IECore::InternedStringVectorData *root, int &linkDepth ) const;
+
+		// Returns the link stored at the given location of the main scene, reusing the
+		// result from m_linkCache when available. The returned Link has a null fileName
+		// and root if the location is not a link. Pass them to expandLink() to retrieve
+		// the linked scene.
+		ConstLinkPtr resolveLink( const SceneInterface *mainScene ) const;
+		ConstLinkPtr computeLink( const SceneInterface *mainScene ) const;
+		void resolveLinksWalk( const SceneInterface *mainScene, const IECore::Canceller *canceller ) const;
 
 		void mainSceneHash( HashType hashType, double time, IECore::MurmurHash &h ) const;
 
@@ -182,7 +203,11 @@ class IECORESCENE_API LinkedScene : public  SampledSceneInterface
 		bool m_atLink;
 		bool m_sampled;
 		bool m_timeRemapped;
-		// \todo: std::map< Path, LinkedScenes > for quick scene calls... built by scene... dies with the instance (usually only root uses it).
+
+		/// Links resolved so far, shared by all locations created from the same root.
+		LinkCachePtr m_linkCache;
+		/// The link we are in, if any. Holds the precomputed time remapping.
+		ConstLinkPtr m_link;
 
 		/// locations of all links in the scene.
 		IECore::PathMatcherDataPtr m_linkLocationsData;
@@ -54,6 +54,74 @@ namespace MeshAlgo
 /// If provided, this will be periodically checked, and cancel the calculation with an exception
 /// if the canceller has been triggered ( indicating the result is no longer needed )
 
+/// Adjacency information for a mesh, derived from `verticesPerFace` and `vertexIds`. Functions
+/// which need adjacency may optionally be passed a MeshTopology, to avoid computing it again
+/// each time the same topology is processed.
+///
+/// NOTE : Uses tbb internally - in order to integrate with a program using tbb, should be placed inside a
+/// this_task_arena::isolate or other mechanism to protect from stealing outer tasks.
+class IECORESCENE_API MeshTopology : public IECore::RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( MeshTopology );
+
+		MeshTopology( const MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+
+		inline int numFaces() const;
+		inline int numVertices() const;
+		inline int numFaceVertices() const;
+		inline int numEdges() const;
+
+		/// The index of the first face-vertex of each face, followed by
+		/// a final entry holding the total number of face-vertices.
+		inline const std::vector<int> &faceOffsets() const;
+		/// The face containing each face-vertex.
+		inline const std::vector<int> &faceVertexFaces() const;
+
+		/// The face-vertices referencing each vertex, stored in compressed
+		/// form. The face-vertices for vertex `v` are in the range
+		/// `[ vertexFaceVertexOffsets()[v], vertexFaceVertexOffsets()[v+1] )`
+		/// of `vertexFaceVertices()`, in ascending order.
+		inline const std::vector<int> &vertexFaceVertexOffsets() const;
+		inline const std::vector<int> &vertexFaceVertices() const;
+
+		/// The unique edges of the mesh, as pairs of vertex ids with the
+		/// lowest id first. Edges are ordered by their first occurrence
+		/// in `vertexIds`.
+		inline const std::vector<Imath::V2i> &edges() const;
+		/// The index of the edge from each face-vertex to the next one in
+		/// the same face.
+		inline const std::vector<int> &faceVertexEdges() const;
+		/// The face-vertex at the start of the opposite half-edge for each
+		/// face-vertex, or -1 for boundary edges. Edges shared by more than
+		/// two faces, or by faces with inconsistent winding, are treated as
+		/// boundaries.
+		inline const std::vector<int> &oppositeFaceVertices() const;
+
+		size_t memoryUsage() const;
+
+	private :
+
+		std::vector<int> m_faceOffsets;
+		std::vector<int> m_faceVertexFaces;
+		std::vector<int> m_vertexFaceVertexOffsets;
+		std::vector<int> m_vertexFaceVertices;
+		std::vector<Imath::V2i> m_edges;
+		std::vector<int> m_faceVertexEdges;
+		std::vector<int> m_oppositeFaceVertices;
+
+};
+
+IE_CORE_DECLAREPTR( MeshTopology );
+
+/// Returns the MeshTopology for a mesh from a process-wide cache keyed by `MeshPrimitive::topologyHash()`,
+/// so that it is shared by all meshes with identical topology, such as every frame of a deforming mesh.
+/// The size of the cache may be set in megabytes using the `IECORESCENE_MESH_TOPOLOGY_CACHE_MEMORY`
+/// environment variable, and defaults to 500.
+IECORESCENE_API ConstMeshTopologyPtr topology( const MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+
 // Enum for specifying how to weight normal calculation
 enum class NormalWeighting
 {
@@ -78,7 +146,7 @@ IECORESCENE_API PrimitiveVariable calculateVertexNormals( const MeshPrimitive *m
 /// With face varying normals, we can average adjacent faces to produce a smooth corner, or create a faceted
 /// corner. So we take both a weighting mode, and "thresholdAngle", which give a cutoff in degrees - faces
 /// which meet at less than this angle will be treated as faceted instead of smooth.
-IECORESCENE_API PrimitiveVariable calculateFaceVaryingNormals( const MeshPrimitive *mesh, NormalWeighting weighting, float thresholdAngle, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
+IECORESCENE_API PrimitiveVariable calculateFaceVaryingNormals( const MeshPrimitive *mesh, NormalWeighting weighting, float thresholdAngle, const std::string &position = "P", const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 
 /// Old form where no weighting method is specified - computes vertex normals using fast but inaccurate method
 /// Deprecated.
@@ -91,11 +159,11 @@ IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangent
 /// Calculate the surface tangent vectors of a mesh primitive based on the first neighbor edge.
 /// Note that "first" is defined by the edge that comes first in the vertexIds list:
 /// if a tri is stored as [ 0, 1, 2 ], then this is interpreted as the edges <0,1>, <1,2> and <2,0>, in that order.
-IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromFirstEdge( const MeshPrimitive *mesh, const std::string &position = "P", const std::string &normal = "N", bool orthoTangents = true, bool leftHanded = false, const IECore::Canceller *canceller = nullptr );
+IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromFirstEdge( const MeshPrimitive *mesh, const std::string &position = "P", const std::string &normal = "N", bool orthoTangents = true, bool leftHanded = false, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 /// Calculate the surface tangent vectors of a mesh primitive based on the primitives centroid
 IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromPrimitiveCentroid( const MeshPrimitive *mesh, const std::string &position = "P", const std::string &normal = "N", bool orthoTangents = true, bool leftHanded = false, const IECore::Canceller *canceller = nullptr );
 /// Calculate the surface tangent vectors of a mesh primitive based on the first two adjacent edges
-IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromTwoEdges( const MeshPrimitive *mesh, const std::string &position = "P", const std::string &normal = "N", bool orthoTangents = true, bool leftHanded = false, const IECore::Canceller *canceller = nullptr );
+IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromTwoEdges( const MeshPrimitive *mesh, const std::string &position = "P", const std::string &normal = "N", bool orthoTangents = true, bool leftHanded = false, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 
 /// Calculate the face area of a mesh primitive.
 IECORESCENE_API PrimitiveVariable calculateFaceArea( const MeshPrimitive *mesh, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
@@ -108,7 +176,15 @@ IECORESCENE_API PrimitiveVariable calculateFaceTextureArea( const MeshPrimitive
 /// The second return value is the V2f distortion of the UV set.
 IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateDistortion( const MeshPrimitive *mesh, const std::string &uvSet = "uv", const std::string &referencePosition = "Pref", const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
 
-IECORESCENE_API void resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller = nullptr );
+/// Resamples a primitive variable to a new interpolation. Conversions are performed in parallel,
+/// using the adjacency from `topology` if it is provided.
+///
+/// NOTE : Uses tbb internally - in order to integrate with a program using tbb, should be placed inside a
+/// this_task_arena::isolate or other mechanism to protect from stealing outer tasks.
+IECORESCENE_API void resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
+/// Resamples the named primitive variables of the mesh in place, processing them concurrently
+/// and sharing the adjacency between them. Throws if any of the variables does not exist.
+IECORESCENE_API void resamplePrimitiveVariables( MeshPrimitive *mesh, const std::vector<std::string> &names, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 
 /// create a new MeshPrimitive deleting faces from the input MeshPrimitive based on the facesToDelete uniform (int|float|bool) PrimitiveVariable
 /// When invert is set then zeros in facesToDelete indicate which faces should be deleted
@@ -118,8 +194,26 @@ IECORESCENE_API MeshPrimitivePtr deleteFaces( const MeshPrimitive *meshPrimitive
 /// primitive variables to match.
 IECORESCENE_API void reverseWinding( MeshPrimitive *meshPrimitive, const IECore::Canceller *canceller = nullptr );
 
-/// Reorder the vertices of a mesh based on an initial choice of 3 vertices
-IECORESCENE_API void reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2, const IECore::Canceller *canceller = nullptr );
+/// Reorder the vertices of a mesh based on an initial choice of 3 vertices. The mesh is
+/// traversed using the edges from `topology`, which is computed if not provided.
+IECORESCENE_API void reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
+
+/// Reorders the faces of a mesh to improve the hit rate of a FIFO vertex cache
+/// holding `cacheSize` vertices, and then renumbers the vertices in order of first
+/// use. All primitive variables, corners and creases are updated to match. Faces
+/// may have any number of vertices, but the order is most effective for triangles.
+///
+/// NOTE : Uses tbb internally - in order to integrate with a program using tbb, should be placed inside a
+/// this_task_arena::isolate or other mechanism to protect from stealing outer tasks.
+IECORESCENE_API void optimizeVertexCache( MeshPrimitive *mesh, int cacheSize = 16, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
+
+/// Reorders the vertices and faces of a mesh along a space filling curve, so that
+/// elements which are close in space are also close in memory. All primitive
+/// variables, corners and creases are updated to match.
+///
+/// NOTE : Uses tbb internally - in order to integrate with a program using tbb, should be placed inside a
+/// this_task_arena::isolate or other mechanism to protect from stealing outer tasks.
+IECORESCENE_API void reorderForLocality( MeshPrimitive *mesh, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
 
 /// Distributes points over a mesh using an IECore::PointDistribution in UV space
 /// and mapping it to 3d space. It gives a fairly even distribution regardless of
@@ -134,7 +228,7 @@ IECORESCENE_API PointsPrimitivePtr distributePoints( const MeshPrimitive *mesh,
 /// ( splitting may be performed on multiple threads )
 ///
 /// Use numMeshes() to get the number of results, then call mesh( i ) for i in range( numMeshes() ) to get
-/// all the split meshes. The results are ordered by sorting the unique values of the primvar ( sorting by
+/// all the split meshes, or call meshes() to get them all at once. The results are ordered by sorting the unique values of the primvar ( sorting by
 /// the first element first in the case of vector types ). You can use value( i ) to get the corresponding
 /// value of the segment primitive variable.
 
@@ -143,7 +237,7 @@ class IECORESCENE_API MeshSplitter
 public:
 
 	// Initialize with a mesh, and matching uniform primitive variable - the mesh will be split based on
-	// unique values of this primitive variable
+	// unique values of this primitive variable. Uses tbb internally to sort the faces by segment.
 	MeshSplitter( ConstMeshPrimitivePtr mesh, const PrimitiveVariable &segmentPrimitiveVariable, const IECore::Canceller *canceller = nullptr );
 
 	// Return the number of meshes we are splitting into, based on the primitive variable passed to the constructor
@@ -153,6 +247,13 @@ public:
 	// data, it is safe to call in parallel on multiple threads
 	MeshPrimitivePtr mesh( int segmentId, const IECore::Canceller *canceller = nullptr ) const;
 
+	// Return all of the result meshes, in the same order as mesh( i ). The meshes are computed
+	// in parallel.
+	//
+	// NOTE : Uses tbb internally - in order to integrate with a program using tbb, should be placed inside a
+	// this_task_arena::isolate or other mechanism to protect from stealing outer tasks.
+	std::vector<MeshPrimitivePtr> meshes( const IECore::Canceller *canceller = nullptr ) const;
+
 	// Return the value of the given segment primitive variable corresponding to one of the outputs
 	template< typename T>
 	typename std::vector<T>::const_reference value( int segmentId ) const;
@@ -182,6 +283,11 @@ private:
 	std::vector< int > m_faceRemap;
 	std::vector< int > m_faceIndices;
 
+	// The names of any primitive variables which are not valid on the original mesh. Validating
+	// indexed primitive variables requires a scan of the indices, so we do it once up front rather
+	// than in every call to mesh(). Sorted, so it can be searched with std::binary_search.
+	std::vector< std::string > m_invalidPrimitiveVariables;
+
 };
 
 /// Deprecated. Use MeshSplitter instead.
@@ -210,16 +316,18 @@ IECORESCENE_API MeshPrimitivePtr triangulate( const MeshPrimitive *mesh, const I
 /// The first vector contains a flat list of all the indices of the connected neighbor vertices.
 ///	The second one holds an offset index for every vertex. Note that the offset indices vector skips the
 /// first offset index (since it's 0).
+/// If `topology` is provided, the result is generated from it rather than from the mesh.
 /// Note also that the resulting data vector has a capacity larger than it's size ( due to the storage required
 /// for the implementation of this function ). If you are keeping this result persistently, you may want to call
 /// result.second->writable().shrink_to_fit() in order to reduce long term memory use, however this reallocation
 /// is just a waste of time if you are using the result to compute something else and then discarding it.
-IECORESCENE_API	std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> connectedVertices( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+IECORESCENE_API	std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> connectedVertices( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 
 /// Generate a list of face vertices which point to each vertex
 /// The first vector contains a flat list of all the indices of the connected face vertices.
 ///	The second one holds offset indices for every vertex, as above.
-IECORESCENE_API	std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> correspondingFaceVertices( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+/// If `topology` is provided, the result is copied from it rather than generated from the mesh.
+IECORESCENE_API	std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> correspondingFaceVertices( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr, const MeshTopology *topology = nullptr );
 
 } // namespace MeshAlgo
 
@@ -43,6 +43,61 @@ namespace IECoreScene
 namespace MeshAlgo
 {
 
+int MeshTopology::numFaces() const
+{
+	return m_faceOffsets.size() - 1;
+}
+
+int MeshTopology::numVertices() const
+{
+	return m_vertexFaceVertexOffsets.size() - 1;
+}
+
+int MeshTopology::numFaceVertices() const
+{
+	return m_faceVertexFaces.size();
+}
+
+int MeshTopology::numEdges() const
+{
+	return m_edges.size();
+}
+
+const std::vector<int> &MeshTopology::faceOffsets() const
+{
+	return m_faceOffsets;
+}
+
+const std::vector<int> &MeshTopology::faceVertexFaces() const
+{
+	return m_faceVertexFaces;
+}
+
+const std::vector<int> &MeshTopology::vertexFaceVertexOffsets() const
+{
+	return m_vertexFaceVertexOffsets;
+}
+
+const std::vector<int> &MeshTopology::vertexFaceVertices() const
+{
+	return m_vertexFaceVertices;
+}
+
+const std::vector<Imath::V2i> &MeshTopology::edges() const
+{
+	return m_edges;
+}
+
+const std::vector<int> &MeshTopology::faceVertexEdges() const
+{
+	return m_faceVertexEdges;
+}
+
+const std::vector<int> &MeshTopology::oppositeFaceVertices() const
+{
+	return m_oppositeFaceVertices;
+}
+
 int MeshSplitter::numMeshes() const
 {
 	return m_meshIndices.size();
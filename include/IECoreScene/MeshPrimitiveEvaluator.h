@@ -41,12 +41,15 @@
 
 #include "IECore/BoundedKDTree.h"
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
 namespace IECoreScene
 {
 
+class BoundingVolumeHierarchy;
+
 /// An implementation of PrimitiveEvaluator to allow spatial queries to be performed on MeshPrimitive instances
 /// \ingroup geometryProcessingGroup
 class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
@@ -142,9 +145,11 @@ class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 		const Imath::Box2f uvBound() const;
 
 		//! @name Internal KDTrees.
-		/// The MeshPrimitiveEvaluator uses internal KDTrees to perform many of
-		/// its queries. Const access is provided to these so that clients can use them
-		/// in implementing their own algorithms.
+		/// The MeshPrimitiveEvaluator uses internal KDTrees to perform uv queries,
+		/// and const access is provided to these so that clients can use them in
+		/// implementing their own algorithms. Spatial queries are accelerated by a
+		/// separate bounding volume hierarchy, so the triangle tree is only built
+		/// on the first call to triangleBoundTree().
 		//////////////////////////////////////////////////////////////////////////
 		//@{
 		/// A type for storing the bounding box for a triangle.
@@ -176,20 +181,23 @@ class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 
 	protected:
 
+		/// Adds "N", "triangleIndex" and "barycentricCoordinates" outputs, and
+		/// "uv" if the mesh has uvs.
+		BatchOutputFunction addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const override;
+
 		ConstMeshPrimitivePtr m_mesh;
 		IECore::ConstV3fVectorDataPtr m_verts;
 		const std::vector<int> *m_meshVertexIds;
 
 		TriangleBoundVector m_triangles;
-		TriangleBoundTree *m_tree;
+		std::unique_ptr<BoundingVolumeHierarchy> m_bvh;
+		mutable std::once_flag m_treeOnceFlag;
+		mutable TriangleBoundTree *m_tree;
 
 		UVBoundVector m_uvTriangles;
 		UVBoundTree *m_uvTree;
 
 		bool pointAtUVWalk( UVBoundTree::NodeIndex nodeIndex, const Imath::V2f &targetUV, Result *result ) const;
-		void closestPointWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::V3f &p, float &closestDistanceSqrd, Result *result ) const;
-		bool intersectionPointWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::Line3f &ray, float &maxDistSqrd, Result *result, bool &hit ) const;
-		void intersectionPointsWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::Line3f &ray, float maxDistSqrd, std::vector<PrimitiveEvaluator::ResultPtr> &results ) const;
 
 		void calculateMassProperties() const;
 		void calculateAverageNormals() const;
@@ -67,6 +67,10 @@ IECORESCENE_API PointsPrimitivePtr mergePoints( const std::vector<const PointsPr
 /// completely segmententing the points based on the unique values in a primitive variable.
 IECORESCENE_API std::vector<PointsPrimitivePtr> segment( const PointsPrimitive *points, const PrimitiveVariable &primitiveVariable, const IECore::Data *segmentValues = nullptr, const IECore::Canceller *canceller = nullptr );
 
+/// Reorders the points along a space filling curve, so that points which are close
+/// in space are also close in memory. All primitive variables are updated to match.
+IECORESCENE_API void reorderForLocality( PointsPrimitive *points, const std::string &position = "P", const IECore::Canceller *canceller = nullptr );
+
 } // namespace PointsAlgo
 
 } // namespace IECoreScene
@@ -136,6 +136,9 @@ class IECORESCENE_API PointsPrimitiveEvaluator : public PrimitiveEvaluator
 		friend struct PrimitiveEvaluator::Description<PointsPrimitiveEvaluator>;
 		static PrimitiveEvaluator::Description<PointsPrimitiveEvaluator> g_evaluatorDescription;
 
+		/// Adds a "pointIndex" output.
+		BatchOutputFunction addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const override;
+
 	private :
 
 
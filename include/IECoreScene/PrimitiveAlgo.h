@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENE_PRIMITIVEALGO_H
+#define IECORESCENE_PRIMITIVEALGO_H
+
+#include "IECoreScene/Export.h"
+#include "IECoreScene/Primitive.h"
+
+#include "IECore/Canceller.h"
+
+IECORE_PUSH_DEFAULT_VISIBILITY
+#include "Imath/ImathMatrix.h"
+IECORE_POP_DEFAULT_VISIBILITY
+
+namespace IECoreScene
+{
+
+namespace PrimitiveAlgo
+{
+
+/// Transforms all the V3f and V3d primitive variables with Point, Vector or Normal
+/// interpretation. Points are transformed by the full matrix, vectors by its upper
+/// 3x3 part and normals by its inverse transpose, matching MatrixMultiplyOp.
+/// Data that is shared with other owners is copied before being transformed, and
+/// uniquely owned data is modified in place. Variables are processed in parallel,
+/// as are the elements within each variable.
+IECORESCENE_API void transform( Primitive *primitive, const Imath::M44f &matrix, const IECore::Canceller *canceller = nullptr );
+
+} // namespace PrimitiveAlgo
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_PRIMITIVEALGO_H
@@ -38,6 +38,8 @@
 #include "IECoreScene/Export.h"
 #include "IECoreScene/Primitive.h"
 
+#include "IECore/Canceller.h"
+#include "IECore/CompoundData.h"
 #include "IECore/Export.h"
 #include "IECore/RunTimeTyped.h"
 
@@ -46,7 +48,9 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "Imath/ImathVec.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace IECoreScene
 {
@@ -164,6 +168,34 @@ class IECORESCENE_API PrimitiveEvaluator : public IECore::RunTimeTyped
 
 		//@}
 
+		//! @name Batch Query Functions
+		/// These perform one query per element of their inputs, running in parallel
+		/// and returning the results as a structure of arrays, with one element per
+		/// query. The returned CompoundData always contains "success" (BoolVectorData)
+		/// and "P" (V3fVectorData), and derived classes add their own outputs such as
+		/// normals, uvs and the index of the element found. The named `primitiveVariables`
+		/// are evaluated at each result and returned in a "primitiveVariables" member.
+		/// Outputs for unsuccessful queries are left default initialised.
+		////////////////////////////////////////////////////////////////////////////////////////
+		//@{
+		IECore::CompoundDataPtr closestPoints(
+			const std::vector<Imath::V3f> &points, const std::vector<std::string> &primitiveVariables = {},
+			const IECore::Canceller *canceller = nullptr
+		) const;
+
+		IECore::CompoundDataPtr pointsAtUV(
+			const std::vector<Imath::V2f> &uvs, const std::vector<std::string> &primitiveVariables = {},
+			const IECore::Canceller *canceller = nullptr
+		) const;
+
+		/// Finds the closest intersection for each ray. `origins` and `directions` must be the same length.
+		IECore::CompoundDataPtr intersectRays(
+			const std::vector<Imath::V3f> &origins, const std::vector<Imath::V3f> &directions,
+			float maxDistance = std::numeric_limits<float>::max(), const std::vector<std::string> &primitiveVariables = {},
+			const IECore::Canceller *canceller = nullptr
+		) const;
+		//@}
+
 		/// Throws an exception if the passed result type is not compatible with the current evaluator
 		virtual void validateResult( Result *result ) const =0;
 
@@ -178,8 +210,25 @@ class IECORESCENE_API PrimitiveEvaluator : public IECore::RunTimeTyped
 			}
 		};
 
+	protected :
+
+		/// Writes the evaluator-specific outputs for a single successful query.
+		using BatchOutputFunction = std::function<void ( const Result *result, size_t queryIndex )>;
+		/// May be implemented by derived classes to add outputs to the results of the
+		/// batch queries. Implementations should add each output to `outputs`, sized for
+		/// `numQueries`, and return a function to fill them in. This will be called
+		/// concurrently from many threads, but never twice for the same `queryIndex`.
+		/// The default implementation adds nothing and returns an empty function.
+		virtual BatchOutputFunction addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const;
+
 	private:
 
+		using BatchQueryFunction = std::function<bool ( size_t queryIndex, Result *result )>;
+		IECore::CompoundDataPtr batchQuery(
+			size_t numQueries, const BatchQueryFunction &query,
+			const std::vector<std::string> &primitiveVariables, const IECore::Canceller *canceller
+		) const;
+
 		static void registerCreator( IECore::TypeId id, CreatorFn f );
 
 		typedef std::map<IECore::TypeId, CreatorFn> CreatorMap;
@@ -39,8 +39,11 @@
 
 #include "IECoreScene/SceneInterface.h"
 
+#include <functional>
+#include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace IECoreScene
 {
@@ -62,7 +65,174 @@ enum ProcessFlags
 
 typedef std::map<std::string, size_t> SceneStats;
 
-IECORESCENE_API SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags );
+/// Parallel traversal
+/// ==================
+
+struct IECORESCENE_API ParallelTraverseOptions
+{
+
+	ParallelTraverseOptions();
+
+	/// The time at which prefetched components are read.
+	double time;
+	/// Components to be read before the visitor is called for
+	/// each location, specified as a combination of `Bounds`,
+	/// `Transforms`, `Attributes` and `Objects`. Prefetching is
+	/// performed in the same task as the call to the visitor.
+	unsigned int prefetch;
+	/// The maximum depth to visit, relative to the starting location
+	/// (which has a depth of 0). A negative value visits all
+	/// descendants.
+	int maxDepth;
+	/// The maximum number of threads to use for the traversal. A value
+	/// of 0 uses as many threads as the TBB scheduler permits.
+	unsigned int maxConcurrency;
+	/// May be used to cancel the traversal, in which case
+	/// `IECore::Cancelled` is thrown from `parallelTraverse()`.
+	const IECore::Canceller *canceller;
+
+};
+
+/// The components of a location read as specified by
+/// `ParallelTraverseOptions::prefetch`. Only the components
+/// specified in `prefetched` are valid.
+struct IECORESCENE_API LocationComponents
+{
+
+	LocationComponents();
+
+	using AttributeMap = std::map<SceneInterface::Name, IECore::ConstObjectPtr>;
+
+	unsigned int prefetched;
+	Imath::Box3d bound;
+	IECore::ConstDataPtr transform;
+	AttributeMap attributes;
+	/// Null if the location has no object.
+	IECore::ConstObjectPtr object;
+
+};
+
+/// Called for each location visited by `parallelTraverse()`, concurrently
+/// from multiple threads. Returning false prunes the traversal, so that the
+/// children of the location are not visited.
+using ParallelTraverseVisitor = std::function<bool ( const SceneInterface *location, const LocationComponents &components )>;
+
+/// Visits `scene` and all its descendants in parallel, calling `visitor`
+/// for each location. Children are visited only after their parent has been
+/// visited, but no other ordering is guaranteed. Locations are spawned as
+/// independent tasks so that idle threads can steal work from anywhere in
+/// the hierarchy, keeping all threads busy even for deep and unbalanced
+/// hierarchies. Exceptions thrown by the visitor cancel the traversal and are
+/// rethrown.
+IECORESCENE_API void parallelTraverse( const SceneInterface *scene, const ParallelTraverseVisitor &visitor, const ParallelTraverseOptions &options = ParallelTraverseOptions() );
+
+/// Profiling
+/// =========
+
+/// Records a single read of a single component of a location.
+struct IECORESCENE_API ProfileEvent
+{
+
+	ProfileEvent();
+
+	SceneInterface::Path path;
+	/// The component read, specified as one of `Bounds`, `Transforms`,
+	/// `Attributes`, `Tags`, `Sets` or `Objects`.
+	ProcessFlags component;
+	/// The scene time at which the component was read.
+	double time;
+	/// The start of the read, in seconds since profiling began.
+	double start;
+	/// The duration of the read in seconds. Because this is measured
+	/// through the public SceneInterface API, it includes the time taken
+	/// to read, decompress and construct the data.
+	double duration;
+	/// The memory used by the data read, as reported by
+	/// `Object::memoryUsage()`.
+	size_t bytes;
+	/// The TBB thread index of the thread performing the read.
+	int thread;
+
+};
+
+/// Collects the ProfileEvents recorded by `parallelReadAll()`.
+struct IECORESCENE_API ReadProfile
+{
+
+	/// Sorted by start time.
+	std::vector<ProfileEvent> events;
+
+	/// Returns a human readable report summarising the total time
+	/// and bytes for each component, followed by the `n` locations
+	/// with the highest total read time.
+	std::string report( size_t n = 10 ) const;
+
+	/// Writes the events in the Chrome trace event format, suitable
+	/// for viewing in `chrome://tracing` or Perfetto.
+	void writeChromeTrace( std::ostream &stream ) const;
+	void writeChromeTrace( const std::string &fileName ) const;
+
+};
+
+/// Diffing
+/// =======
+
+/// Describes a single difference between two scenes.
+struct IECORESCENE_API SceneChange
+{
+
+	enum Type
+	{
+		/// The location or component exists only in the second scene.
+		Added,
+		/// The location or component exists only in the first scene.
+		Removed,
+		/// The component exists in both scenes, with different values.
+		Modified
+	};
+
+	SceneChange();
+	SceneChange( Type type, const SceneInterface::Path &path, ProcessFlags component, const SceneInterface::Name &name = SceneInterface::Name(), double time = 0.0 );
+
+	bool operator == ( const SceneChange &rhs ) const;
+
+	Type type;
+	SceneInterface::Path path;
+	/// The component that has changed, specified as one of `Bounds`,
+	/// `Transforms`, `Attributes`, `Tags`, `Sets` or `Objects`. `None`
+	/// denotes the addition or removal of the location itself.
+	ProcessFlags component;
+	/// The name of the attribute, tag or set that has changed. Empty
+	/// for other components.
+	SceneInterface::Name name;
+	/// The time at which the change occurs. Only meaningful for
+	/// `Bounds`, `Transforms`, `Attributes` and `Objects`.
+	double time;
+
+};
+
+using SceneChanges = std::vector<SceneChange>;
+
+/// Compares the components specified by `flags` at the specified times,
+/// returning a list of changes sorted by location. Both scenes are traversed
+/// in parallel, and `SceneInterface::hash()` is used to avoid loading data
+/// wherever possible. Because hashes are not required to be content-based,
+/// matching hashes are taken to mean identical data, but differing hashes
+/// are verified by loading and comparing the data itself. Subtrees with
+/// matching `HierarchyHash` at all times are skipped entirely. For SceneCaches,
+/// whose `hash()` is specific to the file, `SceneCache::contentHash()` is used
+/// instead where available, so identical subtrees are also skipped when
+/// comparing different files.
+IECORESCENE_API SceneChanges diff( const SceneInterface *a, const SceneInterface *b, const std::vector<double> &times, unsigned int flags = All, const IECore::Canceller *canceller = nullptr );
+
+/// Utilities
+/// =========
+
+/// Reads the specified components of all locations for all frames in the
+/// range, returning counts of the data read. If `profile` is non-null, it
+/// is cleared and then filled with the timings and memory usage for each
+/// component read.
+IECORESCENE_API SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags, ReadProfile *profile = nullptr );
 
 /// copy from one scene to another.
 IECORESCENE_API void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags );
@@ -66,15 +66,30 @@ class IECORESCENE_API SceneCache : public SampledSceneInterface
 		/// current object path to "/". Depending on what mode is chosen,
 		/// different subsets of the methods below are available. When the
 		/// open mode is Read, only the const methods may be used and
-		/// when the open mode is Write, the non-const methods
-		/// may be used in addition. Append mode is currently not supported.
+		/// when the open mode is Write or Append, the non-const methods
+		/// may be used in addition.
+		///
+		/// In Append mode, new locations and new samples are added to an
+		/// existing file without rewriting it. New samples must be later than
+		/// the existing samples for the same location and component. The
+		/// bounds of existing samples are preserved exactly, and new bound
+		/// samples include both the new data and the existing data held
+		/// forward in time. The exception is the addition of new locations,
+		/// which are considered to exist at all times, so their bounds are
+		/// held backwards into the existing samples of their ancestors.
+		///
+		/// The new data and a new index are written after the end of the file,
+		/// and the space used by the previous index is reused once the new one
+		/// has been written. The file is only valid again once it has been
+		/// closed. The previous subindexes of modified locations are not
+		/// reclaimed, so the file grows with every append, even when the same
+		/// locations are modified each time.
 		SceneCache( const std::string &fileName, IECore::IndexedIO::OpenMode mode );
 		/// Constructor which uses an already-opened IndexedIO, this
 		/// can be used if you wish to use an alternative IndexedIO
 		/// implementation for the backend. The given IndexedIO should be
 		/// pointing to the root location on the file. The open mode will
-		/// be the same from the given IndexedIO object. Append mode is not
-		/// supported.
+		/// be the same from the given IndexedIO object.
 		SceneCache( IECore::IndexedIOPtr indexedIO );
 
 		~SceneCache() override;
@@ -136,6 +151,14 @@ class IECORESCENE_API SceneCache : public SampledSceneInterface
 
 		void hash( HashType hashType, double time, IECore::MurmurHash &h ) const override;
 
+		/// Appends a hash of everything stored at this location and below to `h`,
+		/// returning false if the file doesn't store one. Unlike `hash()`, this
+		/// identifies neither the file nor the location, and is the same at all
+		/// times, so it can be used to find identical hierarchies in different
+		/// files. Content hashes are computed when writing, and are removed from
+		/// locations modified in Append mode, as well as from their ancestors.
+		bool contentHash( IECore::MurmurHash &h ) const;
+
 		/// tells you if this scene cache is read only or writable:
 		bool readOnly() const;
 
@@ -120,6 +120,9 @@ class IECORESCENE_API SpherePrimitiveEvaluator : public PrimitiveEvaluator
 
 	protected:
 
+		/// Adds "N" and "uv" outputs.
+		BatchOutputFunction addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const override;
+
 		ConstSpherePrimitivePtr m_sphere;
 };
 
@@ -0,0 +1,295 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORESCENE_BOUNDINGVOLUMEHIERARCHY_H
+#define IECORESCENE_BOUNDINGVOLUMEHIERARCHY_H
+
+#include "IECoreScene/Export.h"
+
+#include "Imath/ImathBox.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace IECoreScene
+{
+
+/// A bounding volume hierarchy over a list of boxes, used to accelerate
+/// spatial queries on primitives. The hierarchy is built in parallel using
+/// the binned surface area heuristic (SAH). Each node has up to four children,
+/// with their bounds stored as a structure of arrays so that all four can be
+/// tested at once, in a form the compiler can vectorise.
+class IECORESCENE_API BoundingVolumeHierarchy
+{
+
+	public :
+
+		/// Builds a hierarchy over `bounds`. Queries report boxes using
+		/// their index in `bounds`.
+		BoundingVolumeHierarchy( const std::vector<Imath::Box3f> &bounds );
+
+		const Imath::Box3f &bound() const;
+
+		/// Calls `f( index, maxDistanceSquared )` for each box which is no further
+		/// than `sqrt( maxDistanceSquared )` from `p`, visiting the nearest boxes first.
+		/// `f` may reduce `maxDistanceSquared` to prune the remainder of the search.
+		template<typename F>
+		void closest( const Imath::V3f &p, float &maxDistanceSquared, F &&f ) const;
+
+		/// Calls `f( index, maxDistance )` for each box intersected by the ray
+		/// `origin + t * direction`, for `0 <= t <= maxDistance`, visiting the
+		/// nearest boxes first. `f` may reduce `maxDistance` to prune the remainder
+		/// of the search. Box tests are conservative, so `f` may also be called for
+		/// boxes which the ray only just misses.
+		template<typename F>
+		void intersect( const Imath::V3f &origin, const Imath::V3f &direction, float &maxDistance, F &&f ) const;
+
+	private :
+
+		class Builder;
+
+		struct Node
+		{
+			Node();
+
+			float minX[4];
+			float minY[4];
+			float minZ[4];
+			float maxX[4];
+			float maxY[4];
+			float maxZ[4];
+			// For interior children, the index of the child node. For leaves,
+			// the index of the first entry in `m_indices`.
+			int first[4];
+			// The number of boxes in leaf children, 0 for interior children,
+			// and -1 for unused children.
+			int count[4];
+		};
+
+		// An entry in the traversal stack : either a node (count == 0) or a leaf.
+		struct StackEntry
+		{
+			int first;
+			int count;
+			float distance;
+		};
+
+		// Construction limits the depth of the hierarchy, so this is enough
+		// for the three siblings we may stack at each level.
+		static constexpr int g_stackSize = 256;
+
+		// Pushes the children in `entries` onto the stack with the nearest last,
+		// so that it is the next to be visited.
+		static void push( StackEntry *entries, int numEntries, StackEntry *stack, int &stackSize );
+
+		std::vector<Node> m_nodes;
+		std::vector<int> m_indices;
+		Imath::Box3f m_bound;
+
+};
+
+inline const Imath::Box3f &BoundingVolumeHierarchy::bound() const
+{
+	return m_bound;
+}
+
+inline void BoundingVolumeHierarchy::push( StackEntry *entries, int numEntries, StackEntry *stack, int &stackSize )
+{
+	// Insertion sort directly onto the stack, which is
+	// cheaper than `std::sort()` for at most four entries.
+	assert( stackSize + numEntries <= g_stackSize );
+	StackEntry *first = stack + stackSize;
+	for( int i = 0; i < numEntries; ++i )
+	{
+		int j = i;
+		for( ; j > 0 && first[j-1].distance < entries[i].distance; --j )
+		{
+			first[j] = first[j-1];
+		}
+		first[j] = entries[i];
+	}
+	stackSize += numEntries;
+}
+
+template<typename F>
+void BoundingVolumeHierarchy::closest( const Imath::V3f &p, float &maxDistanceSquared, F &&f ) const
+{
+	if( m_nodes.empty() )
+	{
+		return;
+	}
+
+	StackEntry stack[g_stackSize];
+	int stackSize = 0;
+	stack[stackSize++] = { 0, 0, 0.0f };
+
+	while( stackSize )
+	{
+		const StackEntry entry = stack[--stackSize];
+		if( entry.distance > maxDistanceSquared )
+		{
+			continue;
+		}
+
+		if( entry.count )
+		{
+			for( int i = entry.first, e = entry.first + entry.count; i < e; ++i )
+			{
+				f( m_indices[i], maxDistanceSquared );
+			}
+			continue;
+		}
+
+		const Node &node = m_nodes[entry.first];
+
+		float distances[4];
+		for( int i = 0; i < 4; ++i )
+		{
+			const float dx = std::max( std::max( node.minX[i] - p.x, p.x - node.maxX[i] ), 0.0f );
+			const float dy = std::max( std::max( node.minY[i] - p.y, p.y - node.maxY[i] ), 0.0f );
+			const float dz = std::max( std::max( node.minZ[i] - p.z, p.z - node.maxZ[i] ), 0.0f );
+			distances[i] = dx * dx + dy * dy + dz * dz;
+		}
+
+		StackEntry children[4];
+		int numChildren = 0;
+		for( int i = 0; i < 4; ++i )
+		{
+			if( node.count[i] >= 0 && distances[i] <= maxDistanceSquared )
+			{
+				children[numChildren++] = { node.first[i], node.count[i], distances[i] };
+			}
+		}
+
+		push( children, numChildren, stack, stackSize );
+	}
+}
+
+template<typename F>
+void BoundingVolumeHierarchy::intersect( const Imath::V3f &origin, const Imath::V3f &direction, float &maxDistance, F &&f ) const
+{
+	if( m_nodes.empty() )
+	{
+		return;
+	}
+
+	// Division by zero gives infinities, which the slab tests below
+	// handle correctly. Choosing the near and far planes according to the
+	// sign of the direction means that the NaNs arising for rays lying in
+	// a slab plane are ignored by the comparisons, leaving the slab open.
+	const Imath::V3f inverseDirection( 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z );
+	const bool negX = inverseDirection.x < 0.0f;
+	const bool negY = inverseDirection.y < 0.0f;
+	const bool negZ = inverseDirection.z < 0.0f;
+
+	// Expands the far distance to account for rounding errors in the slab
+	// tests, so that we never miss a box that is hit. See "Robust BVH Ray
+	// Traversal" (Ize 2013).
+	const float farScale = 1.0f + 4.0f * std::numeric_limits<float>::epsilon();
+
+	StackEntry stack[g_stackSize];
+	int stackSize = 0;
+	stack[stackSize++] = { 0, 0, 0.0f };
+
+	while( stackSize )
+	{
+		const StackEntry entry = stack[--stackSize];
+		if( entry.distance > maxDistance )
+		{
+			continue;
+		}
+
+		if( entry.count )
+		{
+			for( int i = entry.first, e = entry.first + entry.count; i < e; ++i )
+			{
+				f( m_indices[i], maxDistance );
+			}
+			continue;
+		}
+
+		const Node &node = m_nodes[entry.first];
+		const float *nearX = negX ? node.maxX : node.minX;
+		const float *farX = negX ? node.minX : node.maxX;
+		const float *nearY = negY ? node.maxY : node.minY;
+		const float *farY = negY ? node.minY : node.maxY;
+		const float *nearZ = negZ ? node.maxZ : node.minZ;
+		const float *farZ = negZ ? node.minZ : node.maxZ;
+
+		float tNear[4];
+		float tFar[4];
+		for( int i = 0; i < 4; ++i )
+		{
+			float t0 = 0.0f;
+			float t1 = maxDistance;
+
+			const float t0x = ( nearX[i] - origin.x ) * inverseDirection.x;
+			const float t1x = ( farX[i] - origin.x ) * inverseDirection.x;
+			t0 = t0x > t0 ? t0x : t0;
+			t1 = t1x < t1 ? t1x : t1;
+
+			const float t0y = ( nearY[i] - origin.y ) * inverseDirection.y;
+			const float t1y = ( farY[i] - origin.y ) * inverseDirection.y;
+			t0 = t0y > t0 ? t0y : t0;
+			t1 = t1y < t1 ? t1y : t1;
+
+			const float t0z = ( nearZ[i] - origin.z ) * inverseDirection.z;
+			const float t1z = ( farZ[i] - origin.z ) * inverseDirection.z;
+			t0 = t0z > t0 ? t0z : t0;
+			t1 = t1z < t1 ? t1z : t1;
+
+			tNear[i] = t0;
+			tFar[i] = t1 * farScale;
+		}
+
+		StackEntry children[4];
+		int numChildren = 0;
+		for( int i = 0; i < 4; ++i )
+		{
+			if( node.count[i] >= 0 && tNear[i] <= tFar[i] )
+			{
+				children[numChildren++] = { node.first[i], node.count[i], tNear[i] };
+			}
+		}
+
+		push( children, numChildren, stack, stackSize );
+	}
+}
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_BOUNDINGVOLUMEHIERARCHY_H
@@ -36,18 +36,27 @@
 #define IECORESCENE_PRIMITIVEALGOUTILS_H
 
 #include "IECoreScene/CurvesPrimitive.h"
+#include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/MeshPrimitive.h"
 #include "IECoreScene/PointsPrimitive.h"
 
+#include "IECore/Canceller.h"
 #include "IECore/DataAlgo.h"
+#include "IECore/Exception.h"
 #include "IECore/TypeTraits.h"
 
 #include "boost/mpl/and.hpp"
 
+#include "Imath/ImathBox.h"
+
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
 
 #include "tbb/blocked_range.h"
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include "tbb/task_arena.h"
 
 #include "fmt/format.h"
 
@@ -74,6 +83,51 @@ inline int numPrimitives(const IECoreScene::PointsPrimitive *points)
 	return points->getNumPoints();
 }
 
+/// Throws if a MeshTopology passed to `function` was not computed from a mesh with the
+/// same numbers of faces, vertices and face-vertices as `mesh`. This doesn't detect
+/// every mismatch, but it prevents out of bounds accesses.
+inline void validateTopology( const IECoreScene::MeshPrimitive *mesh, const IECoreScene::MeshAlgo::MeshTopology *topology, const char *function )
+{
+	const size_t numVertices = mesh->variableSize( IECoreScene::PrimitiveVariable::Vertex );
+	const size_t numFaceVertices = mesh->variableSize( IECoreScene::PrimitiveVariable::FaceVarying );
+	if(
+		(size_t)topology->numFaces() != mesh->numFaces() ||
+		(size_t)topology->numVertices() != numVertices ||
+		(size_t)topology->numFaceVertices() != numFaceVertices
+	)
+	{
+		throw IECore::InvalidArgumentException(
+			fmt::format(
+				"{} : MeshTopology with {} faces, {} vertices and {} face-vertices does not match MeshPrimitive with {} faces, {} vertices and {} face-vertices.",
+				function,
+				topology->numFaces(), topology->numVertices(), topology->numFaceVertices(),
+				mesh->numFaces(), numVertices, numFaceVertices
+			)
+		);
+	}
+}
+
+/// Calls `f( i )` for each `i` in `[0, size)` in parallel, using an isolated
+/// task group context. `canceller` is checked before each block of at least
+/// `grainSize` elements.
+template<typename F>
+void parallelForEach( size_t size, const IECore::Canceller *canceller, F &&f, size_t grainSize = 1000 )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size, grainSize ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
 inline IECoreScene::PrimitiveVariable::Interpolation splitPrimvarInterpolation(const IECoreScene::MeshPrimitive *mesh)
 {
 	return IECoreScene::PrimitiveVariable::Interpolation::Uniform;
@@ -333,6 +387,74 @@ class TaskSegmenter
 };
 
 
+/// Returns the indices of `positions`, sorted along a Morton (Z-order) curve
+/// through their bounding box. Positions which are close in space tend to be
+/// close in the result. Ties are broken by index, so the order is stable.
+inline std::vector<int> spatialOrder( const std::vector<Imath::V3f> &positions, const IECore::Canceller *canceller )
+{
+	Imath::Box3f bound;
+	for( const auto &p : positions )
+	{
+		bound.extendBy( p );
+	}
+
+	const Imath::V3f size = bound.size();
+	const uint64_t maxCoordinate = ( 1 << 21 ) - 1;
+	auto quantise = [&]( float x, int axis ) -> uint64_t {
+		const float f = ( x - bound.min[axis] ) / size[axis];
+		// Negated comparison so that NaNs (including those from empty or
+		// degenerate bounds) map to 0.
+		if( !( f > 0.0f ) )
+		{
+			return 0;
+		}
+		return std::min( static_cast<uint64_t>( std::min( f, 1.0f ) * maxCoordinate ), maxCoordinate );
+	};
+
+	// Spreads the lower 21 bits of `x` so that there are two zero bits
+	// between each of them.
+	auto spread = []( uint64_t x ) {
+		x &= 0x1fffff;
+		x = ( x | x << 32 ) & 0x1f00000000ffff;
+		x = ( x | x << 16 ) & 0x1f0000ff0000ff;
+		x = ( x | x << 8 ) & 0x100f00f00f00f00f;
+		x = ( x | x << 4 ) & 0x10c30c30c30c30c3;
+		x = ( x | x << 2 ) & 0x1249249249249249;
+		return x;
+	};
+
+	std::vector<std::pair<uint64_t, int>> keys( positions.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, positions.size(), 10000 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const Imath::V3f &p = positions[i];
+				keys[i] = {
+					spread( quantise( p.x, 0 ) ) | spread( quantise( p.y, 1 ) ) << 1 | spread( quantise( p.z, 2 ) ) << 2,
+					static_cast<int>( i )
+				};
+			}
+		},
+		taskGroupContext
+	);
+
+	// `parallel_sort()` doesn't accept a `task_group_context`, so we isolate
+	// it instead, like the loops above.
+	IECore::Canceller::check( canceller );
+	tbb::this_task_arena::isolate( [&] { tbb::parallel_sort( keys.begin(), keys.end() ); } );
+
+	std::vector<int> result( keys.size() );
+	for( size_t i = 0; i < keys.size(); ++i )
+	{
+		result[i] = keys[i].second;
+	}
+	return result;
+}
+
 } // namespace Detail
 } // namespace IECoreScene
 
@@ -37,12 +37,20 @@
 
 #include "IECoreScene/PrimitiveVariable.h"
 #include "IECoreScene/CurvesPrimitive.h"
+#include "IECoreScene/private/PrimitiveAlgoUtils.h"
 
+#include "IECore/Canceller.h"
+#include "IECore/DataAlgo.h"
 #include "IECore/VectorTypedData.h"
 
 #include "fmt/format.h"
 
-#include <unordered_map>
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 namespace IECoreScene
 {
@@ -84,340 +92,302 @@ struct IndexedData
 	IECore::IntVectorDataPtr indices;
 };
 
-/// For building a filtered indexed data array from an existing data array
-/// ensuring the resulting data array is compact.
-template<typename T, template<typename> class V>
-class IndexedPrimitiveVariableBuilder
+/// Describes the elements of a primitive variable which remain after deleting
+/// primitives, as the list of input elements in output order. The elements
+/// belonging to each primitive are assumed to be contiguous, and in primitive
+/// order, as they are for all interpolations other than Vertex on meshes. Mesh
+/// vertices can be described by building from a mask of used vertices.
+///
+/// Construction performs a parallel prefix sum over the primitives, and the
+/// elements may then be gathered from any number of primitive variables using
+/// `IECore::dispatch( data, keptElements, indices )`. Gathering is parallel
+/// too, and it is safe to gather several primitive variables concurrently.
+class KeptElements
 {
-	public:
-		IndexedPrimitiveVariableBuilder( int dataReserveSize, int indexReserveSize, const V<std::vector<T> > *src = nullptr )
-			: m_data( new V<std::vector<T> >() ),
-			m_writable( m_data->writable() ),
-			m_indices( new IECore::IntVectorData() ),
-			m_writableIndices( m_indices->writable() )
+	public :
+
+		/// `keep( i )` returns true if primitive `i` is to be kept, and
+		/// `numElements( i )` returns the number of elements belonging to
+		/// primitive `i`.
+		template<typename KeepFn, typename SizeFn>
+		KeptElements( size_t numPrimitives, KeepFn &&keep, SizeFn &&numElements, const IECore::Canceller *canceller )
+			:	m_canceller( canceller )
 		{
+			// Count the input and output elements for contiguous chunks of primitives,
+			// convert the counts into offsets, and then output the elements for each chunk
+			// in parallel.
+
+			const size_t numChunks = std::max<size_t>( 1, std::min<size_t>( ( numPrimitives + 9999 ) / 10000, 256 ) );
+			const size_t chunkSize = ( numPrimitives + numChunks - 1 ) / numChunks;
+			auto chunkRange = [&]( size_t chunk ) {
+				return std::make_pair( std::min( chunk * chunkSize, numPrimitives ), std::min( ( chunk + 1 ) * chunkSize, numPrimitives ) );
+			};
+
+			// Pairs of input and output offsets for each chunk.
+			std::vector<std::pair<size_t, size_t>> chunkOffsets( numChunks + 1, { 0, 0 } );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, numChunks, 1 ),
+				[&]( const tbb::blocked_range<size_t> &range )
+				{
+					for( size_t chunk = range.begin(); chunk != range.end(); ++chunk )
+					{
+						IECore::Canceller::check( m_canceller );
+						auto &[numInput, numOutput] = chunkOffsets[chunk+1];
+						const auto [begin, end] = chunkRange( chunk );
+						for( size_t i = begin; i < end; ++i )
+						{
+							const size_t n = numElements( i );
+							numInput += n;
+							numOutput += keep( i ) ? n : 0;
+						}
+					}
+				},
+				taskGroupContext
+			);
 
-			if( src )
+			for( size_t chunk = 0; chunk < numChunks; ++chunk )
 			{
-				GeometricInterpretationCopier<V<std::vector<T>>> copier;
-				copier( src, m_data.get() );
+				chunkOffsets[chunk+1].first += chunkOffsets[chunk].first;
+				chunkOffsets[chunk+1].second += chunkOffsets[chunk].second;
 			}
 
-			m_writable.reserve( dataReserveSize );
-
-			if( indexReserveSize > 0 )
-			{
-				m_writableIndices.reserve( indexReserveSize );
-			}
-		}
+			m_numInputElements = chunkOffsets.back().first;
+			m_elements.resize( chunkOffsets.back().second );
 
-		void addIndexedValue( const PrimitiveVariable::IndexedView<T> &indexedData, int i )
-		{
-			if( !indexedData.indices() )
-			{
-				m_writable.push_back( indexedData[i] );
-				return;
-			}
-
-			int oldIndex = indexedData.index( i );
-			int newIndex = static_cast<int>( m_writable.size() );
-			auto it = m_indexMapping.insert( { oldIndex, newIndex } );
-			if( it.second )
-			{
-				m_writableIndices.push_back( newIndex );
-				m_writable.push_back( indexedData[i] );
-			}
-			else
-			{
-				m_writableIndices.push_back( it.first->second );
-			}
-		}
-
-		IndexedData indexedData()
-		{
-			if( m_writableIndices.size() )
-			{
-				return IndexedData( m_data, m_indices );
-			}
-
-			return IndexedData( m_data, nullptr );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, numChunks, 1 ),
+				[&]( const tbb::blocked_range<size_t> &range )
+				{
+					for( size_t chunk = range.begin(); chunk != range.end(); ++chunk )
+					{
+						IECore::Canceller::check( m_canceller );
+						auto [input, output] = chunkOffsets[chunk];
+						const auto [begin, end] = chunkRange( chunk );
+						for( size_t i = begin; i < end; ++i )
+						{
+							const size_t n = numElements( i );
+							if( keep( i ) )
+							{
+								std::iota( m_elements.begin() + output, m_elements.begin() + output + n, static_cast<int>( input ) );
+								output += n;
+							}
+							input += n;
+						}
+					}
+				},
+				taskGroupContext
+			);
 		}
 
-	private:
-
-		typename V<std::vector<T>>::Ptr m_data;
-		std::vector<T> &m_writable;
-
-		IECore::IntVectorDataPtr m_indices;
-		std::vector<int> &m_writableIndices;
-
-		std::unordered_map<int, int> m_indexMapping;
-};
-
-// Base type for all Functors which delete primivars
-template<typename U>
-class DeleteFlagged
-{
-	public:
-		DeleteFlagged( const PrimitiveVariable::IndexedView<U> &deleteFlagView, bool invert )
-			: m_deleteFlagView ( deleteFlagView ), m_dataIndices( nullptr ), m_invert( invert )
+		/// The input element for each output element.
+		const std::vector<int> &elements() const
 		{
+			return m_elements;
 		}
 
-		bool shouldKeepPrimitive( size_t i ) const
+		/// Returns the output element for each input element, or -1 for
+		/// elements which were not kept.
+		std::vector<int> remapping() const
 		{
-			return ( m_invert && m_deleteFlagView[i] ) || ( !m_invert && !m_deleteFlagView[i] );
+			std::vector<int> result( m_numInputElements, -1 );
+			parallelForEach<int>( m_elements.size(), [&]( size_t i ) { result[m_elements[i]] = i; } );
+			return result;
 		}
 
-		void setIndices( const IECore::TypedData<std::vector<int> > *dataIndices )
+		/// Gathers the kept elements. Indexed data is compacted so that it
+		/// contains only the values still referenced, in order of first use.
+		template<typename T, template<typename> class V>
+		IndexedData operator()( const V<std::vector<T>> *data, const IECore::IntVectorData *indices ) const
 		{
-			m_dataIndices = dataIndices ? &dataIndices->readable() : nullptr;
-		}
+			const std::vector<T> &input = data->readable();
 
-	private:
-		const PrimitiveVariable::IndexedView<U> &m_deleteFlagView;
+			typename V<std::vector<T>>::Ptr outputData = new V<std::vector<T>>();
+			GeometricInterpretationCopier<V<std::vector<T>>> copier;
+			copier( data, outputData.get() );
+			std::vector<T> &output = outputData->writable();
 
-	protected:
-		const std::vector<int> *m_dataIndices;
-		bool m_invert;
-};
-
-/// Filter a primitive variable based on optionally indexed flag array
-/// Lifetime of flags, flagIndices & dataIndices should be longer than this functor.
-template<typename U>
-class DeleteFlaggedUniformFunctor : public DeleteFlagged<U>
-{
-	public:
+			if( !indices )
+			{
+				output.resize( m_elements.size() );
+				parallelForEach<T>( m_elements.size(), [&]( size_t i ) { output[i] = input[m_elements[i]]; } );
+				return IndexedData( outputData, nullptr );
+			}
 
-		DeleteFlaggedUniformFunctor( const PrimitiveVariable::IndexedView<U> &deleteFlagView, bool invert ) : DeleteFlagged<U>( deleteFlagView, invert )
-		{
-		}
+			// Numbering values in order of first use is inherently serial, but
+			// is cheap using a dense table rather than a map.
+			const std::vector<int> &inputIndices = indices->readable();
+			IECore::IntVectorDataPtr outputIndicesData = new IECore::IntVectorData();
+			std::vector<int> &outputIndices = outputIndicesData->writable();
+			outputIndices.resize( m_elements.size() );
 
-		template<typename T, template<typename> class V>
-		IndexedData operator()( const V<std::vector<T> > *data )
-		{
+			std::vector<int> indexRemapping( input.size(), -1 );
+			std::vector<int> usedIndices;
+			for( size_t i = 0; i < m_elements.size(); ++i )
+			{
+				if( i % 100000 == 0 )
+				{
+					IECore::Canceller::check( m_canceller );
+				}
 
-			const std::vector<T> &inputs = data->readable();
-			IECoreScene::PrimitiveVariable::IndexedView<T> dataView( inputs, this->m_dataIndices );
+				const int index = inputIndices[m_elements[i]];
+				int &newIndex = indexRemapping[index];
+				if( newIndex == -1 )
+				{
+					newIndex = usedIndices.size();
+					usedIndices.push_back( index );
+				}
+				outputIndices[i] = newIndex;
+			}
 
-			IndexedPrimitiveVariableBuilder<T, V> builder( inputs.size(), this->m_dataIndices ? this->m_dataIndices->size() : 0, data );
+			output.resize( usedIndices.size() );
+			parallelForEach<T>( usedIndices.size(), [&]( size_t i ) { output[i] = input[usedIndices[i]]; } );
 
-			for( size_t i = 0; i < dataView.size(); ++i )
+			if( outputIndices.empty() )
 			{
-				if( this->shouldKeepPrimitive( i ) )
-				{
-					builder.addIndexedValue( dataView, i );
-				}
+				return IndexedData( outputData, nullptr );
 			}
 
-			return builder.indexedData();
+			return IndexedData( outputData, outputIndicesData );
 		}
 
-		IndexedData operator()( const IECore::Data *data )
+		IndexedData operator()( const IECore::Data *data, const IECore::IntVectorData *indices ) const
 		{
 			throw IECore::Exception(
 				fmt::format( "Unexpected Data: {}", ( data ? data->typeName() : std::string( "nullptr" ) ) )
 			);
 		}
 
-};
-
-template<typename U>
-class DeleteFlaggedFaceVaryingFunctor : public DeleteFlagged<U>
-{
-	public:
-
-		DeleteFlaggedFaceVaryingFunctor( const PrimitiveVariable::IndexedView<U> &deleteFlagView, IECore::ConstIntVectorDataPtr verticesPerPrimitive, bool invert )
-			: DeleteFlagged<U>( deleteFlagView, invert ), m_verticesPerPrimitive( verticesPerPrimitive )
-		{
-		}
+	private :
 
-		template<typename T, template<typename> class V>
-		IndexedData operator()( const V<std::vector<T> > *data )
+		// Calls `f( i )` for `i` in the range `[0, size)`, in parallel unless we are
+		// writing to a `std::vector<bool>`, whose elements can't be written concurrently.
+		template<typename T, typename F>
+		void parallelForEach( size_t size, F &&f ) const
 		{
-			const std::vector<T> &inputs = data->readable();
-			const std::vector<int> &verticesPerPrimitive = m_verticesPerPrimitive->readable();
-
-			IECoreScene::PrimitiveVariable::IndexedView<T> dataView( inputs, this->m_dataIndices );
-			IndexedPrimitiveVariableBuilder<T, V> builder( inputs.size(), this->m_dataIndices ? this->m_dataIndices->size() : 0, data );
-
-			size_t offset = 0;
-			for( size_t c = 0; c < verticesPerPrimitive.size(); ++c )
+			if constexpr( std::is_same_v<T, bool> )
 			{
-				int numVerts = verticesPerPrimitive[c];
-				if( this->shouldKeepPrimitive( c ) )
+				IECore::Canceller::check( m_canceller );
+				for( size_t i = 0; i < size; ++i )
 				{
-					for( int v = 0; v < numVerts; ++v )
-					{
-						builder.addIndexedValue( dataView, offset + v );
-					}
+					f( i );
 				}
-				offset += numVerts;
 			}
-
-			return builder.indexedData();
-		}
-
-		IndexedData operator()( const IECore::Data *data )
-		{
-			throw IECore::Exception(
-				fmt::format( "Unexpected Data: {}", ( data ? data->typeName() : std::string( "nullptr" ) ) )
-			);
+			else
+			{
+				Detail::parallelForEach( size, m_canceller, f, 10000 );
+			}
 		}
 
-	private:
-
-		IECore::ConstIntVectorDataPtr m_verticesPerPrimitive;
+		const IECore::Canceller *m_canceller;
+		size_t m_numInputElements;
+		std::vector<int> m_elements;
 
 };
 
-template<typename U>
-class DeleteFlaggedVaryingFunctor : public DeleteFlagged<U>
+/// Gathers elements of primitive variable data into a new order, given the
+/// input element for each output element. Use via
+/// `IECore::dispatch( data, reorderedElements )`.
+class ReorderedElements
 {
-	public:
 
-		DeleteFlaggedVaryingFunctor( const PrimitiveVariable::IndexedView<U> &deleteFlagView, const CurvesPrimitive *curvesPrimitive, bool invert )
-			: DeleteFlagged<U>( deleteFlagView, invert ), m_curvesPrimitive( curvesPrimitive )
+	public :
+
+		ReorderedElements( const std::vector<int> &elements, const IECore::Canceller *canceller )
+			:	m_elements( elements ), m_canceller( canceller )
 		{
 		}
 
 		template<typename T, template<typename> class V>
-		IndexedData operator()( const V<std::vector<T> > *data )
+		IECore::DataPtr operator()( const V<std::vector<T>> *data ) const
 		{
-			const std::vector<T> &inputs = data->readable();
-			IECoreScene::PrimitiveVariable::IndexedView<T> dataView( inputs, this->m_dataIndices );
-			IndexedPrimitiveVariableBuilder<T, V> builder( inputs.size(), this->m_dataIndices ? this->m_dataIndices->size() : 0, data );
+			const std::vector<T> &input = data->readable();
+
+			typename V<std::vector<T>>::Ptr outputData = new V<std::vector<T>>();
+			GeometricInterpretationCopier<V<std::vector<T>>> copier;
+			copier( data, outputData.get() );
+			std::vector<T> &output = outputData->writable();
+			output.resize( m_elements.size() );
 
-			size_t offset = 0;
-			for( size_t c = 0; c < m_curvesPrimitive->numCurves(); ++c )
+			if constexpr( std::is_same_v<T, bool> )
 			{
-				const int numVarying = m_curvesPrimitive->variableSize( PrimitiveVariable::Varying, c );
-				if( this->shouldKeepPrimitive( c ) )
+				// Elements of `std::vector<bool>` can't be written concurrently.
+				IECore::Canceller::check( m_canceller );
+				for( size_t i = 0; i < m_elements.size(); ++i )
 				{
-					for( int v = 0; v < numVarying; ++v )
-					{
-						builder.addIndexedValue( dataView, offset + v );
-					}
+					output[i] = input[m_elements[i]];
 				}
-				offset += numVarying;
+			}
+			else
+			{
+				Detail::parallelForEach( m_elements.size(), m_canceller, [&]( size_t i ) { output[i] = input[m_elements[i]]; }, 10000 );
 			}
 
-			return builder.indexedData();
+			return outputData;
 		}
 
-		IndexedData operator()( const IECore::Data *data )
+		IECore::DataPtr operator()( const IECore::Data *data ) const
 		{
 			throw IECore::Exception(
 				fmt::format( "Unexpected Data: {}", ( data ? data->typeName() : std::string( "nullptr" ) ) )
 			);
 		}
 
-	private:
+	private :
 
-		const CurvesPrimitive *m_curvesPrimitive;
-};
+		const std::vector<int> &m_elements;
+		const IECore::Canceller *m_canceller;
 
+};
 
-template<typename U>
-class DeleteFlaggedVertexFunctor : public DeleteFlagged<U>
+/// Reorders the elements of primitive variables in parallel. `elements( interpolation )`
+/// returns a pointer to the input element for each output element, or nullptr if
+/// variables with that interpolation are to be left as they are. Only the indices
+/// of indexed variables are reordered.
+template<typename ElementsFn>
+void reorderPrimitiveVariables( PrimitiveVariableMap &variables, ElementsFn &&elements, const IECore::Canceller *canceller )
 {
-	public:
-
-		DeleteFlaggedVertexFunctor(
-			size_t maxVertexId,
-			IECore::ConstIntVectorDataPtr vertexIdsData,
-			IECore::ConstIntVectorDataPtr verticesPerFaceData,
-			const PrimitiveVariable::IndexedView<U> &deleteFlagView,
-			bool invert
-		) :  DeleteFlagged<U>( deleteFlagView, invert), m_verticesPerFaceData( verticesPerFaceData ), m_vertexIdsData( vertexIdsData )
+	std::vector<std::pair<PrimitiveVariable *, const std::vector<int> *>> toReorder;
+	for( auto &[name, variable] : variables )
+	{
+		if( const std::vector<int> *e = elements( variable.interpolation ) )
 		{
-			const std::vector<int> *vertexIds = nullptr;
-			if( m_vertexIdsData )
-			{
-				vertexIds = &m_vertexIdsData->readable();
-			}
-			const std::vector<int> &verticesPerFace = m_verticesPerFaceData->readable();
-
-			m_usedVerticesData = new IECore::BoolVectorData();
-			std::vector<bool> &usedVertices = m_usedVerticesData->writable();
-
-			usedVertices.resize( maxVertexId, false );
-
-			size_t index = 0;
-			size_t offset = 0;
-			for( size_t f = 0; f < verticesPerFace.size(); ++f )
-			{
-				int numVerts = verticesPerFace[f];
-
-				if( this->shouldKeepPrimitive( f ) )
-				{
-					for( int v = 0; v < numVerts; ++v )
-					{
-						index = vertexIds ? (*vertexIds)[offset + v] : offset + v;
-						usedVertices[index] = true;
-					}
-				}
-				offset += numVerts;
-			}
-
-			m_remappingData = new IECore::IntVectorData();
-			std::vector<int> &remapping = m_remappingData->writable();
-
-			// again this array is too large but large enough
-			remapping.resize( maxVertexId, -1 );
-
-			size_t newIndex = 0;
-			for( size_t i = 0; i < usedVertices.size(); ++i )
-			{
-				if( usedVertices[i] )
-				{
-					remapping[i] = newIndex;
-					newIndex++;
-				}
-			}
+			toReorder.push_back( { &variable, e } );
 		}
+	}
 
-		template<typename T, template<typename> class V>
-		IndexedData operator()(const V<std::vector<T> > *data )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, toReorder.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
 		{
-			const std::vector<bool> &usedVertices = m_usedVerticesData->readable();
-			const std::vector<T> &vertices = data->readable();
-
-			IndexedPrimitiveVariableBuilder<T, V> builder( vertices.size(), this->m_dataIndices ? this->m_dataIndices->size() : 0, data );
-			IECoreScene::PrimitiveVariable::IndexedView<T> dataView( vertices, this->m_dataIndices );
-
-			for( size_t v = 0; v < dataView.size(); ++v )
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				if( usedVertices[v] )
+				auto &[variable, e] = toReorder[i];
+				const ReorderedElements reorderedElements( *e, canceller );
+				if( variable->indices )
+				{
+					variable->indices = IECore::runTimeCast<IECore::IntVectorData>( reorderedElements( variable->indices.get() ) );
+				}
+				else
 				{
-					builder.addIndexedValue(dataView, v);
+					variable->data = IECore::dispatch( variable->data.get(), reorderedElements );
 				}
 			}
+		},
+		taskGroupContext
+	);
+}
 
-			return builder.indexedData();
-		}
-
-		IndexedData operator()( const IECore::Data *data )
-		{
-			throw IECore::Exception(
-				fmt::format( "Unexpected Data: {}", ( data ? data->typeName() : std::string( "nullptr" ) ) )
-			);
-		}
-
-		IECore::ConstIntVectorDataPtr getRemapping() const
-		{
-			return m_remappingData;
-		}
-
-	private:
-		IECore::ConstIntVectorDataPtr m_verticesPerFaceData;
-		IECore::ConstIntVectorDataPtr m_vertexIdsData;
-
-		IECore::BoolVectorDataPtr m_usedVerticesData;
-
-		// map from old vertex index to new
-		IECore::IntVectorDataPtr m_remappingData;
-};
+/// Returns a function which returns true for the primitives which should be
+/// kept, given a flag for each primitive marking it for deletion.
+template<typename U>
+auto keepUnflagged( const PrimitiveVariable::IndexedView<U> &deleteFlagView, bool invert )
+{
+	return [&deleteFlagView, invert]( size_t i ) {
+		return static_cast<bool>( deleteFlagView[i] ) == invert;
+	};
+}
 
 } // PrimitiveVariableAlgos
 
@@ -53,7 +53,10 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "Imath/ImathBox.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace IECoreVDB
 {
@@ -76,6 +79,14 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 		openvdb::GridBase::ConstPtr findGrid( const std::string &name ) const;
 		openvdb::GridBase::Ptr findGrid( const std::string &name );
 
+		//! Returns the portion of the named grid which intersects the world-space
+		//! `bound`. If the grid has not yet been loaded from file, only the leaf
+		//! nodes intersecting the bound are read. If it has been loaded and the
+		//! bound contains all its active voxels, the grid itself is returned.
+		//! Otherwise the result is cached so that subsequent queries for the
+		//! same region are cheap. Returns null if the grid doesn't exist.
+		openvdb::GridBase::ConstPtr findGrid( const std::string &name, const Imath::Box3f &bound ) const;
+
 		std::vector<std::string> gridNames() const;
 
 		Imath::Box3f bound() const override;
@@ -112,6 +123,8 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 
 			std::unique_ptr<openvdb::io::File> file;
 			std::recursive_mutex mutex;
+			// Identifies the file contents by name, modification time and size.
+			IECore::MurmurHash hash;
 		};
 
 		class HashedGrid
@@ -123,13 +136,15 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 
 				HashedGrid( openvdb::GridBase::Ptr grid, std::shared_ptr<LockedFile> file )
 					: m_grid( grid ),
-					m_hashValid( false ), m_lockedFile( file )
+					m_hashValid( false ), m_lockedFile( file ), m_clippedGrids( std::make_shared<ClippedGrids>() )
 				{
 				}
 
 				IECore::MurmurHash hash() const;
 				openvdb::GridBase::Ptr metadata() const;
 				openvdb::GridBase::Ptr grid() const;
+				openvdb::GridBase::ConstPtr clippedGrid( const Imath::Box3f &bound ) const;
+				void memoryUsage( IECore::Object::MemoryAccumulator &acc ) const;
 				bool unmodifiedFromFile() const;
 				void markedAsEdited();
 
@@ -139,6 +154,16 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 				mutable IECore::MurmurHash m_hash;
 
 				mutable std::shared_ptr<LockedFile> m_lockedFile;
+
+				// Regions partially loaded from file by `clippedGrid()`. These are
+				// owned by a shared cache, but are included in `memoryUsage()` for
+				// as long as they remain alive.
+				struct ClippedGrids
+				{
+					std::mutex mutex;
+					std::vector<std::weak_ptr<const openvdb::GridBase>> grids;
+				};
+				std::shared_ptr<ClippedGrids> m_clippedGrids;
 		};
 
 		std::unordered_map<std::string, HashedGrid> m_grids;
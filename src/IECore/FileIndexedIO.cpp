@@ -104,6 +104,10 @@ FileIndexedIO::StreamFile::StreamFile( const std::string &filename, IndexedIO::O
 				throw IOException( "FileIndexedIO: Cannot open '" + filename + "' for read " );
 			}
 
+			/// If nothing is modified, the index won't be flushed, and we must
+			/// not truncate the file on closing.
+			m_endPosition = fs::file_size( filename );
+
 			try
 			{
 				setInput( f, false, filename);
@@ -86,6 +86,9 @@ MemoryIndexedIO::StreamFile::StreamFile( const char *buf, size_t size, IndexedIO
 			/// Read existing file
 			std::stringstream *f = new std::stringstream( std::string(buf, size), std::ios::binary | std::ios::in | std::ios::out );
 			setInput( f, false, "" );
+			/// If nothing is modified, the index won't be flushed, and the
+			/// buffer must be returned intact.
+			m_endPosition = size;
 		}
 	}
 	else
@@ -849,6 +849,10 @@ class DirectoryNode : public NodeBase
 		// Indicates to this Directory that it's contents have been retrieved from the subindex.
 		void recoveredSubIndex();
 
+		// Indicates to this Directory that it's contents will be modified, and must be saved
+		// again rather than referring to the previous subindex. Used in Append mode only.
+		void reopenedSubIndex();
+
 	protected :
 
 		char m_subindex;	// using char instead of enum to compact members in one word
@@ -1064,6 +1068,12 @@ class StreamIndexedIO::Index : public RefCounted
 		/// read the subindex that contains the children of the given node
 		void readNodeFromSubIndex( DirectoryNode *n );
 
+		/// Prepares the given directory node for modification. In Append mode, directories
+		/// that were previously committed to a subindex are loaded and reopened, along with
+		/// all their ancestors, so that they will be saved again in the new index. In other
+		/// modes, committed directories are read-only and an exception is thrown.
+		void makeWritable( DirectoryNode *n );
+
 		typedef tbb::spin_rw_mutex Mutex;
 		typedef Mutex::scoped_lock MutexLock;
 		/// Returns an appropriate mutex scoped lock to access the given Directory node.
@@ -1103,6 +1113,13 @@ class StreamIndexedIO::Index : public RefCounted
 		uint64_t m_offset;
 		uint64_t m_next;
 
+		/// In Append mode, the region of the file occupied by the index we opened.
+		/// It is only recorded as free space once the new index has been written.
+		/// Note that this doesn't make appending atomic : the index is located via
+		/// the end of the file, so the file is only valid again once it is closed.
+		uint64_t m_previousIndexOffset;
+		uint64_t m_previousIndexSize;
+
 		// only used on Version <= 4
 		typedef std::vector< NodeBase* > IndexToNodeMap;
 		IndexToNodeMap m_indexToNodeMap;
@@ -1296,6 +1313,12 @@ void DirectoryNode::recoveredSubIndex()
 	m_subindex = DirectoryNode::LoadedSubIndex;
 }
 
+void DirectoryNode::reopenedSubIndex()
+{
+	assert( m_subindex == DirectoryNode::LoadedSubIndex );
+	m_subindex = DirectoryNode::NoSubIndex;
+}
+
 
 ///////////////////////////////////////////////
 //
@@ -1407,10 +1430,7 @@ bool StreamIndexedIO::Node::dataChildInfo( const IndexedIO::EntryID &name, Info
 
 DirectoryNode* StreamIndexedIO::Node::addChild( const IndexedIO::EntryID &childName )
 {
-	if ( m_node->subindex() )
-	{
-		throw Exception( "Cannot modify the file at current location! It was already committed to the file." );
-	}
+	m_idx->makeWritable( m_node );
 
 	if ( hasChild(childName) )
 	{
@@ -1441,10 +1461,7 @@ void StreamIndexedIO::Node::addDataChild(
 	size_t numCompressedBlocks
 )
 {
-	if ( m_node->subindex() )
-	{
-		throw Exception( "Cannot modify the file at current location! It was already committed to the file." );
-	}
+	m_idx->makeWritable( m_node );
 
 	if ( hasChild(childName) )
 	{
@@ -1562,6 +1579,8 @@ StreamIndexedIO::Index::Index( StreamIndexedIO::StreamFilePtr stream, const Comp
 	m_hasChanged( false ),
 	m_offset( 0 ),
 	m_next( 0 ),
+	m_previousIndexOffset( 0 ),
+	m_previousIndexSize( 0 ),
 	m_stream( stream ), m_compressionLevel( 0 ),
 	m_compressionThreadCount(1),
 	m_decompressionThreadCount(1), m_compressor( "lz4" )
@@ -1737,6 +1756,17 @@ void StreamIndexedIO::Index::openStream()
 		{
 			read( f );
 		}
+
+		if ( m_stream->openMode() & IndexedIO::Append )
+		{
+			// Rather than writing new data over the existing index, we write it after
+			// the end of the file, and free the existing index once the new one has
+			// been written. `m_next` may have been brought back before the index
+			// by trailing free pages, in which case we retain those too.
+			m_previousIndexOffset = m_next;
+			m_previousIndexSize = fileLen - m_next;
+			m_next = fileLen;
+		}
 	}
 	else
 	{
@@ -2267,7 +2297,7 @@ uint64_t StreamIndexedIO::Index::write()
 	writeNode( m_root, indexOutStream );
 
 	assert( m_freePagesOffset.size() == m_freePagesSize.size() );
-	uint64_t numFreePages = m_freePagesSize.size();
+	uint64_t numFreePages = m_freePagesSize.size() + ( m_previousIndexSize ? 1 : 0 );
 
 	// Write out number of free "pages"
 	writeLittleEndian( indexOutStream, numFreePages);
@@ -2279,6 +2309,13 @@ uint64_t StreamIndexedIO::Index::write()
 		writeLittleEndian( indexOutStream, it->second->m_size );
 	}
 
+	/// The previous index is free space as far as the new index is concerned
+	if ( m_previousIndexSize )
+	{
+		writeLittleEndian( indexOutStream, m_previousIndexOffset );
+		writeLittleEndian( indexOutStream, m_previousIndexSize );
+	}
+
 	/// To synchronize/close, etc.
 	indexOutStream.pop();
 
@@ -2302,7 +2339,17 @@ uint64_t StreamIndexedIO::Index::write()
 
 	m_hasChanged = false;
 
-	return f.tellp();
+	uint64_t end = f.tellp();
+
+	if ( m_previousIndexSize )
+	{
+		// now that the new index is in place, the space used by
+		// the previous one can be reused by further writes.
+		addFreePage( m_previousIndexOffset, m_previousIndexSize );
+		m_previousIndexSize = 0;
+	}
+
+	return end;
 }
 
 uint64_t StreamIndexedIO::Index::allocate( uint64_t sz )
@@ -2705,6 +2752,34 @@ void StreamIndexedIO::Index::readNodeFromSubIndex( DirectoryNode *n )
 	n->recoveredSubIndex();
 }
 
+void StreamIndexedIO::Index::makeWritable( DirectoryNode *n )
+{
+	if ( n->subindex() == DirectoryNode::NoSubIndex )
+	{
+		return;
+	}
+
+	if ( !( m_stream->openMode() & IndexedIO::Append ) )
+	{
+		throw Exception( "Cannot modify the file at current location! It was already committed to the file." );
+	}
+
+	// We don't deallocate the block holding the subindex, because identical subindexes
+	// are shared between directories, and other directories may still refer to it.
+	// As a result, each append that modifies a committed directory increases the
+	// file size by the size of its previous subindex.
+
+	// the parent refers to our subindex, so it must be saved again too
+	if ( n->parent() )
+	{
+		makeWritable( n->parent() );
+	}
+
+	readNodeFromSubIndex( n );
+	n->reopenedSubIndex();
+	m_hasChanged = true;
+}
+
 void StreamIndexedIO::Index::lockDirectory( MutexLock &lock, const DirectoryNode *n, bool writeAccess ) const
 {
 	if ( n->subindexChildren() )
@@ -2884,11 +2959,6 @@ void StreamIndexedIO::open( StreamFilePtr file, const IndexedIO::EntryIDList &ro
 	newIndex->openStream();
 	m_node = new StreamIndexedIO::Node( newIndex.get(), newIndex->root() );
 	setRoot( root );
-
-	// \todo Currently in Append mode, the nodes lazily loaded will not be editable.
-	// In order to fully support it, we should probably read all indexes in memory,
-	// deallocate their data blocks, mark Index as changed and force saving all of
-	// the nodes in the main index, or commit them backwardly.
 }
 
 StreamIndexedIO::~StreamIndexedIO()
@@ -3064,10 +3134,7 @@ void StreamIndexedIO::removeAll( )
 {
 	assert( m_node );
 
-	if ( m_node->m_node->subindex() )
-	{
-		throw Exception( "Cannot modify the file at current location! It was already committed to the file." );
-	}
+	m_node->m_idx->makeWritable( m_node->m_node );
 
 	IndexedIO::EntryIDList names;
 	m_node->childNames( names );
@@ -3082,10 +3149,7 @@ void StreamIndexedIO::remove( const IndexedIO::EntryID &name, bool throwIfNonExi
 	assert( m_node );
 	writable(name);
 
-	if ( m_node->m_node->subindex() )
-	{
-		throw Exception( "Cannot modify the file at current location! It was already committed to the file." );
-	}
+	m_node->m_idx->makeWritable( m_node->m_node );
 
 	m_node->removeChild( name, throwIfNonExistent );
 }
@@ -36,6 +36,8 @@
 
 #include "IECorePython/BoundedKDTreeBinding.h"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "IECore/BoundedKDTree.h"
 #include "IECore/RefCounted.h"
 #include "IECore/TypedData.h"
@@ -107,6 +109,31 @@ struct BoundedKDTreeWrapper
 
 	}
 
+	template<typename S>
+	tuple batchIntersectingBounds( const TypedData<std::vector<S>> *b )
+	{
+		assert(m_tree);
+
+		std::vector<size_t> offsets;
+		std::vector<typename T::Iterator> bounds;
+		{
+			IECorePython::ScopedGILRelease gilRelease;
+			m_tree->intersectingBounds( b->readable(), offsets, bounds );
+		}
+
+		IntVectorDataPtr offsetsData = new IntVectorData();
+		offsetsData->writable().insert( offsetsData->writable().end(), offsets.begin(), offsets.end() );
+
+		IntVectorDataPtr indices = new IntVectorData();
+		indices->writable().reserve( bounds.size() );
+		for( const auto &it : bounds )
+		{
+			indices->writable().push_back( std::distance( m_bounds->readable().begin(), it ) );
+		}
+
+		return make_tuple( offsetsData, indices );
+	}
+
 };
 
 
@@ -117,6 +144,8 @@ void bindBoundedKDTree(const char *bindName)
 		.def(init< typename BoundedKDTreeWrapper<T>::BoundDataPtr >() )
 		.def("intersectingBounds", &BoundedKDTreeWrapper<T>::template intersectingBounds<typename T::Bound> )
 		.def("intersectingBounds", &BoundedKDTreeWrapper<T>::template intersectingBounds<typename T::BaseType> )
+		.def("intersectingBounds", &BoundedKDTreeWrapper<T>::template batchIntersectingBounds<typename T::Bound> )
+		.def("intersectingBounds", &BoundedKDTreeWrapper<T>::template batchIntersectingBounds<typename T::BaseType> )
 	;
 
 }
@@ -38,6 +38,8 @@
 
 #include "IECorePython/KDTreeBinding.h"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "IECore/KDTree.h"
 #include "IECore/RefCounted.h"
 #include "IECore/TypedData.h"
@@ -75,10 +77,10 @@ struct KDTreeWrapper
 
 	PointDataPtr m_points;
 
-	KDTreeWrapper(PointDataPtr points)
+	KDTreeWrapper(PointDataPtr points, bool contiguousPoints)
 	{
 		m_points = points->copy();
-		m_tree = new T(m_points->readable().begin(), m_points->readable().end());
+		m_tree = new T(m_points->readable().begin(), m_points->readable().end(), 4, contiguousPoints);
 	}
 
 	virtual ~KDTreeWrapper()
@@ -142,6 +144,68 @@ struct KDTreeWrapper
 
 	}
 
+	IntVectorDataPtr batchNearestNeighbour( const PointData *points )
+	{
+		assert(m_tree);
+
+		std::vector<typename T::Iterator> nearest;
+		{
+			IECorePython::ScopedGILRelease gilRelease;
+			m_tree->nearestNeighbour( points->readable(), nearest );
+		}
+
+		IntVectorDataPtr indices = new IntVectorData();
+		indices->writable().reserve( nearest.size() );
+		for( const auto &it : nearest )
+		{
+			indices->writable().push_back( std::distance( m_points->readable().begin(), it ) );
+		}
+
+		return indices;
+	}
+
+	tuple batchNearestNeighbours( const PointData *points, typename T::Point::BaseType r )
+	{
+		assert(m_tree);
+
+		std::vector<size_t> offsets;
+		std::vector<typename T::Iterator> neighbours;
+		{
+			IECorePython::ScopedGILRelease gilRelease;
+			m_tree->nearestNeighbours( points->readable(), r, offsets, neighbours );
+		}
+
+		IntVectorDataPtr indices = new IntVectorData();
+		indices->writable().reserve( neighbours.size() );
+		for( const auto &it : neighbours )
+		{
+			indices->writable().push_back( std::distance( m_points->readable().begin(), it ) );
+		}
+
+		return make_tuple( offsetsData( offsets ), indices );
+	}
+
+	tuple batchNearestNNeighbours( const PointData *points, unsigned int numNeighbours )
+	{
+		assert(m_tree);
+
+		std::vector<size_t> offsets;
+		std::vector<typename T::Neighbour> neighbours;
+		{
+			IECorePython::ScopedGILRelease gilRelease;
+			m_tree->nearestNNeighbours( points->readable(), numNeighbours, offsets, neighbours );
+		}
+
+		IntVectorDataPtr indices = new IntVectorData();
+		indices->writable().reserve( neighbours.size() );
+		for( const auto &n : neighbours )
+		{
+			indices->writable().push_back( std::distance( m_points->readable().begin(), n.point ) );
+		}
+
+		return make_tuple( offsetsData( offsets ), indices );
+	}
+
 	IntVectorDataPtr enclosedPoints( const Box &bound )
 	{
 		typedef std::vector<typename T::Iterator> PointArray;
@@ -162,6 +226,15 @@ struct KDTreeWrapper
 		return indices;
 	}
 
+	private :
+
+		static IntVectorDataPtr offsetsData( const std::vector<size_t> &offsets )
+		{
+			IntVectorDataPtr result = new IntVectorData();
+			result->writable().insert( result->writable().end(), offsets.begin(), offsets.end() );
+			return result;
+		}
+
 };
 
 
@@ -169,10 +242,13 @@ template<typename T>
 void bindKDTree(const char *bindName)
 {
 	class_<KDTreeWrapper<T>, boost::noncopyable>(bindName, no_init)
-		.def(init< typename KDTreeWrapper<T>::PointDataPtr >() )
+		.def(init< typename KDTreeWrapper<T>::PointDataPtr, bool >( ( arg( "points" ), arg( "contiguousPoints" ) = false ) ) )
 		.def("nearestNeighbour", &KDTreeWrapper<T>::nearestNeighbour )
 		.def("nearestNeighbours", &KDTreeWrapper<T>::nearestNeighbours )
 		.def("nearestNNeighbours", &KDTreeWrapper<T>::nearestNNeighbours )
+		.def("nearestNeighbour", &KDTreeWrapper<T>::batchNearestNeighbour )
+		.def("nearestNeighbours", &KDTreeWrapper<T>::batchNearestNeighbours )
+		.def("nearestNNeighbours", &KDTreeWrapper<T>::batchNearestNNeighbours )
 		.def("enclosedPoints", &KDTreeWrapper<T>::enclosedPoints )
 		;
 }
@@ -0,0 +1,446 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECoreScene/private/BoundingVolumeHierarchy.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/concurrent_vector.h"
+#include "tbb/parallel_for.h"
+
+#include <utility>
+
+using namespace Imath;
+using namespace IECoreScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const int g_numBins = 16;
+// Ranges no larger than this are never split, since testing the boxes
+// individually costs little more than testing the node that would hold them.
+const int g_minLeafSize = 4;
+// Ranges larger than this are always split.
+const int g_maxLeafSize = 8;
+// Beyond this depth we stop using the SAH and split at the median, to
+// bound the depth of the hierarchy for degenerate inputs.
+const int g_maxSAHDepth = 40;
+// Ranges smaller than this are built serially.
+const int g_parallelThreshold = 4096;
+
+// Half the surface area of a box, which is all we need to compare costs.
+float halfArea( const Box3f &b )
+{
+	if( b.isEmpty() )
+	{
+		return 0.0f;
+	}
+	const V3f s = b.size();
+	return s.x * s.y + s.y * s.z + s.z * s.x;
+}
+
+struct Range
+{
+	int begin;
+	int end;
+	Box3f bound;
+	Box3f centroidBound;
+};
+
+// The builder partitions copies of the input bounds rather than indices
+// into them, so that all its passes access memory sequentially.
+struct Reference
+{
+	Box3f bound;
+	int index;
+};
+
+struct Bin
+{
+	int count = 0;
+	Box3f bound;
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Builder
+//////////////////////////////////////////////////////////////////////////
+
+class BoundingVolumeHierarchy::Builder
+{
+
+	public :
+
+		Builder( BoundingVolumeHierarchy &bvh, const std::vector<Box3f> &bounds )
+			:	m_bvh( bvh ), m_references( bounds.size() )
+		{
+			const int numBounds = bounds.size();
+			Box3f centroidBound;
+			for( int i = 0; i < numBounds; ++i )
+			{
+				m_references[i] = { bounds[i], i };
+				m_bvh.m_bound.extendBy( bounds[i] );
+				centroidBound.extendBy( bounds[i].center() );
+			}
+
+			if( !numBounds )
+			{
+				return;
+			}
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+			m_nodes.grow_by( 1 );
+			const Range root = { 0, numBounds, m_bvh.m_bound, centroidBound };
+			Range children[2];
+			if( split( root, 0, children[0], children[1] ) )
+			{
+				buildNode( 0, children, 2, 0, taskGroupContext );
+			}
+			else
+			{
+				setLeaf( m_nodes[0], 0, root );
+			}
+
+			m_bvh.m_nodes.assign( m_nodes.begin(), m_nodes.end() );
+			m_bvh.m_indices.resize( numBounds );
+			for( int i = 0; i < numBounds; ++i )
+			{
+				m_bvh.m_indices[i] = m_references[i].index;
+			}
+		}
+
+	private :
+
+		// Fills in node `nodeIndex`, starting from `initialChildren` and
+		// splitting the largest children until there are four.
+		void buildNode( int nodeIndex, const Range *initialChildren, int numInitialChildren, int depth, tbb::task_group_context &taskGroupContext )
+		{
+			Range children[4];
+			bool isLeaf[4] = { false, false, false, false };
+			int numChildren = std::copy( initialChildren, initialChildren + numInitialChildren, children ) - children;
+
+			while( numChildren < 4 )
+			{
+				int largest = -1;
+				float largestArea = -1.0f;
+				for( int i = 0; i < numChildren; ++i )
+				{
+					const float area = halfArea( children[i].bound );
+					if( !isLeaf[i] && area > largestArea )
+					{
+						largest = i;
+						largestArea = area;
+					}
+				}
+
+				if( largest == -1 )
+				{
+					break;
+				}
+
+				if( !split( children[largest], depth, children[largest], children[numChildren] ) )
+				{
+					isLeaf[largest] = true;
+				}
+				else
+				{
+					++numChildren;
+				}
+			}
+
+			// Build the remaining interior children, in parallel if they
+			// are big enough to be worth it.
+
+			auto buildChild = [&]( int i ) {
+				Node &node = m_nodes[nodeIndex];
+				Range grandchildren[2];
+				if( isLeaf[i] || !split( children[i], depth + 1, grandchildren[0], grandchildren[1] ) )
+				{
+					setLeaf( node, i, children[i] );
+					return;
+				}
+
+				const int childIndex = m_nodes.grow_by( 1 ) - m_nodes.begin();
+				setBound( node, i, children[i].bound );
+				node.first[i] = childIndex;
+				node.count[i] = 0;
+				buildNode( childIndex, grandchildren, 2, depth + 1, taskGroupContext );
+			};
+
+			int size = 0;
+			for( int i = 0; i < numChildren; ++i )
+			{
+				size += children[i].end - children[i].begin;
+			}
+
+			if( size < g_parallelThreshold )
+			{
+				for( int i = 0; i < numChildren; ++i )
+				{
+					buildChild( i );
+				}
+			}
+			else
+			{
+				tbb::parallel_for(
+					tbb::blocked_range<int>( 0, numChildren, 1 ),
+					[&]( const tbb::blocked_range<int> &range )
+					{
+						for( int i = range.begin(); i != range.end(); ++i )
+						{
+							buildChild( i );
+						}
+					},
+					taskGroupContext
+				);
+			}
+		}
+
+		// Partitions `range` into `left` and `right`, returning false if
+		// it is better left as a leaf. It is safe for `left` to alias `range`.
+		bool split( const Range &range, int depth, Range &left, Range &right )
+		{
+			std::vector<Reference> &references = m_references;
+			const int begin = range.begin;
+			const int end = range.end;
+			const int count = end - begin;
+			if( count <= g_minLeafSize )
+			{
+				return false;
+			}
+
+			const Box3f centroidBound = range.centroidBound;
+			V3f scale( 0.0f );
+			bool binnable = false;
+			for( int axis = 0; axis < 3; ++axis )
+			{
+				const float extent = centroidBound.max[axis] - centroidBound.min[axis];
+				if( extent > 0.0f && depth < g_maxSAHDepth )
+				{
+					scale[axis] = g_numBins / extent;
+					binnable = true;
+				}
+			}
+
+			// Find the lowest cost split between the bins on any axis. All
+			// axes are binned in a single pass, since the cost is dominated
+			// by fetching the bounds.
+
+			float bestCost = std::numeric_limits<float>::max();
+			int bestAxis = -1;
+			int bestBin = -1;
+
+			if( binnable )
+			{
+				Bin bins[3][g_numBins];
+				for( int i = begin; i < end; ++i )
+				{
+					const Box3f &bound = references[i].bound;
+					const V3f centroid = bound.center();
+					for( int axis = 0; axis < 3; ++axis )
+					{
+						if( scale[axis] > 0.0f )
+						{
+							Bin &bin = bins[axis][binIndex( centroid[axis], centroidBound.min[axis], scale[axis] )];
+							bin.count++;
+							bin.bound.extendBy( bound );
+						}
+					}
+				}
+
+				for( int axis = 0; axis < 3; ++axis )
+				{
+					if( !( scale[axis] > 0.0f ) )
+					{
+						continue;
+					}
+
+					float rightAreas[g_numBins];
+					int rightCounts[g_numBins];
+					Box3f accumulatedBound;
+					int accumulatedCount = 0;
+					for( int b = g_numBins - 1; b > 0; --b )
+					{
+						accumulatedBound.extendBy( bins[axis][b].bound );
+						accumulatedCount += bins[axis][b].count;
+						rightAreas[b] = halfArea( accumulatedBound );
+						rightCounts[b] = accumulatedCount;
+					}
+
+					accumulatedBound.makeEmpty();
+					accumulatedCount = 0;
+					for( int b = 1; b < g_numBins; ++b )
+					{
+						accumulatedBound.extendBy( bins[axis][b-1].bound );
+						accumulatedCount += bins[axis][b-1].count;
+						if( !accumulatedCount || !rightCounts[b] )
+						{
+							continue;
+						}
+
+						const float cost = halfArea( accumulatedBound ) * accumulatedCount + rightAreas[b] * rightCounts[b];
+						if( cost < bestCost )
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestBin = b;
+						}
+					}
+				}
+			}
+
+			Range l = { begin, begin, Box3f(), Box3f() };
+			Range r = { begin, end, Box3f(), Box3f() };
+
+			if( bestAxis != -1 )
+			{
+				// Compare with the cost of a leaf, taking the cost of traversing
+				// a node to be the same as that of testing a box.
+				const float area = halfArea( range.bound );
+				if( count <= g_maxLeafSize && ( !( area > 0.0f ) || 1.0f + bestCost / area >= count ) )
+				{
+					return false;
+				}
+
+				// Partition, accumulating the bounds of each side as we go.
+				int i = begin;
+				int j = end - 1;
+				while( i <= j )
+				{
+					const Box3f &bound = references[i].bound;
+					const V3f centroid = bound.center();
+					if( binIndex( centroid[bestAxis], centroidBound.min[bestAxis], scale[bestAxis] ) < bestBin )
+					{
+						l.bound.extendBy( bound );
+						l.centroidBound.extendBy( centroid );
+						++i;
+					}
+					else
+					{
+						r.bound.extendBy( bound );
+						r.centroidBound.extendBy( centroid );
+						std::swap( references[i], references[j] );
+						--j;
+					}
+				}
+				l.end = r.begin = i;
+			}
+			else
+			{
+				// Either the centroids are coincident, or we're too deep
+				// to trust the SAH. Split at the median of the longest axis.
+				if( count <= g_maxLeafSize )
+				{
+					return false;
+				}
+
+				const int middle = begin + count / 2;
+				const int axis = centroidBound.majorAxis();
+				std::nth_element(
+					references.begin() + begin, references.begin() + middle, references.begin() + end,
+					[axis]( const Reference &a, const Reference &b ) {
+						return a.bound.center()[axis] < b.bound.center()[axis];
+					}
+				);
+
+				for( int i = begin; i < end; ++i )
+				{
+					const Box3f &bound = references[i].bound;
+					Range &side = i < middle ? l : r;
+					side.bound.extendBy( bound );
+					side.centroidBound.extendBy( bound.center() );
+				}
+				l.end = r.begin = middle;
+			}
+
+			left = l;
+			right = r;
+			return true;
+		}
+
+		static int binIndex( float x, float min, float scale )
+		{
+			return std::min( g_numBins - 1, static_cast<int>( ( x - min ) * scale ) );
+		}
+
+		static void setBound( Node &node, int i, const Box3f &bound )
+		{
+			node.minX[i] = bound.min.x;
+			node.minY[i] = bound.min.y;
+			node.minZ[i] = bound.min.z;
+			node.maxX[i] = bound.max.x;
+			node.maxY[i] = bound.max.y;
+			node.maxZ[i] = bound.max.z;
+		}
+
+		static void setLeaf( Node &node, int i, const Range &range )
+		{
+			setBound( node, i, range.bound );
+			node.first[i] = range.begin;
+			node.count[i] = range.end - range.begin;
+		}
+
+		BoundingVolumeHierarchy &m_bvh;
+		std::vector<Reference> m_references;
+		// Nodes are allocated concurrently during construction, and
+		// copied into `m_bvh.m_nodes` at the end.
+		tbb::concurrent_vector<Node> m_nodes;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// BoundingVolumeHierarchy
+//////////////////////////////////////////////////////////////////////////
+
+BoundingVolumeHierarchy::Node::Node()
+{
+	for( int i = 0; i < 4; ++i )
+	{
+		minX[i] = minY[i] = minZ[i] = std::numeric_limits<float>::infinity();
+		maxX[i] = maxY[i] = maxZ[i] = -std::numeric_limits<float>::infinity();
+		first[i] = 0;
+		count[i] = -1;
+	}
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy( const std::vector<Imath::Box3f> &bounds )
+{
+	Builder builder( *this, bounds );
+}
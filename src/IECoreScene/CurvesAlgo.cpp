@@ -43,6 +43,11 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/TypeTraits.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <numeric>
+
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Imath;
@@ -101,90 +106,31 @@ Imath::Color3f evalPrimVar<Imath::Color3f>( PrimitiveEvaluator::Result *result,
 	return result->colorPrimVar( primVar );
 }
 
-
-struct  CurvesUniformToVertex
+// Returns the index of the first element of each curve for the specified
+// interpolation, followed by the total number of elements.
+std::vector<int> curveOffsets( const CurvesPrimitive *curves, PrimitiveVariable::Interpolation interpolation )
 {
-	typedef DataPtr ReturnType;
+	const size_t numCurves = curves->numCurves();
 
-	CurvesUniformToVertex( const std::vector<int> &offsets, const Canceller *canceller )	:	m_offsets( offsets ), m_canceller( canceller )
+	std::vector<int> result;
+	result.reserve( numCurves + 1 );
+	int offset = 0;
+	for( size_t i = 0; i < numCurves; ++i )
 	{
+		result.push_back( offset );
+		offset += curves->variableSize( interpolation, i );
 	}
+	result.push_back( offset );
 
-	template<typename From> ReturnType operator()( typename From::ConstPtr data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		typename From::ValueType::const_iterator srcIt = data->readable().begin();
-
-		trg.reserve( m_offsets.size() );
-
-		for ( std::vector<int>::const_iterator oIt = m_offsets.begin(); oIt != m_offsets.end(); oIt++, srcIt++ )
-		{
-			Canceller::check( m_canceller );
-			for ( int i = 0; i < *oIt; i++ )
-			{
-				trg.push_back( *srcIt );
-			}
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data.get(), result.get() );
-
-		return result;
-	}
-
-	const std::vector<int> &m_offsets;
-	const Canceller *m_canceller;
-};
-
-struct  CurvesVertexToUniform
-{
-	typedef DataPtr ReturnType;
-
-	CurvesVertexToUniform( const CurvesPrimitive *curves, const Canceller *canceller ) : m_curves( curves ), m_canceller( canceller )
-	{
-	}
-
-	template<typename From> ReturnType operator()( const From* data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		typename From::ValueType::const_iterator srcIt = data->readable().begin();
-
-		trg.reserve( m_curves->variableSize( PrimitiveVariable::Uniform ) );
-
-		const std::vector<int> &offsets = m_curves->verticesPerCurve()->readable();
-		for( std::vector<int>::const_iterator oIt = offsets.begin(); oIt != offsets.end(); ++oIt )
-		{
-			Canceller::check( m_canceller );
-			// initialize with the first value to avoid
-			// ambiguitity during default construction
-			typename From::ValueType::value_type total = *srcIt;
-			++srcIt;
-
-			for( int i = 1; i < *oIt; ++i, ++srcIt )
-			{
-				total += *srcIt;
-			}
-
-			trg.push_back( total / *oIt );
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
-
-		return result;
-	}
-
-	const CurvesPrimitive *m_curves;
-	const Canceller *m_canceller;
-};
+	return result;
+}
 
-struct  CurvesUniformToVarying
+// Copies the Uniform value of each curve to all its Vertex or Varying elements.
+struct CurvesUniformToElements
 {
 	typedef DataPtr ReturnType;
 
-	CurvesUniformToVarying( const CurvesPrimitive *curves, const Canceller *canceller ) : m_curves( curves ), m_canceller( canceller )
+	CurvesUniformToElements( const std::vector<int> &offsets, const Canceller *canceller )	:	m_offsets( offsets ), m_canceller( canceller )
 	{
 	}
 
@@ -192,20 +138,16 @@ struct  CurvesUniformToVarying
 	{
 		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
 		typename From::ValueType &trg = result->writable();
-		typename From::ValueType::const_iterator srcIt = data->readable().begin();
-
-		trg.reserve( m_curves->variableSize( PrimitiveVariable::Varying ) );
+		const typename From::ValueType &src = data->readable();
 
-		size_t numCurves = m_curves->numCurves();
-		for( size_t i = 0; i < numCurves; ++i, ++srcIt )
-		{
-			Canceller::check( m_canceller );
-			const size_t varyingSize = m_curves->variableSize( PrimitiveVariable::Varying, i );
-			for( size_t j = 0; j < varyingSize; ++j )
+		trg.resize( m_offsets.back() );
+		IECoreScene::Detail::parallelForEach(
+			m_offsets.size() - 1, m_canceller,
+			[&]( size_t curveIndex )
 			{
-				trg.push_back( *srcIt );
+				std::fill( trg.begin() + m_offsets[curveIndex], trg.begin() + m_offsets[curveIndex+1], src[curveIndex] );
 			}
-		}
+		);
 
 		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
 		copier( data.get(), result.get() );
@@ -213,15 +155,16 @@ struct  CurvesUniformToVarying
 		return result;
 	}
 
-	const CurvesPrimitive *m_curves;
+	const std::vector<int> &m_offsets;
 	const Canceller *m_canceller;
 };
 
-struct  CurvesVaryingToUniform
+// Averages the Vertex or Varying elements of each curve.
+struct CurvesElementsToUniform
 {
 	typedef DataPtr ReturnType;
 
-	CurvesVaryingToUniform( const CurvesPrimitive *curves, const Canceller *canceller ) : m_curves( curves ), m_canceller( canceller )
+	CurvesElementsToUniform( const std::vector<int> &offsets, const Canceller *canceller )	:	m_offsets( offsets ), m_canceller( canceller )
 	{
 	}
 
@@ -229,27 +172,27 @@ struct  CurvesVaryingToUniform
 	{
 		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
 		typename From::ValueType &trg = result->writable();
-		typename From::ValueType::const_iterator srcIt = data->readable().begin();
-
-		trg.reserve( m_curves->variableSize( PrimitiveVariable::Uniform ) );
+		const typename From::ValueType &src = data->readable();
 
-		size_t numCurves = m_curves->numCurves();
-		for( size_t i = 0; i < numCurves; ++i )
-		{
-			Canceller::check( m_canceller );
-			// initialize with the first value to avoid
-			// ambiguitity during default construction
-			typename From::ValueType::value_type total = *srcIt;
-			++srcIt;
-
-			const size_t varyingSize = m_curves->variableSize( PrimitiveVariable::Varying, i );
-			for( size_t j = 1; j < varyingSize; ++j, ++srcIt )
+		trg.resize( m_offsets.size() - 1 );
+		IECoreScene::Detail::parallelForEach(
+			trg.size(), m_canceller,
+			[&]( size_t curveIndex )
 			{
-				total += *srcIt;
+				const int begin = m_offsets[curveIndex];
+				const int end = m_offsets[curveIndex+1];
+
+				// initialize with the first value to avoid
+				// ambiguitity during default construction
+				typename From::ValueType::value_type total = src[begin];
+				for( int i = begin + 1; i < end; ++i )
+				{
+					total += src[i];
+				}
+
+				trg[curveIndex] = total / ( end - begin );
 			}
-
-			trg.push_back( total / varyingSize );
-		}
+		);
 
 		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
 		copier( data, result.get() );
@@ -257,15 +200,19 @@ struct  CurvesVaryingToUniform
 		return result;
 	}
 
-	const CurvesPrimitive *m_curves;
+	const std::vector<int> &m_offsets;
 	const Canceller *m_canceller;
 };
 
-struct  CurvesVertexToVarying
+// Evaluates a Vertex variable at the Varying positions of each curve,
+// or a Varying variable at the Vertex positions. This is only needed
+// for cubic curves, as the interpolations are otherwise identical.
+struct CurvesVertexVaryingResampler
 {
 	typedef DataPtr ReturnType;
 
-	CurvesVertexToVarying( const CurvesPrimitive *curves, const Canceller *canceller ) : m_curves( curves ), m_canceller( canceller )
+	CurvesVertexVaryingResampler( const CurvesPrimitive *curves, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller )
+		:	m_curves( curves ), m_toVarying( interpolation != PrimitiveVariable::Vertex ), m_offsets( curveOffsets( curves, interpolation ) ), m_canceller( canceller )
 	{
 	}
 
@@ -274,8 +221,6 @@ struct  CurvesVertexToVarying
 		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
 		typename From::ValueType &trg = result->writable();
 
-		trg.reserve( m_curves->variableSize( PrimitiveVariable::Varying ) );
-
 		const PrimitiveVariable *primVar = nullptr;
 		for( PrimitiveVariableMap::const_iterator it = m_curves->variables.begin(); it != m_curves->variables.end(); ++it )
 		{
@@ -293,22 +238,32 @@ struct  CurvesVertexToVarying
 		}
 
 		ConstCurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( m_curves );
-		PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
 
-		size_t numCurves = m_curves->numCurves();
-		for( size_t i = 0; i < numCurves; ++i )
-		{
-			Canceller::check( m_canceller );
-			size_t numSegments = m_curves->numSegments( i );
-			float step = 1.0f / numSegments;
+		trg.resize( m_offsets.back() );
 
-			const size_t varyingSize = m_curves->variableSize( PrimitiveVariable::Varying, i );
-			for( size_t j = 0; j < varyingSize; ++j )
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, m_offsets.size() - 1 ),
+			[&]( const tbb::blocked_range<size_t> &range )
 			{
-				evaluator->pointAtV( i, j * step, evaluatorResult.get() );
-				trg.push_back( evalPrimVar<typename From::ValueType::value_type>( evaluatorResult.get(), *primVar ) );
-			}
-		}
+				Canceller::check( m_canceller );
+				PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
+				for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+				{
+					// Samples are spaced by segment when evaluating at the Varying
+					// positions, and by vertex when evaluating at the Vertex positions.
+					const int begin = m_offsets[curveIndex];
+					const int end = m_offsets[curveIndex+1];
+					const float step = 1.0f / ( m_toVarying ? m_curves->numSegments( curveIndex ) : end - begin );
+					for( int j = 0; j < end - begin; ++j )
+					{
+						evaluator->pointAtV( curveIndex, j * step, evaluatorResult.get() );
+						trg[begin + j] = evalPrimVar<typename From::ValueType::value_type>( evaluatorResult.get(), *primVar );
+					}
+				}
+			},
+			taskGroupContext
+		);
 
 		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
 		copier( data, result.get() );
@@ -317,67 +272,11 @@ struct  CurvesVertexToVarying
 	}
 
 	const CurvesPrimitive *m_curves;
+	const bool m_toVarying;
+	const std::vector<int> m_offsets;
 	const Canceller *m_canceller;
 };
 
-struct CurvesVaryingToVertex
-{
-	typedef DataPtr ReturnType;
-
-	CurvesVaryingToVertex( const CurvesPrimitive *curves, const Canceller *canceller ) : m_curves( curves ), m_canceller( canceller )
-	{
-	}
-
-	template<typename From> ReturnType operator()( const From* data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-
-		trg.reserve( m_curves->variableSize( PrimitiveVariable::Vertex ) );
-
-
-		const PrimitiveVariable *primVar = nullptr;
-		for( PrimitiveVariableMap::const_iterator it = m_curves->variables.begin(); it != m_curves->variables.end(); ++it )
-		{
-			if( it->second.data->isEqualTo( data ) )
-			{
-				primVar = &it->second;
-				break;
-			}
-		}
-
-		if( !primVar )
-		{
-			return nullptr;
-		}
-
-		ConstCurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( m_curves );
-		PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
-
-		size_t numCurves = m_curves->numCurves();
-		const std::vector<int> &verticesPerCurve = evaluator->verticesPerCurve();
-		for( size_t i = 0; i < numCurves; ++i )
-		{
-			Canceller::check( m_canceller );
-			float step = 1.0f / verticesPerCurve[i];
-			for( int j = 0; j < verticesPerCurve[i]; ++j )
-			{
-				evaluator->pointAtV( i, j * step, evaluatorResult.get() );
-				trg.push_back( evalPrimVar<typename From::ValueType::value_type>( evaluatorResult.get(), *primVar ) );
-			}
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
-
-		return result;
-	}
-
-	const CurvesPrimitive *m_curves;
-	const Canceller *m_canceller;
-};
-
-
 template<typename T>
 CurvesPrimitivePtr deleteCurves(
 	const CurvesPrimitive *curvesPrimitive,
@@ -386,25 +285,24 @@ CurvesPrimitivePtr deleteCurves(
 	const Canceller *canceller
 )
 {
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedUniformFunctor<T> deleteUniformFn( deleteFlagView, invert );
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedVaryingFunctor<T> deleteVaryingFn ( deleteFlagView, curvesPrimitive, invert );
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedVertexFunctor<T> deleteVertexFn(
-		curvesPrimitive->variableSize( PrimitiveVariable::Vertex ),
-		/* vertexIds */ nullptr,
-		curvesPrimitive->verticesPerCurve(),
-		deleteFlagView,
-		invert
-	);
+	using IECoreScene::PrimitiveVariableAlgos::KeptElements;
 
-	const IECore::Data *inputVertsPerCurve = IECore::runTimeCast<const IECore::Data>( curvesPrimitive->verticesPerCurve() );
+	const std::vector<int> &inputVerticesPerCurve = curvesPrimitive->verticesPerCurve()->readable();
+	const size_t numCurves = curvesPrimitive->numCurves();
+	const auto keep = IECoreScene::PrimitiveVariableAlgos::keepUnflagged( deleteFlagView, invert );
 
-	IECoreScene::PrimitiveVariableAlgos::IndexedData outputVertsPerCurve = dispatch( inputVertsPerCurve, deleteUniformFn );
+	// The vertices of each curve are contiguous and not shared with other
+	// curves, so all interpolations can be filtered in the same way.
+	const KeptElements keptCurves( numCurves, keep, []( size_t ) { return 1; }, canceller );
+	const KeptElements keptVarying( numCurves, keep, [&]( size_t c ) { return curvesPrimitive->variableSize( PrimitiveVariable::Varying, c ); }, canceller );
+	const KeptElements keptVertices( numCurves, keep, [&]( size_t c ) { return inputVerticesPerCurve[c]; }, canceller );
 
-	IntVectorDataPtr verticesPerCurve = IECore::runTimeCast<IECore::IntVectorData>( outputVertsPerCurve.data );
+	IntVectorDataPtr verticesPerCurve = IECore::runTimeCast<IECore::IntVectorData>( keptCurves( curvesPrimitive->verticesPerCurve(), nullptr ).data );
 
 	CurvesPrimitivePtr outCurvesPrimitive = new CurvesPrimitive( verticesPerCurve.get(), curvesPrimitive->basis(), curvesPrimitive->wrap() );
 
-	for (PrimitiveVariableMap::const_iterator it = curvesPrimitive->variables.begin(), e = curvesPrimitive->variables.end(); it != e; ++it)
+	std::vector<std::pair<const std::string *, const PrimitiveVariable *>> variables;
+	for( PrimitiveVariableMap::const_iterator it = curvesPrimitive->variables.begin(), e = curvesPrimitive->variables.end(); it != e; ++it )
 	{
 		Canceller::check( canceller );
 		if( !curvesPrimitive->isPrimitiveVariableValid( it->second ) )
@@ -413,43 +311,54 @@ CurvesPrimitivePtr deleteCurves(
 				fmt::format( "CurvesAlgo::deleteCurves cannot process invalid primitive variable \"{}\"", it->first )
 			);
 		}
+		variables.push_back( { &it->first, &it->second } );
+	}
 
-		switch( it->second.interpolation )
+	// Filter the primitive variables in parallel.
+	std::vector<PrimitiveVariable> outputVariables( variables.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
 		{
-			case PrimitiveVariable::Constant:
-			case PrimitiveVariable::Invalid:
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				outCurvesPrimitive->variables[it->first] = it->second;
-				break;
-			}
-			case PrimitiveVariable::Uniform:
-			{
-				const IECore::Data *inputData = it->second.data.get();
-				deleteUniformFn.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, deleteUniformFn );
-				outCurvesPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
-
-				break;
+				const PrimitiveVariable &variable = *variables[i].second;
+				const KeptElements *keptElements = nullptr;
+				switch( variable.interpolation )
+				{
+					case PrimitiveVariable::Uniform :
+						keptElements = &keptCurves;
+						break;
+					case PrimitiveVariable::Varying :
+					case PrimitiveVariable::FaceVarying :
+						keptElements = &keptVarying;
+						break;
+					case PrimitiveVariable::Vertex :
+						keptElements = &keptVertices;
+						break;
+					case PrimitiveVariable::Constant :
+					case PrimitiveVariable::Invalid :
+						break;
+				}
+
+				if( !keptElements )
+				{
+					outputVariables[i] = variable;
+					continue;
+				}
+
+				const IECore::Data *inputData = variable.data.get();
+				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, *keptElements, variable.indices.get() );
+				outputVariables[i] = PrimitiveVariable( variable.interpolation, outputData.data, outputData.indices );
 			}
-			case PrimitiveVariable::Varying:
-			case PrimitiveVariable::FaceVarying:
-			{
-				const IECore::Data *inputData = it->second.data.get();
-				deleteVaryingFn.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, deleteVaryingFn );
-				outCurvesPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
+		},
+		taskGroupContext
+	);
 
-				break;
-			}
-			case PrimitiveVariable::Vertex:
-			{
-				const IECore::Data *inputData = it->second.data.get();
-				deleteVertexFn.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, deleteVertexFn );
-				outCurvesPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
-				break;
-			}
-		}
+	for( size_t i = 0; i < variables.size(); ++i )
+	{
+		outCurvesPrimitive->variables[*variables[i].first] = outputVariables[i];
 	}
 
 	return outCurvesPrimitive;
@@ -486,13 +395,13 @@ void resamplePrimitiveVariable( const CurvesPrimitive *curves, PrimitiveVariable
 	{
 		if( primitiveVariable.interpolation == PrimitiveVariable::Vertex && ( interpolation == PrimitiveVariable::Varying || interpolation == PrimitiveVariable::FaceVarying ) )
 		{
-			// \todo: fix CurvesVertexToVarying so it works with arbitrary PrimitiveVariables
+			// \todo: fix CurvesVertexVaryingResampler so it works with arbitrary PrimitiveVariables
 			// rather than requiring the variables exist on the input CurvesPrimitive.
 			throw InvalidArgumentException( "CurvesAlgo::resamplePrimitiveVariable : Resampling indexed Vertex variables to FaceVarying/Varying is not currently supported. Expand indices first." );
 		}
 		else if( ( primitiveVariable.interpolation == PrimitiveVariable::Varying || primitiveVariable.interpolation == PrimitiveVariable::FaceVarying ) && interpolation == PrimitiveVariable::Vertex )
 		{
-			// \todo: fix CurvesVaryingToVertex so it works with arbitrary PrimitiveVariables
+			// \todo: fix CurvesVertexVaryingResampler so it works with arbitrary PrimitiveVariables
 			// rather than requiring the variables exist on the input CurvesPrimitive.
 			throw InvalidArgumentException( "CurvesAlgo::resamplePrimitiveVariable : Resampling indexed FaceVarying/Varying variables to Vertex is not currently supported. Expand indices first." );
 		}
@@ -533,42 +442,26 @@ void resamplePrimitiveVariable( const CurvesPrimitive *curves, PrimitiveVariable
 	}
 	else if ( interpolation == PrimitiveVariable::Uniform )
 	{
-		if ( primitiveVariable.interpolation == PrimitiveVariable::Vertex )
-		{
-			CurvesVertexToUniform fn( curves, canceller );
-			dstData = despatchTypedData<CurvesVertexToUniform, Detail::IsArithmeticVectorTypedData>( const_cast< Data * >( srcData.get() ), fn );
-		}
-		else if ( primitiveVariable.interpolation == PrimitiveVariable::Varying || primitiveVariable.interpolation == PrimitiveVariable::FaceVarying )
+		if ( primitiveVariable.interpolation == PrimitiveVariable::Vertex || primitiveVariable.interpolation == PrimitiveVariable::Varying || primitiveVariable.interpolation == PrimitiveVariable::FaceVarying )
 		{
-			CurvesVaryingToUniform fn( curves, canceller );
-			dstData = despatchTypedData<CurvesVaryingToUniform, Detail::IsArithmeticVectorTypedData>( const_cast< Data * >( srcData.get() ), fn );
+			const std::vector<int> offsets = curveOffsets( curves, primitiveVariable.interpolation );
+			CurvesElementsToUniform fn( offsets, canceller );
+			dstData = despatchTypedData<CurvesElementsToUniform, Detail::IsArithmeticVectorTypedData>( const_cast< Data * >( srcData.get() ), fn );
 		}
 	}
-	else if ( interpolation == PrimitiveVariable::Vertex )
+	else if ( primitiveVariable.interpolation == PrimitiveVariable::Uniform )
 	{
-		if ( primitiveVariable.interpolation == PrimitiveVariable::Uniform )
-		{
-			CurvesUniformToVertex fn( curves->verticesPerCurve()->readable(), canceller );
-			dstData = despatchTypedData<CurvesUniformToVertex, TypeTraits::IsNumericBasedVectorTypedData>( const_cast< Data * >( srcData.get() ), fn );
-		}
-		else if ( primitiveVariable.interpolation == PrimitiveVariable::Varying || primitiveVariable.interpolation == PrimitiveVariable::FaceVarying )
-		{
-			CurvesVaryingToVertex fn( curves, canceller );
-			dstData = despatchTypedData<CurvesVaryingToVertex, IsPrimitiveEvaluatableTypedData>( const_cast< Data * >( srcData.get() ), fn );
-		}
+		const std::vector<int> offsets = curveOffsets( curves, interpolation );
+		CurvesUniformToElements fn( offsets, canceller );
+		dstData = despatchTypedData<CurvesUniformToElements, TypeTraits::IsNumericBasedVectorTypedData>( const_cast< Data * >( srcData.get() ), fn );
 	}
-	else if ( interpolation == PrimitiveVariable::Varying || interpolation == PrimitiveVariable::FaceVarying )
+	else if (
+		( interpolation == PrimitiveVariable::Vertex && ( primitiveVariable.interpolation == PrimitiveVariable::Varying || primitiveVariable.interpolation == PrimitiveVariable::FaceVarying ) ) ||
+		( ( interpolation == PrimitiveVariable::Varying || interpolation == PrimitiveVariable::FaceVarying ) && primitiveVariable.interpolation == PrimitiveVariable::Vertex )
+	)
 	{
-		if ( primitiveVariable.interpolation == PrimitiveVariable::Uniform )
-		{
-			CurvesUniformToVarying fn( curves, canceller );
-			dstData = despatchTypedData<CurvesUniformToVarying, TypeTraits::IsNumericBasedVectorTypedData>( const_cast< Data * >( srcData.get()), fn );
-		}
-		else if ( primitiveVariable.interpolation == PrimitiveVariable::Vertex )
-		{
-			CurvesVertexToVarying fn( curves, canceller );
-			dstData = despatchTypedData<CurvesVertexToVarying, IsPrimitiveEvaluatableTypedData>( const_cast< Data * >( srcData.get() ), fn );
-		}
+		CurvesVertexVaryingResampler fn( curves, interpolation, canceller );
+		dstData = despatchTypedData<CurvesVertexVaryingResampler, IsPrimitiveEvaluatableTypedData>( const_cast< Data * >( srcData.get() ), fn );
 	}
 
 	if( primitiveVariable.indices )
@@ -616,5 +509,83 @@ CurvesPrimitivePtr deleteCurves( const CurvesPrimitive *curvesPrimitive, const P
 
 }
 
+void reorderForLocality( CurvesPrimitive *curves, const std::string &position, const Canceller *canceller )
+{
+	const V3fVectorData *positionData = curves->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !positionData )
+	{
+		throw InvalidArgumentException( fmt::format( "CurvesAlgo::reorderForLocality : CurvesPrimitive has no Vertex \"{}\" primitive variable.", position ) );
+	}
+
+	const std::vector<V3f> &positions = positionData->readable();
+	const std::vector<int> vertexOffsets = curveOffsets( curves, PrimitiveVariable::Vertex );
+	const std::vector<int> varyingOffsets = curveOffsets( curves, PrimitiveVariable::Varying );
+	const size_t numCurves = curves->numCurves();
+
+	std::vector<V3f> centroids( numCurves );
+	IECoreScene::Detail::parallelForEach(
+		numCurves, canceller,
+		[&]( size_t i ) {
+			V3f centroid( 0 );
+			for( int j = vertexOffsets[i]; j < vertexOffsets[i+1]; ++j )
+			{
+				centroid += positions[j];
+			}
+			const int numVertices = vertexOffsets[i+1] - vertexOffsets[i];
+			centroids[i] = numVertices ? centroid / numVertices : centroid;
+		}
+	);
+
+	const std::vector<int> curveOrder = Detail::spatialOrder( centroids, canceller );
+
+	// Keep the elements of each curve together, moving them as a block.
+
+	const std::vector<int> &verticesPerCurve = curves->verticesPerCurve()->readable();
+	IntVectorDataPtr newVerticesPerCurveData = new IntVectorData;
+	std::vector<int> &newVerticesPerCurve = newVerticesPerCurveData->writable();
+	newVerticesPerCurve.resize( numCurves );
+	std::vector<int> newVertexOffsets( numCurves + 1, 0 );
+	std::vector<int> newVaryingOffsets( numCurves + 1, 0 );
+	for( size_t i = 0; i < numCurves; ++i )
+	{
+		const int curve = curveOrder[i];
+		newVerticesPerCurve[i] = verticesPerCurve[curve];
+		newVertexOffsets[i+1] = newVertexOffsets[i] + vertexOffsets[curve+1] - vertexOffsets[curve];
+		newVaryingOffsets[i+1] = newVaryingOffsets[i] + varyingOffsets[curve+1] - varyingOffsets[curve];
+	}
+
+	std::vector<int> vertexOrder( vertexOffsets.back() );
+	std::vector<int> varyingOrder( varyingOffsets.back() );
+	IECoreScene::Detail::parallelForEach(
+		numCurves, canceller,
+		[&]( size_t i ) {
+			const int curve = curveOrder[i];
+			std::iota( vertexOrder.begin() + newVertexOffsets[i], vertexOrder.begin() + newVertexOffsets[i+1], vertexOffsets[curve] );
+			std::iota( varyingOrder.begin() + newVaryingOffsets[i], varyingOrder.begin() + newVaryingOffsets[i+1], varyingOffsets[curve] );
+		}
+	);
+
+	curves->setTopology( newVerticesPerCurveData.get(), curves->basis(), curves->wrap() );
+
+	PrimitiveVariableAlgos::reorderPrimitiveVariables(
+		curves->variables,
+		[&]( PrimitiveVariable::Interpolation interpolation ) -> const std::vector<int> * {
+			switch( interpolation )
+			{
+				case PrimitiveVariable::Uniform :
+					return &curveOrder;
+				case PrimitiveVariable::Vertex :
+					return &vertexOrder;
+				case PrimitiveVariable::Varying :
+				case PrimitiveVariable::FaceVarying :
+					return &varyingOrder;
+				default :
+					return nullptr;
+			}
+		},
+		canceller
+	);
+}
+
 } //namespace CurveAlgo
 } //namespace IECoreScene
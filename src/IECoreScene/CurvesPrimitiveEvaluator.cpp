@@ -45,6 +45,10 @@
 
 #include "Imath/ImathFun.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Imath;
@@ -352,6 +356,11 @@ struct CurvesPrimitiveEvaluator::Line
 {
 	public :
 
+		Line()
+			:	m_curveIndex( 0 ), m_vMin( 0 ), m_vMax( 0 )
+		{
+		}
+
 		Line( const V3f &p1, const V3f &p2, unsigned curveIndex, float vMin, float vMax )
 			:	m_lineSegment( p1, p2 ), m_curveIndex( curveIndex ), m_vMin( vMin ), m_vMax( vMax )
 		{
@@ -380,7 +389,7 @@ struct CurvesPrimitiveEvaluator::Line
 //////////////////////////////////////////////////////////////////////////
 
 CurvesPrimitiveEvaluator::CurvesPrimitiveEvaluator( ConstCurvesPrimitivePtr curves )
-	:	m_curvesPrimitive( conformedCurves( curves ) ), m_verticesPerCurve( m_curvesPrimitive->verticesPerCurve()->readable() ), m_haveTree( false )
+	:	m_curvesPrimitive( conformedCurves( curves ) ), m_verticesPerCurve( m_curvesPrimitive->verticesPerCurve()->readable() )
 {
 	m_vertexDataOffsets.reserve( m_verticesPerCurve.size() );
 	m_varyingDataOffsets.reserve( m_verticesPerCurve.size() );
@@ -458,8 +467,18 @@ bool CurvesPrimitiveEvaluator::closestPoint( const Imath::V3f &p, PrimitiveEvalu
 	// the cast isn't pretty but i think is the best of the alternatives. we want to delay building the tree until the first
 	// closestPoint() query so people don't pay the overhead if they're just using other queries. the alternative to
 	// the cast is to make the tree members mutable, but i'd rather keep them immutable so that the compiler tells us if
-	// we do anything wrong during the query.
-	const_cast<CurvesPrimitiveEvaluator *>( this )->buildTree();
+	// we do anything wrong during the query. `call_once` guarantees that concurrent queries wait for a single build,
+	// and that the tree is visible to them once it completes. The build uses parallel loops, so we isolate it to
+	// prevent this thread stealing another query task while it waits, and then re-entering `call_once` on the
+	// same flag.
+	std::call_once(
+		m_treeOnceFlag,
+		[this] {
+			tbb::this_task_arena::isolate(
+				[this] { const_cast<CurvesPrimitiveEvaluator *>( this )->buildTree(); }
+			);
+		}
+	);
 
 	unsigned curveIndex = 0;
 	float v = -1;
@@ -472,8 +491,6 @@ bool CurvesPrimitiveEvaluator::closestPoint( const Imath::V3f &p, PrimitiveEvalu
 
 void CurvesPrimitiveEvaluator::closestPointWalk( Box3fTree::NodeIndex nodeIndex, const Imath::V3f &p, unsigned &curveIndex, float &v, float &closestDistSquared ) const
 {
-	assert( m_haveTree );
-
 	const Box3fTree::Node &node = m_tree.node( nodeIndex );
 	if( node.isLeaf() )
 	{
@@ -688,72 +705,83 @@ float CurvesPrimitiveEvaluator::curveLength( unsigned curveIndex, float vStart,
 
 void CurvesPrimitiveEvaluator::buildTree()
 {
-	if( m_haveTree )
-	{
-		return;
-	}
+	const bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
+	const std::vector<V3f> &p = static_cast<const V3fVectorData *>( m_p.data.get() )->readable();
+	const size_t numCurves = m_curvesPrimitive->numCurves();
 
-	std::lock_guard<TreeMutex> lock( m_treeMutex );
-	if( m_haveTree )
+	// Count the lines for each curve, so that we know where
+	// each curve's lines start and can then generate them in
+	// parallel.
+
+	std::vector<size_t> lineOffsets( numCurves + 1, 0 );
+	for( size_t curveIndex = 0; curveIndex<numCurves; curveIndex++ )
 	{
-		// another thread may have built the tree while we waited for the mutex
-		return;
+		int numPoints = linear ? m_verticesPerCurve[curveIndex] : m_curvesPrimitive->numSegments( curveIndex ) * Line::linesPerCurveSegment();
+		lineOffsets[curveIndex+1] = lineOffsets[curveIndex] + std::max( numPoints - 1, 0 );
 	}
 
-	bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
-	const std::vector<V3f> &p = static_cast<const V3fVectorData *>( m_p.data.get() )->readable();
-	PrimitiveEvaluator::ResultPtr result = createResult();
+	m_treeBounds.resize( lineOffsets.back() );
+	m_treeLines.resize( lineOffsets.back() );
 
-	size_t numCurves = m_curvesPrimitive->numCurves();
-	for( size_t curveIndex = 0; curveIndex<numCurves; curveIndex++ )
-	{
-		if( linear )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numCurves ),
+		[&]( const tbb::blocked_range<size_t> &range )
 		{
-			int numVertices = m_verticesPerCurve[curveIndex];
-			int vertIndex = m_vertexDataOffsets[curveIndex];
-			float prevV = 0.0f;
-			for( int i=0; i<numVertices; i++, vertIndex++ )
+			PrimitiveEvaluator::ResultPtr result = createResult();
+			for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
 			{
-				float v = Imath::clamp( (float)i/(float)(numVertices-1), 0.0f, 1.0f );
-				if( i!=0 )
+				size_t lineIndex = lineOffsets[curveIndex];
+				if( linear )
 				{
-					Box3f b;
-					b.extendBy( p[vertIndex-1] );
-					b.extendBy( p[vertIndex] );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line(  p[vertIndex-1], p[vertIndex], curveIndex, prevV, v ) );
+					int numVertices = m_verticesPerCurve[curveIndex];
+					int vertIndex = m_vertexDataOffsets[curveIndex];
+					float prevV = 0.0f;
+					for( int i=0; i<numVertices; i++, vertIndex++ )
+					{
+						float v = Imath::clamp( (float)i/(float)(numVertices-1), 0.0f, 1.0f );
+						if( i!=0 )
+						{
+							Box3f b;
+							b.extendBy( p[vertIndex-1] );
+							b.extendBy( p[vertIndex] );
+							m_treeBounds[lineIndex] = b;
+							m_treeLines[lineIndex++] = Line(  p[vertIndex-1], p[vertIndex], curveIndex, prevV, v );
+						}
+						prevV = v;
+					}
 				}
-				prevV = v;
-			}
-		}
-		else
-		{
-			unsigned numSegments = m_curvesPrimitive->numSegments( curveIndex );
-			int steps = numSegments * Line::linesPerCurveSegment();
-			V3f prevP( 0 );
-			float prevV = 0;
-			for( int i=0; i<steps; i++ )
-			{
-				float v = Imath::clamp( (float)i/(float)(steps-1), 0.0f, 1.0f );
-				pointAtV( curveIndex, v, result.get() );
-				V3f newP = result->point();
-				if( i!=0 )
+				else
 				{
-					Box3f b;
-					b.extendBy( prevP );
-					b.extendBy( newP );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line( prevP, newP, curveIndex, prevV, v ) );
+					unsigned numSegments = m_curvesPrimitive->numSegments( curveIndex );
+					int steps = numSegments * Line::linesPerCurveSegment();
+					V3f prevP( 0 );
+					float prevV = 0;
+					for( int i=0; i<steps; i++ )
+					{
+						float v = Imath::clamp( (float)i/(float)(steps-1), 0.0f, 1.0f );
+						pointAtV( curveIndex, v, result.get() );
+						V3f newP = result->point();
+						if( i!=0 )
+						{
+							Box3f b;
+							b.extendBy( prevP );
+							b.extendBy( newP );
+							m_treeBounds[lineIndex] = b;
+							m_treeLines[lineIndex++] = Line( prevP, newP, curveIndex, prevV, v );
+						}
+
+						prevP = newP;
+						prevV = v;
+					}
 				}
-
-				prevP = newP;
-				prevV = v;
+				assert( lineIndex == lineOffsets[curveIndex+1] );
 			}
-		}
-	}
+		},
+		taskGroupContext
+	);
 
 	m_tree.init( m_treeBounds.begin(), m_treeBounds.end() );
-	m_haveTree = true;
 }
 
 const std::vector<int> &CurvesPrimitiveEvaluator::verticesPerCurve() const
@@ -770,3 +798,19 @@ const std::vector<int> &CurvesPrimitiveEvaluator::varyingDataOffsets() const
 {
 	return m_varyingDataOffsets;
 }
+
+PrimitiveEvaluator::BatchOutputFunction CurvesPrimitiveEvaluator::addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const
+{
+	IntVectorDataPtr curveIndexData = new IntVectorData( std::vector<int>( numQueries, -1 ) );
+	FloatVectorDataPtr vData = new FloatVectorData( std::vector<float>( numQueries, 0.0f ) );
+	outputs->writable()["curveIndex"] = curveIndexData;
+	outputs->writable()["v"] = vData;
+
+	std::vector<int> *curveIndex = &curveIndexData->writable();
+	std::vector<float> *v = &vData->writable();
+	return [curveIndex, v]( const PrimitiveEvaluator::Result *result, size_t queryIndex ) {
+		const Result *curvesResult = static_cast<const Result *>( result );
+		(*curveIndex)[queryIndex] = curvesResult->curveIndex();
+		(*v)[queryIndex] = curvesResult->uv()[1];
+	};
+}
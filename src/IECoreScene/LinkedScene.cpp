@@ -43,6 +43,10 @@
 #include "boost/foreach.hpp"
 #include "boost/filesystem.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/parallel_for.h"
+
 #include <set>
 using namespace IECore;
 using namespace IECoreScene;
@@ -75,6 +79,46 @@ namespace
 	const InternedString g_linkLocations( "linkLocations" );
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Link and LinkCache
+//////////////////////////////////////////////////////////////////////////
+
+/// Describes a link authored at a location in the main scene.
+class LinkedScene::Link : public IECore::RefCounted
+{
+	public :
+
+		Link() : timeRemapped( false )
+		{
+		}
+
+		/// The file and root of the link, or null if the location
+		/// is not a link. The linked scene itself is not held, so that
+		/// its lifetime is managed by SharedSceneInterfaces, and is
+		/// retrieved from there by `LinkedScene::expandLink()`.
+		IECore::ConstStringDataPtr fileName;
+		IECore::ConstInternedStringVectorDataPtr root;
+		bool timeRemapped;
+		/// The attribute providing the time remapping, and
+		/// its value at each of its samples. The remapped times
+		/// are empty if the main scene is not sampled.
+		IECore::InternedString timeAttribute;
+		std::vector<double> remappedTimes;
+
+};
+
+/// Cache of resolved links, keyed by the hash of the main scene path.
+/// Locations which aren't links are stored too, so that their attributes
+/// aren't queried again. They all share a single empty Link.
+class LinkedScene::LinkCache : public IECore::RefCounted
+{
+	public :
+
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, ConstLinkPtr> Map;
+		Map links;
+
+};
+
 LinkedScene::LinkedScene( const std::string &fileName, IndexedIO::OpenMode mode )
 	: m_mainScene( nullptr ),
 	m_linkedScene( nullptr ),
@@ -83,6 +127,8 @@ LinkedScene::LinkedScene( const std::string &fileName, IndexedIO::OpenMode mode
 	m_atLink( false ),
 	m_sampled( true ),
 	m_timeRemapped( false ),
+	m_linkCache( m_readOnly ? new LinkCache : nullptr ),
+	m_link( nullptr ),
 	m_linkLocationsData( new IECore::PathMatcherData() )
 {
 	if( mode & IndexedIO::Append )
@@ -107,6 +153,8 @@ LinkedScene::LinkedScene( ConstSceneInterfacePtr mainScene )
 	m_readOnly( true ),
 	m_atLink( false ),
 	m_timeRemapped( false ),
+	m_linkCache( nullptr ),
+	m_link( nullptr ),
 	m_linkLocationsData( new IECore::PathMatcherData() )
 {
 	if( SceneCachePtr scc = runTimeCast<SceneCache>( m_mainScene ) )
@@ -114,12 +162,19 @@ LinkedScene::LinkedScene( ConstSceneInterfacePtr mainScene )
 		m_readOnly = scc->readOnly();
 	}
 
+	if( m_readOnly )
+	{
+		m_linkCache = new LinkCache;
+	}
+
 	m_sampled = (runTimeCast<const SampledSceneInterface>(mainScene.get()) != nullptr);
 }
 
 LinkedScene::LinkedScene(
 	SceneInterface *mainScene,
 	const SceneInterface *linkedScene,
+	LinkCachePtr linkCache,
+	ConstLinkPtr link,
 	IECore::PathMatcherDataPtr linkLocationsData,
 	int rootLinkDepth,
 	bool readOnly,
@@ -132,6 +187,8 @@ LinkedScene::LinkedScene(
 	m_readOnly( readOnly ),
 	m_atLink( atLink ),
 	m_timeRemapped( timeRemapped ),
+	m_linkCache( linkCache ),
+	m_link( link ),
 	m_linkLocationsData( linkLocationsData )
 {
 	if ( !mainScene )
@@ -189,6 +246,59 @@ IECore::CompoundDataPtr LinkedScene::linkAttributeData( const SceneInterface *sc
 	return d;
 }
 
+void LinkedScene::resolveLinks( const IECore::Canceller *canceller ) const
+{
+	if( !m_readOnly )
+	{
+		throw Exception( "No read access to scene file!" );
+	}
+
+	if( m_linkedScene )
+	{
+		if( const LinkedScene *linkedScene = runTimeCast<const LinkedScene>( m_linkedScene.get() ) )
+		{
+			linkedScene->resolveLinks( canceller );
+		}
+		if( !m_atLink )
+		{
+			// We're inside the link, so there are no more main scene
+			// locations below us.
+			return;
+		}
+	}
+
+	resolveLinksWalk( m_mainScene.get(), canceller );
+}
+
+void LinkedScene::resolveLinksWalk( const SceneInterface *mainScene, const IECore::Canceller *canceller ) const
+{
+	Canceller::check( canceller );
+
+	NameList childNames;
+	mainScene->childNames( childNames );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				ConstSceneInterfacePtr c = mainScene->child( childNames[i] );
+				ConstLinkPtr link = resolveLink( c.get() );
+				int linkDepth;
+				ConstSceneInterfacePtr l = expandLink( link->fileName.get(), link->root.get(), linkDepth );
+				if( const LinkedScene *linkedScene = runTimeCast<const LinkedScene>( l.get() ) )
+				{
+					linkedScene->resolveLinks( canceller );
+				}
+				// Links may have additional children in the main scene,
+				// so we recurse regardless.
+				resolveLinksWalk( c.get(), canceller );
+			}
+		}
+	);
+}
+
 std::string LinkedScene::fileName() const
 {
 	return m_mainScene->fileName();
@@ -1120,7 +1230,7 @@ void LinkedScene::childNames( NameList &childNames ) const
 	}
 }
 
-ConstSceneInterfacePtr LinkedScene::expandLink( const StringData *fileName, const InternedStringVectorData *root, int &linkDepth )
+ConstSceneInterfacePtr LinkedScene::expandLink( const StringData *fileName, const InternedStringVectorData *root, int &linkDepth ) const
 {
 	if ( fileName && root )
 	{
@@ -1149,8 +1259,103 @@ ConstSceneInterfacePtr LinkedScene::expandLink( const StringData *fileName, cons
 	return nullptr;
 }
 
+LinkedScene::ConstLinkPtr LinkedScene::resolveLink( const SceneInterface *mainScene ) const
+{
+	if( !m_linkCache )
+	{
+		return computeLink( mainScene );
+	}
+
+	Path p;
+	mainScene->path( p );
+	MurmurHash key;
+	key.append( p );
+
+	{
+		LinkCache::Map::const_accessor readAccessor;
+		if( m_linkCache->links.find( readAccessor, key ) )
+		{
+			return readAccessor->second;
+		}
+	}
+
+	// Compute without holding a lock, since expanding the link may
+	// open a file. Concurrent computations for the same location are
+	// harmless, and the first one to be inserted wins.
+	ConstLinkPtr link = computeLink( mainScene );
+
+	LinkCache::Map::accessor writeAccessor;
+	if( m_linkCache->links.insert( writeAccessor, key ) )
+	{
+		writeAccessor->second = link;
+	}
+	return writeAccessor->second;
+}
+
+LinkedScene::ConstLinkPtr LinkedScene::computeLink( const SceneInterface *mainScene ) const
+{
+	static ConstLinkPtr g_noLink = new Link;
+
+	LinkPtr link = new Link;
+
+	if( mainScene->hasAttribute( fileNameLinkAttribute ) && mainScene->hasAttribute( rootLinkAttribute ) )
+	{
+		link->fileName = runTimeCast< const StringData >( mainScene->readAttribute( fileNameLinkAttribute, 0 ) );
+		link->root = runTimeCast< const InternedStringVectorData >( mainScene->readAttribute( rootLinkAttribute, 0 ) );
+		link->timeRemapped = mainScene->hasAttribute( timeLinkAttribute );
+		link->timeAttribute = timeLinkAttribute;
+	}
+	else if( mainScene->hasAttribute( linkAttribute ) )
+	{
+		// read from old school link attribute.
+		// \todo: remove this when it doesn't break everyone's stuff!
+		ConstCompoundDataPtr d = runTimeCast< const CompoundData >( mainScene->readAttribute( linkAttribute, 0 ) );
+		link->fileName = d->member< const StringData >( g_fileName );
+		link->root = d->member< const InternedStringVectorData >( g_root );
+		link->timeRemapped = ( d->member<DoubleData>( g_time ) != nullptr );
+		link->timeAttribute = linkAttribute;
+	}
+
+	if( !link->fileName || !link->root )
+	{
+		return g_noLink;
+	}
+
+	// Precompute the remapped time for each sample, so that remappedLinkTime()
+	// doesn't need to read and interpolate the attribute on every query.
+	const SampledSceneInterface *sampledMainScene = runTimeCast<const SampledSceneInterface>( mainScene );
+	if( link->timeRemapped && sampledMainScene )
+	{
+		const size_t numSamples = sampledMainScene->numAttributeSamples( link->timeAttribute );
+		link->remappedTimes.reserve( numSamples );
+		for( size_t i = 0; i < numSamples; ++i )
+		{
+			ConstObjectPtr o = sampledMainScene->readAttributeAtSample( link->timeAttribute, i );
+			const DoubleData *t = runTimeCast<const DoubleData>( o.get() );
+			if( const CompoundData *d = runTimeCast<const CompoundData>( o.get() ) )
+			{
+				t = d->member<DoubleData>( g_time );
+			}
+			if( !t )
+			{
+				throw Exception( "Invalid time when querying for time remapping!" );
+			}
+			link->remappedTimes.push_back( t->readable() );
+		}
+	}
+
+	return link;
+}
+
 double LinkedScene::remappedLinkTime( double time ) const
 {
+	if( m_link && !m_link->remappedTimes.empty() )
+	{
+		size_t floorIndex, ceilIndex;
+		const double x = static_cast<const SampledSceneInterface *>( m_mainScene.get() )->attributeSampleInterval( m_link->timeAttribute, time, floorIndex, ceilIndex );
+		return m_link->remappedTimes[floorIndex] * ( 1.0 - x ) + m_link->remappedTimes[ceilIndex] * x;
+	}
+
 	if( m_mainScene->hasAttribute( timeLinkAttribute ) )
 	{
 		ConstDoubleDataPtr t = runTimeCast< const DoubleData >( m_mainScene->readAttribute( timeLinkAttribute, time ) );
@@ -1178,6 +1383,11 @@ double LinkedScene::remappedLinkTime( double time ) const
 
 double LinkedScene::remappedLinkTimeAtSample( size_t sampleIndex ) const
 {
+	if( m_link && sampleIndex < m_link->remappedTimes.size() )
+	{
+		return m_link->remappedTimes[sampleIndex];
+	}
+
 	if( m_mainScene->hasAttribute( timeLinkAttribute ) )
 	{
 		ConstDoubleDataPtr t = runTimeCast< const DoubleData >( static_cast<const SampledSceneInterface*>(m_mainScene.get())->readAttributeAtSample( timeLinkAttribute, sampleIndex ) );
@@ -1218,7 +1428,7 @@ SceneInterfacePtr LinkedScene::child( const Name &name, MissingBehaviour missing
 		ConstSceneInterfacePtr c = m_linkedScene->child( name, SceneInterface::NullIfMissing );
 		if ( c )
 		{
-			return new LinkedScene( m_mainScene.get(), c.get(), m_linkLocationsData, m_rootLinkDepth, m_readOnly, false, m_timeRemapped );
+			return new LinkedScene( m_mainScene.get(), c.get(), m_linkCache, m_link, m_linkLocationsData, m_rootLinkDepth, m_readOnly, false, m_timeRemapped );
 		}
 		if( !m_atLink )
 		{
@@ -1256,37 +1466,16 @@ SceneInterfacePtr LinkedScene::child( const Name &name, MissingBehaviour missing
 	}
 	if ( m_readOnly )
 	{
-		if( c->hasAttribute( fileNameLinkAttribute ) && c->hasAttribute( rootLinkAttribute ) )
-		{
-			ConstStringDataPtr fileName = runTimeCast< const StringData >( c->readAttribute( fileNameLinkAttribute, 0 ) );
-			ConstInternedStringVectorDataPtr root = runTimeCast< const InternedStringVectorData >( c->readAttribute( rootLinkAttribute, 0 ) );
-
-			/// we found the link attribute...
-			int linkDepth;
-			bool timeRemapped = c->hasAttribute( timeLinkAttribute );
-			ConstSceneInterfacePtr l = expandLink( fileName.get(), root.get(), linkDepth );
-			if ( l )
-			{
-				return new LinkedScene( c.get(), l.get(), m_linkLocationsData, linkDepth, m_readOnly, true, timeRemapped );
-			}
-		}
-		else if( c->hasAttribute( linkAttribute ) )
+		ConstLinkPtr link = resolveLink( c.get() );
+		int linkDepth;
+		ConstSceneInterfacePtr l = expandLink( link->fileName.get(), link->root.get(), linkDepth );
+		if( l )
 		{
-			// read from old school link attribute.
-			// \todo: remove this when it doesn't break everyone's stuff!
-			ConstCompoundDataPtr d = runTimeCast< const CompoundData >( c->readAttribute( linkAttribute, 0 ) );
-			/// we found the link attribute...
-			int linkDepth;
-			bool timeRemapped = ( d->member<DoubleData>( g_time ) != nullptr );
-			ConstSceneInterfacePtr l = expandLink( d->member< const StringData >( g_fileName ), d->member< const InternedStringVectorData >( g_root ), linkDepth );
-			if ( l )
-			{
-				return new LinkedScene( c.get(), l.get(), m_linkLocationsData, linkDepth, m_readOnly, true, timeRemapped );
-			}
+			return new LinkedScene( c.get(), l.get(), m_linkCache, link, m_linkLocationsData, linkDepth, m_readOnly, true, link->timeRemapped );
 		}
 	}
 
-	return new LinkedScene( c.get(), nullptr, m_linkLocationsData, 0, m_readOnly, false, false );
+	return new LinkedScene( c.get(), nullptr, m_linkCache, nullptr, m_linkLocationsData, 0, m_readOnly, false, false );
 
 }
 
@@ -1345,33 +1534,21 @@ SceneInterfacePtr LinkedScene::scene( const Path &path, MissingBehaviour missing
 		s = n;
 	}
 	ConstSceneInterfacePtr l = nullptr;
+	ConstLinkPtr link = nullptr;
 	int linkDepth = 0;
 	bool atLink = false;
 	bool timeRemapped = false;
 
-	if ( s->hasAttribute( fileNameLinkAttribute ) && s->hasAttribute( rootLinkAttribute ) )
+	link = resolveLink( s.get() );
+	l = expandLink( link->fileName.get(), link->root.get(), linkDepth );
+	if( l )
 	{
 		atLink = true;
-		timeRemapped = s->hasAttribute( timeLinkAttribute );
-		ConstStringDataPtr fileName = runTimeCast< const StringData >( s->readAttribute( fileNameLinkAttribute, 0 ) );
-		ConstInternedStringVectorDataPtr root = runTimeCast< const InternedStringVectorData >( s->readAttribute( rootLinkAttribute, 0 ) );
-
-		l = expandLink( fileName.get(), root.get(), linkDepth );
-		if (!l)
-		{
-			atLink = false;
-			timeRemapped = false;
-		}
+		timeRemapped = link->timeRemapped;
 	}
-	else if( s->hasAttribute( linkAttribute ) )
+	else
 	{
-		atLink = true;
-		ConstCompoundDataPtr d = runTimeCast< const CompoundData >( s->readAttribute( linkAttribute, 0 ) );
-		l = expandLink( d->member< const StringData >( g_fileName ), d->member< const InternedStringVectorData >( g_root ), linkDepth );
-		if ( !l )
-		{
-			atLink = false;
-		}
+		link = nullptr;
 	}
 
 	if ( pIt != path.end() )
@@ -1395,7 +1572,7 @@ SceneInterfacePtr LinkedScene::scene( const Path &path, MissingBehaviour missing
 		}
 		atLink = false;
 	}
-	return new LinkedScene( s.get(), l.get(), m_linkLocationsData, linkDepth, m_readOnly, atLink, timeRemapped );
+	return new LinkedScene( s.get(), l.get(), m_linkCache, link, m_linkLocationsData, linkDepth, m_readOnly, atLink, timeRemapped );
 }
 
 ConstSceneInterfacePtr LinkedScene::scene( const Path &path, LinkedScene::MissingBehaviour missingBehaviour ) const
@@ -33,6 +33,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/private/PrimitiveAlgoUtils.h"
+
+#include <algorithm>
 
 using namespace std;
 using namespace IECore;
@@ -55,9 +58,53 @@ inline void linearInsert( int *list, int val )
 
 } // namespace
 
-pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::connectedVertices( const MeshPrimitive *mesh, const Canceller *canceller )
+pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::connectedVertices( const MeshPrimitive *mesh, const Canceller *canceller, const MeshTopology *topology )
 {
 	size_t numVertices = mesh->variableData< V3fVectorData >( "P", PrimitiveVariable::Vertex )->readable().size();
+
+	if( topology )
+	{
+		IECoreScene::Detail::validateTopology( mesh, topology, "MeshAlgo::connectedVertices" );
+
+		// Edges are ordered by first occurrence, so visiting them in order
+		// yields neighbours in the same order as the search below.
+		IntVectorDataPtr offsetsData = new IntVectorData();
+		vector<int> &offsets = offsetsData->writable();
+		offsets.resize( std::max<size_t>( numVertices, topology->numVertices() ) + 1, 0 );
+
+		Canceller::check( canceller );
+		for( const auto &e : topology->edges() )
+		{
+			offsets[e.x + 1]++;
+			if( e.y != e.x )
+			{
+				offsets[e.y + 1]++;
+			}
+		}
+		for( size_t i = 1; i < offsets.size(); ++i )
+		{
+			offsets[i] += offsets[i-1];
+		}
+
+		Canceller::check( canceller );
+		IntVectorDataPtr neighbourListData = new IntVectorData();
+		vector<int> &neighbourList = neighbourListData->writable();
+		neighbourList.resize( offsets.back() );
+		for( const auto &e : topology->edges() )
+		{
+			neighbourList[offsets[e.x]++] = e.y;
+			if( e.y != e.x )
+			{
+				neighbourList[offsets[e.y]++] = e.x;
+			}
+		}
+
+		// Filling has advanced each offset to the start of the next list,
+		// which is the end offset format we return.
+		offsets.pop_back();
+		return pair<IntVectorDataPtr, IntVectorDataPtr>( neighbourListData, offsetsData );
+	}
+
 	const vector<int> &numVerticesPerFace = mesh->verticesPerFace()->readable();
 	const vector<int> &vertexIds = mesh->vertexIds()->readable();
 
@@ -135,9 +182,29 @@ pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::connectedVertices( const Mesh
 	return pair<IntVectorDataPtr, IntVectorDataPtr>( neighbourListData, offsetsData );
 }
 
-pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::correspondingFaceVertices( const MeshPrimitive *mesh, const Canceller *canceller )
+pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::correspondingFaceVertices( const MeshPrimitive *mesh, const Canceller *canceller, const MeshTopology *topology )
 {
 	size_t numVertices = mesh->variableData< V3fVectorData >( "P", PrimitiveVariable::Vertex )->readable().size();
+
+	if( topology )
+	{
+		IECoreScene::Detail::validateTopology( mesh, topology, "MeshAlgo::correspondingFaceVertices" );
+
+		Canceller::check( canceller );
+		IntVectorDataPtr faceVerticesData = new IntVectorData( topology->vertexFaceVertices() );
+
+		// Our offsets omit the leading 0, and may need padding for vertices
+		// that aren't referenced by any face.
+		Canceller::check( canceller );
+		const vector<int> &topologyOffsets = topology->vertexFaceVertexOffsets();
+		IntVectorDataPtr offsetsData = new IntVectorData();
+		vector<int> &offsets = offsetsData->writable();
+		offsets.insert( offsets.end(), topologyOffsets.begin() + 1, topologyOffsets.end() );
+		offsets.resize( std::max( numVertices, offsets.size() ), topologyOffsets.back() );
+
+		return pair<IntVectorDataPtr, IntVectorDataPtr>( faceVerticesData, offsetsData );
+	}
+
 	const vector<int> &vertexIds = mesh->vertexIds()->readable();
 
 	IntVectorDataPtr offsetsData = new IntVectorData();
@@ -38,6 +38,8 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/DataAlgo.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
@@ -151,90 +153,121 @@ void deleteCreases( MeshPrimitive *out, const MeshPrimitive *in, const std::vect
 template<typename T>
 MeshPrimitivePtr deleteFaces( const MeshPrimitive *meshPrimitive, PrimitiveVariable::IndexedView<T> &deleteFlagView, bool invert, const Canceller *canceller )
 {
-	// construct 3 functors for deleting (uniform, vertex & face varying) primvars
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedUniformFunctor<T> uniformFunctor( deleteFlagView, invert );
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedFaceVaryingFunctor<T> faceVaryingFunctor( deleteFlagView, meshPrimitive->verticesPerFace(), invert );
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedVertexFunctor<T> vertexFunctor(
-		meshPrimitive->variableSize( PrimitiveVariable::Vertex ), meshPrimitive->vertexIds(), meshPrimitive->verticesPerFace(), deleteFlagView, invert );
-
-	// filter verticesPerFace using DeleteFlaggedUniformFunctor
-	const IECore::Data *inputVerticesPerFace = IECore::runTimeCast<const IECore::Data>( meshPrimitive->verticesPerFace() );
-	uniformFunctor.setIndices( nullptr );
-	IECoreScene::PrimitiveVariableAlgos::IndexedData outputVerticesPerFace = dispatch( inputVerticesPerFace, uniformFunctor );
-	IntVectorDataPtr verticesPerFace = IECore::runTimeCast<IECore::IntVectorData>( outputVerticesPerFace.data );
-
-	// filter VertexIds using DeleteFlaggedFaceVaryingFunctor
-	const IECore::Data *inputVertexIds = IECore::runTimeCast<const IECore::Data>( meshPrimitive->vertexIds() );
-	faceVaryingFunctor.setIndices( nullptr );
-	IECoreScene::PrimitiveVariableAlgos::IndexedData outputVertexIds = dispatch( inputVertexIds, faceVaryingFunctor );
-
-	// remap the indices also
-	ConstIntVectorDataPtr remappingData = vertexFunctor.getRemapping();
-	const std::vector<int> &remapping = remappingData->readable();
-	IntVectorDataPtr vertexIdsData = IECore::runTimeCast<IECore::IntVectorData>( outputVertexIds.data );
-	IntVectorData::ValueType &vertexIds = vertexIdsData->writable();
-	for( size_t i = 0; i < vertexIds.size(); ++i )
+	using IECoreScene::PrimitiveVariableAlgos::KeptElements;
+	using IECoreScene::PrimitiveVariableAlgos::IndexedData;
+
+	const std::vector<int> &inputVerticesPerFace = meshPrimitive->verticesPerFace()->readable();
+	const std::vector<int> &inputVertexIds = meshPrimitive->vertexIds()->readable();
+	const auto keep = IECoreScene::PrimitiveVariableAlgos::keepUnflagged( deleteFlagView, invert );
+
+	// Find the elements to keep for each interpolation.
+
+	const KeptElements keptFaces( meshPrimitive->numFaces(), keep, []( size_t ) { return 1; }, canceller );
+	const KeptElements keptFaceVertices( meshPrimitive->numFaces(), keep, [&]( size_t f ) { return inputVerticesPerFace[f]; }, canceller );
+
+	// Vertices are shared between faces, so must be flagged as used by
+	// any of the kept faces.
+	std::vector<char> usedVertices( meshPrimitive->variableSize( PrimitiveVariable::Vertex ), 0 );
+	const std::vector<int> &faceVertices = keptFaceVertices.elements();
+	for( size_t i = 0; i < faceVertices.size(); ++i )
 	{
-		if( i % 1000 == 0 )
+		if( i % 100000 == 0 )
 		{
 			Canceller::check( canceller );
 		}
-
-		vertexIds[i] = remapping[vertexIds[i]];
+		usedVertices[inputVertexIds[faceVertices[i]]] = 1;
 	}
 
+	const KeptElements keptVertices( usedVertices.size(), [&]( size_t v ) { return usedVertices[v]; }, []( size_t ) { return 1; }, canceller );
+	const std::vector<int> remapping = keptVertices.remapping();
+
+	// Topology
+
+	IntVectorDataPtr verticesPerFace = runTimeCast<IntVectorData>( keptFaces( meshPrimitive->verticesPerFace(), nullptr ).data );
+
+	IntVectorDataPtr vertexIdsData = new IntVectorData;
+	std::vector<int> &vertexIds = vertexIdsData->writable();
+	vertexIds.resize( faceVertices.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, faceVertices.size(), 10000 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				vertexIds[i] = remapping[inputVertexIds[faceVertices[i]]];
+			}
+		},
+		taskGroupContext
+	);
+
 	// construct mesh without positions as they'll be set when filtering the primvars
 	MeshPrimitivePtr outMeshPrimitive = new MeshPrimitive( verticesPerFace, vertexIdsData, meshPrimitive->interpolation() );
 
 	deleteCorners( outMeshPrimitive.get(), meshPrimitive, remapping, canceller );
 	deleteCreases( outMeshPrimitive.get(), meshPrimitive, remapping, canceller );
 
-	for( PrimitiveVariableMap::const_iterator it = meshPrimitive->variables.begin(), e = meshPrimitive->variables.end(); it != e; ++it )
+	// Primitive variables, filtered in parallel.
+
+	std::vector<std::pair<const std::string *, const PrimitiveVariable *>> variables;
+	for( const auto &[name, variable] : meshPrimitive->variables )
 	{
 		Canceller::check( canceller );
-		if( !meshPrimitive->isPrimitiveVariableValid( it->second ) )
+		if( !meshPrimitive->isPrimitiveVariableValid( variable ) )
 		{
 			throw InvalidArgumentException(
-				fmt::format( "MeshAlgo::deleteFaces cannot process invalid primitive variable \"{}\"", it->first )
+				fmt::format( "MeshAlgo::deleteFaces cannot process invalid primitive variable \"{}\"", name )
 			);
 		}
+		variables.push_back( { &name, &variable } );
+	}
 
-		switch( it->second.interpolation )
+	std::vector<PrimitiveVariable> outputVariables( variables.size() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
 		{
-			case PrimitiveVariable::Uniform:
-			{
-				const IECore::Data *inputData = it->second.data.get();
-				uniformFunctor.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, uniformFunctor );
-				outMeshPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
-				break;
-			}
-			case PrimitiveVariable::Vertex:
-			case PrimitiveVariable::Varying:
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				const IECore::Data *inputData = it->second.data.get();
-				vertexFunctor.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch( inputData, vertexFunctor );
-				outMeshPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
-				break;
-			}
+				const PrimitiveVariable &variable = *variables[i].second;
+				const KeptElements *keptElements = nullptr;
+				switch( variable.interpolation )
+				{
+					case PrimitiveVariable::Uniform :
+						keptElements = &keptFaces;
+						break;
+					case PrimitiveVariable::Vertex :
+					case PrimitiveVariable::Varying :
+						keptElements = &keptVertices;
+						break;
+					case PrimitiveVariable::FaceVarying :
+						keptElements = &keptFaceVertices;
+						break;
+					case PrimitiveVariable::Constant :
+					case PrimitiveVariable::Invalid :
+						break;
+				}
 
-			case PrimitiveVariable::FaceVarying:
-			{
-				const IECore::Data *inputData = it->second.data.get();
-				faceVaryingFunctor.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData outputData = dispatch(inputData, faceVaryingFunctor );
-				outMeshPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, outputData.data, outputData.indices );
-				break;
-			}
-			case PrimitiveVariable::Constant:
-			case PrimitiveVariable::Invalid:
-			{
-				outMeshPrimitive->variables[it->first] = it->second;
-				break;
+				if( !keptElements )
+				{
+					outputVariables[i] = variable;
+					continue;
+				}
+
+				const IECore::Data *inputData = variable.data.get();
+				IndexedData outputData = dispatch( inputData, *keptElements, variable.indices.get() );
+				outputVariables[i] = PrimitiveVariable( variable.interpolation, outputData.data, outputData.indices );
 			}
-		}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < variables.size(); ++i )
+	{
+		outMeshPrimitive->variables[*variables[i].first] = outputVariables[i];
 	}
+
 	return outMeshPrimitive;
 }
 
@@ -33,12 +33,16 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
-#include "IECoreScene/private/PrimitiveAlgoUtils.h"
 
 #include "IECore/DataAlgo.h"
 #include "IECore/DespatchTypedData.h"
 
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <unordered_set>
 
 using namespace Imath;
 using namespace IECore;
@@ -74,314 +78,343 @@ struct DefaultValue<Imath::Vec2<T> >
 	}
 };
 
-struct AppendPrimVars
+// Runs `f( i )` for each mesh index, in parallel where it is safe to do so.
+// The elements of `std::vector<bool>` share storage, so can't be written
+// concurrently.
+template<typename ValueType, typename F>
+void forEachMesh( size_t numMeshes, tbb::task_group_context &taskGroupContext, const Canceller *canceller, F &&f )
 {
-		typedef void ReturnType;
-
-		AppendPrimVars( MeshPrimitive *mesh, const MeshPrimitive *mesh2, const std::string &name, const PrimitiveVariable::Interpolation interpolation, IntVectorData *indices, std::set<DataPtr> &visitedData, const Canceller *canceller )
-			:	m_mesh2( mesh2 ), m_name( name ), m_interpolation( interpolation ), m_indices( indices ), m_visitedData( visitedData ), m_canceller( canceller )
+	if constexpr( std::is_same_v<ValueType, bool> )
+	{
+		for( size_t i = 0; i < numMeshes; ++i )
 		{
+			Canceller::check( canceller );
+			f( i );
 		}
+	}
+	else
+	{
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, numMeshes ),
+			[&] ( const tbb::blocked_range<size_t> &range )
+			{
+				Canceller::check( canceller );
+				for( size_t i = range.begin(); i != range.end(); ++i )
+				{
+					f( i );
+				}
+			},
+			taskGroupContext
+		);
+	}
+}
+
+// Describes a primitive variable in the merged mesh. The first mesh to
+// provide a variable determines its interpolation and type. Only variables
+// provided by the first mesh may be indexed.
+struct MergedVariable
+{
+	std::string name;
+	const PrimitiveVariable *definition;
+	size_t firstMesh;
+};
+
+struct MergeVariableFn
+{
+	typedef PrimitiveVariable ReturnType;
+
+	MergeVariableFn( const std::vector<const MeshPrimitive *> &meshes, const MergedVariable &variable, const Canceller *canceller )
+		:	m_meshes( meshes ), m_variable( variable ), m_canceller( canceller )
+	{
+	}
 
-		template<typename T>
-		ReturnType operator()( T *data )
+	template<typename T>
+	ReturnType operator()( const T *definitionData )
+	{
+		typedef typename T::ValueType::value_type ValueType;
+
+		const PrimitiveVariable::Interpolation interpolation = m_variable.definition->interpolation;
+		const bool indexed = m_variable.firstMesh == 0 && m_variable.definition->indices;
+		const size_t numMeshes = m_meshes.size();
+
+		// Find the source variable for each mesh, and compute the offset
+		// of each mesh's contribution to the output.
+
+		std::vector<const PrimitiveVariable *> sources( numMeshes, nullptr );
+		std::vector<size_t> dataOffsets( numMeshes + 1, 0 );
+		std::vector<size_t> indexOffsets( numMeshes + 1, 0 );
+		for( size_t i = 0; i < numMeshes; ++i )
 		{
-			if ( m_visitedData.find( data ) != m_visitedData.end() )
+			const PrimitiveVariable *source = nullptr;
+			if( i >= m_variable.firstMesh )
 			{
-				return;
+				auto it = m_meshes[i]->variables.find( m_variable.name );
+				if(
+					it != m_meshes[i]->variables.end() &&
+					it->second.interpolation == interpolation &&
+					it->second.data->isInstanceOf( T::staticTypeId() )
+				)
+				{
+					source = &it->second;
+				}
 			}
-			m_visitedData.insert( data );
+			sources[i] = source;
 
-			PrimitiveVariableMap::const_iterator it = m_mesh2->variables.find( m_name );
-			if( it != m_mesh2->variables.end() && it->second.data->isInstanceOf( data->staticTypeId() ) && it->second.interpolation == m_interpolation )
+			size_t dataSize = 0;
+			size_t indexSize = 0;
+			if( source )
 			{
-				if( m_indices )
-				{
-					const int offset = data->readable().size();
+				const size_t sourceDataSize = static_cast<const T *>( source->data.get() )->readable().size();
+				const size_t sourceSize = source->indices ? source->indices->readable().size() : sourceDataSize;
+				dataSize = indexed ? sourceDataSize : sourceSize;
+				indexSize = indexed ? sourceSize : 0;
+			}
+			else
+			{
+				/// \todo: the data would be more compact if we shared a single
+				/// default value between all meshes.
+				const size_t size = m_meshes[i]->variableSize( interpolation );
+				dataSize = indexed ? std::min<size_t>( size, 1 ) : size;
+				indexSize = indexed ? size : 0;
+			}
+
+			dataOffsets[i+1] = dataOffsets[i] + dataSize;
+			indexOffsets[i+1] = indexOffsets[i] + indexSize;
+		}
+
+		// Allocate the output once, and fill in each mesh's contribution
+		// in parallel.
+
+		Canceller::check( m_canceller );
+		typename T::Ptr data = new T;
+		auto &dataWritable = data->writable();
+		dataWritable.resize( dataOffsets.back() );
+		setGeometricInterpretation( data.get(), getGeometricInterpretation( definitionData ) );
+
+		IntVectorDataPtr indices;
+		std::vector<int> *indicesWritable = nullptr;
+		if( indexed )
+		{
+			indices = new IntVectorData;
+			indicesWritable = &indices->writable();
+			indicesWritable->resize( indexOffsets.back() );
+		}
 
-					Canceller::check( m_canceller );
-					const T *data2 = runTimeCast<const T>( it->second.data.get() );
-					data->writable().insert( data->writable().end(), data2->readable().begin(), data2->readable().end() );
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		forEachMesh<ValueType>(
+			numMeshes, taskGroupContext, m_canceller,
+			[&] ( size_t i ) {
 
-					if( it->second.indices )
+				auto dataOut = dataWritable.begin() + dataOffsets[i];
+				const int dataOffset = dataOffsets[i];
+
+				if( const PrimitiveVariable *source = sources[i] )
+				{
+					const auto &sourceData = static_cast<const T *>( source->data.get() )->readable();
+					if( indexed )
 					{
-						/// Re-index to fit on the end of the existing data
-						/// \todo: the data would be more compact if we search
-						/// existing values rather than blindly insert.
-						std::vector<int> &indices = m_indices->writable();
-						const std::vector<int> &indices2 = it->second.indices->readable();
-						Canceller::check( m_canceller );
-						indices.reserve( indices.size() + indices2.size() );
-						Canceller::check( m_canceller );
-						for( const auto &index : indices2 )
+						std::copy( sourceData.begin(), sourceData.end(), dataOut );
+						auto indicesOut = indicesWritable->begin() + indexOffsets[i];
+						if( source->indices )
 						{
-							indices.push_back( offset + index );
+							const std::vector<int> &sourceIndices = source->indices->readable();
+							std::transform( sourceIndices.begin(), sourceIndices.end(), indicesOut, [dataOffset] ( int index ) { return index + dataOffset; } );
+						}
+						else
+						{
+							std::iota( indicesOut, indicesOut + sourceData.size(), dataOffset );
 						}
 					}
-					else
+					else if( source->indices )
 					{
-						/// Append new indices for the second mesh
-						/// \todo: the data would be more compact if we search
-						/// existing values rather than blindly insert.
-						std::vector<int> &indices = m_indices->writable();
-						const size_t data2Size = data2->readable().size();
-						for( size_t i = 0; i < data2Size; ++i )
+						/// The first mesh dictates whether the PrimitiveVariable should
+						/// be indexed. If this mesh has indices, we must expand them.
+						for( int index : source->indices->readable() )
 						{
-							if( i % 1000 == 0 )
-							{
-								Canceller::check( m_canceller );
-							}
-
-							indices.push_back( offset + i );
+							*dataOut++ = sourceData[index];
 						}
 					}
+					else
+					{
+						std::copy( sourceData.begin(), sourceData.end(), dataOut );
+					}
 				}
 				else
 				{
-					/// The first mesh dictates whether the PrimitiveVariable should
-					/// be indexed. If the second mesh has indices, we must expand them.
-					Canceller::check( m_canceller );
-					typename T::Ptr expandedData2 = runTimeCast<T>( it->second.expandedData() );
-					data->writable().insert( data->writable().end(), expandedData2->readable().begin(), expandedData2->readable().end() );
+					std::fill( dataOut, dataWritable.begin() + dataOffsets[i+1], DefaultValue<ValueType>()() );
+					if( indexed )
+					{
+						std::fill( indicesWritable->begin() + indexOffsets[i], indicesWritable->begin() + indexOffsets[i+1], dataOffset );
+					}
 				}
 			}
-			else
-			{
-				typedef typename T::ValueType::value_type ValueType;
-				ValueType defaultValue = DefaultValue<ValueType>()();
-				size_t size = m_mesh2->variableSize( m_interpolation );
-				if( !size )
-				{
-					/// mesh2 may have an empty variableSize if it contains
-					/// no topology, so early out rather than appending.
-					return;
-				}
+		);
 
-				Canceller::check( m_canceller );
-				if( m_indices )
-				{
-					/// \todo: the data would be more compact if we search for defaultValue
-					/// in the existing data rather than blindly insert.
-					m_indices->writable().insert( m_indices->writable().end(), size, data->writable().size() );
-					data->writable().push_back( defaultValue );
-				}
-				else
-				{
-					data->writable().insert( data->writable().end(), size, defaultValue );
-				}
-			}
-		}
+		return PrimitiveVariable( interpolation, data, indices );
+	}
 
 	private :
 
-		const MeshPrimitive *m_mesh2;
-		const std::string m_name;
-		const PrimitiveVariable::Interpolation m_interpolation;
-		IntVectorData *m_indices;
-		std::set<DataPtr> &m_visitedData;
+		const std::vector<const MeshPrimitive *> &m_meshes;
+		const MergedVariable &m_variable;
 		const Canceller *m_canceller;
 
 };
 
-struct PrependPrimVars
+// Concatenates the vectors returned by `accessor` for each mesh, adding
+// `offsets[i]` to the values from mesh `i`.
+template<typename T, typename Accessor>
+typename TypedData<std::vector<T>>::Ptr concatenate( const std::vector<const MeshPrimitive *> &meshes, Accessor &&accessor, const std::vector<int> *offsets, tbb::task_group_context &taskGroupContext, const Canceller *canceller )
 {
-		typedef void ReturnType;
-
-		PrependPrimVars( MeshPrimitive *mesh, const std::string &name, const PrimitiveVariable &primVar, std::map<ConstDataPtr, DataPtr> &visitedData, const Canceller *canceller )
-			:	m_mesh( mesh ), m_name( name ), m_primVar( primVar ), m_visitedData( visitedData ), m_canceller( canceller )
-		{
-		}
+	std::vector<size_t> outputOffsets( meshes.size() + 1, 0 );
+	for( size_t i = 0; i < meshes.size(); ++i )
+	{
+		outputOffsets[i+1] = outputOffsets[i] + accessor( meshes[i] ).size();
+	}
 
-		template<typename T>
-		ReturnType operator()( const T *data )
-		{
-			PrimitiveVariableMap::iterator it = m_mesh->variables.find( m_name );
-			if( it == m_mesh->variables.end() )
+	Canceller::check( canceller );
+	typename TypedData<std::vector<T>>::Ptr result = new TypedData<std::vector<T>>;
+	auto &resultWritable = result->writable();
+	resultWritable.resize( outputOffsets.back() );
+
+	forEachMesh<T>(
+		meshes.size(), taskGroupContext, canceller,
+		[&] ( size_t i ) {
+			const std::vector<T> &input = accessor( meshes[i] );
+			auto out = resultWritable.begin() + outputOffsets[i];
+			if( offsets && (*offsets)[i] )
 			{
-				typename T::Ptr data2 = nullptr;
-
-				std::map<ConstDataPtr, DataPtr>::iterator dataIt = m_visitedData.find( data );
-				if ( dataIt != m_visitedData.end() )
-				{
-					data2 = runTimeCast<T>( dataIt->second );
-				}
-
-				if ( !data2 )
-				{
-					typedef typename T::ValueType::value_type ValueType;
-					ValueType defaultValue = DefaultValue<ValueType>()();
-
-					Canceller::check( m_canceller );
-					typename T::Ptr expandedData = runTimeCast<T>( m_primVar.expandedData() );
-					size_t size = m_mesh->variableSize( m_primVar.interpolation ) - expandedData->readable().size();
-					data2 = new T();
-					data2->writable().insert( data2->writable().end(), size, defaultValue );
-
-					Canceller::check( m_canceller );
-					/// The first mesh dictates whether the PrimitiveVariable should
-					/// be indexed. If the second mesh has indices, we must expand them.
-					data2->writable().insert( data2->writable().end(), expandedData->readable().begin(), expandedData->readable().end() );
-				}
-
-				Canceller::check( m_canceller );
-				m_mesh->variables[m_name] = PrimitiveVariable( m_primVar.interpolation, data2 );
-
-				m_visitedData[data] = data2;
+				const T offset = (*offsets)[i];
+				std::transform( input.begin(), input.end(), out, [offset] ( T v ) { return v + offset; } );
+			}
+			else
+			{
+				std::copy( input.begin(), input.end(), out );
 			}
 		}
+	);
 
-	private :
-
-		MeshPrimitive *m_mesh;
-		const std::string m_name;
-		const PrimitiveVariable &m_primVar;
-		std::map<ConstDataPtr, DataPtr> &m_visitedData;
-		const Canceller *m_canceller;
+	return result;
+}
 
-};
+} // namespace
 
-void merge( MeshPrimitive *a, const MeshPrimitive *b, const Canceller *canceller )
+MeshPrimitivePtr IECoreScene::MeshAlgo::merge( const std::vector<const MeshPrimitive *> &meshes, const Canceller *canceller )
 {
-	const auto &vertexIdsA = a->vertexIds()->readable();
-	const auto &verticesPerFaceA = a->verticesPerFace()->readable();
+	if( meshes.empty() )
+	{
+		throw IECore::InvalidArgumentException( "IECoreScene::MeshAlgo::merge : No Mesh Primitives were provided." );
+	}
 
-	const auto &vertexIdsB = b->vertexIds()->readable();
-	const auto &verticesPerFaceB = b->verticesPerFace()->readable();
+	// The first mesh provides the constant primitive variables and
+	// the mesh-level settings such as interpolation.
 
-	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
-	auto &verticesPerFace = verticesPerFaceData->writable();
-	Canceller::check( canceller );
-	verticesPerFace.resize( verticesPerFaceA.size() + verticesPerFaceB.size() );
-	Canceller::check( canceller );
-	auto it = std::copy( verticesPerFaceA.begin(), verticesPerFaceA.end(), verticesPerFace.begin() );
-	Canceller::check( canceller );
-	std::copy( verticesPerFaceB.begin(), verticesPerFaceB.end(), it );
+	MeshPrimitivePtr result = meshes[0]->copy();
+	if( meshes.size() == 1 )
+	{
+		return result;
+	}
 
-	IntVectorDataPtr vertexIdsData = new IntVectorData;
-	auto &vertexIds = vertexIdsData->writable();
-	Canceller::check( canceller );
-	vertexIds.resize( vertexIdsA.size() + vertexIdsB.size() );
-	Canceller::check( canceller );
-	it = std::copy( vertexIdsA.begin(), vertexIdsA.end(), vertexIds.begin() );
-	int vertexIdOffset = a->variableSize( PrimitiveVariable::Vertex );
-	auto idShift = [vertexIdOffset]( int id ){ return id + vertexIdOffset; };
-	Canceller::check( canceller );
-	std::transform( vertexIdsB.begin(), vertexIdsB.end(), it, idShift );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 
-	Canceller::check( canceller );
-	a->setTopologyUnchecked( verticesPerFaceData, vertexIdsData, a->variableSize( PrimitiveVariable::Vertex ) + b->variableSize( PrimitiveVariable::Vertex ), a->interpolation() );
+	// Topology
 
-	const auto &bCornerIds = b->cornerIds()->readable();
-	if( !bCornerIds.empty() )
+	std::vector<int> vertexOffsets( meshes.size(), 0 );
+	for( size_t i = 1; i < meshes.size(); ++i )
 	{
-		const auto &aCornerIds = a->cornerIds()->readable();
-		IntVectorDataPtr idData = new IntVectorData;
-		auto &ids = idData->writable();
-		Canceller::check( canceller );
-		ids.resize( aCornerIds.size() + bCornerIds.size() );
-		Canceller::check( canceller );
-		it = std::copy( aCornerIds.begin(), aCornerIds.end(), ids.begin() );
-		Canceller::check( canceller );
-		std::transform( bCornerIds.begin(), bCornerIds.end(), it, idShift );
-
-		const auto &aSharpnesses = a->cornerSharpnesses()->readable();
-		const auto &bSharpnesses = b->cornerSharpnesses()->readable();
-		FloatVectorDataPtr sharpnessData = new FloatVectorData;
-		auto &sharpnesses = sharpnessData->writable();
-		Canceller::check( canceller );
-		sharpnesses.resize( aSharpnesses.size() + bSharpnesses.size() );
-		Canceller::check( canceller );
-		auto fIt = std::copy( aSharpnesses.begin(), aSharpnesses.end(), sharpnesses.begin() );
-		Canceller::check( canceller );
-		std::copy( bSharpnesses.begin(), bSharpnesses.end(), fIt );
-
-		a->setCorners( idData.get(), sharpnessData.get() );
+		vertexOffsets[i] = vertexOffsets[i-1] + meshes[i-1]->variableSize( PrimitiveVariable::Vertex );
 	}
+	const int numVertices = vertexOffsets.back() + meshes.back()->variableSize( PrimitiveVariable::Vertex );
 
-	const auto &bCreaseIds = b->creaseIds()->readable();
-	if( !bCreaseIds.empty() )
-	{
-		const auto &aLengths = a->creaseLengths()->readable();
-		const auto &bLengths = b->creaseLengths()->readable();
-		IntVectorDataPtr lengthData = new IntVectorData;
-		auto &lengths = lengthData->writable();
-		Canceller::check( canceller );
-		lengths.resize( aLengths.size() + bLengths.size() );
-		Canceller::check( canceller );
-		it = std::copy( aLengths.begin(), aLengths.end(), lengths.begin() );
-		Canceller::check( canceller );
-		std::copy( bLengths.begin(), bLengths.end(), it );
+	IntVectorDataPtr verticesPerFaceData = concatenate<int>(
+		meshes, [] ( const MeshPrimitive *m ) -> const std::vector<int> & { return m->verticesPerFace()->readable(); },
+		nullptr, taskGroupContext, canceller
+	);
 
-		const auto &aCreaseIds = a->creaseIds()->readable();
-		IntVectorDataPtr idData = new IntVectorData;
-		auto &ids = idData->writable();
-		Canceller::check( canceller );
-		ids.resize( aCreaseIds.size() + bCreaseIds.size() );
-		Canceller::check( canceller );
-		it = std::copy( aCreaseIds.begin(), aCreaseIds.end(), ids.begin() );
-		Canceller::check( canceller );
-		std::transform( bCreaseIds.begin(), bCreaseIds.end(), it, idShift );
+	IntVectorDataPtr vertexIdsData = concatenate<int>(
+		meshes, [] ( const MeshPrimitive *m ) -> const std::vector<int> & { return m->vertexIds()->readable(); },
+		&vertexOffsets, taskGroupContext, canceller
+	);
 
-		const auto &aSharpnesses = a->creaseSharpnesses()->readable();
-		const auto &bSharpnesses = b->creaseSharpnesses()->readable();
-		FloatVectorDataPtr sharpnessData = new FloatVectorData;
-		auto &sharpnesses = sharpnessData->writable();
-		Canceller::check( canceller );
-		sharpnesses.resize( aSharpnesses.size() + bSharpnesses.size() );
-		Canceller::check( canceller );
-		auto fIt = std::copy( aSharpnesses.begin(), aSharpnesses.end(), sharpnesses.begin() );
-		Canceller::check( canceller );
-		std::copy( bSharpnesses.begin(), bSharpnesses.end(), fIt );
+	Canceller::check( canceller );
+	result->setTopologyUnchecked( verticesPerFaceData, vertexIdsData, numVertices, meshes[0]->interpolation() );
 
-		a->setCreases( lengthData.get(), idData.get(), sharpnessData.get() );
-	}
+	// Corners and creases
 
+	const bool hasCorners = std::any_of( meshes.begin(), meshes.end(), [] ( const MeshPrimitive *m ) { return !m->cornerIds()->readable().empty(); } );
+	if( hasCorners )
+	{
+		IntVectorDataPtr ids = concatenate<int>(
+			meshes, [] ( const MeshPrimitive *m ) -> const std::vector<int> & { return m->cornerIds()->readable(); },
+			&vertexOffsets, taskGroupContext, canceller
+		);
+		FloatVectorDataPtr sharpnesses = concatenate<float>(
+			meshes, [] ( const MeshPrimitive *m ) -> const std::vector<float> & { return m->cornerSharpnesses()->readable(); },
+			nullptr, taskGroupContext, canceller
+		);
+		result->setCorners( ids.get(), sharpnesses.get() );
+	}
 
-	/// \todo: can this be parallelized?
-	std::set<DataPtr> visitedData;
-	for( auto &pv : a->variables )
+	const bool hasCreases = std::any_of( meshes.begin(), meshes.end(), [] ( const MeshPrimitive *m ) { return !m->creaseIds()->readable().empty(); } );
+	if( hasCreases )
 	{
-		Canceller::check( canceller );
-		if( pv.second.interpolation != PrimitiveVariable::Constant )
-		{
-			IntVectorData *indices = pv.second.indices ? pv.second.indices.get() : nullptr;
-			AppendPrimVars f( a, b, pv.first, pv.second.interpolation, indices, visitedData, canceller );
-			despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pv.second.data.get(), f );
-		}
+		IntVectorDataPtr lengths = concatenate<int>(
+			meshes, [] ( const MeshPrimitive *m ) -> const std::vector<int> & { return m->creaseLengths()->readable(); },
+			nullptr, taskGroupContext, canceller
+		);
+		IntVectorDataPtr ids = concatenate<int>(
+			meshes, [] ( const MeshPrimitive *m ) -> const std::vector<int> & { return m->creaseIds()->readable(); },
+			&vertexOffsets, taskGroupContext, canceller
+		);
+		FloatVectorDataPtr sharpnesses = concatenate<float>(
+			meshes, [] ( const MeshPrimitive *m ) -> const std::vector<float> & { return m->creaseSharpnesses()->readable(); },
+			nullptr, taskGroupContext, canceller
+		);
+		result->setCreases( lengths.get(), ids.get(), sharpnesses.get() );
 	}
 
-	/// \todo: can this be parallelized?
-	std::map<ConstDataPtr, DataPtr> visitedData2;
-	for( auto &pv : b->variables )
+	// Primitive variables. We first find the definitive version of each
+	// variable, and then merge all variables in parallel.
+
+	std::vector<MergedVariable> variables;
+	std::unordered_set<std::string> names;
+	for( size_t i = 0; i < meshes.size(); ++i )
 	{
 		Canceller::check( canceller );
-		if( pv.second.interpolation != PrimitiveVariable::Constant )
+		for( const auto &pv : meshes[i]->variables )
 		{
-			PrependPrimVars f( a, pv.first, pv.second, visitedData2, canceller );
-			despatchTypedData<PrependPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pv.second.data.get(), f );
+			if( !names.insert( pv.first ).second )
+			{
+				continue;
+			}
+			if( pv.second.interpolation == PrimitiveVariable::Constant || !despatchTraitsTest<TypeTraits::IsVectorTypedData>( pv.second.data.get() ) )
+			{
+				// Variables from the first mesh are kept as they are, and
+				// others are ignored.
+				continue;
+			}
+			variables.push_back( { pv.first, &pv.second, i } );
 		}
 	}
-}
 
-} // namespace
-
-MeshPrimitivePtr IECoreScene::MeshAlgo::merge( const std::vector<const MeshPrimitive *> &meshes, const Canceller *canceller )
-{
-	if( meshes.empty() )
-	{
-		throw IECore::InvalidArgumentException( "IECoreScene::MeshAlgo::merge : No Mesh Primitives were provided." );
-	}
+	std::vector<PrimitiveVariable> mergedVariables( variables.size() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Canceller::check( canceller );
+				MergeVariableFn f( meshes, variables[i], canceller );
+				mergedVariables[i] = despatchTypedData<MergeVariableFn, TypeTraits::IsVectorTypedData>( const_cast<Data *>( variables[i].definition->data.get() ), f );
+			}
+		},
+		taskGroupContext
+	);
 
-	/// \todo: This scales poorly with increasing numbers of meshes.
-	/// Rather than allocating enough memory for everything and filling
-	/// it once, we're re-allocating and re-copying from the start for
-	/// each mesh. Improve the algorithm.
-	MeshPrimitivePtr result = meshes[0]->copy();
-	auto it = meshes.begin() + 1;
-	for( ; it != meshes.end(); ++it )
+	for( size_t i = 0; i < variables.size(); ++i )
 	{
-		Canceller::check( canceller );
-		::merge( result.get(), *it, canceller );
+		result->variables[variables[i].name] = mergedVariables[i];
 	}
 
 	return result;
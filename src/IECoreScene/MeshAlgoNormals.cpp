@@ -34,6 +34,7 @@
 
 #include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/PolygonIterator.h"
+#include "IECoreScene/private/PrimitiveAlgoUtils.h"
 
 #include "IECore/PolygonAlgo.h"
 
@@ -136,7 +137,7 @@ int joinedMatrixIndex( int i, int j, int n )
 	}
 }
 
-PrimitiveVariable calculateNormalsImpl( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation interpolation, MeshAlgo::NormalWeighting weighting, float thresholdAngle, const std::string &position, const Canceller *canceller )
+PrimitiveVariable calculateNormalsImpl( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation interpolation, MeshAlgo::NormalWeighting weighting, float thresholdAngle, const std::string &position, const Canceller *canceller, const MeshAlgo::MeshTopology *topology = nullptr )
 {
 	const V3fVectorData *pData = mesh->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
 	if( !pData )
@@ -155,17 +156,21 @@ PrimitiveVariable calculateNormalsImpl( const MeshPrimitive *mesh, PrimitiveVari
 
 	Canceller::check( canceller );
 
-	std::vector<int> startPerFace;
-	startPerFace.reserve( verticesPerFace.size() );
+	std::vector<int> startPerFaceStorage;
+	if( !topology )
+	{
+		startPerFaceStorage.reserve( verticesPerFace.size() );
 
-	Canceller::check( canceller );
+		Canceller::check( canceller );
 
-	int offset = 0;
-	for( auto numVerts : verticesPerFace )
-	{
-		startPerFace.push_back( offset );
-		offset += numVerts;
+		int offset = 0;
+		for( auto numVerts : verticesPerFace )
+		{
+			startPerFaceStorage.push_back( offset );
+			offset += numVerts;
+		}
 	}
+	const std::vector<int> &startPerFace = topology ? topology->faceOffsets() : startPerFaceStorage;
 
 	const auto &vertIds = mesh->vertexIds()->readable();
 
@@ -289,7 +294,7 @@ PrimitiveVariable calculateNormalsImpl( const MeshPrimitive *mesh, PrimitiveVari
 		cosThreshold = cosf( thresholdAngle / 180.0f * (float)M_PI );
 	}
 
-	auto [ faceVerticesData, faceVertexOffsetsData ] = MeshAlgo::correspondingFaceVertices( mesh, canceller );
+	auto [ faceVerticesData, faceVertexOffsetsData ] = MeshAlgo::correspondingFaceVertices( mesh, canceller, topology );
 	const std::vector<int> &faceVertices = faceVerticesData->readable();
 	const std::vector<int> &faceVertexOffsets = faceVertexOffsetsData->readable();
 
@@ -463,12 +468,17 @@ PrimitiveVariable MeshAlgo::calculateVertexNormals(
 }
 
 PrimitiveVariable MeshAlgo::calculateFaceVaryingNormals(
-	const MeshPrimitive *mesh, NormalWeighting weighting, float thresholdAngle, const std::string &position, const Canceller *canceller
+	const MeshPrimitive *mesh, NormalWeighting weighting, float thresholdAngle, const std::string &position, const Canceller *canceller, const MeshTopology *topology
 )
 {
+	if( topology )
+	{
+		Detail::validateTopology( mesh, topology, "MeshAlgo::calculateFaceVaryingNormals" );
+	}
+
 	return calculateNormalsImpl(
 		mesh, PrimitiveVariable::FaceVarying, weighting, thresholdAngle,
-		position, canceller
+		position, canceller, topology
 	);
 }
 
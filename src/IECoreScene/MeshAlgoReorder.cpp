@@ -33,9 +33,16 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/private/PrimitiveAlgoUtils.h"
+#include "IECoreScene/private/PrimitiveVariableAlgos.h"
 
 #include "IECore/DataAlgo.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -48,57 +55,10 @@ using namespace IECoreScene;
 namespace
 {
 
-typedef int FaceId;
-typedef int EdgeId;
 typedef int VertexId;
 
 typedef std::pair< VertexId, VertexId > Edge;
 
-typedef std::vector< FaceId > FaceList;
-typedef std::set< FaceId > FaceSet;
-typedef std::vector< Edge > EdgeList;
-typedef std::vector<VertexId> VertexList;
-
-typedef std::map< FaceId, EdgeList > FaceToEdgesMap;
-typedef std::map< FaceId, VertexList > FaceToVerticesMap;
-typedef std::map< VertexId, FaceSet > VertexToFacesMap;
-typedef std::map< Edge, FaceList > EdgeToConnectedFacesMap;
-
-struct ReorderFn
-{
-
-		ReorderFn( const std::vector<int> &remapping ) : m_remapping( remapping )
-		{
-		}
-
-		template<typename T>
-		DataPtr operator()( const TypedData<std::vector<T> > *d, const std::string &name )
-		{
-			const auto &inputs = d->readable();
-
-			typename TypedData<std::vector<T> >::Ptr data = d->copy();
-			auto &outputs = data->writable();
-
-			int i = 0;
-			for ( std::vector<int>::const_iterator it = m_remapping.begin(); it != m_remapping.end(); ++it, ++i )
-			{
-				outputs[i] = inputs[ *it ];
-			}
-
-			return data;
-		}
-
-		DataPtr operator()( Data *d, const std::string &name )
-		{
-			throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : \"{}\" has unsupported data type \"{}\".", name, d->typeName() ) );
-		}
-
-	private:
-
-		const std::vector<int> &m_remapping;
-
-};
-
 inline int index( int i, const int l )
 {
 	assert( l > 0 );
@@ -111,237 +71,195 @@ inline int index( int i, const int l )
 	return i % l;
 }
 
-int faceDirection( FaceToVerticesMap &faceToVerticesMap, FaceId face, Edge edge )
+// Walks the faces of a mesh depth first, across the edges of each face in
+// turn, numbering faces, vertices and face-vertices in the order they are
+// reached. Adjacent faces are found using the edges from the MeshTopology,
+// so the walk is linear in the size of the mesh. The walk uses an explicit
+// stack so that large meshes can't overflow the call stack.
+class Traversal
 {
-	FaceToVerticesMap::const_iterator vit = faceToVerticesMap.find( face );
-	assert( vit != faceToVerticesMap.end() );
-	const VertexList &faceVertices = vit->second;
-
-	int numFaceVertices = faceVertices.size();
-
-	VertexList::const_iterator it = std::find( faceVertices.begin(), faceVertices.end(), edge.first );
-	assert( it != faceVertices.end() );
-
-	int edgeVertexOrigin = std::distance( faceVertices.begin(), it );
 
-	assert( faceVertices[ index( edgeVertexOrigin, numFaceVertices )] == edge.first );
+	public :
 
-	int direction = 0;
-	if ( faceVertices[ index( edgeVertexOrigin+1, numFaceVertices )] == edge.second )
-	{
-		direction = 1;
-	}
-	else
-	{
-		assert( faceVertices[ index( edgeVertexOrigin-1, numFaceVertices )] == edge.second ) ;
-		direction = -1;
-	}
-
-	assert( direction == 1 || direction == -1 );
-	return direction;
-}
-
-void visitFace(
-	const MeshPrimitive * mesh,
-	FaceId currentFace,
-	Edge currentEdge,
-	FaceToVerticesMap &faceToVerticesMap,
-	FaceToEdgesMap &faceToEdgesMap,
-	VertexList &faceVaryingOffsets,
-	EdgeToConnectedFacesMap &edgeToConnectedFacesMap,
-	std::vector<VertexId> &vertexMap,
-	std::vector<VertexId> &vertexRemap,
-	std::vector<int> &newVerticesPerFace,
-	std::vector<VertexId> &newVertexIds,
-	std::vector<int> &faceVaryingRemap,
-	std::vector<int> &faceRemap,
-	int &nextVertex,
-	const Canceller *canceller
-)
-{
-	assert( currentEdge.first != currentEdge.second );
-
-	if ( faceRemap[ currentFace ] != -1 )
-	{
-		return;
-	}
-
-	Canceller::check( canceller );
-
-	FaceToEdgesMap::const_iterator currentFaceIt = faceToEdgesMap.find( currentFace );
-	assert( currentFaceIt != faceToEdgesMap.end() );
-	const EdgeList &faceEdges = currentFaceIt->second;
+		Traversal( const MeshPrimitive *mesh, const MeshAlgo::MeshTopology *topology, const Canceller *canceller )
+			:	m_vertexIds( mesh->vertexIds()->readable() ), m_topology( topology ), m_canceller( canceller ),
+				m_faceRemap( topology->numFaces(), -1 ), m_vertexMap( mesh->variableSize( PrimitiveVariable::Vertex ), -1 ),
+				m_vertexRemap( m_vertexMap.size(), -1 ), m_nextVertex( 0 )
+		{
+			// Record the faces using each edge, in face order.
 
-	assert( faceEdges.size() >= 3 );
+			const std::vector<int> &faceVertexFaces = m_topology->faceVertexFaces();
+			const std::vector<int> &faceVertexEdges = m_topology->faceVertexEdges();
 
-	FaceToVerticesMap::const_iterator vit = faceToVerticesMap.find( currentFace );
-	assert( vit != faceToVerticesMap.end() );
-	const VertexList &faceVertices = vit->second;
+			m_edgeFaces.resize( m_topology->numEdges() * 2, -1 );
+			std::vector<int> edgeFaceCounts( m_topology->numEdges(), 0 );
+			for( size_t i = 0; i < faceVertexEdges.size(); ++i )
+			{
+				const int edge = faceVertexEdges[i];
+				const int count = edgeFaceCounts[edge]++;
+				if( count >= 2 )
+				{
+					throw InvalidArgumentException( "MeshAlgo::reorderVertices : Cannot reorder non-manifold mesh." );
+				}
+				m_edgeFaces[edge * 2 + count] = faceVertexFaces[i];
+			}
 
-	int numFaceVertices = faceVertices.size();
+			m_newVerticesPerFace.reserve( m_faceRemap.size() );
+			m_newVertexIds.reserve( m_vertexIds.size() );
+			m_faceVaryingRemap.reserve( m_vertexIds.size() );
+		}
 
-	VertexList::const_iterator it = std::find( faceVertices.begin(), faceVertices.end(), currentEdge.first );
-	assert( it != faceVertices.end() );
+		void walk( int face, const Edge &edge )
+		{
+			visit( face, edge );
 
-	int currentEdgeVertexOrigin = std::distance( faceVertices.begin(), it );
+			const std::vector<int> &faceOffsets = m_topology->faceOffsets();
+			const std::vector<int> &faceVertexEdges = m_topology->faceVertexEdges();
 
-	assert( faceVertices[ index( currentEdgeVertexOrigin, numFaceVertices )] == currentEdge.first );
+			while( !m_stack.empty() )
+			{
+				Frame &frame = m_stack.back();
+				const int begin = faceOffsets[frame.face];
+				const int numFaceVertices = faceOffsets[frame.face+1] - begin;
+				if( frame.nextEdge == numFaceVertices )
+				{
+					m_stack.pop_back();
+					continue;
+				}
+
+				// Follow the current face's edges in order, moving onto the
+				// face adjacent to each one.
+				const int k = frame.nextEdge++;
+				const int faceVertex = begin + index( frame.direction == 1 ? frame.origin + k : frame.origin - 1 - k, numFaceVertices );
+				const int *faceEdges = &m_edgeFaces[faceVertexEdges[faceVertex] * 2];
+				if( faceEdges[1] == -1 )
+				{
+					continue;
+				}
+
+				const int nextFace = faceEdges[0] == frame.face ? faceEdges[1] : faceEdges[0];
+				if( m_faceRemap[nextFace] != -1 )
+				{
+					continue;
+				}
+
+				Edge nextEdge( m_vertexIds[faceVertex], m_vertexIds[begin + index( faceVertex - begin + 1, numFaceVertices )] );
+				int nextOrigin, nextDirection;
+				edgeOrigin( nextFace, nextEdge, nextOrigin, nextDirection );
+				if( nextDirection != frame.direction )
+				{
+					std::swap( nextEdge.first, nextEdge.second );
+				}
+
+				// Note : `frame` is invalidated by `visit()`.
+				visit( nextFace, nextEdge );
+			}
+		}
 
-	int faceVerticesDirection = faceDirection( faceToVerticesMap, currentFace, currentEdge );
+		const std::vector<int> &faceRemap() const { return m_faceRemap; }
+		const std::vector<VertexId> &vertexMap() const { return m_vertexMap; }
+		const std::vector<VertexId> &vertexRemap() const { return m_vertexRemap; }
+		const std::vector<int> &faceVaryingRemap() const { return m_faceVaryingRemap; }
 
-	EdgeList faceEdgesSorted( numFaceVertices );
-	VertexList faceVerticesSorted( numFaceVertices );
+		std::vector<int> &newVerticesPerFace() { return m_newVerticesPerFace; }
+		std::vector<VertexId> &newVertexIds() { return m_newVertexIds; }
 
-	int i;
-	for ( i = 0; i < numFaceVertices; i++ )
-	{
-		faceVerticesSorted[i] = faceVertices[index( currentEdgeVertexOrigin + i * faceVerticesDirection, numFaceVertices )];
+	private :
 
-		if ( faceVerticesDirection == 1 )
+		struct Frame
 		{
-			faceEdgesSorted[i] = faceEdges[index( currentEdgeVertexOrigin + i , numFaceVertices )];
-		}
-		else
+			int face;
+			int origin;
+			int direction;
+			int nextEdge;
+		};
+
+		// Finds the position of `edge.first` within `face`, and whether `edge`
+		// runs forwards or backwards around the face from there.
+		void edgeOrigin( int face, const Edge &edge, int &origin, int &direction ) const
 		{
-			faceEdgesSorted[i] = faceEdges[index( currentEdgeVertexOrigin - 1 - i, numFaceVertices )];
-		}
-	}
+			const std::vector<int> &faceOffsets = m_topology->faceOffsets();
+			const int begin = faceOffsets[face];
+			const int numFaceVertices = faceOffsets[face+1] - begin;
 
-	for ( i = 0; i < numFaceVertices; i++ )
-	{
-		VertexId vertIndex = faceVerticesSorted[i];
+			origin = std::find( m_vertexIds.begin() + begin, m_vertexIds.begin() + begin + numFaceVertices, edge.first ) - ( m_vertexIds.begin() + begin );
+			assert( origin < numFaceVertices );
 
-		if ( vertexMap[vertIndex] == -1 )
-		{
-			vertexMap[vertIndex] = nextVertex++;
-			vertexRemap[ vertexMap[vertIndex] ] = vertIndex;
+			if( m_vertexIds[begin + index( origin + 1, numFaceVertices )] == edge.second )
+			{
+				direction = 1;
+			}
+			else
+			{
+				assert( m_vertexIds[begin + index( origin - 1, numFaceVertices )] == edge.second );
+				direction = -1;
+			}
 		}
-	}
-
-	/// Create the "uniform" mapping
-	faceRemap[currentFace] = newVerticesPerFace.size();
-
-	/// Create the "vertex"/"varying" mapping
-	newVerticesPerFace.push_back( numFaceVertices );
-	for ( i = 0; i < numFaceVertices; i++ )
-	{
-		newVertexIds.push_back( vertexMap[ faceVerticesSorted[i] ] );
-	}
-
-	/// Create the "face-varying" mapping
-	int faceVaryingRemapStart = faceVaryingOffsets[ currentFace ];
-	int fvRelativeIdx = currentEdgeVertexOrigin;
-	for ( i = 0; i < numFaceVertices; i++ )
-	{
-		assert( faceVaryingRemapStart >= 0 );
-		assert( fvRelativeIdx >= 0 );
-		assert( fvRelativeIdx < numFaceVertices );
-
-		int fvIdx = faceVaryingRemapStart + fvRelativeIdx;
-
-		assert( fvIdx >= 0 );
-		assert( fvIdx < ( int )mesh->variableSize( PrimitiveVariable::FaceVarying ) );
-
-		faceVaryingRemap.push_back( fvIdx );
-
-		fvRelativeIdx += faceVerticesDirection;
-		fvRelativeIdx = index( fvRelativeIdx, numFaceVertices );
-	}
-
-	/// Follow current face's edges in order, recursing onto adjacent faces
-	for ( EdgeList::const_iterator edgeIt = faceEdgesSorted.begin(); edgeIt != faceEdgesSorted.end(); ++edgeIt )
-	{
-		Edge nextEdge( *edgeIt );
 
-		EdgeToConnectedFacesMap::const_iterator eit = edgeToConnectedFacesMap.find( nextEdge );
-		assert( eit != edgeToConnectedFacesMap.end() );
-		const FaceList &connectedFaces = eit->second;
-
-		/// Recurse onto the face adjacent to the next edge
-		if ( connectedFaces.size() > 1 )
+		void visit( int face, const Edge &edge )
 		{
-			int nextFace = ( connectedFaces[0] == currentFace ? connectedFaces[1] : connectedFaces[0] );
+			assert( edge.first != edge.second );
 
-			if ( faceDirection( faceToVerticesMap, nextFace, nextEdge ) != faceVerticesDirection )
+			if( m_faceRemap[face] != -1 )
 			{
-				std::swap( nextEdge.first, nextEdge.second );
-				assert( faceDirection( faceToVerticesMap, nextFace, nextEdge ) == faceVerticesDirection );
+				return;
 			}
 
-			visitFace(
-				mesh,
-				nextFace,
-				nextEdge,
-				faceToVerticesMap,
-				faceToEdgesMap,
-				faceVaryingOffsets,
-				edgeToConnectedFacesMap,
-				vertexMap,
-				vertexRemap,
-				newVerticesPerFace,
-				newVertexIds,
-				faceVaryingRemap,
-				faceRemap,
-				nextVertex,
-				canceller
-			);
-		}
-	}
-}
-
-void buildInternalTopology(
-	const std::vector<int> &vertexIds,
-	const std::vector<int> &verticesPerFace,
-	FaceToEdgesMap &faceToEdgesMap,
-	FaceToVerticesMap &faceToVerticesMap,
-	EdgeToConnectedFacesMap &edgeToConnectedFacesMap,
-	VertexToFacesMap &vertexToFacesMap,
-	VertexList &faceVaryingOffsets,
-	int numFaces,
-	int numVerts,
-	const Canceller *canceller
-)
-{
-	int vertOffset = 0;
-	int faceVaryingIdx = 0;
-
-	for( int f = 0; f < numFaces; ++f )
-	{
-		if( f % 1000 == 0 )
-		{
-			Canceller::check( canceller );
-		}
+			if( m_newVerticesPerFace.size() % 1000 == 0 )
+			{
+				Canceller::check( m_canceller );
+			}
 
-		int numFaceVertices = verticesPerFace[f];
-		assert( numFaceVertices >= 3 );
+			const std::vector<int> &faceOffsets = m_topology->faceOffsets();
+			const int begin = faceOffsets[face];
+			const int numFaceVertices = faceOffsets[face+1] - begin;
 
-		faceVaryingOffsets.push_back( faceVaryingIdx );
-		faceVaryingIdx += numFaceVertices;
+			int origin, direction;
+			edgeOrigin( face, edge, origin, direction );
 
-		for( int v = 0; v < numFaceVertices; ++v )
-		{
-			assert( vertOffset < (int)vertexIds.size() );
-			int vertexId = vertexIds[ vertOffset + v ];
+			/// Create the "uniform" mapping
+			m_faceRemap[face] = m_newVerticesPerFace.size();
+			m_newVerticesPerFace.push_back( numFaceVertices );
 
-			assert( vertexId < numVerts );
+			/// Create the "vertex"/"varying" and "face-varying" mappings
+			for( int i = 0; i < numFaceVertices; ++i )
+			{
+				const int faceVertex = begin + index( origin + i * direction, numFaceVertices );
+				const VertexId vertIndex = m_vertexIds[faceVertex];
+				if( m_vertexMap[vertIndex] == -1 )
+				{
+					m_vertexMap[vertIndex] = m_nextVertex++;
+					m_vertexRemap[ m_vertexMap[vertIndex] ] = vertIndex;
+				}
+
+				m_newVertexIds.push_back( m_vertexMap[vertIndex] );
+				m_faceVaryingRemap.push_back( faceVertex );
+			}
 
-			vertexToFacesMap[ vertexId ].insert( f );
+			m_stack.push_back( { face, origin, direction, 0 } );
+		}
 
-			faceToVerticesMap[ f ].push_back( vertexId );
+		const std::vector<int> &m_vertexIds;
+		const MeshAlgo::MeshTopology *m_topology;
+		const Canceller *m_canceller;
 
-			int nextVertexId = vertexIds[ vertOffset + (( v + 1 ) % numFaceVertices )];
+		// The faces using each edge, stored in pairs, with -1
+		// for the second face of boundary edges.
+		std::vector<int> m_edgeFaces;
 
-			faceToEdgesMap[ f ].push_back( Edge( vertexId, nextVertexId ) );
+		std::vector<int> m_faceRemap;
+		std::vector<VertexId> m_vertexMap;
+		std::vector<VertexId> m_vertexRemap;
+		std::vector<int> m_newVerticesPerFace;
+		std::vector<VertexId> m_newVertexIds;
+		std::vector<int> m_faceVaryingRemap;
+		int m_nextVertex;
 
-			edgeToConnectedFacesMap[ Edge( vertexId, nextVertexId )].push_back( f );
-			edgeToConnectedFacesMap[ Edge( nextVertexId, vertexId )].push_back( f );
-		}
+		std::vector<Frame> m_stack;
 
-		vertOffset += numFaceVertices;
-	}
-}
+};
 
-IntVectorDataPtr reorderIds( const std::vector<int> &ids, std::vector<VertexId> &vertexMap, const Canceller *canceller )
+IntVectorDataPtr reorderIds( const std::vector<int> &ids, const std::vector<VertexId> &vertexMap, const Canceller *canceller )
 {
 	IntVectorDataPtr result = new IntVectorData;
 	auto &outIds = result->writable();
@@ -364,14 +282,8 @@ IntVectorDataPtr reorderIds( const std::vector<int> &ids, std::vector<VertexId>
 
 } // namespace
 
-void MeshAlgo::reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2, const Canceller *canceller )
+void MeshAlgo::reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2, const Canceller *canceller, const MeshTopology *topology )
 {
-	FaceToEdgesMap faceToEdgesMap;
-	FaceToVerticesMap faceToVerticesMap;
-	EdgeToConnectedFacesMap edgeToConnectedFacesMap;
-	VertexToFacesMap vertexToFacesMap;
-	VertexList faceVaryingOffsets;
-
 	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
 	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
 	int numFaces = verticesPerFace.size();
@@ -382,85 +294,60 @@ void MeshAlgo::reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2,
 		throw InvalidArgumentException( "MeshAlgo::reorderVertices : Cannot reorder empty mesh." );
 	}
 
-	buildInternalTopology( vertexIds, verticesPerFace, faceToEdgesMap, faceToVerticesMap, edgeToConnectedFacesMap, vertexToFacesMap, faceVaryingOffsets, numFaces, numVerts, canceller );
-
-	for( EdgeToConnectedFacesMap::const_iterator it = edgeToConnectedFacesMap.begin(); it != edgeToConnectedFacesMap.end(); ++it )
+	ConstMeshTopologyPtr cachedTopology;
+	if( !topology )
 	{
-		if ( it->second.size() > 2 || it->second.size() == 0 )
-		{
-			throw InvalidArgumentException( "MeshAlgo::reorderVertices : Cannot reorder non-manifold mesh." );
-		}
+		cachedTopology = MeshAlgo::topology( mesh, canceller );
+		topology = cachedTopology.get();
 	}
-
-	VertexToFacesMap::const_iterator vIt0 = vertexToFacesMap.find( id0 );
-	if( vIt0 == vertexToFacesMap.end() )
+	else
 	{
-		throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : Cannot find vertex {}", id0 ) );
+		Detail::validateTopology( mesh, topology, "MeshAlgo::reorderVertices" );
 	}
 
-	VertexToFacesMap::const_iterator vIt1 = vertexToFacesMap.find( id1 );
-	if( vIt1 == vertexToFacesMap.end() )
-	{
-		throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : Cannot find vertex {}", id1 ) );
-	}
+	Traversal traversal( mesh, topology, canceller );
 
-	VertexToFacesMap::const_iterator vIt2 = vertexToFacesMap.find( id2 );
-	if( vIt2 == vertexToFacesMap.end() )
-	{
-		throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : Cannot find vertex {}", id2 ) );
-	}
+	// Find the face containing all three vertices.
 
-	FaceSet tmp;
+	const std::vector<int> &faceOffsets = topology->faceOffsets();
+	const std::vector<int> &faceVertexFaces = topology->faceVertexFaces();
+	const std::vector<int> &vertexFaceVertexOffsets = topology->vertexFaceVertexOffsets();
+	const std::vector<int> &vertexFaceVertices = topology->vertexFaceVertices();
 
-	const FaceSet &vtx0Faces = vIt0->second;
-	const FaceSet &vtx1Faces = vIt1->second;
-	const FaceSet &vtx2Faces = vIt2->second;
+	for( int id : { id0, id1, id2 } )
+	{
+		if( id < 0 || id >= numVerts || vertexFaceVertexOffsets[id] == vertexFaceVertexOffsets[id+1] )
+		{
+			throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : Cannot find vertex {}", id ) );
+		}
+	}
 
-	std::set_intersection(
-		vtx0Faces.begin(), vtx0Faces.end(),
-		vtx1Faces.begin(), vtx1Faces.end(),
-		std::inserter( tmp, tmp.end() )
-	);
+	auto faceHasVertex = [&]( int face, int id ) {
+		return std::find( vertexIds.begin() + faceOffsets[face], vertexIds.begin() + faceOffsets[face+1], id ) != vertexIds.begin() + faceOffsets[face+1];
+	};
 
-	FaceSet tmp2;
-	std::set_intersection(
-		tmp.begin(),  tmp.end(),
-		vtx2Faces.begin(),  vtx2Faces.end(),
-		std::inserter( tmp2, tmp2.end() )
-	);
+	std::vector<int> faces;
+	for( int i = vertexFaceVertexOffsets[id0]; i < vertexFaceVertexOffsets[id0+1]; ++i )
+	{
+		// Face-vertices are in ascending order, so repeated faces are adjacent.
+		const int face = faceVertexFaces[vertexFaceVertices[i]];
+		if( ( faces.empty() || faces.back() != face ) && faceHasVertex( face, id1 ) && faceHasVertex( face, id2 ) )
+		{
+			faces.push_back( face );
+		}
+	}
 
-	if( tmp2.size() != 1 )
+	if( faces.size() != 1 )
 	{
 		throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderVertices : Vertices {}, {}, and {} do not uniquely define a single polygon", id0, id1, id2 ) );
 	}
 
-	int currentFace = *tmp2.begin();
-	Edge currentEdge( id0, id1 );
-	std::vector<int> faceRemap( numFaces, -1 );
-	std::vector<VertexId> vertexMap( numVerts, -1 );
-	std::vector<VertexId> vertexRemap( numVerts, -1 );
-	std::vector<int> newVerticesPerFace;
-	std::vector<VertexId> newVertexIds;
-	std::vector<int> faceVaryingRemap;
-	int nextVertex = 0;
-
-	visitFace(
-		mesh,
-		currentFace,
-		currentEdge,
-		faceToVerticesMap,
-		faceToEdgesMap,
-		faceVaryingOffsets,
-		edgeToConnectedFacesMap,
-		vertexMap,
-		vertexRemap,
-		newVerticesPerFace,
-		newVertexIds,
-		faceVaryingRemap,
-		faceRemap,
-		nextVertex,
-		canceller
-	);
+	traversal.walk( faces[0], Edge( id0, id1 ) );
+
+	const std::vector<int> &faceRemap = traversal.faceRemap();
+	const std::vector<VertexId> &vertexMap = traversal.vertexMap();
+	const std::vector<VertexId> &vertexRemap = traversal.vertexRemap();
+	const std::vector<int> &faceVaryingRemap = traversal.faceVaryingRemap();
 
 	assert( (int)vertexMap.size() == numVerts );
 	assert( (int)vertexRemap.size() == numVerts );
@@ -492,14 +379,16 @@ void MeshAlgo::reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2,
 	}
 
 	assert( faceVaryingRemap.size() == mesh->variableSize( PrimitiveVariable::FaceVarying ) );
-	assert( newVerticesPerFace.size() == verticesPerFace.size() );
-	assert( newVertexIds.size() == vertexIds.size() );
+	assert( traversal.newVerticesPerFace().size() == verticesPerFace.size() );
+	assert( traversal.newVertexIds().size() == vertexIds.size() );
 
-	mesh->setTopologyUnchecked( new IntVectorData( newVerticesPerFace ), new IntVectorData( newVertexIds ), numVerts, mesh->interpolation() );
+	IntVectorDataPtr newVerticesPerFace = new IntVectorData;
+	newVerticesPerFace->writable().swap( traversal.newVerticesPerFace() );
+	IntVectorDataPtr newVertexIds = new IntVectorData;
+	newVertexIds->writable().swap( traversal.newVertexIds() );
 
-	ReorderFn vertexFn( vertexRemap );
-	ReorderFn faceVaryingFn( faceVaryingRemap );
-	ReorderFn uniformFn( faceRemap );
+	// Note : `vertexIds` and `verticesPerFace` may not be used after this.
+	mesh->setTopologyUnchecked( newVerticesPerFace, newVertexIds, numVerts, mesh->interpolation() );
 
 	const auto &cornerIds = mesh->cornerIds()->readable();
 	if( !cornerIds.empty() )
@@ -513,51 +402,335 @@ void MeshAlgo::reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2,
 		mesh->setCreases( mesh->creaseLengths(), reorderIds( creaseIds, vertexMap, canceller ).get(), mesh->creaseSharpnesses() );
 	}
 
-	int meshIndex = 0;
-	for( PrimitiveVariableMap::iterator it = mesh->variables.begin(); it != mesh->variables.end(); ++it, ++meshIndex )
+	PrimitiveVariableAlgos::reorderPrimitiveVariables(
+		mesh->variables,
+		[&]( PrimitiveVariable::Interpolation interpolation ) -> const std::vector<int> * {
+			switch( interpolation )
+			{
+				case PrimitiveVariable::Uniform :
+					return &faceRemap;
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					return &vertexRemap;
+				case PrimitiveVariable::FaceVarying :
+					return &faceVaryingRemap;
+				default :
+					return nullptr;
+			}
+		},
+		canceller
+	);
+
+	assert( mesh->arePrimitiveVariablesValid() );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Vertex cache and locality optimisation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Reorders the faces and vertices of a mesh, given the original index of each
+// face and vertex in the new order. Face-varying elements follow their faces.
+void reorderFacesAndVertices( MeshPrimitive *mesh, const std::vector<int> &faceOrder, const std::vector<int> &vertexOrder, const Canceller *canceller )
+{
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const int numVerts = mesh->variableSize( PrimitiveVariable::Vertex );
+
+	assert( faceOrder.size() == verticesPerFace.size() );
+	assert( (int)vertexOrder.size() == numVerts );
+
+	std::vector<int> faceOffsets( verticesPerFace.size() + 1, 0 );
+	std::partial_sum( verticesPerFace.begin(), verticesPerFace.end(), faceOffsets.begin() + 1 );
+
+	IntVectorDataPtr newVerticesPerFaceData = new IntVectorData;
+	std::vector<int> &newVerticesPerFace = newVerticesPerFaceData->writable();
+	newVerticesPerFace.resize( faceOrder.size() );
+	std::vector<int> newFaceOffsets( faceOrder.size() + 1, 0 );
+	for( size_t i = 0; i < faceOrder.size(); ++i )
+	{
+		newVerticesPerFace[i] = verticesPerFace[faceOrder[i]];
+		newFaceOffsets[i+1] = newFaceOffsets[i] + newVerticesPerFace[i];
+	}
+
+	std::vector<VertexId> vertexMap( numVerts );
+	for( int i = 0; i < numVerts; ++i )
 	{
-		if( meshIndex % 1000 == 0 )
+		vertexMap[vertexOrder[i]] = i;
+	}
+
+	IntVectorDataPtr newVertexIdsData = new IntVectorData;
+	std::vector<VertexId> &newVertexIds = newVertexIdsData->writable();
+	newVertexIds.resize( vertexIds.size() );
+	std::vector<int> faceVaryingOrder( vertexIds.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, faceOrder.size(), 1000 ),
+		[&]( const tbb::blocked_range<size_t> &range )
 		{
 			Canceller::check( canceller );
-		}
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const int begin = faceOffsets[faceOrder[i]];
+				for( int j = 0; j < newVerticesPerFace[i]; ++j )
+				{
+					faceVaryingOrder[newFaceOffsets[i] + j] = begin + j;
+					newVertexIds[newFaceOffsets[i] + j] = vertexMap[vertexIds[begin + j]];
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	IntVectorDataPtr newCornerIds = reorderIds( mesh->cornerIds()->readable(), vertexMap, canceller );
+	IntVectorDataPtr newCreaseIds = reorderIds( mesh->creaseIds()->readable(), vertexMap, canceller );
+
+	// Note : `vertexIds` and `verticesPerFace` may not be used after this.
+	mesh->setTopologyUnchecked( newVerticesPerFaceData, newVertexIdsData, numVerts, mesh->interpolation() );
+
+	if( !newCornerIds->readable().empty() )
+	{
+		mesh->setCorners( newCornerIds.get(), mesh->cornerSharpnesses() );
+	}
+
+	if( !newCreaseIds->readable().empty() )
+	{
+		mesh->setCreases( mesh->creaseLengths(), newCreaseIds.get(), mesh->creaseSharpnesses() );
+	}
+
+	PrimitiveVariableAlgos::reorderPrimitiveVariables(
+		mesh->variables,
+		[&]( PrimitiveVariable::Interpolation interpolation ) -> const std::vector<int> * {
+			switch( interpolation )
+			{
+				case PrimitiveVariable::Uniform :
+					return &faceOrder;
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					return &vertexOrder;
+				case PrimitiveVariable::FaceVarying :
+					return &faceVaryingOrder;
+				default :
+					return nullptr;
+			}
+		},
+		canceller
+	);
+
+	assert( mesh->arePrimitiveVariablesValid() );
+}
+
+} // namespace
+
+void MeshAlgo::optimizeVertexCache( MeshPrimitive *mesh, int cacheSize, const Canceller *canceller, const MeshTopology *topology )
+{
+	if( cacheSize < 3 )
+	{
+		throw InvalidArgumentException( fmt::format( "MeshAlgo::optimizeVertexCache : Cache size {} is less than 3.", cacheSize ) );
+	}
+
+	ConstMeshTopologyPtr cachedTopology;
+	if( !topology )
+	{
+		cachedTopology = MeshAlgo::topology( mesh, canceller );
+		topology = cachedTopology.get();
+	}
+	else
+	{
+		// The face and vertex orders are built from the topology, and
+		// must match the mesh for `reorderFacesAndVertices()`.
+		Detail::validateTopology( mesh, topology, "MeshAlgo::optimizeVertexCache" );
+	}
+
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const std::vector<int> &faceOffsets = topology->faceOffsets();
+	const std::vector<int> &faceVertexFaces = topology->faceVertexFaces();
+	const std::vector<int> &vertexFaceVertexOffsets = topology->vertexFaceVertexOffsets();
+	const std::vector<int> &vertexFaceVertices = topology->vertexFaceVertices();
+	const int numFaces = topology->numFaces();
+	const int numVerts = topology->numVertices();
+
+	// Order the faces using the "Tipsify" algorithm from "Fast Triangle Reordering
+	// for Vertex Locality and Reduced Overdraw" (Sander et al. 2007). We emit all the
+	// remaining faces around a "fanning" vertex, and then fan around whichever of
+	// their vertices is likely to still be in a FIFO cache of `cacheSize` vertices,
+	// using a simulated timestamp for each vertex. Polygons are treated just like
+	// triangles, so the order is also good for meshes which are triangulated later.
+
+	std::vector<int> liveFaceVertices( numVerts );
+	for( int v = 0; v < numVerts; ++v )
+	{
+		liveFaceVertices[v] = vertexFaceVertexOffsets[v+1] - vertexFaceVertexOffsets[v];
+	}
+
+	std::vector<int> cacheTimes( numVerts, 0 );
+	std::vector<bool> emitted( numFaces, false );
+	std::vector<int> faceOrder;
+	faceOrder.reserve( numFaces );
 
-		if( it->second.interpolation == PrimitiveVariable::FaceVarying )
+	std::vector<VertexId> deadEnds;
+	std::vector<VertexId> candidates;
+	int time = cacheSize + 1;
+	int cursor = 0;
+
+	// Finds a vertex to continue from when the last fan didn't
+	// leave any candidates.
+	auto nextVertex = [&]() -> int {
+		while( !deadEnds.empty() )
 		{
-			assert( it->second.data );
-			if( it->second.indices )
+			const int v = deadEnds.back();
+			deadEnds.pop_back();
+			if( liveFaceVertices[v] > 0 )
 			{
-				it->second.indices = runTimeCast<IntVectorData>( faceVaryingFn( it->second.indices.get(), it->first ) );
+				return v;
 			}
-			else
+		}
+		while( cursor < numVerts )
+		{
+			if( liveFaceVertices[cursor] > 0 )
 			{
-				it->second.data = dispatch( it->second.data.get(), faceVaryingFn, it->first );
+				return cursor;
 			}
+			++cursor;
 		}
-		else if( it->second.interpolation == PrimitiveVariable::Vertex || it->second.interpolation == PrimitiveVariable::Varying )
+		return -1;
+	};
+
+	int fanningVertex = nextVertex();
+	while( fanningVertex != -1 )
+	{
+		Canceller::check( canceller );
+
+		candidates.clear();
+		for( int i = vertexFaceVertexOffsets[fanningVertex]; i < vertexFaceVertexOffsets[fanningVertex+1]; ++i )
 		{
-			assert( it->second.data );
-			if( it->second.indices )
+			const int face = faceVertexFaces[vertexFaceVertices[i]];
+			if( emitted[face] )
 			{
-				it->second.indices = runTimeCast<IntVectorData>( vertexFn( it->second.indices.get(), it->first ) );
+				continue;
 			}
-			else
+
+			emitted[face] = true;
+			faceOrder.push_back( face );
+			for( int j = faceOffsets[face]; j < faceOffsets[face+1]; ++j )
 			{
-				it->second.data = dispatch( it->second.data.get(), vertexFn, it->first );
+				const VertexId v = vertexIds[j];
+				deadEnds.push_back( v );
+				candidates.push_back( v );
+				--liveFaceVertices[v];
+				if( time - cacheTimes[v] > cacheSize )
+				{
+					cacheTimes[v] = time++;
+				}
 			}
 		}
-		else if( it->second.interpolation == PrimitiveVariable::Uniform )
+
+		// Prefer the candidate that has been in the cache longest, provided
+		// it will still be there after emitting all its remaining faces.
+		int bestVertex = -1;
+		int bestPriority = -1;
+		for( VertexId v : candidates )
 		{
-			assert( it->second.data );
-			if( it->second.indices )
+			if( liveFaceVertices[v] <= 0 )
 			{
-				it->second.indices = runTimeCast<IntVectorData>( uniformFn( it->second.indices.get(), it->first ) );
+				continue;
 			}
-			else
+
+			int priority = 0;
+			if( time - cacheTimes[v] + 2 * liveFaceVertices[v] <= cacheSize )
+			{
+				priority = time - cacheTimes[v];
+			}
+
+			if( priority > bestPriority )
 			{
-				it->second.data = dispatch( it->second.data.get(), uniformFn, it->first );
+				bestVertex = v;
+				bestPriority = priority;
 			}
 		}
+
+		fanningVertex = bestVertex != -1 ? bestVertex : nextVertex();
 	}
 
-	assert( mesh->arePrimitiveVariablesValid() );
+	// Faces without vertices are never reached from a vertex.
+	for( int face = 0; face < numFaces; ++face )
+	{
+		if( !emitted[face] )
+		{
+			faceOrder.push_back( face );
+		}
+	}
+
+	// Number the vertices in order of first use, so that vertex data is
+	// also accessed coherently. Unused vertices go at the end.
+
+	std::vector<VertexId> vertexMap( numVerts, -1 );
+	std::vector<int> vertexOrder;
+	vertexOrder.reserve( numVerts );
+	for( int face : faceOrder )
+	{
+		for( int j = faceOffsets[face]; j < faceOffsets[face+1]; ++j )
+		{
+			const VertexId v = vertexIds[j];
+			if( vertexMap[v] == -1 )
+			{
+				vertexMap[v] = vertexOrder.size();
+				vertexOrder.push_back( v );
+			}
+		}
+	}
+
+	for( int v = 0; v < numVerts; ++v )
+	{
+		if( vertexMap[v] == -1 )
+		{
+			vertexOrder.push_back( v );
+		}
+	}
+
+	reorderFacesAndVertices( mesh, faceOrder, vertexOrder, canceller );
+}
+
+void MeshAlgo::reorderForLocality( MeshPrimitive *mesh, const std::string &position, const Canceller *canceller )
+{
+	const V3fVectorData *positionData = mesh->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !positionData )
+	{
+		throw InvalidArgumentException( fmt::format( "MeshAlgo::reorderForLocality : MeshPrimitive has no Vertex \"{}\" primitive variable.", position ) );
+	}
+
+	const std::vector<V3f> &positions = positionData->readable();
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+
+	std::vector<int> faceOffsets( verticesPerFace.size() + 1, 0 );
+	std::partial_sum( verticesPerFace.begin(), verticesPerFace.end(), faceOffsets.begin() + 1 );
+
+	std::vector<V3f> centroids( verticesPerFace.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, verticesPerFace.size(), 1000 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				V3f centroid( 0 );
+				for( int j = faceOffsets[i]; j < faceOffsets[i+1]; ++j )
+				{
+					centroid += positions[vertexIds[j]];
+				}
+				centroids[i] = verticesPerFace[i] ? centroid / verticesPerFace[i] : centroid;
+			}
+		},
+		taskGroupContext
+	);
+
+	const std::vector<int> vertexOrder = Detail::spatialOrder( positions, canceller );
+	const std::vector<int> faceOrder = Detail::spatialOrder( centroids, canceller );
+
+	reorderFacesAndVertices( mesh, faceOrder, vertexOrder, canceller );
 }
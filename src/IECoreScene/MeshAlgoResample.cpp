@@ -32,7 +32,6 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "IECoreScene/FaceVaryingPromotionOp.h"
 #include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/private/PrimitiveAlgoUtils.h"
 #include "IECoreScene/private/PrimitiveVariableAlgos.h"
@@ -40,6 +39,13 @@
 #include "IECore/DataAlgo.h"
 #include "IECore/DespatchTypedData.h"
 
+#include "fmt/format.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <numeric>
+
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
@@ -51,106 +57,128 @@ using namespace IECoreScene;
 namespace
 {
 
-struct MeshVertexToUniform
+bool needsFaceOffsets( PrimitiveVariable::Interpolation srcInterpolation, PrimitiveVariable::Interpolation interpolation )
 {
-	typedef DataPtr ReturnType;
+	return
+		( interpolation == PrimitiveVariable::Uniform && ( srcInterpolation == PrimitiveVariable::Vertex || srcInterpolation == PrimitiveVariable::Varying || srcInterpolation == PrimitiveVariable::FaceVarying ) ) ||
+		( interpolation == PrimitiveVariable::FaceVarying && srcInterpolation == PrimitiveVariable::Uniform )
+	;
+}
 
-	MeshVertexToUniform( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
-	{
-	}
+bool needsVertexFaceVertices( PrimitiveVariable::Interpolation srcInterpolation, PrimitiveVariable::Interpolation interpolation )
+{
+	return
+		( interpolation == PrimitiveVariable::Vertex || interpolation == PrimitiveVariable::Varying ) &&
+		( srcInterpolation == PrimitiveVariable::Uniform || srcInterpolation == PrimitiveVariable::FaceVarying )
+	;
+}
 
-	template<typename From> ReturnType operator()( const From* data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
+// The adjacency used by the resampling kernels. This is borrowed from
+// the MeshTopology when one is provided, and otherwise only the parts
+// that are needed are computed.
+class Adjacency
+{
 
-		// TODO sipmlify this code by using polygon face & vertex iterators
-		trg.reserve( m_mesh->numFaces() );
+	public :
 
-		std::vector<int>::const_iterator vId = m_mesh->vertexIds()->readable().begin();
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it )
+		Adjacency( const MeshPrimitive *mesh, const MeshAlgo::MeshTopology *topology, bool faceOffsets, bool vertexFaceVertices, const Canceller *canceller )
+			:	m_faceOffsets( &m_faceOffsetsStorage ), m_faceVertexFaces( &m_faceVertexFacesStorage ),
+				m_vertexFaceVertexOffsets( &m_vertexFaceVertexOffsetsStorage ), m_vertexFaceVertices( &m_vertexFaceVerticesStorage )
 		{
-			Canceller::check( m_canceller );
-
-			// initialize with the first value to avoid
-			// ambiguitity during default construction
-			typename From::ValueType::value_type total = src[ *vId ];
-			++vId;
-
-			for( int j = 1; j < *it; ++j, ++vId )
+			if( topology )
 			{
-				total += src[ *vId ];
+				m_faceOffsets = &topology->faceOffsets();
+				m_faceVertexFaces = &topology->faceVertexFaces();
+				m_vertexFaceVertexOffsets = &topology->vertexFaceVertexOffsets();
+				m_vertexFaceVertices = &topology->vertexFaceVertices();
+				return;
 			}
 
-			trg.push_back( total / *it );
-		}
+			if( !faceOffsets && !vertexFaceVertices )
+			{
+				return;
+			}
 
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
+			Canceller::check( canceller );
 
-		return result;
-	}
+			const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+			m_faceOffsetsStorage.reserve( verticesPerFace.size() + 1 );
+			int offset = 0;
+			for( int numVerts : verticesPerFace )
+			{
+				m_faceOffsetsStorage.push_back( offset );
+				offset += numVerts;
+			}
+			m_faceOffsetsStorage.push_back( offset );
 
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
-};
+			if( !vertexFaceVertices )
+			{
+				return;
+			}
 
-struct MeshUniformToVertex
-{
-	typedef DataPtr ReturnType;
+			Canceller::check( canceller );
 
-	MeshUniformToVertex( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
-	{
-	}
+			const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+			m_faceVertexFacesStorage.resize( vertexIds.size() );
+			for( size_t f = 0; f < verticesPerFace.size(); ++f )
+			{
+				std::fill(
+					m_faceVertexFacesStorage.begin() + m_faceOffsetsStorage[f],
+					m_faceVertexFacesStorage.begin() + m_faceOffsetsStorage[f+1],
+					(int)f
+				);
+			}
 
-	template<typename From> ReturnType operator()( const From* data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
+			Canceller::check( canceller );
 
-		size_t numVerts = m_mesh->variableSize( PrimitiveVariable::Vertex );
-		std::vector<int> count( numVerts, 0 );
-		trg.resize( numVerts, typename From::ValueType::value_type( 0.0f ) );
+			// Counting sort of the face-vertices by vertex, which leaves the
+			// face-vertices of each vertex in ascending order.
+			m_vertexFaceVertexOffsetsStorage.assign( mesh->variableSize( PrimitiveVariable::Vertex ) + 1, 0 );
+			for( int vertexId : vertexIds )
+			{
+				++m_vertexFaceVertexOffsetsStorage[vertexId + 1];
+			}
+			std::partial_sum( m_vertexFaceVertexOffsetsStorage.begin(), m_vertexFaceVertexOffsetsStorage.end(), m_vertexFaceVertexOffsetsStorage.begin() );
 
-		typename From::ValueType::const_iterator srcIt = src.begin();
-		std::vector<int>::const_iterator vId = m_mesh->vertexIds()->readable().begin();
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it, ++srcIt )
-		{
-			Canceller::check( m_canceller );
+			Canceller::check( canceller );
 
-			for( int j = 0; j < *it; ++j, ++vId )
+			std::vector<int> next( m_vertexFaceVertexOffsetsStorage.begin(), m_vertexFaceVertexOffsetsStorage.end() - 1 );
+			m_vertexFaceVerticesStorage.resize( vertexIds.size() );
+			for( size_t i = 0; i < vertexIds.size(); ++i )
 			{
-				trg[ *vId ] += *srcIt;
-				++count[ *vId ];
+				m_vertexFaceVerticesStorage[next[vertexIds[i]]++] = i;
 			}
 		}
 
-		std::vector<int>::const_iterator cIt = count.begin();
-		typename From::ValueType::iterator trgIt = trg.begin(), trgEnd = trg.end();
-		for( trgIt = trg.begin(); trgIt != trgEnd ; ++trgIt, ++cIt )
-		{
-			*trgIt /= *cIt;
-		}
+		Adjacency( const Adjacency & ) = delete;
+		Adjacency &operator=( const Adjacency & ) = delete;
 
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
+		const std::vector<int> &faceOffsets() const { return *m_faceOffsets; }
+		const std::vector<int> &faceVertexFaces() const { return *m_faceVertexFaces; }
+		const std::vector<int> &vertexFaceVertexOffsets() const { return *m_vertexFaceVertexOffsets; }
+		const std::vector<int> &vertexFaceVertices() const { return *m_vertexFaceVertices; }
 
-		return result;
-	}
+	private :
+
+		const std::vector<int> *m_faceOffsets;
+		const std::vector<int> *m_faceVertexFaces;
+		const std::vector<int> *m_vertexFaceVertexOffsets;
+		const std::vector<int> *m_vertexFaceVertices;
+
+		std::vector<int> m_faceOffsetsStorage;
+		std::vector<int> m_faceVertexFacesStorage;
+		std::vector<int> m_vertexFaceVertexOffsetsStorage;
+		std::vector<int> m_vertexFaceVerticesStorage;
 
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
 };
 
-struct MeshFaceVaryingToVertex
+// Averages Vertex, Varying or FaceVarying data over each face.
+struct MeshToUniform
 {
 	typedef DataPtr ReturnType;
 
-	MeshFaceVaryingToVertex( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
+	MeshToUniform( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation srcInterpolation, const Adjacency &adjacency, const Canceller *canceller )
+		:	m_mesh( mesh ), m_faceVarying( srcInterpolation == PrimitiveVariable::FaceVarying ), m_adjacency( adjacency ), m_canceller( canceller )
 	{
 	}
 
@@ -160,37 +188,28 @@ struct MeshFaceVaryingToVertex
 		typename From::ValueType &trg = result->writable();
 		const typename From::ValueType &src = data->readable();
 
-		size_t numVerts = m_mesh->variableSize( PrimitiveVariable::Vertex );
-		std::vector<int> count( numVerts, 0 );
-		trg.resize( numVerts, typename From::ValueType::value_type( 0.0f ) );
+		const std::vector<int> &vertexIds = m_mesh->vertexIds()->readable();
+		const std::vector<int> &faceOffsets = m_adjacency.faceOffsets();
 
-		const std::vector<int>& vertexIds = m_mesh->vertexIds()->readable();
-		std::vector<int>::const_iterator vertexIdIt = vertexIds.begin();
-		typename From::ValueType::const_iterator srcIt = src.begin(), srcEnd = src.end();
-
-		int cancelTestCounter = 0;
-		for( ; srcIt != srcEnd ; ++srcIt, ++vertexIdIt )
-		{
-			if( cancelTestCounter++ == 1000 )
+		trg.resize( m_mesh->numFaces() );
+		IECoreScene::Detail::parallelForEach(
+			trg.size(), m_canceller,
+			[&]( size_t faceIndex )
 			{
-				Canceller::check( m_canceller );
-				cancelTestCounter = 0;
+				const int begin = faceOffsets[faceIndex];
+				const int end = faceOffsets[faceIndex+1];
+
+				// initialize with the first value to avoid
+				// ambiguity during default construction
+				typename From::ValueType::value_type total = src[ m_faceVarying ? begin : vertexIds[begin] ];
+				for( int i = begin + 1; i < end; ++i )
+				{
+					total += src[ m_faceVarying ? i : vertexIds[i] ];
+				}
+
+				trg[faceIndex] = total / ( end - begin );
 			}
-			trg[ *vertexIdIt ] += *srcIt;
-			++count[ *vertexIdIt ];
-		}
-
-		std::vector<int>::const_iterator cIt = count.begin();
-		typename From::ValueType::iterator trgIt = trg.begin(), trgEnd = trg.end();
-		for( trgIt = trg.begin(); trgIt != trgEnd ; ++trgIt, ++cIt )
-		{
-			if( cancelTestCounter++ == 1000 )
-			{
-				Canceller::check( m_canceller );
-				cancelTestCounter = 0;
-			}
-			*trgIt /= *cIt;
-		}
+		);
 
 		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
 		copier( data, result.get() );
@@ -199,14 +218,20 @@ struct MeshFaceVaryingToVertex
 	}
 
 	const MeshPrimitive *m_mesh;
+	const bool m_faceVarying;
+	const Adjacency &m_adjacency;
 	const Canceller *m_canceller;
 };
 
-struct MeshFaceVaryingToUniform
+// Averages Uniform or FaceVarying data over the face-vertices
+// referencing each vertex. The values are summed in face-vertex
+// order, so the result is independent of the number of threads.
+struct MeshToVertex
 {
 	typedef DataPtr ReturnType;
 
-	MeshFaceVaryingToUniform( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
+	MeshToVertex( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation srcInterpolation, const Adjacency &adjacency, const Canceller *canceller )
+		:	m_mesh( mesh ), m_uniform( srcInterpolation == PrimitiveVariable::Uniform ), m_adjacency( adjacency ), m_canceller( canceller )
 	{
 	}
 
@@ -216,27 +241,32 @@ struct MeshFaceVaryingToUniform
 		typename From::ValueType &trg = result->writable();
 		const typename From::ValueType &src = data->readable();
 
-		trg.reserve( m_mesh->numFaces() );
-
-		typename From::ValueType::const_iterator srcIt = src.begin();
-
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it )
-		{
-			Canceller::check( m_canceller );
-
-			// initialize with the first value to avoid
-			// ambiguity during default construction
-			typename From::ValueType::value_type total = *srcIt;
-			++srcIt;
+		const std::vector<int> &offsets = m_adjacency.vertexFaceVertexOffsets();
+		const std::vector<int> &faceVertices = m_adjacency.vertexFaceVertices();
+		const std::vector<int> &faceVertexFaces = m_adjacency.faceVertexFaces();
 
-			for( int j = 1; j < *it; ++j, ++srcIt )
+		trg.resize( m_mesh->variableSize( PrimitiveVariable::Vertex ) );
+		IECoreScene::Detail::parallelForEach(
+			trg.size(), m_canceller,
+			[&]( size_t vertexIndex )
 			{
-				total += *srcIt;
+				const int begin = offsets[vertexIndex];
+				const int end = offsets[vertexIndex+1];
+
+				typename From::ValueType::value_type total( 0.0f );
+				for( int i = begin; i < end; ++i )
+				{
+					total += src[ m_uniform ? faceVertexFaces[faceVertices[i]] : faceVertices[i] ];
+				}
+
+				// Vertices not referenced by any face are left at zero.
+				if( end > begin )
+				{
+					total /= ( end - begin );
+				}
+				trg[vertexIndex] = total;
 			}
-
-			trg.push_back( total / *it );
-		}
+		);
 
 		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
 		copier( data, result.get() );
@@ -245,46 +275,65 @@ struct MeshFaceVaryingToUniform
 	}
 
 	const MeshPrimitive *m_mesh;
+	const bool m_uniform;
+	const Adjacency &m_adjacency;
 	const Canceller *m_canceller;
 };
 
-struct MeshAnythingToFaceVarying
+// Copies Uniform, Vertex or Varying data to each face-vertex.
+struct MeshToFaceVarying
 {
 	typedef DataPtr ReturnType;
 
-	MeshAnythingToFaceVarying( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation srcInterpolation, const Canceller *canceller )
-		: m_mesh( mesh ), m_srcInterpolation( srcInterpolation ), m_canceller( canceller )
+	MeshToFaceVarying( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation srcInterpolation, const Adjacency &adjacency, const Canceller *canceller )
+		:	m_mesh( mesh ), m_uniform( srcInterpolation == PrimitiveVariable::Uniform ), m_adjacency( adjacency ), m_canceller( canceller )
 	{
 	}
 
 	template<typename From> ReturnType operator()( const From* data )
 	{
+		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
+		typename From::ValueType &trg = result->writable();
+		const typename From::ValueType &src = data->readable();
 
-		// TODO replace the call to the IECore::FaceVaryingPromotionOpPtr and include the logic in this file ( with cancellation ).
+		const std::vector<int> &vertexIds = m_mesh->vertexIds()->readable();
+		trg.resize( vertexIds.size() );
 
-		// we need to duplicate because the Op expects a primvar to manipulate..
-		MeshPrimitivePtr tmpMesh = m_mesh->copy();
-		// cast OK due to read-only access.
-		tmpMesh->variables["tmpPrimVar"] = PrimitiveVariable( m_srcInterpolation, const_cast< From * >(data) );
-		FaceVaryingPromotionOpPtr promoteOp = new FaceVaryingPromotionOp();
-		promoteOp->inputParameter()->setValue( tmpMesh );
-		IECore::StringVectorDataPtr names = new StringVectorData();
-		names->writable().push_back( "tmpPrimVar" );
-		promoteOp->primVarNamesParameter()->setValue( names );
-		ReturnType result = runTimeCast< MeshPrimitive >( promoteOp->operate() )->variables["tmpPrimVar"].data;
+		if( m_uniform )
+		{
+			const std::vector<int> &faceOffsets = m_adjacency.faceOffsets();
+			IECoreScene::Detail::parallelForEach(
+				m_mesh->numFaces(), m_canceller,
+				[&]( size_t faceIndex )
+				{
+					std::fill( trg.begin() + faceOffsets[faceIndex], trg.begin() + faceOffsets[faceIndex+1], src[faceIndex] );
+				}
+			);
+		}
+		else
+		{
+			IECoreScene::Detail::parallelForEach(
+				vertexIds.size(), m_canceller,
+				[&]( size_t i )
+				{
+					trg[i] = src[vertexIds[i]];
+				}
+			);
+		}
 
+		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
+		copier( data, result.get() );
 
 		return result;
 	}
 
 	const MeshPrimitive *m_mesh;
-	PrimitiveVariable::Interpolation m_srcInterpolation;
+	const bool m_uniform;
+	const Adjacency &m_adjacency;
 	const Canceller *m_canceller;
 };
 
-} // namespace
-
-void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller )
+void resample( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const Adjacency &adjacency, const Canceller *canceller )
 {
 	PrimitiveVariable::Interpolation srcInterpolation = primitiveVariable.interpolation;
 	if ( srcInterpolation == interpolation )
@@ -340,28 +389,15 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 
 	if( interpolation == PrimitiveVariable::Uniform )
 	{
-		if( srcInterpolation == PrimitiveVariable::Varying || srcInterpolation == PrimitiveVariable::Vertex )
-		{
-			MeshVertexToUniform fn( mesh, canceller );
-			dstData = despatchTypedData<MeshVertexToUniform, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
-		}
-		else if( srcInterpolation == PrimitiveVariable::FaceVarying )
-		{
-			MeshFaceVaryingToUniform fn( mesh, canceller );
-			dstData = despatchTypedData<MeshFaceVaryingToUniform, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
-		}
+		MeshToUniform fn( mesh, srcInterpolation, adjacency, canceller );
+		dstData = despatchTypedData<MeshToUniform, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 	}
 	else if( interpolation == PrimitiveVariable::Varying || interpolation == PrimitiveVariable::Vertex )
 	{
-		if( srcInterpolation == PrimitiveVariable::Uniform )
+		if( srcInterpolation == PrimitiveVariable::Uniform || srcInterpolation == PrimitiveVariable::FaceVarying )
 		{
-			MeshUniformToVertex fn( mesh, canceller );
-			dstData = despatchTypedData<MeshUniformToVertex, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
-		}
-		else if( srcInterpolation == PrimitiveVariable::FaceVarying )
-		{
-			MeshFaceVaryingToVertex fn( mesh, canceller );
-			dstData = despatchTypedData<MeshFaceVaryingToVertex, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
+			MeshToVertex fn( mesh, srcInterpolation, adjacency, canceller );
+			dstData = despatchTypedData<MeshToVertex, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 		}
 		else if( srcInterpolation == PrimitiveVariable::Varying || srcInterpolation == PrimitiveVariable::Vertex )
 		{
@@ -370,8 +406,8 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 	}
 	else if( interpolation == PrimitiveVariable::FaceVarying )
 	{
-		MeshAnythingToFaceVarying fn( mesh, srcInterpolation, canceller );
-		dstData = despatchTypedData<MeshAnythingToFaceVarying, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
+		MeshToFaceVarying fn( mesh, srcInterpolation, adjacency, canceller );
+		dstData = despatchTypedData<MeshToFaceVarying, IECoreScene::Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 	}
 
 	if( primitiveVariable.indices )
@@ -383,3 +419,71 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 		primitiveVariable = PrimitiveVariable( interpolation, dstData );
 	}
 }
+
+} // namespace
+
+void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller, const MeshTopology *topology )
+{
+	if( primitiveVariable.interpolation == interpolation )
+	{
+		return;
+	}
+
+	if( topology )
+	{
+		IECoreScene::Detail::validateTopology( mesh, topology, "MeshAlgo::resamplePrimitiveVariable" );
+	}
+
+	const Adjacency adjacency(
+		mesh, topology,
+		needsFaceOffsets( primitiveVariable.interpolation, interpolation ),
+		needsVertexFaceVertices( primitiveVariable.interpolation, interpolation ),
+		canceller
+	);
+
+	resample( mesh, primitiveVariable, interpolation, adjacency, canceller );
+}
+
+void IECoreScene::MeshAlgo::resamplePrimitiveVariables( MeshPrimitive *mesh, const std::vector<std::string> &names, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller, const MeshTopology *topology )
+{
+	std::vector<PrimitiveVariable *> variables;
+	bool faceOffsets = false;
+	bool vertexFaceVertices = false;
+	for( const auto &name : names )
+	{
+		auto it = mesh->variables.find( name );
+		if( it == mesh->variables.end() )
+		{
+			throw InvalidArgumentException( fmt::format( "MeshAlgo::resamplePrimitiveVariables : MeshPrimitive has no \"{}\" primitive variable.", name ) );
+		}
+
+		if( std::find( variables.begin(), variables.end(), &it->second ) != variables.end() )
+		{
+			continue;
+		}
+
+		variables.push_back( &it->second );
+		faceOffsets = faceOffsets || needsFaceOffsets( it->second.interpolation, interpolation );
+		vertexFaceVertices = vertexFaceVertices || needsVertexFaceVertices( it->second.interpolation, interpolation );
+	}
+
+	if( topology )
+	{
+		IECoreScene::Detail::validateTopology( mesh, topology, "MeshAlgo::resamplePrimitiveVariables" );
+	}
+
+	const Adjacency adjacency( mesh, topology, faceOffsets, vertexFaceVertices, canceller );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				resample( mesh, *variables[i], interpolation, adjacency, canceller );
+			}
+		},
+		taskGroupContext
+	);
+}
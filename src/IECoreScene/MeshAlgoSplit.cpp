@@ -37,6 +37,9 @@
 
 #include "IECoreScene/MeshAlgo.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
 #include <unordered_map>
 
 using namespace Imath;
@@ -385,63 +388,120 @@ IECoreScene::MeshAlgo::MeshSplitter::MeshSplitter( ConstMeshPrimitivePtr mesh, c
 	);
 
 	const std::vector<int> &faceToSegmentIndex = faceToSegmentIndexData->readable();
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
 
-	// Now that we have our faceToSegmentIndex and remapSegmentIndices vector, we can count the number of faces
-	// for each output mesh
-	std::vector<int> faceCounts;
-	faceCounts.resize( numSegments, 0 );
-
-	Canceller::check( canceller );
-
-	for( int i : faceToSegmentIndex )
-	{
-		faceCounts[ remapSegmentIndices[ i - remapSegmentIndexMin ] ]++;
-	}
+	auto segmentForFace = [&]( size_t faceIndex ) {
+		return remapSegmentIndices[ faceToSegmentIndex[ faceIndex ] - remapSegmentIndexMin ];
+	};
 
-	// We need store the faces so that it's easy to access all the faces for one output mesh at a time.
-	// To keep things nice and contiguous, and avoid small allocations for small meshes, we will allocate
-	// some vectors with the original size of the verticesPerFace vector, but sorted by output mesh index
+	// Now that we have our faceToSegmentIndex and remapSegmentIndices vector, we can sort the faces by
+	// output mesh. We need store the faces so that it's easy to access all the faces for one output mesh
+	// at a time. To keep things nice and contiguous, and avoid small allocations for small meshes, we
+	// will allocate some vectors with the original size of the verticesPerFace vector, but sorted by
+	// output mesh index.
+	//
+	// We do this with a counting sort, parallelised by dividing the input faces into contiguous chunks.
+	// Each chunk counts its own faces for each output mesh, and then scatters them into its own range
+	// within each output mesh, so the faces for each output mesh remain in their original order. The
+	// counts take numChunks * numSegments ints, so we limit the number of chunks to keep this in
+	// proportion to the number of faces.
+	const size_t numChunks = std::max<size_t>(
+		1, std::min<size_t>( { ( numFaces + 9999 ) / 10000, 64, numFaces / numSegments } )
+	);
+	const size_t chunkSize = ( numFaces + numChunks - 1 ) / numChunks;
+	auto chunkRange = [&]( size_t chunk ) {
+		return std::make_pair( std::min( chunk * chunkSize, numFaces ), std::min( ( chunk + 1 ) * chunkSize, numFaces ) );
+	};
+
+	// chunkOffsets stores the count of faces in each output mesh for each chunk, and is then
+	// converted in place into the position in m_faceRemap where each chunk writes each output mesh.
+	// chunkFaceVertexOffsets does the same for the running sum of verticesPerFace.
+	std::vector<int> chunkOffsets( numChunks * numSegments, 0 );
+	std::vector<int> chunkFaceVertexOffsets( numChunks, 0 );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numChunks, 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t chunk = range.begin(); chunk != range.end(); ++chunk )
+			{
+				Canceller::check( canceller );
+				int *counts = chunkOffsets.data() + chunk * numSegments;
+				int faceVertexCount = 0;
+				const auto [begin, end] = chunkRange( chunk );
+				for( size_t faceIndex = begin; faceIndex < end; faceIndex++ )
+				{
+					counts[ segmentForFace( faceIndex ) ]++;
+					faceVertexCount += verticesPerFace[ faceIndex ];
+				}
+				chunkFaceVertexOffsets[chunk] = faceVertexCount;
+			}
+		},
+		taskGroupContext
+	);
 
 	Canceller::check( canceller );
 
 	// meshIndices stores the offset in m_faceRemap where each mesh starts
-	m_meshIndices.reserve( faceCounts.size() );
+	m_meshIndices.resize( numSegments );
 	int meshStartIndex = 0;
-	for( int c : faceCounts )
+	for( int segment = 0; segment < numSegments; segment++ )
 	{
-		m_meshIndices.push_back( meshStartIndex );
-		meshStartIndex += c;
+		m_meshIndices[segment] = meshStartIndex;
+		for( size_t chunk = 0; chunk < numChunks; chunk++ )
+		{
+			int &offset = chunkOffsets[ chunk * numSegments + segment ];
+			const int count = offset;
+			offset = meshStartIndex;
+			meshStartIndex += count;
+		}
 	}
 
-	// Now output the faceRemap vector, which tells us for each output face, the index of the source face
-	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
-
-	// We do this by keeping track of the current position for each output mesh, and scanning through
-	// all the input faces, incrementing the correct output mesh position when we find a face for that
-	// mesh.
-	std::vector<int> curMeshIndices( m_meshIndices );
-
-	Canceller::check( canceller );
-
-	m_faceRemap.resize( numFaces );
-	for( unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++ )
+	int faceVertexIndex = 0;
+	for( int &offset : chunkFaceVertexOffsets )
 	{
-		int meshId = remapSegmentIndices[ faceToSegmentIndex[ faceIndex ] - remapSegmentIndexMin ];
-		m_faceRemap[ curMeshIndices[ meshId ] ] = faceIndex;
-		curMeshIndices[ meshId ]++;
+		const int count = offset;
+		offset = faceVertexIndex;
+		faceVertexIndex += count;
 	}
 
-	Canceller::check( canceller );
-
-	// When accessing faces through m_faceRemap, we need to independently access a face based on its index.
+	// Now output the faceRemap vector, which tells us for each output face, the index of the source face.
+	//
+	// When accessing faces through m_faceRemap, we also need to independently access a face based on its index.
 	// We don't want to scan from the start summing all the verticesPerFace each time, so this requires
-	// us to pre-accumulate a running sum of verticesPerFace, that we can index directly into
-	int faceVertexIndex = 0;
-	m_faceIndices.reserve( numFaces );
-	for( int f : verticesPerFace )
+	// us to pre-accumulate a running sum of verticesPerFace, that we can index directly into. We output
+	// this in the same pass.
+	m_faceRemap.resize( numFaces );
+	m_faceIndices.resize( numFaces );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numChunks, 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t chunk = range.begin(); chunk != range.end(); ++chunk )
+			{
+				Canceller::check( canceller );
+				int *offsets = chunkOffsets.data() + chunk * numSegments;
+				int faceVertexOffset = chunkFaceVertexOffsets[chunk];
+				const auto [begin, end] = chunkRange( chunk );
+				for( size_t faceIndex = begin; faceIndex < end; faceIndex++ )
+				{
+					m_faceRemap[ offsets[ segmentForFace( faceIndex ) ]++ ] = faceIndex;
+					m_faceIndices[ faceIndex ] = faceVertexOffset;
+					faceVertexOffset += verticesPerFace[ faceIndex ];
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	for( const auto &p : mesh->variables )
 	{
-		m_faceIndices.push_back( faceVertexIndex );
-		faceVertexIndex += f;
+		Canceller::check( canceller );
+		if( !mesh->isPrimitiveVariableValid( p.second ) )
+		{
+			m_invalidPrimitiveVariables.push_back( p.first );
+		}
 	}
 
 }
@@ -463,16 +523,11 @@ namespace {
 // small pieces ), but it much more efficient to just index into a location than it is to
 // hash an integer to use it as a hashmap key.
 //
-// It would be possible to implement a much more compact version storing only 1 bit per id,
-// with separate counts every 64 or 128 ids, which would perform better on very large
-// meshes being split into very small pieces, but that doesn't help much in average cases,
-// and is a fair bit more complicated. If we encounter issues with performance when
-// splitting into tiny meshes, the simplest solution is probably to switch to an unordered_map
-// when numIndices is much smaller than numOriginalIds - the break even point for performance
-// seems to be when numOriginalIds is about 10 000 times greater than numIndices - or actually
-// much higher when the indices are fairly coherent ( ie. the ids which are selected fall
-// mainly in the same range, so many are in the same block ), which is common for most ways of
-// producing meshes.
+// When numIndices is much smaller than numOriginalIds, we instead sort a copy of the indices
+// to find the used ids. This avoids allocating and scanning a table covering the whole id
+// range, which otherwise dominates the cost of splitting a very large mesh into very many
+// small pieces. The result is identical in both cases : new ids are assigned in order of
+// the original ids.
 
 class Reindexer
 {
@@ -489,7 +544,8 @@ public:
 		m_newIndicesData( new IntVectorData() ),
 		m_newIndices( m_newIndicesData->writable() ),
 		m_blockSize( blockSize ),
-		m_fromOldIds( ( numOriginalIds - 1 ) / blockSize + 1 ),
+		m_sorted( (size_t)numIndices * 16 < (size_t)numOriginalIds ),
+		m_fromOldIds( m_sorted ? 0 : ( numOriginalIds - 1 ) / blockSize + 1 ),
 		m_numIdsUsed( 0 ),
 		m_indicesComputed( false )
 	{
@@ -499,6 +555,13 @@ public:
 	// Add an index - if the indexed id is not yet part of the output ids, it will be included
 	void addIndex( int id )
 	{
+		if( m_sorted )
+		{
+			m_newIndices.push_back( id );
+			m_indicesComputed = false;
+			return;
+		}
+
 		// Determine which block to use, and the index within that block
 		int blockId = id / m_blockSize;
 		int subIndex = id % m_blockSize;
@@ -526,6 +589,12 @@ public:
 	inline int testIndex( int id )
 	{
 		computeIndices();
+		if( m_sorted )
+		{
+			auto it = std::lower_bound( m_usedIds.begin(), m_usedIds.end(), id );
+			return ( it != m_usedIds.end() && *it == id ) ? it - m_usedIds.begin() : -1;
+		}
+
 		int blockId = id / m_blockSize;
 		int subIndex = id % m_blockSize;
 		auto &block = m_fromOldIds[ blockId ];
@@ -554,6 +623,15 @@ public:
 	{
 		computeIndices();
 		out.resize( m_numIdsUsed );
+		if( m_sorted )
+		{
+			for( int i = 0; i < m_numIdsUsed; i++ )
+			{
+				out[i] = in[ m_usedIds[i] ];
+			}
+			return;
+		}
+
 		for( unsigned int i = 0; i < m_fromOldIds.size(); i++ )
 		{
 			auto &blockPointer = m_fromOldIds[ i ];
@@ -578,6 +656,12 @@ public:
 	void getDataRemapping( std::vector<int> &dataRemap )
 	{
 		computeIndices();
+		if( m_sorted )
+		{
+			dataRemap = m_usedIds;
+			return;
+		}
+
 		dataRemap.resize( m_numIdsUsed );
 		for( unsigned int i = 0; i < m_fromOldIds.size(); i++ )
 		{
@@ -611,6 +695,20 @@ private:
 
 		m_indicesComputed = true;
 
+		if( m_sorted )
+		{
+			m_usedIds = m_newIndices;
+			std::sort( m_usedIds.begin(), m_usedIds.end() );
+			m_usedIds.erase( std::unique( m_usedIds.begin(), m_usedIds.end() ), m_usedIds.end() );
+			m_numIdsUsed = m_usedIds.size();
+
+			for( int &id : m_newIndices )
+			{
+				id = std::lower_bound( m_usedIds.begin(), m_usedIds.end(), id ) - m_usedIds.begin();
+			}
+			return;
+		}
+
 		for( unsigned int blockId = 0; blockId < m_fromOldIds.size(); blockId++ )
 		{
 			auto &block = m_fromOldIds[ blockId ];
@@ -645,6 +743,9 @@ private:
 	// A performance tuning value determining how large the blocks that are allocated to hold ids are.
 	const int m_blockSize;
 
+	// Whether to find the used ids by sorting, rather than using m_fromOldIds
+	const bool m_sorted;
+
 	// Store the mapping from old ids to new ids. The outer vector holds a unique_ptr for each
 	// block of m_blockSize ids in the original id range. These pointers are null if no ids from
 	// that block have been used. Once a block is used, it is allocated with a vector that is set
@@ -652,6 +753,10 @@ private:
 	// is called, all used elements get a new id assigned, relative to just the used ids.
 	std::vector< std::unique_ptr< std::vector< int > > > m_fromOldIds;
 
+	// When m_sorted is true, the sorted list of unique ids used, so that the position of an
+	// original id in this list is its new id.
+	std::vector< int > m_usedIds;
+
 	// How many unique ids have appeared in the indices added so far
 	int m_numIdsUsed;
 
@@ -954,7 +1059,7 @@ MeshPrimitivePtr IECoreScene::MeshAlgo::MeshSplitter::mesh( int segmentId, const
 	// Now split all primvars using	ResamplePrimitiveVariableFunctor()
 	for( const auto &p : m_mesh->variables )
 	{
-		if( !m_mesh->isPrimitiveVariableValid( p.second ) )
+		if( std::binary_search( m_invalidPrimitiveVariables.begin(), m_invalidPrimitiveVariables.end(), p.first ) )
 		{
 			IECore::msg( Msg::Error, "MeshAlgoSplit", "Cannot resample " + p.first + " because it is not valid to start with." );
 			continue;
@@ -966,6 +1071,26 @@ MeshPrimitivePtr IECoreScene::MeshAlgo::MeshSplitter::mesh( int segmentId, const
 	return ret;
 }
 
+std::vector<MeshPrimitivePtr> IECoreScene::MeshAlgo::MeshSplitter::meshes( const IECore::Canceller *canceller ) const
+{
+	std::vector<MeshPrimitivePtr> result( numMeshes() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, numMeshes() ),
+		[&]( const tbb::blocked_range<int> &range )
+		{
+			for( int i = range.begin(); i != range.end(); ++i )
+			{
+				result[i] = mesh( i, canceller );
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
 Imath::Box3f IECoreScene::MeshAlgo::MeshSplitter::bound( int segmentId, const IECore::Canceller *canceller ) const
 {
 	if( segmentId < 0 || segmentId > (int)m_meshIndices.size() )
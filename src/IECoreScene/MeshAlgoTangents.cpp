@@ -33,6 +33,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/private/PrimitiveAlgoUtils.h"
+
 #include "IECore/DataAlgo.h"
 
 using namespace Imath;
@@ -70,6 +72,25 @@ void calculcateBasis( const V3f &p0, const V3f &p1, const V3f &p2, const V2f &uv
 	outBasis.normal.normalize();
 }
 
+// Computes the tangent and bitangent for a vertex from its normal and a
+// direction towards a neighbouring point.
+void orthogonalTangents( const V3f &normal, const V3f &direction, bool orthoTangents, bool leftHanded, V3f &tangent, V3f &biTangent )
+{
+	tangent = direction.normalized();
+	biTangent = normal.cross( tangent ).normalized();
+	if ( orthoTangents )
+	{
+		if ( leftHanded )
+		{
+			tangent = normal.cross( biTangent ).normalized();
+		}
+		else
+		{
+			tangent = biTangent.cross( normal ).normalized();
+		}
+	}
+}
+
 } // namespace
 
 std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculateTangents(
@@ -166,106 +187,147 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 
 	size_t numUVs = IECore::size( uvIt->second.data.get() );
 
-	Canceller::check( canceller );
-	std::vector<V3f> uTangents( numUVs, V3f( 0 ) );
-	Canceller::check( canceller );
-	std::vector<V3f> vTangents( numUVs, V3f( 0 ) );
-	Canceller::check( canceller );
-	std::vector<V3f> normals( numUVs, V3f( 0 ) );
+	// Compute the basis for the triangle at each face-vertex in parallel.
 
-	size_t vertStart = 0;
+	Canceller::check( canceller );
+	std::vector<int> faceOffsets( vertsPerFace.size() + 1, 0 );
 	for( size_t faceIndex = 0; faceIndex < vertsPerFace.size(); faceIndex++ )
 	{
-		if( ( faceIndex % 1000 ) == 0 )
-		{
-			Canceller::check( canceller );
-		}
-
-		for ( size_t faceVertIndex = 0; faceVertIndex < (size_t)vertsPerFace[faceIndex]; ++faceVertIndex)
-		{
-			// indices into the facevarying data for this *triangle*
-			size_t fvi0 = vertStart + faceVertIndex;
-			size_t fvi1 = vertStart + (faceVertIndex + 1) % vertsPerFace[faceIndex];
-			size_t fvi2 = vertStart + (faceVertIndex + 2) % vertsPerFace[faceIndex];
+		faceOffsets[faceIndex+1] = faceOffsets[faceIndex] + vertsPerFace[faceIndex];
+	}
 
-			assert( fvi0 < vertIds.size() );
-			assert( fvi0 < uvIndexedView.size() );
+	const size_t numFaceVertices = vertIds.size();
+	Canceller::check( canceller );
+	std::vector<Basis> faceVertexBases( numFaceVertices );
+
+	IECoreScene::Detail::parallelForEach(
+		vertsPerFace.size(), canceller,
+		[&]( size_t faceIndex ) {
+			const size_t vertStart = faceOffsets[faceIndex];
+			const size_t numFaceVerts = vertsPerFace[faceIndex];
+			for( size_t faceVertIndex = 0; faceVertIndex < numFaceVerts; ++faceVertIndex )
+			{
+				// indices into the facevarying data for this *triangle*
+				size_t fvi0 = vertStart + faceVertIndex;
+				size_t fvi1 = vertStart + (faceVertIndex + 1) % numFaceVerts;
+				size_t fvi2 = vertStart + (faceVertIndex + 2) % numFaceVerts;
 
-			assert( fvi1 < vertIds.size() );
-			assert( fvi1 < uvIndexedView.size() );
+				assert( fvi0 < vertIds.size() );
+				assert( fvi0 < uvIndexedView.size() );
 
-			assert( fvi2 < vertIds.size() );
-			assert( fvi2 < uvIndexedView.size() );
+				assert( fvi1 < vertIds.size() );
+				assert( fvi1 < uvIndexedView.size() );
 
-			// positions for each vertex of this face
-			const V3f &p0 = points[vertIds[fvi0]];
-			const V3f &p1 = points[vertIds[fvi1]];
-			const V3f &p2 = points[vertIds[fvi2]];
+				assert( fvi2 < vertIds.size() );
+				assert( fvi2 < uvIndexedView.size() );
 
-			// uv coordinates for each vertex of this face
-			const V2f &uv0 = uvIndexedView[fvi0];
-			const V2f &uv1 = uvIndexedView[fvi1];
-			const V2f &uv2 = uvIndexedView[fvi2];
+				// positions for each vertex of this face
+				const V3f &p0 = points[vertIds[fvi0]];
+				const V3f &p1 = points[vertIds[fvi1]];
+				const V3f &p2 = points[vertIds[fvi2]];
 
-			Basis basis;
-			calculcateBasis( p0, p1, p2, uv0, uv1, uv2, basis );
+				// uv coordinates for each vertex of this face
+				const V2f &uv0 = uvIndexedView[fvi0];
+				const V2f &uv1 = uvIndexedView[fvi1];
+				const V2f &uv2 = uvIndexedView[fvi2];
 
-			// and accumulate them into the computation so far
-			uTangents[uvIndexedView.index(fvi0)] += basis.tangent;
-			vTangents[uvIndexedView.index(fvi0)] += basis.bitangent;
-			normals[uvIndexedView.index(fvi0)] += basis.normal;
+				calculcateBasis( p0, p1, p2, uv0, uv1, uv2, faceVertexBases[fvi0] );
+			}
 		}
+	);
+
+	// Accumulate the bases for each uv. Rather than scattering from the
+	// face-vertices, which can't be done in parallel, we build a table of
+	// the face-vertices for each uv and gather from those. Face-vertices are
+	// listed in ascending order, so the results are identical to a serial
+	// accumulation.
 
-		vertStart += vertsPerFace[faceIndex];
+	Canceller::check( canceller );
+	std::vector<int> uvFaceVertexOffsets( numUVs + 1, 0 );
+	for( size_t i = 0; i < numFaceVertices; ++i )
+	{
+		uvFaceVertexOffsets[uvIndexedView.index( i ) + 1]++;
+	}
+	for( size_t i = 0; i < numUVs; ++i )
+	{
+		uvFaceVertexOffsets[i+1] += uvFaceVertexOffsets[i];
 	}
 
-	// normalize and orthogonalize everything
-	for( size_t i = 0; i < uTangents.size(); i++ )
+	Canceller::check( canceller );
+	std::vector<int> uvFaceVertices( numFaceVertices );
 	{
-		if( ( i % 1000 ) == 0 )
+		std::vector<int> insertPositions( uvFaceVertexOffsets.begin(), uvFaceVertexOffsets.end() - 1 );
+		for( size_t i = 0; i < numFaceVertices; ++i )
 		{
-			Canceller::check( canceller );
+			uvFaceVertices[insertPositions[uvIndexedView.index( i )]++] = i;
 		}
+	}
 
-		normals[i].normalize();
+	Canceller::check( canceller );
+	std::vector<V3f> uTangents( numUVs );
+	Canceller::check( canceller );
+	std::vector<V3f> vTangents( numUVs );
+
+	IECoreScene::Detail::parallelForEach(
+		numUVs, canceller,
+		[&]( size_t i ) {
+			V3f uTangent( 0 );
+			V3f vTangent( 0 );
+			V3f normal( 0 );
+			for( int j = uvFaceVertexOffsets[i], e = uvFaceVertexOffsets[i+1]; j < e; ++j )
+			{
+				const Basis &basis = faceVertexBases[uvFaceVertices[j]];
+				uTangent += basis.tangent;
+				vTangent += basis.bitangent;
+				normal += basis.normal;
+			}
 
-		uTangents[i].normalize();
-		vTangents[i].normalize();
+			// normalize and orthogonalize everything
 
-		// Make uTangent/vTangent orthogonal to normal
-		uTangents[i] -= normals[i] * uTangents[i].dot( normals[i] );
-		vTangents[i] -= normals[i] * vTangents[i].dot( normals[i] );
+			normal.normalize();
 
-		uTangents[i].normalize();
-		vTangents[i].normalize();
+			uTangent.normalize();
+			vTangent.normalize();
 
-		if( orthoTangents )
-		{
-			vTangents[i] -= uTangents[i] * vTangents[i].dot( uTangents[i] );
-			vTangents[i].normalize();
-		}
+			// Make uTangent/vTangent orthogonal to normal
+			uTangent -= normal * uTangent.dot( normal );
+			vTangent -= normal * vTangent.dot( normal );
 
-		// Ensure we have set of basis vectors (n, uT, vT) with the correct handedness.
-		if ( !leftHanded )
-		{
-			if( uTangents[i].cross( vTangents[i] ).dot( normals[i] ) < 0.0f )
+			uTangent.normalize();
+			vTangent.normalize();
+
+			if( orthoTangents )
 			{
-				uTangents[i] *= -1.0f;
+				vTangent -= uTangent * vTangent.dot( uTangent );
+				vTangent.normalize();
 			}
-		}
-		else
-		{
-			if( uTangents[i].cross( vTangents[i] ).dot( normals[i] ) > 0.0f )
+
+			// Ensure we have set of basis vectors (n, uT, vT) with the correct handedness.
+			if ( !leftHanded )
 			{
-				uTangents[i] *= -1.0f;
+				if( uTangent.cross( vTangent ).dot( normal ) < 0.0f )
+				{
+					uTangent *= -1.0f;
+				}
+			}
+			else
+			{
+				if( uTangent.cross( vTangent ).dot( normal ) > 0.0f )
+				{
+					uTangent *= -1.0f;
+				}
 			}
-		}
 
-	}
+			uTangents[i] = uTangent;
+			vTangents[i] = vTangent;
+		}
+	);
 
 	// convert the tangents back to facevarying data and add that to the mesh
-	V3fVectorDataPtr fvUD = new V3fVectorData( uTangents );
-	V3fVectorDataPtr fvVD = new V3fVectorData( vTangents );
+	V3fVectorDataPtr fvUD = new V3fVectorData;
+	fvUD->writable().swap( uTangents );
+	V3fVectorDataPtr fvVD = new V3fVectorData;
+	fvVD->writable().swap( vTangents );
 
 	IntVectorDataPtr indices;
 
@@ -333,9 +395,9 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	Canceller::check( canceller );
 	std::vector<int> faceIdPerVert( numPoints, -1 );
 
-	// calculate centroids
-	// TODO: generalize this to MeshAlgo::calculateCentroid
-	size_t vertStart = 0;
+	// Find the face offsets, and the last face using each vertex. This is
+	// cheap to do serially.
+	std::vector<int> faceOffsets( vertsPerFace.size() + 1, 0 );
 	for( size_t faceIndex = 0; faceIndex < vertsPerFace.size(); ++faceIndex )
 	{
 		if( ( faceIndex % 1000 ) == 0 )
@@ -343,45 +405,42 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 			Canceller::check( canceller );
 		}
 
-		for ( size_t faceVertIndex = 0; faceVertIndex < (size_t)vertsPerFace[faceIndex]; ++faceVertIndex)
+		faceOffsets[faceIndex+1] = faceOffsets[faceIndex] + vertsPerFace[faceIndex];
+		for( int fvi0 = faceOffsets[faceIndex]; fvi0 < faceOffsets[faceIndex+1]; ++fvi0 )
 		{
-			size_t fvi0 = vertStart + faceVertIndex;
-			centroids[faceIndex] += points[vertIds[fvi0]];
 			faceIdPerVert[vertIds[fvi0]] = faceIndex;
 		}
-		centroids[faceIndex] /= vertsPerFace[faceIndex];
-
-		vertStart += vertsPerFace[faceIndex];
 	}
 
-	// calculate per vertex tangents from centroids
-	for ( size_t i = 0; i < (size_t)points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
-		{
-			Canceller::check( canceller );
-		}
-
-		tangents[i] = ( centroids[faceIdPerVert[i]] - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
-			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
-			}
-			else
+	// calculate centroids
+	// TODO: generalize this to MeshAlgo::calculateCentroid
+	IECoreScene::Detail::parallelForEach(
+		vertsPerFace.size(), canceller,
+		[&]( size_t faceIndex ) {
+			for( int fvi0 = faceOffsets[faceIndex]; fvi0 < faceOffsets[faceIndex+1]; ++fvi0 )
 			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
+				centroids[faceIndex] += points[vertIds[fvi0]];
 			}
+			centroids[faceIndex] /= vertsPerFace[faceIndex];
 		}
-	}
+	);
+
+	// calculate per vertex tangents from centroids
+	IECoreScene::Detail::parallelForEach(
+		points.size(), canceller,
+		[&]( size_t i ) {
+			const V3f &centroid = centroids[faceIdPerVert[i]];
+			orthogonalTangents( normals[i], centroid - points[i], orthoTangents, leftHanded, tangents[i], biTangents[i] );
+		}
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
-	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData( tangents );
+	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData;
+	tangentsDataPtr->writable().swap( tangents );
 	Canceller::check( canceller );
-	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData( biTangents );
+	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData;
+	biTangentsDataPtr->writable().swap( biTangents );
 
 	Canceller::check( canceller );
 	PrimitiveVariable tangentPrimVar( IECoreScene::PrimitiveVariable::Interpolation::Vertex, tangentsDataPtr );
@@ -397,9 +456,15 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	const std::string &normal /* = "N" */,
 	bool orthoTangents,
 	bool leftHanded,
-	const Canceller *canceller
+	const Canceller *canceller,
+	const MeshTopology *topology
 )
 {
+	if( topology )
+	{
+		Detail::validateTopology( mesh, topology, "MeshAlgo::calculateTangentsFromFirstEdge" );
+	}
+
 	// get point data
 	const V3fVectorData *positionData = mesh->variableData<V3fVectorData>( position );
 	if( !positionData )
@@ -435,42 +500,29 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	std::vector<V3f> biTangents( numPoints, V3f( 0 ) );
 
 	// get neighbors
-	std::pair<IntVectorDataPtr, IntVectorDataPtr> tangentPtr = MeshAlgo::connectedVertices( mesh, canceller );
+	std::pair<IntVectorDataPtr, IntVectorDataPtr> tangentPtr = MeshAlgo::connectedVertices( mesh, canceller, topology );
 	IntVectorDataPtr neighborList = tangentPtr.first;
 	IntVectorDataPtr offsets = tangentPtr.second;
 	auto &neighborListR = neighborList->readable();
 	auto &offsetsR = offsets->readable();
 
 	// calculate tangents from first neighbor and biTangents as orthogonal vectors
-	for ( unsigned int i = 0; i < points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
-		{
-			Canceller::check( canceller );
+	IECoreScene::Detail::parallelForEach(
+		points.size(), canceller,
+		[&]( size_t i ) {
+			int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
+			const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
+			orthogonalTangents( normals[i], firstNeighbor - points[i], orthoTangents, leftHanded, tangents[i], biTangents[i] );
 		}
-
-		int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
-		const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
-		tangents[i] = ( firstNeighbor - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
-			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
-			}
-			else
-			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
-			}
-		}
-	}
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
-	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData( tangents );
+	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData;
+	tangentsDataPtr->writable().swap( tangents );
 	Canceller::check( canceller );
-	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData( biTangents );
+	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData;
+	biTangentsDataPtr->writable().swap( biTangents );
 
 	Canceller::check( canceller );
 	PrimitiveVariable tangentPrimVar( IECoreScene::PrimitiveVariable::Interpolation::Vertex, tangentsDataPtr );
@@ -486,9 +538,15 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	const std::string &normal /* = "N" */,
 	bool orthoTangents,
 	bool leftHanded,
-	const Canceller *canceller
+	const Canceller *canceller,
+	const MeshTopology *topology
 )
 {
+	if( topology )
+	{
+		Detail::validateTopology( mesh, topology, "MeshAlgo::calculateTangentsFromTwoEdges" );
+	}
+
 	// get point data
 	const V3fVectorData *positionData = mesh->variableData<V3fVectorData>( position );
 	if( !positionData )
@@ -524,45 +582,32 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	std::vector<V3f> biTangents( numPoints, V3f( 0 ) );
 
 	// get neighbors
-	std::pair<IntVectorDataPtr, IntVectorDataPtr> tangentPtr = MeshAlgo::connectedVertices( mesh, canceller );
+	std::pair<IntVectorDataPtr, IntVectorDataPtr> tangentPtr = MeshAlgo::connectedVertices( mesh, canceller, topology );
 	IntVectorDataPtr neighborList = tangentPtr.first;
 	IntVectorDataPtr offsets = tangentPtr.second;
 	auto &neighborListR = neighborList->readable();
 	auto &offsetsR = offsets->readable();
 
 	// calculate tangents from first neighbor and biTangents as orthogonal vectors
-	for ( unsigned int i = 0; i < points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
-		{
-			Canceller::check( canceller );
-		}
-
-		int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
-		int lastIndex =  offsetsR[i] > firstNeighborIndex ? firstNeighborIndex + 1 : firstNeighborIndex;  // if we only have one neighbor use the edge, else the next neighbor
-
-		const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
-		const V3f &secondNeighbor = points[neighborListR[lastIndex]];
-		tangents[i] = ( ( firstNeighbor + (secondNeighbor - firstNeighbor ) * 0.5 ) - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
-			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
-			}
-			else
-			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
-			}
+	IECoreScene::Detail::parallelForEach(
+		points.size(), canceller,
+		[&]( size_t i ) {
+			int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
+			int lastIndex =  offsetsR[i] > firstNeighborIndex ? firstNeighborIndex + 1 : firstNeighborIndex;  // if we only have one neighbor use the edge, else the next neighbor
+
+			const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
+			const V3f &secondNeighbor = points[neighborListR[lastIndex]];
+			orthogonalTangents( normals[i], ( firstNeighbor + (secondNeighbor - firstNeighbor ) * 0.5 ) - points[i], orthoTangents, leftHanded, tangents[i], biTangents[i] );
 		}
-	}
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
-	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData( tangents );
+	V3fVectorDataPtr tangentsDataPtr = new V3fVectorData;
+	tangentsDataPtr->writable().swap( tangents );
 	Canceller::check( canceller );
-	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData( biTangents );
+	V3fVectorDataPtr biTangentsDataPtr = new V3fVectorData;
+	biTangentsDataPtr->writable().swap( biTangents );
 
 	Canceller::check( canceller );
 	PrimitiveVariable tangentPrimVar( IECoreScene::PrimitiveVariable::Interpolation::Vertex, tangentsDataPtr );
@@ -0,0 +1,267 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECoreScene/MeshAlgo.h"
+
+#include "IECore/LRUCache.h"
+
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <cstdlib>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+
+//////////////////////////////////////////////////////////////////////////
+// MeshTopology
+//////////////////////////////////////////////////////////////////////////
+
+MeshAlgo::MeshTopology::MeshTopology( const MeshPrimitive *mesh, const Canceller *canceller )
+{
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const int numFaces = verticesPerFace.size();
+	const int numFaceVertices = vertexIds.size();
+	const int numVertices = mesh->variableSize( PrimitiveVariable::Vertex );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+	// Faces
+
+	Canceller::check( canceller );
+	m_faceOffsets.resize( numFaces + 1 );
+	m_faceOffsets[0] = 0;
+	for( int f = 0; f < numFaces; ++f )
+	{
+		m_faceOffsets[f+1] = m_faceOffsets[f] + verticesPerFace[f];
+	}
+
+	m_faceVertexFaces.resize( numFaceVertices );
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, numFaces ),
+		[&] ( const tbb::blocked_range<int> &range )
+		{
+			Canceller::check( canceller );
+			for( int f = range.begin(); f != range.end(); ++f )
+			{
+				std::fill( m_faceVertexFaces.begin() + m_faceOffsets[f], m_faceVertexFaces.begin() + m_faceOffsets[f+1], f );
+			}
+		},
+		taskGroupContext
+	);
+
+	// Vertex to face-vertex mapping. Filling in face-vertex order means that
+	// each list is sorted without further work.
+
+	Canceller::check( canceller );
+	m_vertexFaceVertexOffsets.resize( numVertices + 1, 0 );
+	for( int v : vertexIds )
+	{
+		m_vertexFaceVertexOffsets[v+1]++;
+	}
+	for( int v = 0; v < numVertices; ++v )
+	{
+		m_vertexFaceVertexOffsets[v+1] += m_vertexFaceVertexOffsets[v];
+	}
+
+	Canceller::check( canceller );
+	m_vertexFaceVertices.resize( numFaceVertices );
+	vector<int> insertPositions( m_vertexFaceVertexOffsets.begin(), m_vertexFaceVertexOffsets.end() - 1 );
+	for( int i = 0; i < numFaceVertices; ++i )
+	{
+		m_vertexFaceVertices[insertPositions[vertexIds[i]]++] = i;
+	}
+
+	// Half-edges. The half-edge starting at each face-vertex runs to the next
+	// face-vertex in the same face. We find opposites by searching the face-vertices
+	// of the end vertex, and identify each edge by its first half-edge (in either
+	// direction), so that edges can be numbered consistently.
+
+	auto nextFaceVertex = [this] ( int i ) {
+		const int next = i + 1;
+		return next == m_faceOffsets[m_faceVertexFaces[i]+1] ? m_faceOffsets[m_faceVertexFaces[i]] : next;
+	};
+
+	m_oppositeFaceVertices.resize( numFaceVertices );
+	m_faceVertexEdges.resize( numFaceVertices );
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, numFaceVertices ),
+		[&] ( const tbb::blocked_range<int> &range )
+		{
+			Canceller::check( canceller );
+			for( int i = range.begin(); i != range.end(); ++i )
+			{
+				const int v0 = vertexIds[i];
+				const int v1 = vertexIds[nextFaceVertex( i )];
+
+				int firstHalfEdge = i;
+				int numSame = 0;
+				int numOpposite = 0;
+				int opposite = -1;
+
+				for( int j = m_vertexFaceVertexOffsets[v0], e = m_vertexFaceVertexOffsets[v0+1]; j < e; ++j )
+				{
+					const int fv = m_vertexFaceVertices[j];
+					if( vertexIds[nextFaceVertex( fv )] == v1 )
+					{
+						firstHalfEdge = std::min( firstHalfEdge, fv );
+						numSame++;
+					}
+				}
+
+				for( int j = m_vertexFaceVertexOffsets[v1], e = m_vertexFaceVertexOffsets[v1+1]; j < e; ++j )
+				{
+					const int fv = m_vertexFaceVertices[j];
+					if( vertexIds[nextFaceVertex( fv )] == v0 )
+					{
+						firstHalfEdge = std::min( firstHalfEdge, fv );
+						opposite = fv;
+						numOpposite++;
+					}
+				}
+
+				m_oppositeFaceVertices[i] = ( numSame == 1 && numOpposite == 1 && v0 != v1 ) ? opposite : -1;
+				// Temporarily store the first half-edge, to be replaced with
+				// the edge index below.
+				m_faceVertexEdges[i] = firstHalfEdge;
+			}
+		},
+		taskGroupContext
+	);
+
+	// Number the edges. Since the first half-edge for an edge always precedes
+	// the others, a single pass is sufficient.
+
+	Canceller::check( canceller );
+	for( int i = 0; i < numFaceVertices; ++i )
+	{
+		const int firstHalfEdge = m_faceVertexEdges[i];
+		if( firstHalfEdge == i )
+		{
+			const int v0 = vertexIds[i];
+			const int v1 = vertexIds[nextFaceVertex( i )];
+			m_faceVertexEdges[i] = m_edges.size();
+			m_edges.push_back( V2i( std::min( v0, v1 ), std::max( v0, v1 ) ) );
+		}
+		else
+		{
+			m_faceVertexEdges[i] = m_faceVertexEdges[firstHalfEdge];
+		}
+	}
+	m_edges.shrink_to_fit();
+}
+
+size_t MeshAlgo::MeshTopology::memoryUsage() const
+{
+	return
+		sizeof( MeshTopology ) +
+		( m_faceOffsets.capacity() + m_faceVertexFaces.capacity() + m_vertexFaceVertexOffsets.capacity() +
+		  m_vertexFaceVertices.capacity() + m_faceVertexEdges.capacity() + m_oppositeFaceVertices.capacity() ) * sizeof( int ) +
+		m_edges.capacity() * sizeof( V2i )
+	;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Topology cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct TopologyCacheGetterKey
+{
+
+	TopologyCacheGetterKey( const MeshPrimitive *mesh )
+		:	mesh( mesh )
+	{
+		mesh->topologyHash( hash );
+		// The topology hash doesn't include the number of vertices,
+		// which may be greater than the number referenced by `vertexIds`.
+		// MeshTopology depends on it, so it must be part of the key.
+		hash.append( mesh->variableSize( PrimitiveVariable::Vertex ) );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const MeshPrimitive *mesh;
+	IECore::MurmurHash hash;
+
+};
+
+using TopologyCache = IECore::LRUCache<IECore::MurmurHash, MeshAlgo::ConstMeshTopologyPtr, IECore::LRUCachePolicy::Parallel, TopologyCacheGetterKey>;
+
+TopologyCache &topologyCache()
+{
+	static TopologyCache *g_cache = [] () {
+		const char *m = getenv( "IECORESCENE_MESH_TOPOLOGY_CACHE_MEMORY" );
+		const size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+		return new TopologyCache(
+			[] ( const TopologyCacheGetterKey &key, size_t &cost ) -> MeshAlgo::ConstMeshTopologyPtr {
+				// We don't pass a canceller, because the cache would store the
+				// resulting exception, and return it to all subsequent callers.
+				// Isolate, because MeshTopology uses parallel loops, and we
+				// are holding the cache's item lock. Without isolation, this
+				// thread could steal an outer task which requests the same
+				// item, and wait forever for the lock it holds itself.
+				MeshAlgo::ConstMeshTopologyPtr result;
+				tbb::this_task_arena::isolate(
+					[&result, &key] {
+						result = new MeshAlgo::MeshTopology( key.mesh );
+					}
+				);
+				cost = result->memoryUsage();
+				return result;
+			},
+			1024 * 1024 * mi
+		);
+	}();
+	return *g_cache;
+}
+
+} // namespace
+
+MeshAlgo::ConstMeshTopologyPtr MeshAlgo::topology( const MeshPrimitive *mesh, const Canceller *canceller )
+{
+	Canceller::check( canceller );
+	return topologyCache().get( TopologyCacheGetterKey( mesh ) );
+}
@@ -33,10 +33,13 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
-#include "IECoreScene/PolygonIterator.h"
 
 #include "IECore/DataAlgo.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <type_traits>
 #include <unordered_set>
 
 using namespace Imath;
@@ -51,26 +54,51 @@ namespace
 {
 
 template<typename T>
-void reverseWinding( MeshPrimitive *mesh, T &values, const Canceller *canceller )
+void reverseWinding( const std::vector<int> &faceOffsets, std::vector<T> &values, const Canceller *canceller )
 {
-	for( PolygonIterator it = mesh->faceBegin(), eIt = mesh->faceEnd(); it != eIt; ++it )
+	const size_t numFaces = faceOffsets.size() - 1;
+	if constexpr( std::is_same_v<T, bool> )
+	{
+		// Neighbouring elements of `std::vector<bool>` can't be
+		// written concurrently.
+		for( size_t f = 0; f < numFaces; ++f )
+		{
+			if( f % 1000 == 0 )
+			{
+				Canceller::check( canceller );
+			}
+			std::reverse( values.begin() + faceOffsets[f], values.begin() + faceOffsets[f+1] );
+		}
+	}
+	else
 	{
-		Canceller::check( canceller );
-		std::reverse( it.faceVaryingBegin( values.begin() ), it.faceVaryingEnd( values.begin() ) );
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, numFaces, 1000 ),
+			[&]( const tbb::blocked_range<size_t> &range )
+			{
+				Canceller::check( canceller );
+				for( size_t f = range.begin(); f != range.end(); ++f )
+				{
+					std::reverse( values.begin() + faceOffsets[f], values.begin() + faceOffsets[f+1] );
+				}
+			},
+			taskGroupContext
+		);
 	}
 }
 
 struct ReverseWindingFunctor
 {
 
-	ReverseWindingFunctor( MeshPrimitive *mesh, const Canceller *canceller ) : m_mesh( mesh ), m_canceller( canceller )
+	ReverseWindingFunctor( const std::vector<int> &faceOffsets, const Canceller *canceller ) : m_faceOffsets( faceOffsets ), m_canceller( canceller )
 	{
 	}
 
 	template<typename T>
 	void operator()( TypedData<std::vector<T>> *data )
 	{
-		reverseWinding( m_mesh, data->writable(), m_canceller );
+		reverseWinding( m_faceOffsets, data->writable(), m_canceller );
 	}
 
 	void operator()( Data *data )
@@ -80,7 +108,7 @@ struct ReverseWindingFunctor
 
 	private :
 
-		MeshPrimitive *m_mesh;
+		const std::vector<int> &m_faceOffsets;
 		const Canceller *m_canceller;
 
 };
@@ -89,33 +117,54 @@ struct ReverseWindingFunctor
 
 void IECoreScene::MeshAlgo::reverseWinding( MeshPrimitive *mesh, const Canceller *canceller )
 {
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	std::vector<int> faceOffsets;
+	faceOffsets.reserve( verticesPerFace.size() + 1 );
+	int offset = 0;
+	for( int numVerts : verticesPerFace )
+	{
+		faceOffsets.push_back( offset );
+		offset += numVerts;
+	}
+	faceOffsets.push_back( offset );
+
+	// Gather the topology and all the distinct FaceVarying data, so that
+	// they can be reversed in parallel.
+
 	IntVectorDataPtr vertexIds = mesh->vertexIds()->copy();
-	::reverseWinding( mesh, vertexIds->writable(), canceller );
-	mesh->setTopologyUnchecked(
-		mesh->verticesPerFace(),
-		vertexIds,
-		mesh->variableSize( PrimitiveVariable::Vertex ),
-		mesh->interpolation()
-	);
+	std::vector<Data *> faceVaryingData = { vertexIds.get() };
 
 	std::unordered_set<const Data *> visited;
-	ReverseWindingFunctor reverseWindingFunctor( mesh, canceller );
 	for( auto &it : mesh->variables )
 	{
 		if( it.second.interpolation == PrimitiveVariable::FaceVarying )
 		{
-			if( it.second.indices )
-			{
-				if( visited.insert( it.second.indices.get() ).second )
-				{
-					::reverseWinding<IntVectorData::ValueType>( mesh, it.second.indices->writable(), canceller );
-				}
-			}
-			else if( visited.insert( it.second.data.get() ).second )
+			Data *data = it.second.indices ? it.second.indices.get() : it.second.data.get();
+			if( visited.insert( data ).second )
 			{
-				dispatch( it.second.data.get(), reverseWindingFunctor );
+				faceVaryingData.push_back( data );
 			}
 		}
 	}
-}
 
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, faceVaryingData.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				ReverseWindingFunctor reverseWindingFunctor( faceOffsets, canceller );
+				dispatch( faceVaryingData[i], reverseWindingFunctor );
+			}
+		},
+		taskGroupContext
+	);
+
+	mesh->setTopologyUnchecked(
+		mesh->verticesPerFace(),
+		vertexIds,
+		mesh->variableSize( PrimitiveVariable::Vertex ),
+		mesh->interpolation()
+	);
+}
@@ -35,12 +35,14 @@
 #include "IECoreScene/MeshPrimitiveEvaluator.h"
 
 #include "IECoreScene/PrimitiveVariable.h"
+#include "IECoreScene/private/BoundingVolumeHierarchy.h"
 
 #include "IECore/BoxOps.h"
 #include "IECore/Exception.h"
 #include "IECore/Export.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/TriangleAlgo.h"
+#include "IECore/VectorTypedData.h"
 
 IECORE_PUSH_DEFAULT_VISIBILITY
 #include "Imath/ImathMatrix.h"
@@ -49,7 +51,11 @@ IECORE_POP_DEFAULT_VISIBILITY
 #include "Imath/ImathBoxAlgo.h"
 #include "Imath/ImathLineAlgo.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <cassert>
+#include <cmath>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -211,7 +217,7 @@ const V3i &MeshPrimitiveEvaluator::Result::vertexIds() const
 	return m_vertexIds;
 }
 
-MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_uvTree(nullptr), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_haveAverageNormals( false )
+MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_tree( nullptr ), m_uvTree(nullptr), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_haveAverageNormals( false )
 {
 	if (! mesh )
 	{
@@ -249,52 +255,58 @@ MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m
 	}
 
 	const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-	m_triangles.reserve( verticesPerFace.size() );
-	m_uvTriangles.reserve( verticesPerFace.size() );
-	unsigned int triangleIdx = 0;
-	IntVectorData::ValueType::const_iterator vertexIdIt = m_meshVertexIds->begin();
-	for ( IntVectorData::ValueType::const_iterator it = verticesPerFace.begin();
-		it != verticesPerFace.end(); ++it, ++triangleIdx)
+	for( int numVertices : verticesPerFace )
 	{
-
-		if (*it != 3 )
+		if( numVertices != 3 )
 		{
 			throw InvalidArgumentException( "Non-triangular mesh given to MeshPrimitiveEvaluator");
 		}
+	}
 
-		Imath::V3i triangleVertexIds;
-
-		triangleVertexIds[0] = *vertexIdIt++;
-		assert( triangleVertexIds[0] < (int)( m_verts->readable().size() ) );
-		triangleVertexIds[1] = *vertexIdIt++;
-		assert( triangleVertexIds[1] < (int)( m_verts->readable().size() ) );
-		triangleVertexIds[2] = *vertexIdIt++;
-		assert( triangleVertexIds[2] < (int)( m_verts->readable().size() ) );
+	const bool haveUVs = m_uv.interpolation != PrimitiveVariable::Invalid;
+	m_triangles.resize( verticesPerFace.size() );
+	if( haveUVs )
+	{
+		m_uvTriangles.resize( verticesPerFace.size() );
+	}
 
-		const V3f &p0 = m_verts->readable()[ triangleVertexIds[0] ];
-		const V3f &p1 = m_verts->readable()[ triangleVertexIds[1] ];
-		const V3f &p2 = m_verts->readable()[ triangleVertexIds[2] ];
+	const std::vector<V3f> &verts = m_verts->readable();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, m_triangles.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t triangleIdx = range.begin(); triangleIdx != range.end(); ++triangleIdx )
+			{
+				const size_t vertIdOffset = triangleIdx * 3;
+				const Imath::V3i triangleVertexIds( (*m_meshVertexIds)[vertIdOffset], (*m_meshVertexIds)[vertIdOffset+1], (*m_meshVertexIds)[vertIdOffset+2] );
 
-		Box3f bound( p0 );
-		bound.extendBy( p1 );
-		bound.extendBy( p2 );
+				assert( triangleVertexIds[0] < (int)( verts.size() ) );
+				assert( triangleVertexIds[1] < (int)( verts.size() ) );
+				assert( triangleVertexIds[2] < (int)( verts.size() ) );
 
-		m_triangles.push_back( bound );
+				Box3f bound( verts[triangleVertexIds[0]] );
+				bound.extendBy( verts[triangleVertexIds[1]] );
+				bound.extendBy( verts[triangleVertexIds[2]] );
+				m_triangles[triangleIdx] = bound;
 
-		if( m_uv.interpolation != PrimitiveVariable::Invalid )
-		{
-			Imath::V2f uv[3];
-			triangleUVs( triangleIdx, triangleVertexIds, uv );
+				if( haveUVs )
+				{
+					Imath::V2f uv[3];
+					triangleUVs( triangleIdx, triangleVertexIds, uv );
 
-			Box2f uvBound( uv[0] );
-			uvBound.extendBy( uv[1] );
-			uvBound.extendBy( uv[2] );
+					Box2f uvBound( uv[0] );
+					uvBound.extendBy( uv[1] );
+					uvBound.extendBy( uv[2] );
 
-			m_uvTriangles.push_back( uvBound );
-		}
-	}
+					m_uvTriangles[triangleIdx] = uvBound;
+				}
+			}
+		},
+		taskGroupContext
+	);
 
-	m_tree = new TriangleBoundTree( m_triangles.begin(), m_triangles.end() );
+	m_bvh = std::make_unique<BoundingVolumeHierarchy>( m_triangles );
 
 	if( m_uv.interpolation != PrimitiveVariable::Invalid )
 	{
@@ -316,8 +328,6 @@ PrimitiveEvaluatorPtr MeshPrimitiveEvaluator::create( ConstPrimitivePtr primitiv
 
 MeshPrimitiveEvaluator::~MeshPrimitiveEvaluator()
 {
-	assert( m_tree );
-
 	delete m_tree;
 	m_tree = nullptr;
 
@@ -764,15 +774,45 @@ bool MeshPrimitiveEvaluator::closestPoint( const V3f &p, PrimitiveEvaluator::Res
 		return false;
 	}
 
-	assert( m_tree );
-
-	Result *mr = static_cast<Result *>( result );
+	const std::vector<V3f> &verts = m_verts->readable();
 
 	float maxDistSqrd = std::numeric_limits<float>::max();
+	int closestTriangle = -1;
+	V3f closestBary;
 
-	closestPointWalk( m_tree->rootIndex(), p, maxDistSqrd, mr );
+	m_bvh->closest(
+		p, maxDistSqrd,
+		[&]( int triangleIndex, float &closestDistanceSqrd )
+		{
+			const size_t vertIdOffset = triangleIndex * 3;
 
-	return true;
+			V3f bary;
+			const float dSqrd = triangleClosestBarycentric(
+				verts[(*m_meshVertexIds)[vertIdOffset]],
+				verts[(*m_meshVertexIds)[vertIdOffset+1]],
+				verts[(*m_meshVertexIds)[vertIdOffset+2]],
+				p,
+				bary
+			);
+
+			if( dSqrd < closestDistanceSqrd )
+			{
+				closestDistanceSqrd = dSqrd;
+				closestTriangle = triangleIndex;
+				closestBary = bary;
+			}
+		}
+	);
+
+	if( closestTriangle < 0 )
+	{
+		// Only possible if all the distances are NaN.
+		return false;
+	}
+
+	// The remainder of the result is only computed for the winning
+	// triangle, rather than for every improvement found along the way.
+	return barycentricPosition( closestTriangle, closestBary, result );
 }
 
 bool MeshPrimitiveEvaluator::pointAtUV( const Imath::V2f &uv, PrimitiveEvaluator::Result *result ) const
@@ -800,20 +840,55 @@ bool MeshPrimitiveEvaluator::intersectionPoint( const Imath::V3f &origin, const
 		return false;
 	}
 
-	assert( m_tree );
-
-	Result *mr = static_cast<Result *>( result );
+	const std::vector<V3f> &verts = m_verts->readable();
+	const V3f dir = direction.normalized();
 
 	float maxDistSqrd = maxDistance * maxDistance;
+	int closestTriangle = -1;
+	V3f closestBary;
+	V3f closestHitPoint;
+
+	// As `dir` is normalised, distances along the ray are
+	// the same as distances from the origin.
+	float maxRayDistance = maxDistance;
+	m_bvh->intersect(
+		origin, dir, maxRayDistance,
+		[&]( int triangleIndex, float &maxHitDistance )
+		{
+			const size_t vertIdOffset = triangleIndex * 3;
+
+			V3f hitPoint, bary;
+			bool front;
+			if( !triangleRayIntersection(
+				verts[(*m_meshVertexIds)[vertIdOffset]],
+				verts[(*m_meshVertexIds)[vertIdOffset+1]],
+				verts[(*m_meshVertexIds)[vertIdOffset+2]],
+				origin, dir, hitPoint, bary, front
+			) )
+			{
+				return;
+			}
 
-	Imath::Line3f ray;
-	ray.pos = origin;
-	ray.dir = direction.normalized();
+			const float dSqrd = vecDistance2( hitPoint, origin );
+			if( dSqrd < maxDistSqrd )
+			{
+				maxDistSqrd = dSqrd;
+				maxHitDistance = std::sqrt( dSqrd );
+				closestTriangle = triangleIndex;
+				closestBary = bary;
+				closestHitPoint = hitPoint;
+			}
+		}
+	);
 
-	bool hit = false;
+	if( closestTriangle < 0 )
+	{
+		return false;
+	}
 
-	intersectionPointWalk( m_tree->rootIndex(), ray, maxDistSqrd, mr, hit );
-	return hit;
+	barycentricPosition( closestTriangle, closestBary, result );
+	static_cast<Result *>( result )->m_p = closestHitPoint;
+	return true;
 }
 
 int MeshPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, const Imath::V3f &direction,
@@ -826,15 +901,39 @@ int MeshPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, const
 		return 0;
 	}
 
-	assert( m_tree );
+	const std::vector<V3f> &verts = m_verts->readable();
+	const V3f dir = direction.normalized();
+	const float maxDistSqrd = maxDistance * maxDistance;
 
-	float maxDistSqrd = maxDistance * maxDistance;
+	float maxRayDistance = maxDistance;
+	m_bvh->intersect(
+		origin, dir, maxRayDistance,
+		[&]( int triangleIndex, float & /* maxHitDistance */ )
+		{
+			const size_t vertIdOffset = triangleIndex * 3;
 
-	Imath::Line3f ray;
-	ray.pos = origin;
-	ray.dir = direction.normalized();
+			V3f hitPoint, bary;
+			bool front;
+			if( !triangleRayIntersection(
+				verts[(*m_meshVertexIds)[vertIdOffset]],
+				verts[(*m_meshVertexIds)[vertIdOffset+1]],
+				verts[(*m_meshVertexIds)[vertIdOffset+2]],
+				origin, dir, hitPoint, bary, front
+			) )
+			{
+				return;
+			}
 
-	intersectionPointsWalk( m_tree->rootIndex(), ray, maxDistSqrd, results );
+			if( vecDistance2( hitPoint, origin ) < maxDistSqrd )
+			{
+				// We want every hit, so we never reduce the search distance.
+				ResultPtr result = new Result();
+				barycentricPosition( triangleIndex, bary, result.get() );
+				result->m_p = hitPoint;
+				results.push_back( result );
+			}
+		}
+	);
 
 	return results.size();
 }
@@ -870,95 +969,6 @@ bool MeshPrimitiveEvaluator::barycentricPosition( unsigned int triangleIndex, co
 	return true;
 }
 
-void MeshPrimitiveEvaluator::closestPointWalk( TriangleBoundTree::NodeIndex nodeIndex, const V3f &p, float &closestDistanceSqrd, Result *result ) const
-{
-	assert( m_tree );
-
-	const TriangleBoundTree::Node &node = m_tree->node( nodeIndex );
-	if( node.isLeaf() )
-	{
-		TriangleBoundTree::Iterator *permLast = node.permLast();
-		for( TriangleBoundTree::Iterator *perm = node.permFirst(); perm!=permLast; perm++ )
-		{
-			size_t triangleIndex = *perm - m_triangles.begin(); // triangle index is just the distance of the triangle from the beginning of the vector
-			size_t vertIdOffset = triangleIndex * 3;
-			Imath::V3i vertexIds( (*m_meshVertexIds)[vertIdOffset], (*m_meshVertexIds)[vertIdOffset+1], (*m_meshVertexIds)[vertIdOffset+2] );
-
-			assert( vertexIds[0] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[1] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[2] < (int)( m_verts->readable().size() ) );
-
-			V3f bary;
-			float dSqrd = triangleClosestBarycentric(
-				m_verts->readable()[vertexIds[0]],
-				m_verts->readable()[vertexIds[1]],
-				m_verts->readable()[vertexIds[2]],
-				p,
-				bary );
-
-			if (dSqrd < closestDistanceSqrd)
-			{
-				closestDistanceSqrd = dSqrd;
-
-				result->m_bary = bary;
-				result->m_vertexIds = vertexIds;
-				result->m_triangleIdx = triangleIndex;
-
-				if( m_uv.interpolation != PrimitiveVariable::Invalid )
-				{
-					result->m_uv = result->vec2PrimVar( m_uv );
-				}
-
-				const Imath::V3f &p0 = m_verts->readable()[vertexIds[0]];
-				const Imath::V3f &p1 = m_verts->readable()[vertexIds[1]];
-				const Imath::V3f &p2 = m_verts->readable()[vertexIds[2]];
-
-				result->m_p = trianglePoint( p0, p1, p2, result->m_bary );
-
-				result->m_n = triangleNormal( p0, p1, p2 );
-			}
-		}
-	}
-	else
-	{
-		/// Descend into the closest box first
-
-		float dHigh = vecDistance(
-			closestPointInBox( p, m_tree->node( TriangleBoundTree::highChildIndex( nodeIndex ) ).bound() ),
-			p
-		);
-
-		float dLow = vecDistance(
-			closestPointInBox( p, m_tree->node( TriangleBoundTree::lowChildIndex( nodeIndex ) ).bound() ),
-			p
-		);
-
-		TriangleBoundTree::NodeIndex firstChild, secondChild;
-
-		float dSecond;
-
-		if (dHigh < dLow)
-		{
-			firstChild = TriangleBoundTree::highChildIndex( nodeIndex );
-			secondChild = TriangleBoundTree::lowChildIndex( nodeIndex );
-			dSecond = dLow;
-		}
-		else
-		{
-			firstChild = TriangleBoundTree::lowChildIndex( nodeIndex );
-			secondChild = TriangleBoundTree::highChildIndex( nodeIndex );
-			dSecond = dHigh;
-		}
-
-		closestPointWalk( firstChild, p, closestDistanceSqrd, result );
-
-		if (dSecond * dSecond < closestDistanceSqrd )
-		{
-			closestPointWalk( secondChild, p, closestDistanceSqrd, result );
-		}
-	}
-}
-
 bool MeshPrimitiveEvaluator::pointAtUVWalk( UVBoundTree::NodeIndex nodeIndex, const Imath::V2f &targetUV, Result *result ) const
 {
 	assert( m_uv.interpolation != PrimitiveVariable::Invalid );
@@ -1028,248 +1038,6 @@ bool MeshPrimitiveEvaluator::pointAtUVWalk( UVBoundTree::NodeIndex nodeIndex, co
 }
 
 
-bool MeshPrimitiveEvaluator::intersectionPointWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::Line3f &ray, float &maxDistSqrd, Result *result, bool &hit ) const
-{
-	assert( m_tree );
-
-	const TriangleBoundTree::Node &node = m_tree->node( nodeIndex );
-
-	if( node.isLeaf() )
-	{
-		TriangleBoundTree::Iterator *permLast = node.permLast();
-		bool intersects = false;
-
-		for( TriangleBoundTree::Iterator *perm = node.permFirst(); perm!=permLast; perm++ )
-		{
-			size_t triangleIndex = *perm - m_triangles.begin(); // triangle index is just the distance of the triangle from the beginning of the vector
-			size_t vertIdOffset = triangleIndex * 3;
-			Imath::V3i vertexIds( (*m_meshVertexIds)[vertIdOffset], (*m_meshVertexIds)[vertIdOffset+1], (*m_meshVertexIds)[vertIdOffset+2] );
-
-			assert( vertexIds[0] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[1] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[2] < (int)( m_verts->readable().size() ) );
-
-			const Imath::V3f &p0 = m_verts->readable()[ vertexIds[0] ];
-			const Imath::V3f &p1 = m_verts->readable()[ vertexIds[1] ];
-			const Imath::V3f &p2 = m_verts->readable()[ vertexIds[2] ];
-
-			V3f hitPoint, bary;
-			bool front;
-
-			if ( triangleRayIntersection( p0, p1, p2, ray.pos, ray.dir, hitPoint, bary, front ) )
-			{
-				float dSqrd = vecDistance2( hitPoint, ray.pos );
-
-				if (dSqrd < maxDistSqrd)
-				{
-					maxDistSqrd = dSqrd;
-
-					result->m_bary = bary;
-					result->m_vertexIds = vertexIds;
-					result->m_triangleIdx = triangleIndex;
-
-					result->m_p = hitPoint;
-
-					if( m_uv.interpolation != PrimitiveVariable::Invalid )
-					{
-						result->m_uv = result->vec2PrimVar( m_uv );
-					}
-
-					result->m_n = triangleNormal( p0, p1, p2 );
-
-					intersects = true;
-					hit = true;
-				}
-			}
-		}
-
-		return intersects;
-	}
-	else
-	{
-		V3f highHitPoint;
-		bool highHit = boxIntersects(
-			m_tree->node( TriangleBoundTree::highChildIndex( nodeIndex ) ).bound(),
-			ray.pos,
-			ray.dir,
-			highHitPoint
-		);
-
-		V3f lowHitPoint;
-		bool lowHit = boxIntersects(
-			m_tree->node( TriangleBoundTree::lowChildIndex( nodeIndex ) ).bound(),
-			ray.pos,
-			ray.dir,
-			lowHitPoint
-		);
-
-		float dHigh = -1;
-		if ( highHit )
-		{
-			float distSqrd = vecDistance2( highHitPoint, ray.pos );
-			if ( distSqrd > maxDistSqrd )
-			{
-				highHit = false;
-			}
-			else
-			{
-				dHigh = distSqrd;
-			}
-		}
-
-		float dLow = -1;
-		if ( lowHit )
-		{
-			float distSqrd = vecDistance2( lowHitPoint, ray.pos );
-			if ( distSqrd > maxDistSqrd )
-			{
-				lowHit = false;
-			}
-			else
-			{
-				dLow = distSqrd;
-			}
-		}
-
-		if (lowHit)
-		{
-			if (highHit)
-			{
-				/// Descend into the closest intersection first
-
-				TriangleBoundTree::NodeIndex firstChild, secondChild;
-				float dSecond;
-				if (dHigh < dLow)
-				{
-					firstChild = TriangleBoundTree::highChildIndex( nodeIndex );
-					secondChild = TriangleBoundTree::lowChildIndex( nodeIndex );
-					dSecond = dLow;
-				}
-				else
-				{
-					firstChild = TriangleBoundTree::lowChildIndex( nodeIndex );
-					secondChild = TriangleBoundTree::highChildIndex( nodeIndex );
-					dSecond = dHigh;
-				}
-
-				bool intersection = intersectionPointWalk( firstChild, ray, maxDistSqrd, result, hit );
-
-				if (intersection)
-				{
-					if ( dSecond < maxDistSqrd )
-					{
-						intersectionPointWalk( secondChild, ray, maxDistSqrd, result, hit );
-					}
-
-					return true;
-				}
-				else
-				{
-					return intersectionPointWalk( secondChild, ray, maxDistSqrd, result, hit );
-				}
-			}
-			else
-			{
-				return intersectionPointWalk( TriangleBoundTree::lowChildIndex( nodeIndex ), ray, maxDistSqrd, result, hit );
-			}
-
-		}
-		else if (highHit)
-		{
-			return intersectionPointWalk( TriangleBoundTree::highChildIndex( nodeIndex ), ray, maxDistSqrd, result, hit );
-		}
-
-
-		return false;
-	}
-
-}
-
-void MeshPrimitiveEvaluator::intersectionPointsWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::Line3f &ray, float maxDistSqrd, std::vector<PrimitiveEvaluator::ResultPtr> &results ) const
-{
-	assert( m_tree );
-
-	const TriangleBoundTree::Node &node = m_tree->node( nodeIndex );
-
-	if( node.isLeaf() )
-	{
-		TriangleBoundTree::Iterator *permLast = node.permLast();
-
-		for( TriangleBoundTree::Iterator *perm = node.permFirst(); perm!=permLast; perm++ )
-		{
-			size_t triangleIndex = *perm - m_triangles.begin(); // triangle index is just the distance of the triangle from the beginning of the vector
-			size_t vertIdOffset = triangleIndex * 3;
-			Imath::V3i vertexIds( (*m_meshVertexIds)[vertIdOffset], (*m_meshVertexIds)[vertIdOffset+1], (*m_meshVertexIds)[vertIdOffset+2] );
-
-			assert( vertexIds[0] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[1] < (int)( m_verts->readable().size() ) );
-			assert( vertexIds[2] < (int)( m_verts->readable().size() ) );
-
-			const Imath::V3f &p0 =  m_verts->readable()[ vertexIds[0] ];
-			const Imath::V3f &p1 =  m_verts->readable()[ vertexIds[1] ];
-			const Imath::V3f &p2 =  m_verts->readable()[ vertexIds[2] ];
-
-			V3f hitPoint, bary;
-			bool front;
-
-			if ( triangleRayIntersection( p0, p1, p2, ray.pos, ray.dir, hitPoint, bary, front ) )
-			{
-				float dSqrd = vecDistance2( hitPoint, ray.pos );
-
-				if (dSqrd < maxDistSqrd)
-				{
-					ResultPtr result = new Result();
-
-					result->m_bary = bary;
-					result->m_vertexIds = vertexIds;
-					result->m_triangleIdx = triangleIndex;
-
-					result->m_p = hitPoint;
-
-					if ( m_uv.interpolation != PrimitiveVariable::Invalid )
-					{
-						result->m_uv = result->vec2PrimVar( m_uv );
-					}
-
-					result->m_n = triangleNormal( p0, p1, p2 );
-
-					results.push_back( result );
-				}
-			}
-		}
-	}
-	else
-	{
-		V3f hitPoint;
-
-		/// Test highChild bound for intersection, descending into children if necessary
-		bool hit = boxIntersects(
-			m_tree->node( TriangleBoundTree::highChildIndex( nodeIndex ) ).bound(),
-			ray.pos,
-			ray.dir,
-			hitPoint
-		);
-
-		if ( hit && vecDistance2( hitPoint, ray.pos ) < maxDistSqrd )
-		{
-			intersectionPointsWalk( TriangleBoundTree::highChildIndex( nodeIndex ), ray, maxDistSqrd, results );
-		}
-
-		/// Test lowChild bound for intersection, descending into children if necessary
-		hit = boxIntersects(
-			m_tree->node( TriangleBoundTree::lowChildIndex( nodeIndex ) ).bound(),
-			ray.pos,
-			ray.dir,
-			hitPoint
-		);
-
-		if ( hit && vecDistance2( hitPoint, ray.pos ) < maxDistSqrd )
-		{
-			intersectionPointsWalk( TriangleBoundTree::lowChildIndex( nodeIndex ), ray, maxDistSqrd, results );
-		}
-	}
-}
-
 const Imath::Box2f MeshPrimitiveEvaluator::uvBound() const
 {
 	if( !m_uvTree )
@@ -1286,6 +1054,14 @@ const MeshPrimitiveEvaluator::TriangleBoundVector *MeshPrimitiveEvaluator::trian
 
 const MeshPrimitiveEvaluator::TriangleBoundTree *MeshPrimitiveEvaluator::triangleBoundTree() const
 {
+	std::call_once(
+		m_treeOnceFlag,
+		[this] {
+			// The tree only reads the bounds, but requires non-const iterators.
+			TriangleBoundVector &triangles = const_cast<TriangleBoundVector &>( m_triangles );
+			m_tree = new TriangleBoundTree( triangles.begin(), triangles.end() );
+		}
+	);
 	return m_tree;
 }
 
@@ -1299,6 +1075,41 @@ const MeshPrimitiveEvaluator::UVBoundTree *MeshPrimitiveEvaluator::uvBoundTree()
 	return m_uvTree;
 }
 
+PrimitiveEvaluator::BatchOutputFunction MeshPrimitiveEvaluator::addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const
+{
+	V3fVectorDataPtr nData = new V3fVectorData( std::vector<V3f>( numQueries, V3f( 0 ) ) );
+	nData->setInterpretation( GeometricData::Normal );
+	IntVectorDataPtr triangleIndexData = new IntVectorData( std::vector<int>( numQueries, -1 ) );
+	V3fVectorDataPtr barycentricCoordinatesData = new V3fVectorData( std::vector<V3f>( numQueries, V3f( 0 ) ) );
+
+	outputs->writable()["N"] = nData;
+	outputs->writable()["triangleIndex"] = triangleIndexData;
+	outputs->writable()["barycentricCoordinates"] = barycentricCoordinatesData;
+
+	std::vector<V2f> *uv = nullptr;
+	if( m_uv.interpolation != PrimitiveVariable::Invalid )
+	{
+		V2fVectorDataPtr uvData = new V2fVectorData( std::vector<V2f>( numQueries, V2f( 0 ) ) );
+		uvData->setInterpretation( GeometricData::UV );
+		outputs->writable()["uv"] = uvData;
+		uv = &uvData->writable();
+	}
+
+	std::vector<V3f> *n = &nData->writable();
+	std::vector<int> *triangleIndex = &triangleIndexData->writable();
+	std::vector<V3f> *barycentricCoordinates = &barycentricCoordinatesData->writable();
+	return [n, triangleIndex, barycentricCoordinates, uv]( const PrimitiveEvaluator::Result *result, size_t queryIndex ) {
+		const Result *meshResult = static_cast<const Result *>( result );
+		(*n)[queryIndex] = meshResult->m_n;
+		(*triangleIndex)[queryIndex] = meshResult->m_triangleIdx;
+		(*barycentricCoordinates)[queryIndex] = meshResult->m_bary;
+		if( uv )
+		{
+			(*uv)[queryIndex] = meshResult->m_uv;
+		}
+	};
+}
+
 void MeshPrimitiveEvaluator::triangleUVs( size_t triangleIndex, const Imath::V3i &vertexIds, Imath::V2f uv[3] ) const
 {
 	PrimitiveVariable::IndexedView<V2f> uvs( m_uv );
@@ -43,7 +43,10 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/TypeTraits.h"
 
+#include "tbb/parallel_for.h"
+
 #include <numeric>
+#include <type_traits>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -110,8 +113,12 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, IECoreS
 {
 	PointsPrimitivePtr outPointsPrimitive = pointsPrimitive->copy();
 
-	IECoreScene::PrimitiveVariableAlgos::DeleteFlaggedUniformFunctor<T> vertexFunctor( deleteFlagView, invert );
+	const IECoreScene::PrimitiveVariableAlgos::KeptElements keptPoints(
+		pointsPrimitive->getNumPoints(), IECoreScene::PrimitiveVariableAlgos::keepUnflagged( deleteFlagView, invert ),
+		[]( size_t ) { return 1; }, canceller
+	);
 
+	std::vector<std::pair<const std::string *, const PrimitiveVariable *>> variables;
 	for( PrimitiveVariableMap::const_iterator it = pointsPrimitive->variables.begin(), e = pointsPrimitive->variables.end(); it != e; ++it )
 	{
 		Canceller::check( canceller );
@@ -127,10 +134,7 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, IECoreS
 						fmt::format( "PointsAlgo::deletePoints cannot process invalid primitive variable \"{}\"", it->first )
 					);
 				}
-				const IECore::Data *inputData = it->second.data.get();
-				vertexFunctor.setIndices( it->second.indices.get() );
-				IECoreScene::PrimitiveVariableAlgos::IndexedData indexedData = dispatch( inputData, vertexFunctor );
-				outPointsPrimitive->variables[it->first] = PrimitiveVariable( it->second.interpolation, indexedData.data, indexedData.indices );
+				variables.push_back( { &it->first, &it->second } );
 				break;
 			}
 			default :
@@ -138,6 +142,27 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, IECoreS
 		}
 	}
 
+	// Filter the primitive variables in parallel.
+	std::vector<IECoreScene::PrimitiveVariableAlgos::IndexedData> outputData( variables.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const IECore::Data *inputData = variables[i].second->data.get();
+				outputData[i] = dispatch( inputData, keptPoints, variables[i].second->indices.get() );
+			}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < variables.size(); ++i )
+	{
+		outPointsPrimitive->variables[*variables[i].first] = PrimitiveVariable( variables[i].second->interpolation, outputData[i].data, outputData[i].indices );
+	}
+
 	V3fVectorDataPtr positionData = outPointsPrimitive->variableData<V3fVectorData>( "P" );
 	if( positionData )
 	{
@@ -147,58 +172,85 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, IECoreS
 	return outPointsPrimitive;
 }
 
-struct CollectDataFn
+struct MergePrimVarsFn
 {
-	CollectDataFn( size_t size ) : offset( 0 ), m_size( size )
+	typedef DataPtr ReturnType;
+
+	MergePrimVarsFn( const std::vector<PointsPrimitivePtr> &pointsPrimitives, const std::string &primVarName, const std::vector<size_t> &offsets, const Canceller *canceller )
+		:	m_pointsPrimitives( pointsPrimitives ), m_primVarName( primVarName ), m_offsets( offsets ), m_canceller( canceller )
 	{
 	}
 
-	typedef void ReturnType;
-
 	template<typename T>
 	ReturnType operator()( const T *data )
 	{
-		T *container = nullptr;
-		if( !outputData )
-		{
-			container = new T();
-			outputData = container;
+		typedef typename T::ValueType::value_type ValueType;
+
+		Canceller::check( m_canceller );
+		typename T::Ptr result = new T();
+		auto &resultWritable = result->writable();
+		resultWritable.resize( m_offsets.back() );
+
+		auto copyPrimVar = [&] ( size_t i ) {
+			PrimitiveVariableMap::const_iterator it = m_pointsPrimitives[i]->variables.find( m_primVarName );
+			if( it == m_pointsPrimitives[i]->variables.end() )
+			{
+				return;
+			}
+
+			const auto &input = static_cast<const T *>( it->second.data.get() )->readable();
+			auto out = resultWritable.begin() + m_offsets[i];
+			if( it->second.indices )
+			{
+				for( int index : it->second.indices->readable() )
+				{
+					*out++ = input[index];
+				}
+			}
+			else
+			{
+				std::copy( input.begin(), input.end(), out );
+			}
+		};
 
-			container->writable().resize( m_size );
+		if constexpr( std::is_same_v<ValueType, bool> )
+		{
+			// Elements of `std::vector<bool>` share storage,
+			// so can't be written concurrently.
+			for( size_t i = 0; i < m_pointsPrimitives.size(); ++i )
+			{
+				Canceller::check( m_canceller );
+				copyPrimVar( i );
+			}
 		}
 		else
 		{
-			container = runTimeCast<T>( outputData.get() );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, m_pointsPrimitives.size() ),
+				[&] ( const tbb::blocked_range<size_t> &range )
+				{
+					Canceller::check( m_canceller );
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						copyPrimVar( i );
+					}
+				},
+				taskGroupContext
+			);
 		}
 
-		std::copy( data->readable().begin(), data->readable().end(), container->writable().begin() + offset );
+		return result;
 	}
 
-	DataPtr outputData;
-	size_t offset;
-	size_t m_size;
-};
+	private :
 
-DataPtr mergePrimVars( const std::vector<PointsPrimitivePtr> &pointsPrimitives, const std::string &primVarName, size_t totalCount, const Canceller *canceller )
-{
-	CollectDataFn fn( totalCount );
+		const std::vector<PointsPrimitivePtr> &m_pointsPrimitives;
+		const std::string &m_primVarName;
+		const std::vector<size_t> &m_offsets;
+		const Canceller *m_canceller;
 
-	for( size_t i = 0; i < pointsPrimitives.size(); ++i )
-	{
-		Canceller::check( canceller );
-		PrimitiveVariableMap::const_iterator it = pointsPrimitives[i]->variables.find( primVarName );
-
-		if( it != pointsPrimitives[i]->variables.end() )
-		{
-			PrimitiveVariable primVar = it->second;
-			despatchTypedData<CollectDataFn, TypeTraits::IsVectorTypedData>( const_cast< Data * >( primVar.data.get() ), fn );
-		}
-
-		fn.offset += pointsPrimitives[i]->getNumPoints();
-	}
-
-	return fn.outputData;
-}
+};
 
 } // anonymous namespace
 
@@ -406,21 +458,83 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 	// allocate the new points primitive and copy the primvars
 	PointsPrimitivePtr newPoints = new PointsPrimitive( totalPointCount );
 
+	std::vector<size_t> offsets( validatedPointsPrimitives.size() + 1, 0 );
+	for( size_t i = 0; i < validatedPointsPrimitives.size(); ++i )
+	{
+		offsets[i+1] = offsets[i] + validatedPointsPrimitives[i]->getNumPoints();
+	}
+
 	// copy constant primvars
 	for( PrimitiveVariableMap::const_iterator it = constantPrimVars.begin(); it != constantPrimVars.end(); ++it )
 	{
 		newPoints->variables[it->first] = it->second;
 	}
 
-	// merge vertex primvars
-	for( FoundPrimvars::const_iterator it = foundPrimvars.begin(); it != foundPrimvars.end(); ++it )
+	// merge vertex primvars, using the data from the first primitive
+	// providing each one to determine its type.
+	std::vector<std::pair<std::string, const Data *>> vertexPrimVars;
+	for( const auto &[name, typeId] : foundPrimvars )
 	{
-		DataPtr mergedData = mergePrimVars( validatedPointsPrimitives, it->first, totalPointCount, canceller );
-		newPoints->variables[it->first] = PrimitiveVariable( PrimitiveVariable::Vertex, mergedData );
+		for( const auto &p : validatedPointsPrimitives )
+		{
+			PrimitiveVariableMap::const_iterator it = p->variables.find( name );
+			if( it != p->variables.end() )
+			{
+				vertexPrimVars.push_back( { name, it->second.data.get() } );
+				break;
+			}
+		}
+	}
+
+	std::vector<DataPtr> mergedData( vertexPrimVars.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, vertexPrimVars.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				MergePrimVarsFn fn( validatedPointsPrimitives, vertexPrimVars[i].first, offsets, canceller );
+				mergedData[i] = despatchTypedData<MergePrimVarsFn, TypeTraits::IsVectorTypedData>( const_cast<Data *>( vertexPrimVars[i].second ), fn );
+			}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < vertexPrimVars.size(); ++i )
+	{
+		newPoints->variables[vertexPrimVars[i].first] = PrimitiveVariable( PrimitiveVariable::Vertex, mergedData[i] );
 	}
 
 	return newPoints;
 }
 
+void reorderForLocality( PointsPrimitive *points, const std::string &position, const Canceller *canceller )
+{
+	const V3fVectorData *positionData = points->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !positionData )
+	{
+		throw InvalidArgumentException( fmt::format( "PointsAlgo::reorderForLocality : PointsPrimitive has no Vertex \"{}\" primitive variable.", position ) );
+	}
+
+	const std::vector<int> pointOrder = Detail::spatialOrder( positionData->readable(), canceller );
+
+	PrimitiveVariableAlgos::reorderPrimitiveVariables(
+		points->variables,
+		[&]( PrimitiveVariable::Interpolation interpolation ) -> const std::vector<int> * {
+			switch( interpolation )
+			{
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+				case PrimitiveVariable::FaceVarying :
+					return &pointOrder;
+				default :
+					return nullptr;
+			}
+		},
+		canceller
+	);
+}
+
 } // namespace PointsAlgo
 } // namespace IECoreScene
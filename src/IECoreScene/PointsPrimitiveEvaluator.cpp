@@ -38,6 +38,7 @@
 
 #include "IECore/Exception.h"
 #include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
 
 using namespace std;
 using namespace Imath;
@@ -267,3 +268,14 @@ void PointsPrimitiveEvaluator::buildTree()
 	m_tree.init( m_pVector->begin(), m_pVector->end() );
 	m_haveTree = true;
 }
+
+PrimitiveEvaluator::BatchOutputFunction PointsPrimitiveEvaluator::addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const
+{
+	IntVectorDataPtr pointIndexData = new IntVectorData( std::vector<int>( numQueries, -1 ) );
+	outputs->writable()["pointIndex"] = pointIndexData;
+
+	std::vector<int> *pointIndex = &pointIndexData->writable();
+	return [pointIndex]( const PrimitiveEvaluator::Result *result, size_t queryIndex ) {
+		(*pointIndex)[queryIndex] = static_cast<const Result *>( result )->pointIndex();
+	};
+}
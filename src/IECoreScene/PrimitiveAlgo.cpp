@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "IECoreScene/PrimitiveAlgo.h"
+
+#include "IECore/VectorTypedData.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+using namespace IECore;
+using namespace IECoreScene;
+using namespace Imath;
+
+namespace
+{
+
+// The loops below are written out by hand rather than using
+// `Matrix44::multVecMatrix()` and `multDirMatrix()`, so that they
+// contain no branches or divisions and can be vectorised by the
+// compiler. The arithmetic is otherwise identical.
+
+template<typename T>
+void transformPoints( Vec3<T> *p, size_t size, const Matrix44<T> &m )
+{
+	for( size_t i = 0; i < size; ++i )
+	{
+		const Vec3<T> s = p[i];
+		p[i] = Vec3<T>(
+			s.x * m[0][0] + s.y * m[1][0] + s.z * m[2][0] + m[3][0],
+			s.x * m[0][1] + s.y * m[1][1] + s.z * m[2][1] + m[3][1],
+			s.x * m[0][2] + s.y * m[1][2] + s.z * m[2][2] + m[3][2]
+		);
+	}
+}
+
+template<typename T>
+void transformDirections( Vec3<T> *p, size_t size, const Matrix44<T> &m )
+{
+	for( size_t i = 0; i < size; ++i )
+	{
+		const Vec3<T> s = p[i];
+		p[i] = Vec3<T>(
+			s.x * m[0][0] + s.y * m[1][0] + s.z * m[2][0],
+			s.x * m[0][1] + s.y * m[1][1] + s.z * m[2][1],
+			s.x * m[0][2] + s.y * m[1][2] + s.z * m[2][2]
+		);
+	}
+}
+
+template<typename T>
+void transformVectors( std::vector<Vec3<T>> &data, GeometricData::Interpretation interpretation, const Matrix44<T> &matrix, const Matrix44<T> &normalMatrix, const Canceller *canceller )
+{
+	// Projective matrices require a division by w, which we
+	// leave to Imath.
+	const bool affine = matrix[0][3] == 0 && matrix[1][3] == 0 && matrix[2][3] == 0 && matrix[3][3] == 1;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, data.size(), 1000 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			Canceller::check( canceller );
+			Vec3<T> *p = data.data() + range.begin();
+			const size_t size = range.size();
+			switch( interpretation )
+			{
+				case GeometricData::Point :
+					if( affine )
+					{
+						transformPoints( p, size, matrix );
+					}
+					else
+					{
+						for( size_t i = 0; i < size; ++i )
+						{
+							matrix.multVecMatrix( p[i], p[i] );
+						}
+					}
+					break;
+				case GeometricData::Vector :
+					transformDirections( p, size, matrix );
+					break;
+				case GeometricData::Normal :
+					transformDirections( p, size, normalMatrix );
+					break;
+				default :
+					break;
+			}
+		},
+		taskGroupContext
+	);
+}
+
+bool transformable( const Data *data )
+{
+	GeometricData::Interpretation interpretation;
+	if( auto v3f = runTimeCast<const V3fVectorData>( data ) )
+	{
+		interpretation = v3f->getInterpretation();
+	}
+	else if( auto v3d = runTimeCast<const V3dVectorData>( data ) )
+	{
+		interpretation = v3d->getInterpretation();
+	}
+	else
+	{
+		return false;
+	}
+
+	return
+		interpretation == GeometricData::Point ||
+		interpretation == GeometricData::Vector ||
+		interpretation == GeometricData::Normal
+	;
+}
+
+} // namespace
+
+void IECoreScene::PrimitiveAlgo::transform( Primitive *primitive, const Imath::M44f &matrix, const IECore::Canceller *canceller )
+{
+	std::vector<PrimitiveVariable *> variables;
+	for( auto &it : primitive->variables )
+	{
+		if( it.second.data && transformable( it.second.data.get() ) )
+		{
+			variables.push_back( &it.second );
+		}
+	}
+
+	// Compute the matrices for each precision once, rather than
+	// once per variable.
+	const M44d matrixD( matrix );
+	const M44f normalMatrix = matrix.inverse().transposed();
+	const M44d normalMatrixD = matrixD.inverse().transposed();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, variables.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				PrimitiveVariable &variable = *variables[i];
+				if( variable.data->refCount() > 1 )
+				{
+					// Shared with another primitive variable or object,
+					// so we must copy rather than modify in place.
+					variable.data = variable.data->copy();
+				}
+
+				if( auto v3f = runTimeCast<V3fVectorData>( variable.data.get() ) )
+				{
+					transformVectors( v3f->writable(), v3f->getInterpretation(), matrix, normalMatrix, canceller );
+				}
+				else
+				{
+					auto v3d = static_cast<V3dVectorData *>( variable.data.get() );
+					transformVectors( v3d->writable(), v3d->getInterpretation(), matrixD, normalMatrixD, canceller );
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
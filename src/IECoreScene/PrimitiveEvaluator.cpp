@@ -38,9 +38,81 @@
 #include "IECoreScene/MeshPrimitiveEvaluator.h"
 #include "IECoreScene/SpherePrimitiveEvaluator.h"
 
+#include "IECore/DataAlgo.h"
+#include "IECore/VectorTypedData.h"
+
+#include "fmt/format.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <type_traits>
+
+using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+using PrimitiveVariableWriter = std::function<void ( const PrimitiveEvaluator::Result *result, size_t queryIndex )>;
+
+template<typename T, T (PrimitiveEvaluator::Result::*Getter)( const PrimitiveVariable & ) const>
+PrimitiveVariableWriter primitiveVariableWriter( const PrimitiveVariable &primitiveVariable, size_t numQueries, CompoundDataMap &outputs, const std::string &name )
+{
+	using DataType = TypedData<std::vector<T>>;
+	typename DataType::Ptr data = new DataType( std::vector<T>( numQueries, T( 0 ) ) );
+	if constexpr( std::is_same_v<T, V3f> || std::is_same_v<T, V2f> )
+	{
+		data->setInterpretation( getGeometricInterpretation( primitiveVariable.data.get() ) );
+	}
+	outputs[name] = data;
+
+	std::vector<T> *values = &data->writable();
+	return [&primitiveVariable, values]( const PrimitiveEvaluator::Result *result, size_t queryIndex ) {
+		(*values)[queryIndex] = (result->*Getter)( primitiveVariable );
+	};
+}
+
+PrimitiveVariableWriter primitiveVariableWriter( const PrimitiveVariable &primitiveVariable, size_t numQueries, CompoundDataMap &outputs, const std::string &name )
+{
+	switch( primitiveVariable.data->typeId() )
+	{
+		case V3fDataTypeId :
+		case V3fVectorDataTypeId :
+			return primitiveVariableWriter<V3f, &PrimitiveEvaluator::Result::vectorPrimVar>( primitiveVariable, numQueries, outputs, name );
+		case V2fDataTypeId :
+		case V2fVectorDataTypeId :
+			return primitiveVariableWriter<V2f, &PrimitiveEvaluator::Result::vec2PrimVar>( primitiveVariable, numQueries, outputs, name );
+		case FloatDataTypeId :
+		case FloatVectorDataTypeId :
+			return primitiveVariableWriter<float, &PrimitiveEvaluator::Result::floatPrimVar>( primitiveVariable, numQueries, outputs, name );
+		case IntDataTypeId :
+		case IntVectorDataTypeId :
+			return primitiveVariableWriter<int, &PrimitiveEvaluator::Result::intPrimVar>( primitiveVariable, numQueries, outputs, name );
+		case Color3fDataTypeId :
+		case Color3fVectorDataTypeId :
+			return primitiveVariableWriter<Color3f, &PrimitiveEvaluator::Result::colorPrimVar>( primitiveVariable, numQueries, outputs, name );
+		case HalfDataTypeId :
+		case HalfVectorDataTypeId :
+			return primitiveVariableWriter<half, &PrimitiveEvaluator::Result::halfPrimVar>( primitiveVariable, numQueries, outputs, name );
+		default :
+			throw InvalidArgumentException(
+				fmt::format( "Primitive variable \"{}\" has unsupported type \"{}\"", name, primitiveVariable.data->typeName() )
+			);
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// PrimitiveEvaluator
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( PrimitiveEvaluator );
 
 PrimitiveEvaluator::CreatorMap &PrimitiveEvaluator::getCreateFns()
@@ -102,3 +174,113 @@ bool PrimitiveEvaluator::signedDistance( const Imath::V3f &p, float &distance, R
 
 	return true;
 }
+
+CompoundDataPtr PrimitiveEvaluator::closestPoints( const std::vector<Imath::V3f> &points, const std::vector<std::string> &primitiveVariables, const IECore::Canceller *canceller ) const
+{
+	return batchQuery(
+		points.size(),
+		[&]( size_t queryIndex, Result *result ) {
+			return closestPoint( points[queryIndex], result );
+		},
+		primitiveVariables, canceller
+	);
+}
+
+CompoundDataPtr PrimitiveEvaluator::pointsAtUV( const std::vector<Imath::V2f> &uvs, const std::vector<std::string> &primitiveVariables, const IECore::Canceller *canceller ) const
+{
+	return batchQuery(
+		uvs.size(),
+		[&]( size_t queryIndex, Result *result ) {
+			return pointAtUV( uvs[queryIndex], result );
+		},
+		primitiveVariables, canceller
+	);
+}
+
+CompoundDataPtr PrimitiveEvaluator::intersectRays( const std::vector<Imath::V3f> &origins, const std::vector<Imath::V3f> &directions, float maxDistance, const std::vector<std::string> &primitiveVariables, const IECore::Canceller *canceller ) const
+{
+	if( origins.size() != directions.size() )
+	{
+		throw InvalidArgumentException(
+			fmt::format( "Number of origins ({}) does not match number of directions ({})", origins.size(), directions.size() )
+		);
+	}
+
+	return batchQuery(
+		origins.size(),
+		[&]( size_t queryIndex, Result *result ) {
+			return intersectionPoint( origins[queryIndex], directions[queryIndex], result, maxDistance );
+		},
+		primitiveVariables, canceller
+	);
+}
+
+PrimitiveEvaluator::BatchOutputFunction PrimitiveEvaluator::addBatchOutputs( size_t /* numQueries */, IECore::CompoundData * /* outputs */ ) const
+{
+	return BatchOutputFunction();
+}
+
+CompoundDataPtr PrimitiveEvaluator::batchQuery( size_t numQueries, const BatchQueryFunction &query, const std::vector<std::string> &primitiveVariables, const IECore::Canceller *canceller ) const
+{
+	CompoundDataPtr outputs = new CompoundData;
+
+	V3fVectorDataPtr pData = new V3fVectorData( std::vector<V3f>( numQueries, V3f( 0 ) ) );
+	pData->setInterpretation( GeometricData::Point );
+	outputs->writable()["P"] = pData;
+	std::vector<V3f> &p = pData->writable();
+
+	std::vector<BatchOutputFunction> writers;
+	if( BatchOutputFunction writer = addBatchOutputs( numQueries, outputs.get() ) )
+	{
+		writers.push_back( writer );
+	}
+
+	// Keep the primitive alive while we reference its variables.
+	ConstPrimitivePtr primitive = this->primitive();
+	CompoundDataPtr primitiveVariableOutputs = new CompoundData;
+	outputs->writable()["primitiveVariables"] = primitiveVariableOutputs;
+	for( const auto &name : primitiveVariables )
+	{
+		auto it = primitive->variables.find( name );
+		if( it == primitive->variables.end() )
+		{
+			throw InvalidArgumentException( fmt::format( "Primitive variable \"{}\" does not exist", name ) );
+		}
+		writers.push_back( primitiveVariableWriter( it->second, numQueries, primitiveVariableOutputs->writable(), name ) );
+	}
+
+	// `std::vector<bool>` can't be written concurrently, so we
+	// record success in bytes and convert at the end.
+	std::vector<char> success( numQueries, 0 );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numQueries ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			Canceller::check( canceller );
+			// Results are reused for every query in the range, which is
+			// safe because each query overwrites them completely.
+			ResultPtr result = createResult();
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				if( !query( i, result.get() ) )
+				{
+					continue;
+				}
+
+				success[i] = 1;
+				p[i] = result->point();
+				for( const auto &writer : writers )
+				{
+					writer( result.get(), i );
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	outputs->writable()["success"] = new BoolVectorData( std::vector<bool>( success.begin(), success.end() ) );
+
+	return outputs;
+}
@@ -37,12 +37,22 @@
 #include "IECoreScene/CurvesPrimitive.h"
 #include "IECoreScene/MeshPrimitive.h"
 #include "IECoreScene/PointsPrimitive.h"
+#include "IECoreScene/SceneCache.h"
 #include "IECoreScene/SceneInterface.h"
 
-#include "tbb/blocked_range.h"
-#include "tbb/parallel_for.h"
+#include "fmt/format.h"
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -50,51 +60,81 @@ using namespace IECoreScene;
 namespace
 {
 
-template<typename LocationFn>
-void parallelLocationWalk( const SceneInterface *src, SceneInterface *dst, LocationFn &locationFn, double time, unsigned int flags, tbb::task_group_context &taskGroupContext )
+void readComponents( const SceneInterface *scene, const SceneAlgo::ParallelTraverseOptions &options, SceneAlgo::LocationComponents &components )
 {
-	locationFn( src, dst, time, flags );
-
-	SceneInterface::NameList childNames;
-	src->childNames( childNames );
-	if( childNames.empty() )
+	if( options.prefetch & SceneAlgo::Bounds )
 	{
-		return;
+		components.bound = scene->readBound( options.time );
 	}
 
-	std::vector<SceneInterfacePtr> childSceneInterfaces;
-	childSceneInterfaces.reserve( childNames.size() );
-
-	std::vector<ConstSceneInterfacePtr> srcChildSceneInterfaces;
-	srcChildSceneInterfaces.reserve( childNames.size() );
-
-	for( const auto &childName : childNames )
+	if( options.prefetch & SceneAlgo::Transforms )
 	{
-		SceneInterfacePtr dstChild = dst ? dst->child( childName, SceneInterface::CreateIfMissing ) : nullptr;
-		childSceneInterfaces.push_back( dstChild );
+		components.transform = scene->readTransform( options.time );
+	}
 
-		ConstSceneInterfacePtr srcChild = src->child( childName );
-		srcChildSceneInterfaces.push_back( srcChild );
+	if( options.prefetch & SceneAlgo::Attributes )
+	{
+		SceneInterface::NameList attributeNames;
+		scene->attributeNames( attributeNames );
+		for( const auto &attributeName : attributeNames )
+		{
+			components.attributes[attributeName] = scene->readAttribute( attributeName, options.time );
+		}
 	}
 
-	if( childNames.size() == 1 )
+	if( options.prefetch & SceneAlgo::Objects && scene->hasObject() )
 	{
-		// Serial execution
-		parallelLocationWalk<LocationFn>( srcChildSceneInterfaces[0].get(), childSceneInterfaces[0].get(), locationFn, time, flags, taskGroupContext );
+		components.object = scene->readObject( options.time, options.canceller );
 	}
-	else
+
+	components.prefetched = options.prefetch & ( SceneAlgo::Bounds | SceneAlgo::Transforms | SceneAlgo::Attributes | SceneAlgo::Objects );
+}
+
+// Visits a location and then spawns a task for each of its children, so that
+// idle threads may steal work from any level of the hierarchy. The last child
+// is visited in the current task, to avoid the overhead of a spawn where
+// the current thread would otherwise just wait.
+void traverseWalk( const SceneInterface *scene, int depth, const SceneAlgo::ParallelTraverseVisitor &visitor, const SceneAlgo::ParallelTraverseOptions &options, tbb::task_group &taskGroup )
+{
+	// Holds ownership of `location` after we've moved on from `scene`.
+	ConstSceneInterfacePtr locationHolder;
+	const SceneInterface *location = scene;
+	while( true )
 	{
-		tbb::parallel_for(
-			tbb::blocked_range<size_t>( 0, childNames.size() ),
-			[&]( const tbb::blocked_range<size_t> &r )
-			{
-				for( size_t i = r.begin(); i != r.end(); ++i )
-				{
-					parallelLocationWalk<LocationFn>( srcChildSceneInterfaces[i].get(), childSceneInterfaces[i].get(), locationFn, time, flags, taskGroupContext );
+		Canceller::check( options.canceller );
+
+		SceneAlgo::LocationComponents components;
+		readComponents( location, options, components );
+		if( !visitor( location, components ) )
+		{
+			return;
+		}
+
+		if( options.maxDepth >= 0 && depth >= options.maxDepth )
+		{
+			return;
+		}
+
+		SceneInterface::NameList childNames;
+		location->childNames( childNames );
+		if( childNames.empty() )
+		{
+			return;
+		}
+
+		++depth;
+		for( size_t i = 0, e = childNames.size() - 1; i < e; ++i )
+		{
+			ConstSceneInterfacePtr child = location->child( childNames[i] );
+			taskGroup.run(
+				[child, depth, &visitor, &options, &taskGroup] {
+					traverseWalk( child.get(), depth, visitor, options, taskGroup );
 				}
-			},
-			taskGroupContext
-		);
+			);
+		}
+
+		locationHolder = location->child( childNames.back() );
+		location = locationHolder.get();
 	}
 }
 
@@ -114,7 +154,94 @@ struct CopyInfo
 	T setCount;
 };
 
-CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags )
+class Profiler
+{
+
+	using Clock = std::chrono::steady_clock;
+
+	public :
+
+		Profiler()
+			:	m_start( Clock::now() )
+		{
+		}
+
+		// Records a ProfileEvent for the duration of its lifetime.
+		// Does nothing if the profiler is null.
+		class Scope
+		{
+
+			public :
+
+				Scope( Profiler *profiler, const SceneInterface::Path &path, double time, SceneAlgo::ProcessFlags component )
+					:	m_profiler( profiler ), m_path( path ), m_time( time ), m_component( component ), m_bytes( 0 )
+				{
+					if( m_profiler )
+					{
+						m_start = Clock::now();
+					}
+				}
+
+				~Scope()
+				{
+					if( !m_profiler )
+					{
+						return;
+					}
+
+					const Clock::time_point end = Clock::now();
+
+					SceneAlgo::ProfileEvent event;
+					event.path = m_path;
+					event.component = m_component;
+					event.time = m_time;
+					event.start = std::chrono::duration<double>( m_start - m_profiler->m_start ).count();
+					event.duration = std::chrono::duration<double>( end - m_start ).count();
+					event.bytes = m_bytes;
+					event.thread = tbb::this_task_arena::current_thread_index();
+					m_profiler->m_events.local().push_back( event );
+				}
+
+				void addBytes( size_t bytes )
+				{
+					m_bytes += bytes;
+				}
+
+			private :
+
+				Profiler *m_profiler;
+				const SceneInterface::Path &m_path;
+				double m_time;
+				SceneAlgo::ProcessFlags m_component;
+				Clock::time_point m_start;
+				size_t m_bytes;
+
+		};
+
+		void events( std::vector<SceneAlgo::ProfileEvent> &events )
+		{
+			events.clear();
+			for( const auto &threadEvents : m_events )
+			{
+				events.insert( events.end(), threadEvents.begin(), threadEvents.end() );
+			}
+
+			std::sort(
+				events.begin(), events.end(),
+				[]( const SceneAlgo::ProfileEvent &a, const SceneAlgo::ProfileEvent &b ) {
+					return a.start < b.start;
+				}
+			);
+		}
+
+	private :
+
+		Clock::time_point m_start;
+		tbb::enumerable_thread_specific<std::vector<SceneAlgo::ProfileEvent>> m_events;
+
+};
+
+CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags, Profiler *profiler = nullptr )
 {
 	SceneInterface::Path path;
 	src->path( path );
@@ -123,7 +250,9 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Bounds )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Bounds );
 		auto bound = src->readBound( time );
+		profilerScope.addBytes( sizeof( bound ) );
 		if( dst )
 		{
 			dst->writeBound( bound, time );
@@ -132,7 +261,9 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Transforms )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Transforms );
 		IECore::ConstDataPtr transform = src->readTransform( time );
+		profilerScope.addBytes( transform ? transform->memoryUsage() : 0 );
 		if( dst && !isRoot )
 		{
 			dst->writeTransform( transform.get(), time );
@@ -141,6 +272,7 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Attributes )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Attributes );
 		SceneInterface::NameList attributeNames;
 		src->attributeNames( attributeNames );
 
@@ -148,6 +280,7 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 		for( const auto &attributeName : attributeNames )
 		{
 			IECore::ConstObjectPtr attr = src->readAttribute( attributeName, time );
+			profilerScope.addBytes( attr ? attr->memoryUsage() : 0 );
 			if( dst )
 			{
 				dst->writeAttribute( attributeName, attr.get(), time );
@@ -157,8 +290,10 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Tags )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Tags );
 		SceneInterface::NameList tags;
 		src->readTags( tags );
+		profilerScope.addBytes( tags.size() * sizeof( SceneInterface::Name ) );
 		copyInfo.tagCount += tags.size();
 		if( dst )
 		{
@@ -168,6 +303,7 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Sets && isRoot )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Sets );
 		SceneInterface::NameList setNames = src->setNames();
 		copyInfo.setCount += setNames.size();
 		for( const auto &setName : setNames )
@@ -182,7 +318,9 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Objects && src->hasObject() )
 	{
+		Profiler::Scope profilerScope( profiler, path, time, SceneAlgo::Objects );
 		IECore::ConstObjectPtr obj = src->readObject( time );
+		profilerScope.addBytes( obj ? obj->memoryUsage() : 0 );
 
 		if( IECoreScene::MeshPrimitive::ConstPtr mesh = IECore::runTimeCast<const IECoreScene::MeshPrimitive>( obj ) )
 		{
@@ -206,6 +344,349 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 }
 
+const char *componentName( SceneAlgo::ProcessFlags component )
+{
+	switch( component )
+	{
+		case SceneAlgo::Bounds :
+			return "bound";
+		case SceneAlgo::Transforms :
+			return "transform";
+		case SceneAlgo::Attributes :
+			return "attributes";
+		case SceneAlgo::Tags :
+			return "tags";
+		case SceneAlgo::Sets :
+			return "sets";
+		case SceneAlgo::Objects :
+			return "object";
+		default :
+			return "unknown";
+	}
+}
+
+std::string jsonEscape( const std::string &s )
+{
+	std::string result;
+	result.reserve( s.size() );
+	for( char c : s )
+	{
+		switch( c )
+		{
+			case '"' :
+				result += "\\\"";
+				break;
+			case '\\' :
+				result += "\\\\";
+				break;
+			default :
+				if( static_cast<unsigned char>( c ) < 0x20 )
+				{
+					result += fmt::format( "\\u{:04x}", static_cast<int>( c ) );
+				}
+				else
+				{
+					result += c;
+				}
+		}
+	}
+	return result;
+}
+
+bool hashesMatch( const SceneInterface *a, const SceneInterface *b, SceneInterface::HashType hashType, double time )
+{
+	MurmurHash hashA, hashB;
+	a->hash( hashType, time, hashA );
+	b->hash( hashType, time, hashB );
+	return hashA == hashB;
+}
+
+bool pathLess( const SceneInterface::Path &a, const SceneInterface::Path &b )
+{
+	return std::lexicographical_compare(
+		a.begin(), a.end(), b.begin(), b.end(),
+		[]( const InternedString &x, const InternedString &y ) {
+			return x.string() < y.string();
+		}
+	);
+}
+
+// Appends the names only in `a` to `onlyInA`, the names only in `b`
+// to `onlyInB`, and the names in both to `inBoth`.
+void compareNames( SceneInterface::NameList a, SceneInterface::NameList b, SceneInterface::NameList &onlyInA, SceneInterface::NameList &onlyInB, SceneInterface::NameList &inBoth )
+{
+	std::sort( a.begin(), a.end() );
+	std::sort( b.begin(), b.end() );
+	std::set_difference( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( onlyInA ) );
+	std::set_difference( b.begin(), b.end(), a.begin(), a.end(), std::back_inserter( onlyInB ) );
+	std::set_intersection( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( inBoth ) );
+}
+
+class Differ
+{
+
+	public :
+
+		Differ( const std::vector<double> &times, unsigned int flags, const Canceller *canceller )
+			:	m_times( times ), m_flags( flags ), m_canceller( canceller )
+		{
+		}
+
+		void walk( const SceneInterface *a, const SceneInterface *b, const SceneInterface::Path &path, tbb::task_group &taskGroup )
+		{
+			Canceller::check( m_canceller );
+
+			if( hierarchyMatches( a, b ) )
+			{
+				return;
+			}
+
+			compareLocation( a, b, path );
+
+			SceneInterface::NameList childNamesA, childNamesB;
+			a->childNames( childNamesA );
+			b->childNames( childNamesB );
+
+			SceneInterface::NameList removed, added, common;
+			compareNames( childNamesA, childNamesB, removed, added, common );
+
+			SceneInterface::Path childPath = path;
+			childPath.push_back( SceneInterface::Name() );
+			for( const auto &name : removed )
+			{
+				childPath.back() = name;
+				addChange( SceneAlgo::SceneChange::Removed, childPath, SceneAlgo::None );
+			}
+			for( const auto &name : added )
+			{
+				childPath.back() = name;
+				addChange( SceneAlgo::SceneChange::Added, childPath, SceneAlgo::None );
+			}
+
+			for( const auto &name : common )
+			{
+				ConstSceneInterfacePtr childA = a->child( name );
+				ConstSceneInterfacePtr childB = b->child( name );
+				childPath.back() = name;
+				taskGroup.run(
+					[this, childA, childB, childPath, &taskGroup] {
+						walk( childA.get(), childB.get(), childPath, taskGroup );
+					}
+				);
+			}
+		}
+
+		void compareSets( const SceneInterface *a, const SceneInterface *b, const SceneInterface::Path &path )
+		{
+			SceneInterface::NameList removed, added, common;
+			compareNames( a->setNames(), b->setNames(), removed, added, common );
+
+			for( const auto &name : removed )
+			{
+				addChange( SceneAlgo::SceneChange::Removed, path, SceneAlgo::Sets, name );
+			}
+			for( const auto &name : added )
+			{
+				addChange( SceneAlgo::SceneChange::Added, path, SceneAlgo::Sets, name );
+			}
+
+			for( const auto &name : common )
+			{
+				MurmurHash hashA, hashB;
+				a->hashSet( name, hashA );
+				b->hashSet( name, hashB );
+				if( hashA == hashB )
+				{
+					continue;
+				}
+				if( a->readSet( name, true, m_canceller ) != b->readSet( name, true, m_canceller ) )
+				{
+					addChange( SceneAlgo::SceneChange::Modified, path, SceneAlgo::Sets, name );
+				}
+			}
+		}
+
+		void changes( SceneAlgo::SceneChanges &changes )
+		{
+			changes.clear();
+			for( const auto &threadChanges : m_changes )
+			{
+				changes.insert( changes.end(), threadChanges.begin(), threadChanges.end() );
+			}
+
+			std::sort(
+				changes.begin(), changes.end(),
+				[]( const SceneAlgo::SceneChange &a, const SceneAlgo::SceneChange &b ) {
+					if( a.path != b.path )
+					{
+						return pathLess( a.path, b.path );
+					}
+					if( a.component != b.component )
+					{
+						return a.component < b.component;
+					}
+					if( a.name != b.name )
+					{
+						return a.name.string() < b.name.string();
+					}
+					return a.time < b.time;
+				}
+			);
+		}
+
+	private :
+
+		bool hierarchyMatches( const SceneInterface *a, const SceneInterface *b ) const
+		{
+			// SceneCache's `hash()` identifies the file and location rather than
+			// the data, so it never matches between files. Compare the stored content
+			// hashes instead where we have them, since they cover all times.
+			const SceneCache *sceneCacheA = runTimeCast<const SceneCache>( a );
+			const SceneCache *sceneCacheB = runTimeCast<const SceneCache>( b );
+			if( sceneCacheA && sceneCacheB )
+			{
+				MurmurHash hashA, hashB;
+				if( sceneCacheA->contentHash( hashA ) && sceneCacheB->contentHash( hashB ) )
+				{
+					return hashA == hashB;
+				}
+			}
+
+			for( double time : m_times )
+			{
+				if( !hashesMatch( a, b, SceneInterface::HierarchyHash, time ) )
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void compareLocation( const SceneInterface *a, const SceneInterface *b, const SceneInterface::Path &path )
+		{
+			if( m_flags & SceneAlgo::Bounds )
+			{
+				for( double time : m_times )
+				{
+					if( !hashesMatch( a, b, SceneInterface::BoundHash, time ) && a->readBound( time ) != b->readBound( time ) )
+					{
+						addChange( SceneAlgo::SceneChange::Modified, path, SceneAlgo::Bounds, SceneInterface::Name(), time );
+					}
+				}
+			}
+
+			if( m_flags & SceneAlgo::Transforms )
+			{
+				for( double time : m_times )
+				{
+					if( !hashesMatch( a, b, SceneInterface::TransformHash, time ) && a->readTransformAsMatrix( time ) != b->readTransformAsMatrix( time ) )
+					{
+						addChange( SceneAlgo::SceneChange::Modified, path, SceneAlgo::Transforms, SceneInterface::Name(), time );
+					}
+				}
+			}
+
+			if( m_flags & SceneAlgo::Attributes )
+			{
+				SceneInterface::NameList attributeNamesA, attributeNamesB;
+				a->attributeNames( attributeNamesA );
+				b->attributeNames( attributeNamesB );
+
+				SceneInterface::NameList removed, added, common;
+				compareNames( attributeNamesA, attributeNamesB, removed, added, common );
+				for( const auto &name : removed )
+				{
+					addChange( SceneAlgo::SceneChange::Removed, path, SceneAlgo::Attributes, name );
+				}
+				for( const auto &name : added )
+				{
+					addChange( SceneAlgo::SceneChange::Added, path, SceneAlgo::Attributes, name );
+				}
+
+				for( double time : m_times )
+				{
+					if( common.empty() || hashesMatch( a, b, SceneInterface::AttributesHash, time ) )
+					{
+						continue;
+					}
+					for( const auto &name : common )
+					{
+						ConstObjectPtr attributeA = a->readAttribute( name, time );
+						ConstObjectPtr attributeB = b->readAttribute( name, time );
+						if( !objectsEqual( attributeA.get(), attributeB.get() ) )
+						{
+							addChange( SceneAlgo::SceneChange::Modified, path, SceneAlgo::Attributes, name, time );
+						}
+					}
+				}
+			}
+
+			if( m_flags & SceneAlgo::Tags )
+			{
+				SceneInterface::NameList tagsA, tagsB;
+				a->readTags( tagsA );
+				b->readTags( tagsB );
+
+				SceneInterface::NameList removed, added, common;
+				compareNames( tagsA, tagsB, removed, added, common );
+				for( const auto &name : removed )
+				{
+					addChange( SceneAlgo::SceneChange::Removed, path, SceneAlgo::Tags, name );
+				}
+				for( const auto &name : added )
+				{
+					addChange( SceneAlgo::SceneChange::Added, path, SceneAlgo::Tags, name );
+				}
+			}
+
+			if( m_flags & SceneAlgo::Objects )
+			{
+				const bool hasObjectA = a->hasObject();
+				const bool hasObjectB = b->hasObject();
+				if( hasObjectA != hasObjectB )
+				{
+					addChange( hasObjectA ? SceneAlgo::SceneChange::Removed : SceneAlgo::SceneChange::Added, path, SceneAlgo::Objects );
+				}
+				else if( hasObjectA )
+				{
+					for( double time : m_times )
+					{
+						if( hashesMatch( a, b, SceneInterface::ObjectHash, time ) )
+						{
+							continue;
+						}
+						ConstObjectPtr objectA = a->readObject( time, m_canceller );
+						ConstObjectPtr objectB = b->readObject( time, m_canceller );
+						if( !objectsEqual( objectA.get(), objectB.get() ) )
+						{
+							addChange( SceneAlgo::SceneChange::Modified, path, SceneAlgo::Objects, SceneInterface::Name(), time );
+						}
+					}
+				}
+			}
+		}
+
+		static bool objectsEqual( const Object *a, const Object *b )
+		{
+			if( !a || !b )
+			{
+				return a == b;
+			}
+			return *a == *b;
+		}
+
+		void addChange( SceneAlgo::SceneChange::Type type, const SceneInterface::Path &path, SceneAlgo::ProcessFlags component, const SceneInterface::Name &name = SceneInterface::Name(), double time = 0.0 )
+		{
+			m_changes.local().push_back( SceneAlgo::SceneChange( type, path, component, name, time ) );
+		}
+
+		const std::vector<double> &m_times;
+		const unsigned int m_flags;
+		const Canceller *m_canceller;
+		tbb::enumerable_thread_specific<SceneAlgo::SceneChanges> m_changes;
+
+};
+
 template<typename LocationFn>
 void copy( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags, LocationFn &locationFn )
 {
@@ -229,28 +710,217 @@ namespace IECoreScene
 namespace SceneAlgo
 {
 
-SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags )
+ParallelTraverseOptions::ParallelTraverseOptions()
+	:	time( 0.0 ), prefetch( None ), maxDepth( -1 ), maxConcurrency( 0 ), canceller( nullptr )
+{
+}
+
+LocationComponents::LocationComponents()
+	:	prefetched( None )
+{
+}
+
+void parallelTraverse( const SceneInterface *scene, const ParallelTraverseVisitor &visitor, const ParallelTraverseOptions &options )
+{
+	auto traverse = [&] {
+		// Isolate so that we don't steal unrelated outer tasks
+		// while waiting for the traversal to complete.
+		tbb::this_task_arena::isolate(
+			[&] {
+				tbb::task_group taskGroup;
+				taskGroup.run_and_wait(
+					[&] {
+						traverseWalk( scene, 0, visitor, options, taskGroup );
+					}
+				);
+			}
+		);
+	};
+
+	if( options.maxConcurrency )
+	{
+		tbb::task_arena arena( options.maxConcurrency );
+		arena.execute( traverse );
+	}
+	else
+	{
+		traverse();
+	}
+}
+
+ProfileEvent::ProfileEvent()
+	:	component( None ), time( 0.0 ), start( 0.0 ), duration( 0.0 ), bytes( 0 ), thread( 0 )
+{
+}
+
+std::string ReadProfile::report( size_t n ) const
+{
+	struct Totals
+	{
+		Totals() : duration( 0.0 ), bytes( 0 ), count( 0 ) {}
+		double duration;
+		size_t bytes;
+		size_t count;
+	};
+
+	std::map<ProcessFlags, Totals> componentTotals;
+	std::unordered_map<std::string, Totals> locationTotals;
+	for( const auto &event : events )
+	{
+		Totals &c = componentTotals[event.component];
+		c.duration += event.duration;
+		c.bytes += event.bytes;
+		c.count++;
+
+		std::string path;
+		SceneInterface::pathToString( event.path, path );
+		Totals &l = locationTotals[path];
+		l.duration += event.duration;
+		l.bytes += event.bytes;
+		l.count++;
+	}
+
+	std::string result = fmt::format( "{:<12} {:>10} {:>12} {:>14}\n", "Component", "Reads", "Time (s)", "Bytes" );
+	for( const auto &c : componentTotals )
+	{
+		result += fmt::format( "{:<12} {:>10} {:>12.6f} {:>14}\n", componentName( c.first ), c.second.count, c.second.duration, c.second.bytes );
+	}
+
+	using LocationTotal = std::pair<std::string, Totals>;
+	std::vector<LocationTotal> sortedLocations( locationTotals.begin(), locationTotals.end() );
+	const size_t numLocations = std::min( n, sortedLocations.size() );
+	std::partial_sort(
+		sortedLocations.begin(), sortedLocations.begin() + numLocations, sortedLocations.end(),
+		[]( const LocationTotal &a, const LocationTotal &b ) {
+			return a.second.duration > b.second.duration;
+		}
+	);
+
+	result += fmt::format( "\nSlowest {} locations :\n\n{:>12} {:>14}  {}\n", numLocations, "Time (s)", "Bytes", "Location" );
+	for( size_t i = 0; i < numLocations; ++i )
+	{
+		const LocationTotal &l = sortedLocations[i];
+		result += fmt::format( "{:>12.6f} {:>14}  {}\n", l.second.duration, l.second.bytes, l.first );
+	}
+
+	return result;
+}
+
+void ReadProfile::writeChromeTrace( std::ostream &stream ) const
+{
+	stream << "{\"traceEvents\":[";
+	bool first = true;
+	std::string path;
+	for( const auto &event : events )
+	{
+		SceneInterface::pathToString( event.path, path );
+		stream << ( first ? "\n" : ",\n" );
+		stream << fmt::format(
+			"{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{},"
+			"\"args\":{{\"location\":\"{}\",\"time\":{},\"bytes\":{}}}}}",
+			componentName( event.component ), componentName( event.component ),
+			event.start * 1e6, event.duration * 1e6, event.thread,
+			jsonEscape( path ), event.time, event.bytes
+		);
+		first = false;
+	}
+	stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void ReadProfile::writeChromeTrace( const std::string &fileName ) const
+{
+	std::ofstream stream( fileName );
+	if( !stream.good() )
+	{
+		throw IECore::IOException( "Unable to open file \"" + fileName + "\" for writing" );
+	}
+	writeChromeTrace( stream );
+}
+
+SceneChange::SceneChange()
+	:	type( Modified ), component( None ), time( 0.0 )
+{
+}
+
+SceneChange::SceneChange( Type type, const SceneInterface::Path &path, ProcessFlags component, const SceneInterface::Name &name, double time )
+	:	type( type ), path( path ), component( component ), name( name ), time( time )
+{
+}
+
+bool SceneChange::operator == ( const SceneChange &rhs ) const
+{
+	return
+		type == rhs.type &&
+		path == rhs.path &&
+		component == rhs.component &&
+		name == rhs.name &&
+		time == rhs.time
+	;
+}
+
+SceneChanges diff( const SceneInterface *a, const SceneInterface *b, const std::vector<double> &times, unsigned int flags, const IECore::Canceller *canceller )
+{
+	Differ differ( times, flags, canceller );
+	const SceneInterface::Path rootPath;
+
+	tbb::this_task_arena::isolate(
+		[&] {
+			tbb::task_group taskGroup;
+			taskGroup.run(
+				[&] {
+					differ.walk( a, b, rootPath, taskGroup );
+				}
+			);
+			if( flags & Sets )
+			{
+				taskGroup.run(
+					[&] {
+						differ.compareSets( a, b, rootPath );
+					}
+				);
+			}
+			taskGroup.wait();
+		}
+	);
+
+	SceneChanges result;
+	differ.changes( result );
+	return result;
+}
+
+SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags, ReadProfile *profile )
 {
 	std::atomic<size_t> locationCount( 0 );
 	::CopyInfo<std::atomic<size_t> > copyInfos;
 
-	auto locationFn = [&locationCount, &copyInfos]( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags )
+	std::unique_ptr<Profiler> profiler;
+	if( profile )
 	{
-		locationCount++;
-		::CopyInfo<size_t> copyInfo = ::handleLocation( src, nullptr, time, flags );
-
-		copyInfos.polygonCount += copyInfo.polygonCount;
-		copyInfos.tagCount += copyInfo.tagCount;
-		copyInfos.attributeCount += copyInfo.attributeCount;
-		copyInfos.curveCount += copyInfo.curveCount;
-		copyInfos.pointCount += copyInfo.pointCount;
-	};
+		profiler = std::make_unique<Profiler>();
+	}
 
 	for( int f = startFrame; f <= endFrame; ++f )
 	{
-		double time = f / frameRate;
-		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
-		parallelLocationWalk<decltype( locationFn )>( src, nullptr, locationFn, time, flags, taskGroupContext );
+		const double time = f / frameRate;
+		auto visitor = [&locationCount, &copyInfos, &profiler, time, flags]( const SceneInterface *location, const LocationComponents &components )
+		{
+			locationCount++;
+			::CopyInfo<size_t> copyInfo = ::handleLocation( location, nullptr, time, flags, profiler.get() );
+
+			copyInfos.polygonCount += copyInfo.polygonCount;
+			copyInfos.tagCount += copyInfo.tagCount;
+			copyInfos.attributeCount += copyInfo.attributeCount;
+			copyInfos.curveCount += copyInfo.curveCount;
+			copyInfos.pointCount += copyInfo.pointCount;
+			return true;
+		};
+
+		parallelTraverse( src, visitor );
+	}
+
+	if( profiler )
+	{
+		profiler->events( profile->events );
 	}
 
 	SceneStats stats;
@@ -275,7 +945,10 @@ void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int e
 			flags &= ~Tags;
 		}
 
-		::copy( src, dst, time, flags, ::handleLocation );
+		auto locationFn = []( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags ) {
+			::handleLocation( src, dst, time, flags );
+		};
+		::copy( src, dst, time, flags, locationFn );
 	}
 }
 
@@ -74,8 +74,8 @@ IE_CORE_DEFINERUNTIMETYPEDDESCRIPTION( SceneCache )
 // can use the filename constructor as a convenience over the IndexedIO
 // constructor.
 static IndexedIO::Description<FileIndexedIO> extensionDescription( ".scc" );
-// Register the .scc extension in the factory function for SceneCache on Read and Write modes
-static SceneInterface::FileFormatDescription<SceneCache> registrar(".scc", IndexedIO::Read | IndexedIO::Write);
+// Register the .scc extension in the factory function for SceneCache on Read, Write and Append modes
+static SceneInterface::FileFormatDescription<SceneCache> registrar(".scc", IndexedIO::Read | IndexedIO::Write | IndexedIO::Append);
 
 static InternedString headerEntry("header");
 static InternedString rootEntry("root");
@@ -91,6 +91,7 @@ static InternedString ancestorTagsEntry("ancestorTags");
 static InternedString descendentTagsEntry("descendentTags");
 static InternedString setsEntry("sets");
 static InternedString childSetsEntry("childSets");
+static InternedString contentHashEntry("contentHash");
 
 const SceneInterface::Name &SceneCache::animatedObjectTopologyAttribute = InternedString( "sceneInterface:animatedObjectTopology" );
 const SceneInterface::Name &SceneCache::animatedObjectPrimVarsAttribute = InternedString( "sceneInterface:animatedObjectPrimVars" );
@@ -765,6 +766,20 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 			}
 		}
 
+		bool contentHash( MurmurHash &h ) const
+		{
+			if ( !m_indexedIO->hasEntry( contentHashEntry ) )
+			{
+				return false;
+			}
+
+			uint64_t contentHash[2];
+			uint64_t *contentHashAddress = contentHash;
+			m_indexedIO->read( contentHashEntry, contentHashAddress, 2 );
+			h.append( MurmurHash( contentHash[0], contentHash[1] ) );
+			return true;
+		}
+
 		static ReaderImplementation *reader( Implementation *impl, bool throwException = true )
 		{
 			ReaderImplementation *reader = dynamic_cast< ReaderImplementation* >( impl );
@@ -1197,7 +1212,9 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 		IE_CORE_DECLAREPTR( WriterImplementation )
 
-		WriterImplementation( IndexedIOPtr io, Implementation *parent = nullptr) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent ))
+		/// When `existing` is true, the location is already present in the file being
+		/// appended to, and its sample times and bounds are restored from it.
+		WriterImplementation( IndexedIOPtr io, Implementation *parent = nullptr, bool existing = false ) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent )), m_numRestoredObjectSamples( 0 ), m_hasContentHash( !existing )
 		{
 			if ( m_parent )
 			{
@@ -1208,6 +1225,15 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			{
 				// only the root instance allocate the map.
 				m_sampleTimesMap = new SampleTimesMap;
+				if ( existing )
+				{
+					restoreSampleTimesMap();
+				}
+			}
+
+			if ( existing && m_sampleTimesMap )
+			{
+				restore();
 			}
 		}
 
@@ -1342,6 +1368,10 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			IndexedIOPtr io = m_indexedIO->subdirectory( attributesEntry, IndexedIO::CreateIfMissing );
 			io = io->subdirectory( name, IndexedIO::CreateIfMissing );
 			attribute->save( io, sampleEntry(sampleIndex) );
+
+			MurmurHash &attributeHash = m_attributeHashes[name];
+			attributeHash.append( time );
+			attribute->hash( attributeHash );
 		}
 
 		void writeLocalTag( const char *tag )
@@ -1413,10 +1443,20 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			IndexedIOPtr io = m_indexedIO->subdirectory( objectEntry, IndexedIO::CreateIfMissing );
 			object->save( io, sampleEntry(sampleIndex) );
 
+			m_objectHash.append( time );
+			object->hash( m_objectHash );
+
+			if ( sampleIndex && sampleIndex == m_numRestoredObjectSamples )
+			{
+				// first sample appended to an existing object
+				restoreAnimatedObjectHashes();
+			}
+
 			const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object );
 			if ( renderable )
 			{
-				if ( !m_objectSamples.size() && m_objectSampleTimes.size() > 1 )
+				// only samples written since opening the file have their bounds stored in m_objectSamples
+				if ( m_objectSamples.size() != sampleIndex - m_numRestoredObjectSamples )
 				{
 					throw Exception( "Either all object samples must have bounds (VisibleRenderable) or none of them!" );
 				}
@@ -1424,37 +1464,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				const Primitive *primitive = runTimeCast< const Primitive >( renderable );
 				if ( primitive )
 				{
-					MurmurHash topologyHash;
-					primitive->topologyHash( topologyHash );
-					topologyHash.append( primitive->typeId() );
-					if ( m_objectSamples.empty() )
-					{
-						m_animatedObjectTopology = AnimatedHashTest( topologyHash, false );
-					}
-
-					if ( topologyHash != m_animatedObjectTopology.first )
-					{
-						m_animatedObjectTopology.second = true;
-					}
-
-					for ( PrimitiveVariableMap::const_iterator it = primitive->variables.begin(); it != primitive->variables.end(); ++it )
-					{
-						Name primVarName = Name( it->first );
-
-						MurmurHash hash;
-						it->second.data->hash( hash );
-						hash.append( it->second.interpolation );
-
-						AnimatedPrimVarMap::iterator pIt = m_animatedObjectPrimVars.find( primVarName );
-						if ( pIt == m_animatedObjectPrimVars.end() )
-						{
-							m_animatedObjectPrimVars.insert( AnimatedPrimVarMap::value_type( primVarName, AnimatedHashTest( hash, false ) ) );
-						}
-						else if ( hash != pIt->second.first )
-						{
-							pIt->second.second = true;
-						}
-					}
+					updateAnimatedObjectHashes( primitive, sampleIndex == 0 );
 				}
 
 				Box3f bf = renderable->bound();
@@ -1488,7 +1498,16 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			setData->writable() = set;
 
 			IndexedIOPtr setsIO = m_indexedIO->subdirectory( setsEntry, IndexedIO::CreateIfMissing );
+			if ( setsIO->hasEntry( name ) )
+			{
+				// replacing a set restored from the file we're appending to
+				setsIO->remove( name );
+			}
 			setData->Object::save( setsIO, name );
+
+			MurmurHash &setHash = m_setHashes[name];
+			setHash = MurmurHash();
+			setData->hash( setHash );
 		}
 
 		WriterImplementationPtr child( const Name &name, MissingBehaviour missingBehaviour )
@@ -1509,12 +1528,14 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			{
 				return nullptr;
 			}
+			// children we haven't created ourselves must already be in the file we're appending to
+			const bool existing = children->hasEntry( name );
 			IndexedIOPtr childIO = children->subdirectory( name, (IndexedIO::MissingBehaviour)missingBehaviour );
 			if ( !childIO )
 			{
 				return nullptr;
 			}
-			WriterImplementationPtr result = new WriterImplementation( childIO, this );
+			WriterImplementationPtr result = new WriterImplementation( childIO, this, existing );
 			this->m_children[ name ] = result;
 			return result;
 		}
@@ -1583,6 +1604,204 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 		}
 
+		// Reads the sample times referenced by the given location in the file.
+		SampleTimes restoreSampleTimes( const IndexedIO *location )
+		{
+			if ( !location->hasEntry( sampleTimesEntry ) )
+			{
+				return SampleTimes();
+			}
+
+			IndexedIO::EntryID samplesEntry;
+			if ( location->entry( sampleTimesEntry ).entryType() == IndexedIO::File )
+			{
+				/// Provided for backward compatibility.
+				uint64_t sampleTimesIndex = 0;
+				location->read( sampleTimesEntry, sampleTimesIndex );
+				samplesEntry = sampleEntry( sampleTimesIndex );
+			}
+			else
+			{
+				IndexedIO::EntryIDList sampleList;
+				location->subdirectory( sampleTimesEntry )->entryIds( sampleList );
+				if ( sampleList.size() != 1 )
+				{
+					throw Exception( "Corrupted file! Could not find sample times key!!!" );
+				}
+				samplesEntry = sampleList[0];
+			}
+
+			IndexedIOPtr sampleTimesIO = globalSampleTimes();
+			SampleTimes sampleTimes( sampleTimesIO->entry( samplesEntry ).arrayLength() );
+			if ( sampleTimes.size() )
+			{
+				double *ptrTimes = &sampleTimes[0];
+				sampleTimesIO->read( samplesEntry, ptrTimes, sampleTimes.size() );
+			}
+			return sampleTimes;
+		}
+
+		// Called on the root location in Append mode, so that new locations share
+		// the sample times already stored in the file.
+		void restoreSampleTimesMap()
+		{
+			IndexedIOPtr sampleTimesIO = globalSampleTimes();
+			IndexedIO::EntryIDList entries;
+			sampleTimesIO->entryIds( entries, IndexedIO::File );
+			for ( const auto &entry : entries )
+			{
+				SampleTimes sampleTimes( sampleTimesIO->entry( entry ).arrayLength() );
+				if ( sampleTimes.size() )
+				{
+					double *ptrTimes = &sampleTimes[0];
+					sampleTimesIO->read( entry, ptrTimes, sampleTimes.size() );
+				}
+				m_sampleTimesMap->insert( SampleTimesMap::value_type( sampleTimes, atoi( entry.value().c_str() ) ) );
+			}
+		}
+
+		// Called in Append mode for locations already in the file. Restores the
+		// sample times so that new samples are numbered after the existing ones,
+		// and restores the transforms and bounds so that flush() can compute new
+		// bounds that include the existing data. Object samples aren't restored,
+		// since their bounds are already included in the restored bounds.
+		void restore()
+		{
+			// We don't restore enough of the existing data to recompute the content
+			// hash, so we remove it rather than leave it stale.
+			if ( m_indexedIO->hasEntry( contentHashEntry ) )
+			{
+				m_indexedIO->remove( contentHashEntry );
+			}
+
+			IndexedIOPtr io = m_indexedIO->subdirectory( transformEntry, IndexedIO::NullIfMissing );
+			if ( io )
+			{
+				m_transformSampleTimes = restoreSampleTimes( io.get() );
+				for ( size_t i = 0; i < m_transformSampleTimes.size(); ++i )
+				{
+					ConstDataPtr transform = runTimeCast< const Data >( Object::load( io, sampleEntry( i ) ) );
+					if ( !transform )
+					{
+						throw Exception( "Invalid transform data in file!" );
+					}
+					m_transformSamples.push_back( transform );
+				}
+			}
+
+			io = m_indexedIO->subdirectory( attributesEntry, IndexedIO::NullIfMissing );
+			if ( io )
+			{
+				NameList attributeNames;
+				io->entryIds( attributeNames, IndexedIO::Directory );
+				for ( const auto &attributeName : attributeNames )
+				{
+					m_attributeSampleTimes[attributeName] = restoreSampleTimes( io->subdirectory( attributeName ).get() );
+				}
+			}
+
+			io = m_indexedIO->subdirectory( objectEntry, IndexedIO::NullIfMissing );
+			if ( io )
+			{
+				m_objectSampleTimes = restoreSampleTimes( io.get() );
+				m_numRestoredObjectSamples = m_objectSampleTimes.size();
+			}
+
+			io = m_indexedIO->subdirectory( boundEntry, IndexedIO::NullIfMissing );
+			if ( io )
+			{
+				m_boundSampleTimes = restoreSampleTimes( io.get() );
+				m_boundSamples.resize( m_boundSampleTimes.size() );
+				for ( size_t i = 0; i < m_boundSamples.size(); ++i )
+				{
+					double *boxAddress = m_boundSamples[i].min.getValue();
+					io->read( sampleEntry( i ), boxAddress, 6 );
+				}
+			}
+		}
+
+		// Called when the first sample is appended to an object already in the file.
+		// Initialises the tests for animated topology and primitive variables from the
+		// last existing sample, and from the results of the tests stored in the file.
+		void restoreAnimatedObjectHashes()
+		{
+			ConstIndexedIOPtr io = m_indexedIO->subdirectory( objectEntry );
+			ConstPrimitivePtr primitive = runTimeCast< const Primitive >( Object::load( io, sampleEntry( m_numRestoredObjectSamples - 1 ) ) );
+			if ( !primitive )
+			{
+				return;
+			}
+
+			updateAnimatedObjectHashes( primitive.get(), true );
+
+			if ( hasAttribute( animatedObjectTopologyAttribute ) )
+			{
+				m_animatedObjectTopology.second = true;
+			}
+			else if ( hasAttribute( animatedObjectPrimVarsAttribute ) )
+			{
+				io = m_indexedIO->subdirectory( attributesEntry )->subdirectory( animatedObjectPrimVarsAttribute );
+				ConstInternedStringVectorDataPtr primVars = runTimeCast< const InternedStringVectorData >( Object::load( io, sampleEntry( 0 ) ) );
+				if ( primVars )
+				{
+					for ( const auto &primVarName : primVars->readable() )
+					{
+						AnimatedPrimVarMap::iterator pIt = m_animatedObjectPrimVars.find( primVarName );
+						if ( pIt != m_animatedObjectPrimVars.end() )
+						{
+							pIt->second.second = true;
+						}
+					}
+				}
+			}
+		}
+
+		void updateAnimatedObjectHashes( const Primitive *primitive, bool firstSample )
+		{
+			MurmurHash topologyHash;
+			primitive->topologyHash( topologyHash );
+			topologyHash.append( primitive->typeId() );
+			if ( firstSample )
+			{
+				m_animatedObjectTopology = AnimatedHashTest( topologyHash, false );
+			}
+
+			if ( topologyHash != m_animatedObjectTopology.first )
+			{
+				m_animatedObjectTopology.second = true;
+			}
+
+			for ( PrimitiveVariableMap::const_iterator it = primitive->variables.begin(); it != primitive->variables.end(); ++it )
+			{
+				Name primVarName = Name( it->first );
+
+				MurmurHash hash;
+				it->second.data->hash( hash );
+				hash.append( it->second.interpolation );
+
+				AnimatedPrimVarMap::iterator pIt = m_animatedObjectPrimVars.find( primVarName );
+				if ( pIt == m_animatedObjectPrimVars.end() )
+				{
+					m_animatedObjectPrimVars.insert( AnimatedPrimVarMap::value_type( primVarName, AnimatedHashTest( hash, false ) ) );
+				}
+				else if ( hash != pIt->second.first )
+				{
+					pIt->second.second = true;
+				}
+			}
+		}
+
+		void removeAttribute( const SceneCache::Name &name )
+		{
+			m_attributeSampleTimes.erase( name );
+			m_attributeHashes.erase( name );
+			IndexedIOPtr io = m_indexedIO->subdirectory( attributesEntry, IndexedIO::NullIfMissing );
+			if ( io && io->hasEntry( name ) )
+			{
+				io->remove( name );
+			}
+		}
+
 		// Function to store intelligently the given sample times in the file location.
 		// It actually saves the index there, and stores the unique sample times in a global shared location.
 		void storeSampleTimes( const SampleTimes &sampleTimes, IndexedIOPtr location )
@@ -1609,6 +1828,11 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				sampleTimesIndex = it.first->second;
 				samplesEntry = sampleEntry(sampleTimesIndex);
 			}
+			if ( location->hasEntry( sampleTimesEntry ) )
+			{
+				// replacing the sample times restored from the file we're appending to
+				location->remove( sampleTimesEntry );
+			}
 			location->createSubdirectory( sampleTimesEntry )->createSubdirectory( samplesEntry );
 		}
 
@@ -1644,7 +1868,9 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 		// function called when bounding boxes were not explicitly defined in this scene location.
 		// the function accumulates bounding box samples in the variables m_boundSampleTimes and m_boundSamples.
-		void accumulateBoxSamples( const SampleTimes &sampleTimes, const BoxSamples &boxSamples )
+		// When `extendEarlierSamples` is false, existing samples earlier than the first incoming sample are
+		// kept as they are, rather than being extended by it.
+		void accumulateBoxSamples( const SampleTimes &sampleTimes, const BoxSamples &boxSamples, bool extendEarlierSamples = true )
 		{
 
 			/// simple case: zero new samples
@@ -1714,7 +1940,10 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				{
 					// combine this existing box with the interpolation of the incoming boxes:
 					Imath::Box3d newSample = m_boundSamples[ existingTime - m_boundSampleTimes.begin() ];
-					extendBoxByInterpolation( newSample, sampleTimes, boxSamples, incomingTime, *existingTime );
+					if( extendEarlierSamples || incomingTime != sampleTimes.begin() )
+					{
+						extendBoxByInterpolation( newSample, sampleTimes, boxSamples, incomingTime, *existingTime );
+					}
 					newSampleTimes.push_back( *existingTime );
 					newBoxSamples.push_back( newSample );
 					++existingTime;
@@ -1783,8 +2012,12 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 
 			// detect if topology or prim vars are animated
-			if ( !m_objectSampleTimes.empty() )
+			if ( m_objectSampleTimes.size() > m_numRestoredObjectSamples )
 			{
+				// discard any results restored from the file, since they're recomputed here
+				removeAttribute( animatedObjectTopologyAttribute );
+				removeAttribute( animatedObjectPrimVarsAttribute );
+
 				if ( m_animatedObjectTopology.second )
 				{
 					writeAttribute( animatedObjectTopologyAttribute, new BoolData( true ), 0 );
@@ -1970,10 +2203,14 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				}
 			}
 
-			if ( m_objectSampleTimes.size() && m_objectSamples.size() )
+			if ( m_objectSamples.size() )
 			{
-				// union all the bounding box samples from the child and also from the optional object stored in this location
-				accumulateBoxSamples( m_objectSampleTimes, m_objectSamples );
+				// union all the bounding box samples from the child and also from the optional object stored in this location.
+				// restored object samples are skipped, since their bounds are already included in the restored bounds.
+				// For the same reason, the restored bounds from before the first new sample are kept exactly as they were,
+				// rather than being extended by the new samples as if they were held backwards in time.
+				const SampleTimes objectSampleTimes( m_objectSampleTimes.begin() + m_numRestoredObjectSamples, m_objectSampleTimes.end() );
+				accumulateBoxSamples( objectSampleTimes, m_objectSamples, /* extendEarlierSamples = */ m_numRestoredObjectSamples == 0 );
 			}
 
 
@@ -2009,6 +2246,8 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				m_parent->writeChildSets( setNames );
 			}
 
+			writeContentHash();
+
 			// deallocate children since we now computed everything from them anyways...
 			m_children.clear();
 
@@ -2027,6 +2266,83 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		}
 
 
+		// Stores a hash of everything written to this location and its descendants,
+		// for use as the HierarchyHash. Must be called after the children have been
+		// flushed. Locations restored from an existing file have no content hash, and
+		// neither do their ancestors.
+		void writeContentHash()
+		{
+			for ( const auto &[name, child] : m_children )
+			{
+				m_hasContentHash = m_hasContentHash && child->m_hasContentHash;
+			}
+
+			if ( !m_hasContentHash )
+			{
+				return;
+			}
+
+			MurmurHash h = m_objectHash;
+
+			h.append( m_transformSampleTimes.size() );
+			for ( size_t i = 0; i < m_transformSamples.size(); ++i )
+			{
+				h.append( m_transformSampleTimes[i] );
+				m_transformSamples[i]->hash( h );
+			}
+
+			h.append( m_boundSampleTimes.size() );
+			if ( m_boundSampleTimes.size() )
+			{
+				h.append( m_boundSampleTimes.data(), m_boundSampleTimes.size() );
+				h.append( m_boundSamples.data(), m_boundSamples.size() );
+			}
+
+			appendNamedHashes( h, m_attributeHashes.begin(), m_attributeHashes.end() );
+			appendNamedHashes( h, m_setHashes.begin(), m_setHashes.end() );
+
+			NameList tags;
+			readTags( tags, SceneInterface::LocalTag );
+			std::sort( tags.begin(), tags.end(), []( const Name &a, const Name &b ) { return a.string() < b.string(); } );
+			h.append( tags.size() );
+			for ( const auto &tag : tags )
+			{
+				h.append( tag );
+			}
+
+			std::vector< std::pair< Name, MurmurHash > > childHashes;
+			for ( const auto &[name, child] : m_children )
+			{
+				childHashes.emplace_back( name, child->m_contentHash );
+			}
+			appendNamedHashes( h, childHashes.begin(), childHashes.end() );
+
+			m_contentHash = h;
+			const uint64_t contentHash[2] = { h.h1(), h.h2() };
+			m_indexedIO->write( contentHashEntry, contentHash, 2 );
+		}
+
+		// Appends name and hash pairs in a consistent order. InternedStrings
+		// compare by address, so we can't rely on the order of a map.
+		template<typename Iterator>
+		static void appendNamedHashes( MurmurHash &h, Iterator begin, Iterator end )
+		{
+			std::vector< std::pair< Name, MurmurHash > > namedHashes( begin, end );
+			std::sort(
+				namedHashes.begin(), namedHashes.end(),
+				[]( const std::pair< Name, MurmurHash > &a, const std::pair< Name, MurmurHash > &b ) {
+					return a.first.string() < b.first.string();
+				}
+			);
+
+			h.append( namedHashes.size() );
+			for ( const auto &[name, namedHash] : namedHashes )
+			{
+				h.append( name );
+				h.append( namedHash );
+			}
+		}
+
 		// walk up to the root writing the child set names at every location
 		void writeChildSets( const NameList &childSets )
 		{
@@ -2196,6 +2512,8 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		SampleTimes m_transformSampleTimes;
 		AttributeSamplesMap m_attributeSampleTimes;
 		SampleTimes m_objectSampleTimes;
+		// number of object samples restored from the file we're appending to
+		size_t m_numRestoredObjectSamples;
 		// store the transform objects (we want to interpolate the transforms later)
 		TransformSamples m_transformSamples;
 		// store the object's bounding box (we want to transform them later)
@@ -2208,6 +2526,14 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 		AnimatedHashTest m_animatedObjectTopology;
 		AnimatedPrimVarMap m_animatedObjectPrimVars;
+
+		// Hashes of the data written to this location, used to compute the
+		// content hash when flushing.
+		MurmurHash m_objectHash;
+		std::map< SceneCache::Name, MurmurHash > m_attributeHashes;
+		std::map< SceneCache::Name, MurmurHash > m_setHashes;
+		bool m_hasContentHash;
+		MurmurHash m_contentHash;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -2216,13 +2542,16 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 SceneCache::SceneCache( const std::string &fileName, IndexedIO::OpenMode mode )
 {
-	if( mode & IndexedIO::Append )
-	{
-		throw InvalidArgumentException( "Append mode not supported" );
-	}
 	IndexedIOPtr indexedIO = IndexedIO::create( fileName, IndexedIO::rootPath, mode );
 
-	if( indexedIO->openMode() & IndexedIO::Write )
+	if( indexedIO->openMode() & IndexedIO::Append )
+	{
+		// Appending to an existing file. New files opened in Append mode
+		// are reported as being in Write mode, and are handled below.
+		indexedIO = indexedIO->subdirectory( rootEntry );
+		m_implementation = new WriterImplementation( indexedIO, nullptr, /* existing = */ true );
+	}
+	else if( indexedIO->openMode() & IndexedIO::Write )
 	{
 		ObjectPtr header = HeaderGenerator::header();
 		header->save( indexedIO, headerEntry );
@@ -2240,10 +2569,6 @@ SceneCache::SceneCache( const std::string &fileName, IndexedIO::OpenMode mode )
 
 SceneCache::SceneCache( IECore::IndexedIOPtr indexedIO )
 {
-	if( indexedIO->openMode() & IndexedIO::Append )
-	{
-		throw InvalidArgumentException( "Append mode not supported" );
-	}
 	IndexedIO::EntryIDList path;
 	indexedIO->path( path );
 	if ( path.size() )
@@ -2251,7 +2576,12 @@ SceneCache::SceneCache( IECore::IndexedIOPtr indexedIO )
 		throw InvalidArgumentException( "The given IndexedIO object is not at root!" );
 	}
 
-	if( indexedIO->openMode() & IndexedIO::Write )
+	if( indexedIO->openMode() & IndexedIO::Append )
+	{
+		indexedIO = indexedIO->subdirectory( rootEntry );
+		m_implementation = new WriterImplementation( indexedIO, nullptr, /* existing = */ true );
+	}
+	else if( indexedIO->openMode() & IndexedIO::Write )
 	{
 		ObjectPtr header = HeaderGenerator::header();
 		header->save( indexedIO, headerEntry );
@@ -2649,6 +2979,12 @@ void SceneCache::hash( HashType hashType, double time, MurmurHash &h ) const
 	reader->hash( hashType, time, h );
 }
 
+bool SceneCache::contentHash( MurmurHash &h ) const
+{
+	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
+	return reader->contentHash( h );
+}
+
 SceneCachePtr SceneCache::duplicate( ImplementationPtr& impl ) const
 {
 	return new SceneCache( impl );
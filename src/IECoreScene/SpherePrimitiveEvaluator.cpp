@@ -40,6 +40,7 @@
 #include "IECore/Math.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/TriangleAlgo.h"
+#include "IECore/VectorTypedData.h"
 
 #include "Imath/ImathBoxAlgo.h"
 #include "Imath/ImathLineAlgo.h"
@@ -454,3 +455,21 @@ float SpherePrimitiveEvaluator::surfaceArea() const
 
 	return 4.0 * M_PI * r*r ;
 }
+
+PrimitiveEvaluator::BatchOutputFunction SpherePrimitiveEvaluator::addBatchOutputs( size_t numQueries, IECore::CompoundData *outputs ) const
+{
+	V3fVectorDataPtr nData = new V3fVectorData( std::vector<V3f>( numQueries, V3f( 0 ) ) );
+	nData->setInterpretation( GeometricData::Normal );
+	V2fVectorDataPtr uvData = new V2fVectorData( std::vector<V2f>( numQueries, V2f( 0 ) ) );
+	uvData->setInterpretation( GeometricData::UV );
+
+	outputs->writable()["N"] = nData;
+	outputs->writable()["uv"] = uvData;
+
+	std::vector<V3f> *n = &nData->writable();
+	std::vector<V2f> *uv = &uvData->writable();
+	return [n, uv]( const PrimitiveEvaluator::Result *result, size_t queryIndex ) {
+		(*n)[queryIndex] = result->normal();
+		(*uv)[queryIndex] = result->uv();
+	};
+}
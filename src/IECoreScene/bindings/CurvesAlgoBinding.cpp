@@ -89,6 +89,12 @@ CurvesPrimitivePtr updateEndpointMultiplicityWrapper( const CurvesPrimitive *cur
 	return CurvesAlgo::updateEndpointMultiplicity( curves, cubicBasis, canceller );
 }
 
+void reorderForLocalityWrapper( CurvesPrimitive *curves, const std::string &position, const IECore::Canceller *canceller )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	CurvesAlgo::reorderForLocality( curves, position, canceller );
+}
+
 BOOST_PYTHON_FUNCTION_OVERLOADS(segmentOverLoads, segmentWrapper, 2, 4);
 
 } // namepsace
@@ -106,6 +112,7 @@ void bindCurvesAlgo()
 	def( "resamplePrimitiveVariable", &resamplePrimitiveVariableWrapper, ( arg_( "curvesPrimitive" ), arg_( "primitiveVariable" ), arg_( "interpolation" ), arg_( "canceller" ) = object() ) );
 	def( "deleteCurves", &deleteCurvesWrapper, ( arg_( "curvesPrimitive" ), arg_( "curvesToDelete" ), arg_( "invert" ) = false, arg_( "canceller" ) = object() ) );
 	def( "segment", ::segmentWrapper, segmentOverLoads());
+	def( "reorderForLocality", &reorderForLocalityWrapper, ( arg_( "curves" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "isPinned", &CurvesAlgo::isPinned );
 	def( "convertPinnedToNonPeriodic", &convertPinnedToNonPeriodicWrapper, ( arg_( "curves" ), arg_( "canceller" ) = object() ) );
 	def( "updateEndpointMultiplicity", &updateEndpointMultiplicityWrapper, ( arg_( "curves" ), arg_( "cubicBasis" ), arg_( "canceller" ) = object() ) );
@@ -69,6 +69,7 @@
 #include "PointInstancerBinding.h"
 #include "PointsPrimitiveBinding.h"
 #include "PointsPrimitiveEvaluatorBinding.h"
+#include "PrimitiveAlgoBinding.h"
 #include "PrimitiveBinding.h"
 #include "PrimitiveEvaluatorBinding.h"
 #include "PrimitiveOpBinding.h"
@@ -158,6 +159,7 @@ BOOST_PYTHON_MODULE(_IECoreScene)
 	bindMeshAlgo();
 	bindCurvesAlgo();
 	bindPointsAlgo();
+	bindPrimitiveAlgo();
 	bindTypedObjectParameter();
 	bindTypeId();
 	bindSceneAlgo();
@@ -38,6 +38,7 @@
 
 #include "IECoreScene/MeshAlgo.h"
 
+#include "IECorePython/RefCountedBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
 
 #include "boost/python/suite/indexing/container_utils.hpp"
@@ -95,10 +96,10 @@ PrimitiveVariable calculateVertexNormalsWrapper( const MeshPrimitive *mesh, Mesh
 	return MeshAlgo::calculateVertexNormals( mesh, weighting, position, canceller );
 }
 
-PrimitiveVariable calculateFaceVaryingNormalsWrapper( const MeshPrimitive *mesh, MeshAlgo::NormalWeighting weighting, float thresholdAngle, const std::string &position, const IECore::Canceller *canceller )
+PrimitiveVariable calculateFaceVaryingNormalsWrapper( const MeshPrimitive *mesh, MeshAlgo::NormalWeighting weighting, float thresholdAngle, const std::string &position, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::calculateFaceVaryingNormals( mesh, weighting, thresholdAngle, position, canceller );
+	return MeshAlgo::calculateFaceVaryingNormals( mesh, weighting, thresholdAngle, position, canceller, topology );
 }
 
 PrimitiveVariable calculateNormalsWrapperOld( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation interpolation, const std::string &position, const IECore::Canceller *canceller )
@@ -113,10 +114,10 @@ std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromUVWrapper(
 	return MeshAlgo::calculateTangentsFromUV( mesh, uvSet, position, orthoTangents, leftHanded, canceller );
 }
 
-std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromFirstEdgeWrapper( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded, const IECore::Canceller *canceller )
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromFirstEdgeWrapper( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::calculateTangentsFromFirstEdge( mesh, position, normal, orthoTangents, leftHanded, canceller );
+	return MeshAlgo::calculateTangentsFromFirstEdge( mesh, position, normal, orthoTangents, leftHanded, canceller, topology );
 }
 
 std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromPrimitiveCentroidWrapper( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded, const IECore::Canceller *canceller )
@@ -125,10 +126,10 @@ std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromPrimitiveCe
 	return MeshAlgo::calculateTangentsFromPrimitiveCentroid( mesh, position, normal, orthoTangents, leftHanded, canceller );
 }
 
-std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromTwoEdgesWrapper( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded, const IECore::Canceller *canceller )
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromTwoEdgesWrapper( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::calculateTangentsFromTwoEdges( mesh, position, normal, orthoTangents, leftHanded, canceller );
+	return MeshAlgo::calculateTangentsFromTwoEdges( mesh, position, normal, orthoTangents, leftHanded, canceller, topology );
 }
 
 PrimitiveVariable calculateFaceAreaWrapper( const MeshPrimitive *mesh, const std::string &position, const IECore::Canceller *canceller )
@@ -149,10 +150,18 @@ std::pair<PrimitiveVariable, PrimitiveVariable> calculateDistortionWrapper( cons
 	return MeshAlgo::calculateDistortion( mesh, uvSet, referencePosition, position, canceller );
 }
 
-void resamplePrimitiveVariableWrapper( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller )
+void resamplePrimitiveVariableWrapper( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation, canceller );
+	return MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation, canceller, topology );
+}
+
+void resamplePrimitiveVariablesWrapper( MeshPrimitive *mesh, boost::python::list &names, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
+{
+	std::vector<std::string> namesVector;
+	boost::python::container_utils::extend_container( namesVector, names );
+	ScopedGILRelease gilRelease;
+	MeshAlgo::resamplePrimitiveVariables( mesh, namesVector, interpolation, canceller, topology );
 }
 
 MeshPrimitivePtr deleteFacesWrapper( const MeshPrimitive *meshPrimitive, const PrimitiveVariable &facesToDelete, bool invert, const IECore::Canceller *canceller )
@@ -167,10 +176,22 @@ void reverseWindingWrapper( MeshPrimitive *meshPrimitive, const IECore::Cancelle
 	return MeshAlgo::reverseWinding( meshPrimitive, canceller );
 }
 
-void reorderVerticesWrapper( MeshPrimitive *mesh, int id0, int id1, int id2, const IECore::Canceller *canceller )
+void reorderVerticesWrapper( MeshPrimitive *mesh, int id0, int id1, int id2, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::reorderVertices( mesh, id0, id1, id2, canceller );
+	return MeshAlgo::reorderVertices( mesh, id0, id1, id2, canceller, topology );
+}
+
+void optimizeVertexCacheWrapper( MeshPrimitive *mesh, int cacheSize, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
+{
+	ScopedGILRelease gilRelease;
+	MeshAlgo::optimizeVertexCache( mesh, cacheSize, canceller, topology );
+}
+
+void reorderForLocalityWrapper( MeshPrimitive *mesh, const std::string &position, const IECore::Canceller *canceller )
+{
+	ScopedGILRelease gilRelease;
+	MeshAlgo::reorderForLocality( mesh, position, canceller );
 }
 
 PointsPrimitivePtr distributePointsWrapper( const MeshPrimitive *mesh, float density, const Imath::V2f &offset, const std::string &densityMask, const std::string &uvSet, const std::string &refPosition, const IECore::StringAlgo::MatchPattern &primitiveVariables, const IECore::Canceller *canceller )
@@ -211,16 +232,38 @@ MeshPrimitivePtr triangulateWrapper( const MeshPrimitive *mesh, const IECore::Ca
 	return MeshAlgo::triangulate( mesh, canceller );
 }
 
-std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> connectedVerticesWrapper( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr )
+std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> connectedVerticesWrapper( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::connectedVertices( mesh, canceller, topology );
+}
+
+std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> correspondingFaceVerticesWrapper( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller, const MeshAlgo::MeshTopology *topology )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::correspondingFaceVertices( mesh, canceller, topology );
+}
+
+MeshAlgo::MeshTopologyPtr meshTopologyConstructor( const MeshPrimitive *mesh, const IECore::Canceller *canceller )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::connectedVertices( mesh, canceller );
+	return new MeshAlgo::MeshTopology( mesh, canceller );
 }
 
-std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> correspondingFaceVerticesWrapper( const IECoreScene::MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr )
+MeshAlgo::MeshTopologyPtr topologyWrapper( const MeshPrimitive *mesh, const IECore::Canceller *canceller )
 {
 	ScopedGILRelease gilRelease;
-	return MeshAlgo::correspondingFaceVertices( mesh, canceller );
+	// Python doesn't understand constness, so this is only safe
+	// because we don't bind any methods which modify a MeshTopology.
+	return boost::const_pointer_cast<MeshAlgo::MeshTopology>( MeshAlgo::topology( mesh, canceller ) );
+}
+
+// Accessors return copies, as we have no way of preventing Python from
+// modifying the shared data.
+template<typename T, const std::vector<T> &(MeshAlgo::MeshTopology::*accessor)() const>
+typename IECore::TypedData<std::vector<T>>::Ptr meshTopologyAccessor( const MeshAlgo::MeshTopology &topology )
+{
+	return new IECore::TypedData<std::vector<T>>( (topology.*accessor)() );
 }
 
 // The C++ version of value() is templated, but we can bind it to Python by returning a TypedData of an appropriate
@@ -243,6 +286,22 @@ IECore::DataPtr meshSplitterValueWrapper( const IECoreScene::MeshAlgo::MeshSplit
 	);
 }
 
+boost::python::list meshSplitterMeshesWrapper( const IECoreScene::MeshAlgo::MeshSplitter &meshSplitter, const IECore::Canceller *canceller )
+{
+	std::vector<MeshPrimitivePtr> meshes;
+	{
+		ScopedGILRelease gilRelease;
+		meshes = meshSplitter.meshes( canceller );
+	}
+
+	boost::python::list result;
+	for( const auto &m : meshes )
+	{
+		result.append( m );
+	}
+	return result;
+}
+
 } // namespace anonymous
 
 namespace IECoreSceneModule
@@ -268,31 +327,53 @@ void bindMeshAlgo()
 
 	def( "calculateUniformNormals", &calculateUniformNormalsWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "calculateVertexNormals", &calculateVertexNormalsWrapper, ( arg_( "mesh" ), arg_( "weighting" ) = MeshAlgo::NormalWeighting::Angle, arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
-	def( "calculateFaceVaryingNormals", &calculateFaceVaryingNormalsWrapper, ( arg_( "mesh" ), arg_( "weighting" ) = MeshAlgo::NormalWeighting::Angle, arg_( "thresholdAngle" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
+	def( "calculateFaceVaryingNormals", &calculateFaceVaryingNormalsWrapper, ( arg_( "mesh" ), arg_( "weighting" ) = MeshAlgo::NormalWeighting::Angle, arg_( "thresholdAngle" ), arg_( "position" ) = "P", arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
 	def( "calculateNormals", &calculateNormalsWrapperOld, ( arg_( "mesh" ), arg_( "interpolation" ) = PrimitiveVariable::Vertex, arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "calculateTangents", &MeshAlgo::calculateTangents, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "orthoTangents" ) = true, arg_( "position" ) = "P" ) );
 	def( "calculateTangentsFromUV", &calculateTangentsFromUVWrapper, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv",  arg_( "position" ) = "P", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object() ) );
-	def( "calculateTangentsFromFirstEdge", &calculateTangentsFromFirstEdgeWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object() ) );
-	def( "calculateTangentsFromTwoEdges", &calculateTangentsFromTwoEdgesWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object() ) );
+	def( "calculateTangentsFromFirstEdge", &calculateTangentsFromFirstEdgeWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+	def( "calculateTangentsFromTwoEdges", &calculateTangentsFromTwoEdgesWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
 	def( "calculateTangentsFromPrimitiveCentroid", &calculateTangentsFromPrimitiveCentroidWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false, arg_( "canceller" ) = object() ) );
 	def( "calculateFaceArea", &calculateFaceAreaWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "calculateFaceTextureArea", &calculateFaceTextureAreaWrapper, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "calculateDistortion", &calculateDistortionWrapper, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "referencePosition" ) = "Pref", arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
-	def( "resamplePrimitiveVariable", &resamplePrimitiveVariableWrapper, ( arg_( "mesh" ), arg_( "primitiveVariable" ), arg_( "interpolation" ), arg( "canceller" ) = object() ) );
+	def( "resamplePrimitiveVariable", &resamplePrimitiveVariableWrapper, ( arg_( "mesh" ), arg_( "primitiveVariable" ), arg_( "interpolation" ), arg( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+	def( "resamplePrimitiveVariables", &resamplePrimitiveVariablesWrapper, ( arg_( "mesh" ), arg_( "names" ), arg_( "interpolation" ), arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
 	def( "deleteFaces", &deleteFacesWrapper, ( arg_( "meshPrimitive" ), arg_( "facesToDelete" ), arg_( "invert" ) = false, arg_( "canceller" ) = object() ) );
 	def( "reverseWinding", &reverseWindingWrapper, ( arg_( "meshPrimitive" ), arg_( "canceller" ) = object() ) );
-	def( "reorderVertices", &reorderVerticesWrapper, ( arg_( "mesh" ), arg_( "id0" ), arg_( "id1" ), arg_( "id2" ), arg_( "canceller" ) = object() ) );
+	def( "reorderVertices", &reorderVerticesWrapper, ( arg_( "mesh" ), arg_( "id0" ), arg_( "id1" ), arg_( "id2" ), arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+	def( "optimizeVertexCache", &optimizeVertexCacheWrapper, ( arg_( "mesh" ), arg_( "cacheSize" ) = 16, arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+	def( "reorderForLocality", &reorderForLocalityWrapper, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "distributePoints", &distributePointsWrapper, ( arg_( "mesh" ), arg_( "density" ) = 100.0, arg_( "offset" ) = Imath::V2f( 0 ), arg_( "densityMask" ) = "density", arg_( "uvSet" ) = "uv", arg_( "refPosition" ) = "P", arg( "primitiveVariables" ) = "", arg_( "canceller" ) = object() ) );
 	def( "segment", &::segmentWrapper, segmentOverLoads() );
 	def( "merge", &::mergeWrapper, ( arg_( "meshes" ), arg_( "canceller" ) = object() ) );
 	def( "triangulate", &triangulateWrapper, (arg_("mesh"), arg_( "canceller" ) = object() ) );
-	def( "connectedVertices", &connectedVerticesWrapper, ( arg_("mesh"), arg_( "canceller" ) = object() ) );
-	def( "correspondingFaceVertices", &correspondingFaceVerticesWrapper, ( arg_("mesh"), arg_( "canceller" ) = object() ) );
+	def( "connectedVertices", &connectedVerticesWrapper, ( arg_("mesh"), arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+	def( "correspondingFaceVertices", &correspondingFaceVerticesWrapper, ( arg_("mesh"), arg_( "canceller" ) = object(), arg_( "topology" ) = object() ) );
+
+	RefCountedClass<MeshAlgo::MeshTopology, IECore::RefCounted>( "MeshTopology" )
+		.def( "__init__", make_constructor( &meshTopologyConstructor, default_call_policies(), ( arg_( "mesh" ), arg_( "canceller" ) = object() ) ) )
+		.def( "numFaces", &MeshAlgo::MeshTopology::numFaces )
+		.def( "numVertices", &MeshAlgo::MeshTopology::numVertices )
+		.def( "numFaceVertices", &MeshAlgo::MeshTopology::numFaceVertices )
+		.def( "numEdges", &MeshAlgo::MeshTopology::numEdges )
+		.def( "faceOffsets", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::faceOffsets> )
+		.def( "faceVertexFaces", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::faceVertexFaces> )
+		.def( "vertexFaceVertexOffsets", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::vertexFaceVertexOffsets> )
+		.def( "vertexFaceVertices", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::vertexFaceVertices> )
+		.def( "edges", &meshTopologyAccessor<Imath::V2i, &MeshAlgo::MeshTopology::edges> )
+		.def( "faceVertexEdges", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::faceVertexEdges> )
+		.def( "oppositeFaceVertices", &meshTopologyAccessor<int, &MeshAlgo::MeshTopology::oppositeFaceVertices> )
+		.def( "memoryUsage", &MeshAlgo::MeshTopology::memoryUsage )
+	;
+
+	def( "topology", &topologyWrapper, ( arg_( "mesh" ), arg_( "canceller" ) = object() ) );
 
 	class_< MeshAlgo::MeshSplitter >( "MeshSplitter", no_init )
 		.def( init< ConstMeshPrimitivePtr, const PrimitiveVariable &, optional< const IECore::Canceller *> >() )
 		.def( "numMeshes", &MeshAlgo::MeshSplitter::numMeshes )
 		.def( "mesh", &MeshAlgo::MeshSplitter::mesh, ( arg_( "segmentId" ), arg_( "canceller" ) = object() ) )
+		.def( "meshes", &meshSplitterMeshesWrapper, ( arg_( "canceller" ) = object() ) )
 		.def( "bound", &MeshAlgo::MeshSplitter::bound, ( arg_( "segmentId" ), arg_( "canceller" ) = object() ) )
 		.def( "value", &meshSplitterValueWrapper, ( arg_( "segmentId" ) ) )
 	;
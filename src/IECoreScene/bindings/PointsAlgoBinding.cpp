@@ -95,6 +95,12 @@ boost::python::list segmentWrapper(const PointsPrimitive *points, const Primitiv
 
 BOOST_PYTHON_FUNCTION_OVERLOADS(segmentOverLoads, segmentWrapper, 2, 4);
 
+void reorderForLocalityWrapper( PointsPrimitive *points, const std::string &position, const IECore::Canceller *canceller )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	PointsAlgo::reorderForLocality( points, position, canceller );
+}
+
 } // namepsace
 
 namespace IECoreSceneModule
@@ -111,6 +117,7 @@ void bindPointsAlgo()
 	def( "deletePoints", &deletePointsWrapper, ( arg_( "meshPrimitive" ), arg_( "pointsToDelete" ), arg_( "invert" ) = false, arg_( "canceller" ) = object() ) );
 	def( "mergePoints", &::mergePointsWrapper, ( arg_("pointsPrimitives"), arg_("canceller") = object() ) );
 	def( "segment", &::segmentWrapper, segmentOverLoads());
+	def( "reorderForLocality", &reorderForLocalityWrapper, ( arg_( "points" ), arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 }
 
 } // namespace IECoreSceneModule
@@ -39,6 +39,11 @@
 #include "IECoreScene/PrimitiveEvaluator.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "IECore/VectorTypedData.h"
+
+#include "boost/python/suite/indexing/container_utils.hpp"
 
 using namespace IECore;
 using namespace IECorePython;
@@ -131,6 +136,30 @@ struct PrimitiveEvaluatorHelper
 		return result;
 	}
 
+	static CompoundDataPtr closestPoints( PrimitiveEvaluator &evaluator, const V3fVectorData *points, object primitiveVariables, const Canceller *canceller )
+	{
+		std::vector<std::string> primitiveVariablesVector;
+		boost::python::container_utils::extend_container( primitiveVariablesVector, primitiveVariables );
+		ScopedGILRelease gilRelease;
+		return evaluator.closestPoints( points->readable(), primitiveVariablesVector, canceller );
+	}
+
+	static CompoundDataPtr pointsAtUV( PrimitiveEvaluator &evaluator, const V2fVectorData *uvs, object primitiveVariables, const Canceller *canceller )
+	{
+		std::vector<std::string> primitiveVariablesVector;
+		boost::python::container_utils::extend_container( primitiveVariablesVector, primitiveVariables );
+		ScopedGILRelease gilRelease;
+		return evaluator.pointsAtUV( uvs->readable(), primitiveVariablesVector, canceller );
+	}
+
+	static CompoundDataPtr intersectRays( PrimitiveEvaluator &evaluator, const V3fVectorData *origins, const V3fVectorData *directions, float maxDistance, object primitiveVariables, const Canceller *canceller )
+	{
+		std::vector<std::string> primitiveVariablesVector;
+		boost::python::container_utils::extend_container( primitiveVariablesVector, primitiveVariables );
+		ScopedGILRelease gilRelease;
+		return evaluator.intersectRays( origins->readable(), directions->readable(), maxDistance, primitiveVariablesVector, canceller );
+	}
+
 	static PrimitivePtr primitive( PrimitiveEvaluator &evaluator )
 	{
 		return evaluator.primitive()->copy();
@@ -184,6 +213,9 @@ void bindPrimitiveEvaluator()
 		.def( "intersectionPoint", intersectionPointMaxDist )
 		.def( "intersectionPoints", intersectionPoints )
 		.def( "intersectionPoints", intersectionPointsMaxDist )
+		.def( "closestPoints", &PrimitiveEvaluatorHelper::closestPoints, ( arg( "points" ), arg( "primitiveVariables" ) = list(), arg( "canceller" ) = object() ) )
+		.def( "pointsAtUV", &PrimitiveEvaluatorHelper::pointsAtUV, ( arg( "uvs" ), arg( "primitiveVariables" ) = list(), arg( "canceller" ) = object() ) )
+		.def( "intersectRays", &PrimitiveEvaluatorHelper::intersectRays, ( arg( "origins" ), arg( "directions" ), arg( "maxDistance" ) = std::numeric_limits<float>::max(), arg( "primitiveVariables" ) = list(), arg( "canceller" ) = object() ) )
 		.def( "primitive", &PrimitiveEvaluatorHelper::primitive )
 		.def( "volume", &PrimitiveEvaluator::volume )
 		.def( "centerOfGravity", &PrimitiveEvaluator::centerOfGravity )
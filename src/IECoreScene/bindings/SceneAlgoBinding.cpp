@@ -33,13 +33,18 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/python.hpp"
+#include "boost/python/suite/indexing/container_utils.hpp"
 
 #include "SceneAlgoBinding.h"
 
 #include "IECoreScene/SceneAlgo.h"
 
+#include "IECorePython/ExceptionAlgo.h"
+#include "IECorePython/ScopedGILLock.h"
 #include "IECorePython/ScopedGILRelease.h"
 
+#include "IECore/CompoundObject.h"
+
 
 using namespace boost::python;
 using namespace IECore;
@@ -48,12 +53,12 @@ using namespace IECoreScene;
 namespace
 {
 
-dict parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags )
+dict parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags, SceneAlgo::ReadProfile *profile )
 {
 	SceneAlgo::SceneStats stats;
 	{
 		IECorePython::ScopedGILRelease scopedGILRelease;
-		stats = SceneAlgo::parallelReadAll( src, startFrame, endFrame, frameRate, flags );
+		stats = SceneAlgo::parallelReadAll( src, startFrame, endFrame, frameRate, flags, profile );
 	}
 
 	dict result;
@@ -65,6 +70,105 @@ dict parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, f
 	return result;
 }
 
+std::string profileEventPath( const SceneAlgo::ProfileEvent &event )
+{
+	std::string result;
+	SceneInterface::pathToString( event.path, result );
+	return result;
+}
+
+list readProfileEvents( const SceneAlgo::ReadProfile &profile )
+{
+	list result;
+	for( const auto &event : profile.events )
+	{
+		result.append( event );
+	}
+	return result;
+}
+
+void readProfileWriteChromeTrace( const SceneAlgo::ReadProfile &profile, const std::string &fileName )
+{
+	IECorePython::ScopedGILRelease scopedGILRelease;
+	profile.writeChromeTrace( fileName );
+}
+
+DataPtr locationComponentsTransform( const SceneAlgo::LocationComponents &components )
+{
+	return components.transform ? components.transform->copy() : nullptr;
+}
+
+CompoundObjectPtr locationComponentsAttributes( const SceneAlgo::LocationComponents &components )
+{
+	CompoundObjectPtr result = new CompoundObject;
+	for( const auto &attribute : components.attributes )
+	{
+		result->members()[attribute.first] = attribute.second->copy();
+	}
+	return result;
+}
+
+ObjectPtr locationComponentsObject( const SceneAlgo::LocationComponents &components )
+{
+	return components.object ? components.object->copy() : nullptr;
+}
+
+void parallelTraverse( const SceneInterface *scene, object visitor, const SceneAlgo::ParallelTraverseOptions &options, const IECore::Canceller *canceller )
+{
+	SceneAlgo::ParallelTraverseOptions optionsWithCanceller = options;
+	optionsWithCanceller.canceller = canceller;
+
+	auto f = [&visitor]( const SceneInterface *location, const SceneAlgo::LocationComponents &components ) -> bool
+	{
+		IECorePython::ScopedGILLock gilLock;
+		try
+		{
+			// Pass a copy of `components`, so that it remains valid if the visitor keeps
+			// a reference to it. This is cheap, because the components are held by pointer.
+			object result = visitor( SceneInterfacePtr( const_cast<SceneInterface *>( location ) ), components );
+			return result.is_none() || extract<bool>( result )();
+		}
+		catch( const error_already_set & )
+		{
+			IECorePython::ExceptionAlgo::translatePythonException();
+		}
+	};
+
+	IECorePython::ScopedGILRelease scopedGILRelease;
+	SceneAlgo::parallelTraverse( scene, f, optionsWithCanceller );
+}
+
+std::string sceneChangePath( const SceneAlgo::SceneChange &change )
+{
+	std::string result;
+	SceneInterface::pathToString( change.path, result );
+	return result;
+}
+
+std::string sceneChangeName( const SceneAlgo::SceneChange &change )
+{
+	return change.name.string();
+}
+
+list diff( const SceneInterface *a, const SceneInterface *b, object pythonTimes, unsigned int flags, const IECore::Canceller *canceller )
+{
+	std::vector<double> times;
+	boost::python::container_utils::extend_container( times, pythonTimes );
+
+	SceneAlgo::SceneChanges changes;
+	{
+		IECorePython::ScopedGILRelease scopedGILRelease;
+		changes = SceneAlgo::diff( a, b, times, flags, canceller );
+	}
+
+	list result;
+	for( const auto &change : changes )
+	{
+		result.append( change );
+	}
+	return result;
+}
+
 } // namespace
 
 namespace IECoreSceneModule
@@ -92,9 +196,61 @@ void bindSceneAlgo()
 		.export_values()
 		;
 
+	class_<SceneAlgo::ParallelTraverseOptions>( "ParallelTraverseOptions" )
+		.def_readwrite( "time", &SceneAlgo::ParallelTraverseOptions::time )
+		.def_readwrite( "prefetch", &SceneAlgo::ParallelTraverseOptions::prefetch )
+		.def_readwrite( "maxDepth", &SceneAlgo::ParallelTraverseOptions::maxDepth )
+		.def_readwrite( "maxConcurrency", &SceneAlgo::ParallelTraverseOptions::maxConcurrency )
+	;
+
+	class_<SceneAlgo::LocationComponents>( "LocationComponents", no_init )
+		.def_readonly( "prefetched", &SceneAlgo::LocationComponents::prefetched )
+		.def_readonly( "bound", &SceneAlgo::LocationComponents::bound )
+		.add_property( "transform", &locationComponentsTransform )
+		.add_property( "attributes", &locationComponentsAttributes )
+		.add_property( "object", &locationComponentsObject )
+	;
+
+	def( "parallelTraverse", &::parallelTraverse, ( arg( "scene" ), arg( "visitor" ), arg( "options" ) = SceneAlgo::ParallelTraverseOptions(), arg( "canceller" ) = object() ) );
+
 	def( "copy", &SceneAlgo::copy );
 
-	def( "parallelReadAll", &::parallelReadAll);
+	class_<SceneAlgo::ProfileEvent>( "ProfileEvent" )
+		.add_property( "path", &profileEventPath )
+		.def_readonly( "component", &SceneAlgo::ProfileEvent::component )
+		.def_readonly( "time", &SceneAlgo::ProfileEvent::time )
+		.def_readonly( "start", &SceneAlgo::ProfileEvent::start )
+		.def_readonly( "duration", &SceneAlgo::ProfileEvent::duration )
+		.def_readonly( "bytes", &SceneAlgo::ProfileEvent::bytes )
+		.def_readonly( "thread", &SceneAlgo::ProfileEvent::thread )
+	;
+
+	class_<SceneAlgo::ReadProfile, boost::noncopyable>( "ReadProfile" )
+		.def( "events", &readProfileEvents )
+		.def( "report", &SceneAlgo::ReadProfile::report, ( arg( "n" ) = 10 ) )
+		.def( "writeChromeTrace", &readProfileWriteChromeTrace )
+	;
+
+	def( "parallelReadAll", &::parallelReadAll, ( arg( "src" ), arg( "startFrame" ), arg( "endFrame" ), arg( "frameRate" ), arg( "flags" ), arg( "profile" ) = object() ) );
+
+	{
+		scope changeScope = class_<SceneAlgo::SceneChange>( "SceneChange" )
+			.def_readonly( "type", &SceneAlgo::SceneChange::type )
+			.add_property( "path", &sceneChangePath )
+			.def_readonly( "component", &SceneAlgo::SceneChange::component )
+			.add_property( "name", &sceneChangeName )
+			.def_readonly( "time", &SceneAlgo::SceneChange::time )
+			.def( self == self )
+		;
+
+		enum_<SceneAlgo::SceneChange::Type>( "Type" )
+			.value( "Added", SceneAlgo::SceneChange::Added )
+			.value( "Removed", SceneAlgo::SceneChange::Removed )
+			.value( "Modified", SceneAlgo::SceneChange::Modified )
+		;
+	}
+
+	def( "diff", &::diff, ( arg( "a" ), arg( "b" ), arg( "times" ), arg( "flags" ) = SceneAlgo::All, arg( "canceller" ) = object() ) );
 }
 
 } // namespace IECoreSceneModule
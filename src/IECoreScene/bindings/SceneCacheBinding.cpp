@@ -69,6 +69,16 @@ SceneCachePtr constructor2( IECore::IndexedIOPtr indexedIO )
 	return new SceneCache( indexedIO );
 }
 
+object contentHash( const SceneCache &sceneCache )
+{
+	MurmurHash h;
+	if( sceneCache.contentHash( h ) )
+	{
+		return object( h );
+	}
+	return object();
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -168,6 +178,7 @@ void bindSceneCache()
 	RunTimeTypedClass<SceneCache>()
 		.def( "__init__", make_constructor( &constructor ), "Opens a scene file for read or write." )
 		.def( "__init__", make_constructor( &constructor2 ), "Opens a scene from a previously opened file handle." )
+		.def( "contentHash", &contentHash )
 	;
 
 	def( "testSceneCacheParallelAttributeRead", &testSceneCacheParallelAttributeRead );
@@ -35,6 +35,7 @@
 #include "IECoreVDB/VDBObject.h"
 
 #include "IECore/Exception.h"
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/MurmurHash.h"
 #include "IECore/SimpleTypedData.h"
@@ -42,10 +43,13 @@
 #include "openvdb/io/Stream.h"
 #include "openvdb/openvdb.h"
 
+#include "boost/filesystem/operations.hpp"
 #include "boost/iostreams/categories.hpp"
 #include "boost/iostreams/stream.hpp"
+#include "boost/lexical_cast.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 
 using namespace IECore;
 using namespace IECoreVDB;
@@ -82,6 +86,20 @@ Imath::Box<Imath::Vec3<T> > worldBound( const openvdb::GridBase *grid, float pad
 }
 
 
+//! Returns true if clipping `grid` to the world-space `bound` would leave all of its active voxels intact.
+bool containsActiveVoxels( const openvdb::BBoxd &bound, const openvdb::GridBase *grid )
+{
+	const openvdb::CoordBBox activeBound = grid->evalActiveVoxelBoundingBox();
+	if( activeBound.empty() )
+	{
+		return true;
+	}
+
+	const openvdb::Vec3d offset( 0.5 );
+	const openvdb::BBoxd indexBound( activeBound.min().asVec3d() - offset, activeBound.max().asVec3d() + offset );
+	return bound.isInside( grid->transform().indexToWorld( indexBound ) );
+}
+
 //! allow hashing via a io stream interface.
 struct MurmurHashSink
 {
@@ -102,6 +120,74 @@ struct MurmurHashSink
 	MurmurHash &hash;
 };
 
+// Cache for clipped grids, keyed by the contents of the source grid and
+// the world-space bound. Grids not yet loaded are read partially from
+// file, and grids already in memory are clipped from a copy.
+struct ClippedGridCacheGetterKey
+{
+
+	ClippedGridCacheGetterKey( openvdb::io::File *file, std::recursive_mutex &mutex, const IECore::MurmurHash &fileHash, const std::string &gridName, const openvdb::BBoxd &bound )
+		:	file( file ), mutex( &mutex ), grid( nullptr ), gridName( gridName ), bound( bound )
+	{
+		hash.append( fileHash );
+		hash.append( gridName );
+		hash.append( bound.min().asPointer(), 3 );
+		hash.append( bound.max().asPointer(), 3 );
+	}
+
+	ClippedGridCacheGetterKey( const openvdb::GridBase *grid, const IECore::MurmurHash &gridHash, const openvdb::BBoxd &bound )
+		:	file( nullptr ), mutex( nullptr ), grid( grid ), bound( bound )
+	{
+		hash.append( gridHash );
+		hash.append( bound.min().asPointer(), 3 );
+		hash.append( bound.max().asPointer(), 3 );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	openvdb::io::File *file;
+	std::recursive_mutex *mutex;
+	const openvdb::GridBase *grid;
+	std::string gridName;
+	const openvdb::BBoxd &bound;
+	IECore::MurmurHash hash;
+
+};
+
+using ClippedGridCache = IECore::LRUCache<IECore::MurmurHash, openvdb::GridBase::ConstPtr, IECore::LRUCachePolicy::Parallel, ClippedGridCacheGetterKey>;
+
+ClippedGridCache &clippedGridCache()
+{
+	static ClippedGridCache *g_cache = [] () {
+		const char *m = getenv( "IECOREVDB_GRID_CACHE_MEMORY" );
+		const size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+		return new ClippedGridCache(
+			[] ( const ClippedGridCacheGetterKey &key, size_t &cost ) -> openvdb::GridBase::ConstPtr {
+				openvdb::GridBase::Ptr result;
+				if( key.file )
+				{
+					std::lock_guard<std::recursive_mutex> l( *key.mutex );
+					// OpenVDB uses delayed loading and clipping here, so
+					// only the leaf nodes intersecting the bound are read.
+					result = key.file->readGrid( key.gridName, key.bound );
+				}
+				else
+				{
+					result = key.grid->deepCopyGrid();
+					result->clipGrid( key.bound );
+				}
+				cost = result->memUsage();
+				return result;
+			},
+			1024 * 1024 * mi
+		);
+	}();
+	return *g_cache;
+}
+
 }
 
 IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( VDBObject );
@@ -124,6 +210,11 @@ VDBObject::VDBObject( const std::string &filename ) : m_unmodifiedFromFile( true
 	m_lockedFile->file->setCopyMaxBytes( 0 );
 	m_lockedFile->file->open(); //lazy loading of grid data is default enabling OPENVDB_DISABLE_DELAYED_LOAD will load the grids up front
 
+	// so that grids cached by `findGrid( name, bound )` aren't reused if the file is rewritten
+	m_lockedFile->hash.append( filename );
+	m_lockedFile->hash.append( (uint64_t)boost::filesystem::last_write_time( filename ) );
+	m_lockedFile->hash.append( (uint64_t)boost::filesystem::file_size( filename ) );
+
 	openvdb::GridPtrVecPtr grids = m_lockedFile->file->readAllGridMetadata();
 
 	if ( !grids )
@@ -166,6 +257,17 @@ openvdb::GridBase::Ptr VDBObject::findGrid( const std::string &name )
 	return openvdb::GridBase::Ptr();
 }
 
+openvdb::GridBase::ConstPtr VDBObject::findGrid( const std::string &name, const Imath::Box3f &bound ) const
+{
+	auto it = m_grids.find( name );
+	if( it != m_grids.end() )
+	{
+		return it->second.clippedGrid( bound );
+	}
+
+	return openvdb::GridBase::ConstPtr();
+}
+
 std::vector<std::string> VDBObject::gridNames() const
 {
 	std::vector<std::string> outputGridNames;
@@ -378,7 +480,7 @@ void VDBObject::memoryUsage( IECore::Object::MemoryAccumulator &acc ) const
 
 	for( const auto &it : m_grids )
 	{
-		acc.accumulate( it.second.metadata().get(), it.second.metadata()->memUsage() );
+		it.second.memoryUsage( acc );
 	}
 }
 
@@ -418,6 +520,79 @@ openvdb::GridBase::Ptr VDBObject::HashedGrid::grid() const
 	return m_grid;
 }
 
+openvdb::GridBase::ConstPtr VDBObject::HashedGrid::clippedGrid( const Imath::Box3f &bound ) const
+{
+	if( bound.isEmpty() )
+	{
+		return m_grid->copyGridWithNewTree();
+	}
+
+	const openvdb::BBoxd worldBound(
+		openvdb::Vec3d( bound.min.x, bound.min.y, bound.min.z ),
+		openvdb::Vec3d( bound.max.x, bound.max.y, bound.max.z )
+	);
+
+	openvdb::GridBase::ConstPtr result;
+	auto tmp = m_lockedFile;
+	if( tmp && tmp->file )
+	{
+		// The grid hasn't been loaded yet, so we can avoid loading
+		// the parts of it that are outside the bound.
+		result = clippedGridCache().get( ClippedGridCacheGetterKey( tmp->file.get(), tmp->mutex, tmp->hash, m_grid->getName(), worldBound ) );
+	}
+	else
+	{
+		// The grid is already in memory. If clipping wouldn't remove
+		// anything then we can share it, otherwise we clip a copy,
+		// caching it by the hash of the grid.
+		openvdb::GridBase::ConstPtr g = grid();
+		if( containsActiveVoxels( worldBound, g.get() ) )
+		{
+			return g;
+		}
+
+		IECore::MurmurHash gridHash;
+		{
+			std::lock_guard<std::mutex> l( m_clippedGrids->mutex );
+			gridHash = hash();
+		}
+		result = clippedGridCache().get( ClippedGridCacheGetterKey( g.get(), gridHash, worldBound ) );
+	}
+
+	std::lock_guard<std::mutex> l( m_clippedGrids->mutex );
+	auto &grids = m_clippedGrids->grids;
+	grids.erase(
+		std::remove_if( grids.begin(), grids.end(), [] ( const std::weak_ptr<const openvdb::GridBase> &g ) { return g.expired(); } ),
+		grids.end()
+	);
+	if( std::none_of( grids.begin(), grids.end(), [&result] ( const std::weak_ptr<const openvdb::GridBase> &g ) { return g.lock() == result; } ) )
+	{
+		grids.push_back( result );
+	}
+	return result;
+}
+
+void VDBObject::HashedGrid::memoryUsage( IECore::Object::MemoryAccumulator &acc ) const
+{
+	acc.accumulate( m_grid.get(), m_grid->memUsage() );
+
+	if( !m_clippedGrids )
+	{
+		return;
+	}
+
+	// Accumulating by pointer means that regions shared with
+	// other VDBObjects via the cache are only counted once.
+	std::lock_guard<std::mutex> l( m_clippedGrids->mutex );
+	for( const auto &g : m_clippedGrids->grids )
+	{
+		if( auto grid = g.lock() )
+		{
+			acc.accumulate( grid.get(), grid->memUsage() );
+		}
+	}
+}
+
 IECore::MurmurHash VDBObject::HashedGrid::hash() const
 {
 	if( !m_hashValid )
@@ -446,7 +621,9 @@ void VDBObject::HashedGrid::markedAsEdited()
 	if( m_grid.use_count() > 1 )
 	{
 		m_grid = m_grid->deepCopyGrid();
-		m_hash = IECore::MurmurHash();
-		m_hashValid = false;
 	}
+	// The caller may modify the grid, so the hash must be
+	// recomputed even if the grid wasn't shared.
+	m_hash = IECore::MurmurHash();
+	m_hashValid = false;
 }
@@ -69,6 +69,18 @@ boost::python::list gridNames( VDBObject::Ptr vdbObject )
 	return result;
 }
 
+openvdb::GridBase::Ptr findClippedGrid( const VDBObject &vdbObject, const std::string &name, const Imath::Box3f &bound )
+{
+	openvdb::GridBase::ConstPtr grid = vdbObject.findGrid( name, bound );
+	if( !grid )
+	{
+		return openvdb::GridBase::Ptr();
+	}
+	// The grid may be shared with the cache, so we must return
+	// a copy for Python to modify freely.
+	return grid->deepCopyGrid();
+}
+
 } // namespace
 
 BOOST_PYTHON_MODULE( _IECoreVDB )
@@ -87,6 +99,7 @@ BOOST_PYTHON_MODULE( _IECoreVDB )
 		.def("metadata", &VDBObject::metadata)
 		.def("removeGrid", &VDBObject::removeGrid)
 		.def( "findGrid", (openvdb::GridBase::Ptr (VDBObject::*)( const std::string &name ))&VDBObject::findGrid )
+		.def( "findGrid", &findClippedGrid )
 		.def( "insertGrid", &VDBObject::insertGrid )
 		.def("unmodifiedFromFile", &VDBObject::unmodifiedFromFile)
 		.def("fileName", &VDBObject::fileName)
@@ -71,6 +71,23 @@ class TestBoundedKDTree:
 
 		self.assertEqual( len( bIdxArray ), numBounds )
 
+	def doBatchIntersectingBounds( self, numBounds ) :
+
+		self.makeRandomTree( numBounds )
+
+		queryBounds = self.bounds.copy()
+		queryBounds.resize( min( numBounds, 100 ) )
+
+		offsets, indices = self.tree.intersectingBounds( queryBounds )
+		self.assertEqual( len( offsets ), len( queryBounds ) + 1 )
+		self.assertEqual( offsets[-1], len( indices ) )
+
+		for i, b in enumerate( queryBounds ) :
+			result = set( indices[offsets[i]:offsets[i+1]] )
+			self.assertEqual( result, set( self.tree.intersectingBounds( b ) ) )
+			# Every bound intersects itself.
+			self.assertIn( i, result )
+
 
 
 class TestBoundedKDTreeBox3f(unittest.TestCase, TestBoundedKDTree):
@@ -121,6 +138,32 @@ class TestBoundedKDTreeBox3f(unittest.TestCase, TestBoundedKDTree):
 			self.doIntersectingRandomBounds(t)
 			self.doIntersectingBounds(t)
 
+	def testBatchIntersectingBounds( self ) :
+
+		for t in self.treeSizes :
+			self.doBatchIntersectingBounds( t )
+
+	def testLargeTree( self ) :
+
+		# Small bounds on a grid, so we can compute the expected
+		# results directly. There are enough of them for the
+		# subtrees near the root to be built concurrently.
+		bounds = IECore.Box3fVectorData()
+		for x in range( 0, 40 ) :
+			for y in range( 0, 40 ) :
+				for z in range( 0, 20 ) :
+					bounds.append( imath.Box3f( imath.V3f( x, y, z ), imath.V3f( x, y, z ) + imath.V3f( 0.5 ) ) )
+
+		tree = IECore.Box3fTree( bounds )
+
+		for query in [
+			imath.Box3f( imath.V3f( 0 ), imath.V3f( 0.25 ) ),
+			imath.Box3f( imath.V3f( 10.75 ), imath.V3f( 12.25 ) ),
+			imath.Box3f( imath.V3f( -1 ), imath.V3f( 100 ) ),
+		] :
+			expected = { i for i, b in enumerate( bounds ) if b.intersects( query ) }
+			self.assertEqual( set( tree.intersectingBounds( query ) ), expected )
+
 
 class TestBoundedKDTreeBox3d(unittest.TestCase, TestBoundedKDTree):
 
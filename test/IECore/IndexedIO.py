@@ -329,6 +329,37 @@ class TestFileIndexedIO(unittest.TestCase):
 		self.assertEqual( len(e), 0 )
 		f.remove("sub2")
 
+	def testAppend(self):
+		"""Test FileIndexedIO append"""
+
+		fileName = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		f = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Write )
+		f.write( "a", 1 )
+		IECore.IntVectorData( [ 1, 2, 3 ] ).save( f, "obj" )
+		del f
+
+		size = os.path.getsize( fileName )
+
+		# Opening and closing without changes must leave the file intact
+
+		f = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Append )
+		del f
+		self.assertEqual( os.path.getsize( fileName ), size )
+
+		# Directories committed by `Object.save()` can be modified
+
+		f = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Append )
+		f.write( "b", 2 )
+		f.subdirectory( "obj" ).write( "extra", 3 )
+		del f
+
+		f = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( f.read( "a" ).value, 1 )
+		self.assertEqual( f.read( "b" ).value, 2 )
+		self.assertEqual( f.subdirectory( "obj" ).read( "extra" ).value, 3 )
+		self.assertEqual( IECore.Object.load( f, "obj" ), IECore.IntVectorData( [ 1, 2, 3 ] ) )
+
 	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
 	def testRmStress(self) :
 		"""Test FileIndexedIO rm (stress test)"""
@@ -129,6 +129,37 @@ class TestKDTree:
 				else :
 					self.assertFalse( i in s )
 
+	def doBatchQueries( self, numPoints, **kw ) :
+
+		self.makeTree( numPoints, **kw )
+
+		queryPoints = self.points.copy()
+		queryPoints.resize( min( numPoints, 1000 ) )
+
+		nearest = self.tree.nearestNeighbour( queryPoints )
+		self.assertEqual( len( nearest ), len( queryPoints ) )
+		for i, p in enumerate( queryPoints ) :
+			self.assertEqual( nearest[i], self.tree.nearestNeighbour( p ) )
+
+		for r in self.radii :
+			offsets, neighbours = self.tree.nearestNeighbours( queryPoints, r )
+			self.assertEqual( len( offsets ), len( queryPoints ) + 1 )
+			self.assertEqual( offsets[-1], len( neighbours ) )
+			for i, p in enumerate( queryPoints ) :
+				self.assertEqual(
+					set( neighbours[offsets[i]:offsets[i+1]] ),
+					set( self.tree.nearestNeighbours( p, r ) )
+				)
+
+		for n in self.numNeighbours :
+			offsets, neighbours = self.tree.nearestNNeighbours( queryPoints, n )
+			self.assertEqual( len( offsets ), len( queryPoints ) + 1 )
+			self.assertEqual( offsets[-1], len( neighbours ) )
+			for i, p in enumerate( queryPoints ) :
+				self.assertEqual(
+					list( neighbours[offsets[i]:offsets[i+1]] ),
+					list( self.tree.nearestNNeighbours( p, n ) )
+				)
 
 class TestKDTreeV2f(unittest.TestCase, TestKDTree):
 
@@ -228,7 +259,7 @@ class TestKDTreeV2d(unittest.TestCase, TestKDTree):
 
 class TestKDTreeV3f(unittest.TestCase, TestKDTree):
 
-	def makeTree(self, numPoints):
+	def makeTree(self, numPoints, contiguousPoints = False):
 		# Make tree creation repeatable, but different for every size
 		random.seed(100 + 5 * numPoints)
 		self.points = IECore.V3fVectorData()
@@ -236,7 +267,7 @@ class TestKDTreeV3f(unittest.TestCase, TestKDTree):
 		for i in range(0, numPoints):
 			self.points.append( imath.V3f( random.random(), random.random(), random.random() ) )
 
-		self.tree = IECore.V3fTree( self.points )
+		self.tree = IECore.V3fTree( self.points, contiguousPoints )
 
 	def randomBox( self ) :
 
@@ -274,6 +305,13 @@ class TestKDTreeV3f(unittest.TestCase, TestKDTree):
 		for t in self.treeSizes:
 			self.doEnclosedPoints(t)
 
+	def testBatchQueries( self ) :
+
+		# Include a tree large enough to be built in parallel.
+		for t in self.treeSizes + [ 50000 ] :
+			self.doBatchQueries( t )
+			self.doBatchQueries( t, contiguousPoints = True )
+
 class TestKDTreeV3d(unittest.TestCase, TestKDTree):
 
 	def makeTree(self, numPoints):
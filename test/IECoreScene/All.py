@@ -84,6 +84,7 @@ from ClippingPlaneTest import ClippingPlaneTest
 from MeshAlgoTest import *
 from CurvesAlgoTest import *
 from PointsAlgoTest import *
+from PrimitiveAlgoTest import PrimitiveAlgoTest
 from ObjectInterpolationTest import ObjectInterpolationTest
 from SceneAlgo import *
 from ShaderNetworkTest import ShaderNetworkTest
@@ -1862,6 +1862,64 @@ class CurvesAlgoDeleteCurvesTest ( unittest.TestCase ):
 			)
 		)
 
+class CurvesAlgoReorderForLocalityTest( unittest.TestCase ) :
+
+	def test( self ) :
+
+		verticesPerCurve = [ 4 + ( i % 4 ) for i in range( 0, 100 ) ]
+		positions = []
+		for i, n in enumerate( verticesPerCurve ) :
+			origin = imath.V3f( ( i * 37 ) % 101, ( i * 53 ) % 97, 0 )
+			positions.extend( [ origin + imath.V3f( 0, 0, j ) for j in range( 0, n ) ] )
+
+		curves = IECoreScene.CurvesPrimitive( IECore.IntVectorData( verticesPerCurve ), IECore.CubicBasisf.bSpline(), False, IECore.V3fVectorData( positions ) )
+		curves["curveId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( range( 0, curves.numCurves() ) ) )
+		curves["vertexId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( range( 0, len( positions ) ) ) )
+		numVarying = curves.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Varying )
+		self.assertNotEqual( numVarying, len( positions ) )
+		curves["varyingId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Varying, IECore.IntVectorData( range( 0, numVarying ) ) )
+		self.assertTrue( curves.arePrimitiveVariablesValid() )
+
+		reordered = curves.copy()
+		IECoreScene.CurvesAlgo.reorderForLocality( reordered )
+		self.assertTrue( reordered.arePrimitiveVariablesValid() )
+		self.assertEqual( reordered.basis(), curves.basis() )
+		self.assertEqual( reordered.wrap(), curves.wrap() )
+		self.assertNotEqual( reordered["curveId"].data, curves["curveId"].data )
+		self.assertEqual( sorted( reordered["curveId"].data ), list( range( 0, curves.numCurves() ) ) )
+
+		# Each curve keeps its own vertices and varying elements, in order.
+
+		def offsets( c, interpolation ) :
+			result = [ 0 ]
+			for i in range( 0, c.numCurves() ) :
+				result.append( result[-1] + c.variableSize( interpolation, i ) )
+			return result
+
+		vertexOffsets = offsets( curves, IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+		varyingOffsets = offsets( curves, IECoreScene.PrimitiveVariable.Interpolation.Varying )
+		newVertexOffsets = offsets( reordered, IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+		newVaryingOffsets = offsets( reordered, IECoreScene.PrimitiveVariable.Interpolation.Varying )
+
+		for i, curve in enumerate( reordered["curveId"].data ) :
+			self.assertEqual( reordered.verticesPerCurve()[i], verticesPerCurve[curve] )
+			self.assertEqual(
+				list( reordered["vertexId"].data[newVertexOffsets[i]:newVertexOffsets[i+1]] ),
+				list( range( vertexOffsets[curve], vertexOffsets[curve+1] ) )
+			)
+			self.assertEqual(
+				list( reordered["varyingId"].data[newVaryingOffsets[i]:newVaryingOffsets[i+1]] ),
+				list( range( varyingOffsets[curve], varyingOffsets[curve+1] ) )
+			)
+
+		for i, v in enumerate( reordered["vertexId"].data ) :
+			self.assertEqual( reordered["P"].data[i], positions[v] )
+
+		# Reordering is stable, so a second pass does nothing.
+		reordered2 = reordered.copy()
+		IECoreScene.CurvesAlgo.reorderForLocality( reordered2 )
+		self.assertEqual( reordered2, reordered )
+
 class CurvesAlgoConvertPinnedToNonPeriodicTest( unittest.TestCase ):
 
 	def test( self ) :
@@ -1225,6 +1225,33 @@ class CurvesPrimitiveEvaluatorTest( unittest.TestCase ) :
 
 		IECoreScene.testCurvesPrimitiveEvaluatorParallelClosestPoint()
 
+	def testBatchClosestPoints( self ) :
+
+		rand = imath.Rand32()
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bSpline() ) :
+
+			numCurves = 1000
+			numVerts = 4 + basis.step * 3
+			p = IECore.V3fVectorData( [ imath.V3f( rand.nextf(), rand.nextf(), rand.nextf() ) * 10 for i in range( 0, numCurves * numVerts ) ] )
+			curves = IECoreScene.CurvesPrimitive( IECore.IntVectorData( [ numVerts ] * numCurves ), basis, False, p )
+
+			e = IECoreScene.CurvesPrimitiveEvaluator( curves )
+			points = IECore.V3fVectorData( [ imath.V3f( rand.nextf(), rand.nextf(), rand.nextf() ) * 10 for i in range( 0, 1000 ) ] )
+
+			# Batch queries first, so that the tree is built by
+			# the parallel query rather than a single one.
+			results = e.closestPoints( points )
+			self.assertEqual( set( results.keys() ), { "success", "P", "primitiveVariables", "curveIndex", "v" } )
+
+			result = e.createResult()
+			for i, point in enumerate( points ) :
+				self.assertTrue( e.closestPoint( point, result ) )
+				self.assertTrue( results["success"][i] )
+				self.assertEqual( results["P"][i], result.point() )
+				self.assertEqual( results["curveIndex"][i], result.curveIndex() )
+				self.assertEqual( results["v"][i], result.uv()[1] )
+
 	def testPinnedCurves( self ) :
 
 		curves = IECoreScene.CurvesPrimitive(
@@ -459,6 +459,14 @@ class LinkedSceneTest( unittest.TestCase ) :
 		self.assertEqual( Aa.readTransformAsMatrix( 0.0 ), A.readTransformAsMatrix( 0.8 / 8 ) )
 		self.assertEqual( Aa.readTransformAsMatrix( 0.0 ), A.readTransformAsMatrix( 0.9 / 8 ) )
 
+		# same again, but navigating with scene():
+		A = l.scene( [ "transform2", "instance2", "A" ] )
+		for t in range( 1, 10 ) :
+			self.assertEqual( Aa.readTransformAsMatrix( 0.0 ), A.readTransformAsMatrix( t / 80.0 ) )
+
+		i2 = l.scene( [ "transform2", "instance2" ] )
+		self.assertEqual( i2.readBound( 0.5 / 8 ), m.readBound( 0.0 ) )
+
 
 	def readSavedScenes( self, fileVersion ):
 
@@ -1176,6 +1184,97 @@ class LinkedSceneTest( unittest.TestCase ) :
 		self.assertEqual( r.readSet( "don" ), IECore.PathMatcher(['/C', '/C/D/A'] ) )
 		self.assertEqual( r.readSet( "stew" ), IECore.PathMatcher(['/C/D/A/B'] ) )
 
+	def testResolveLinks( self ) :
+
+		m = IECoreScene.SceneCache( os.path.join( "test", "IECore", "data", "sccFiles", "animatedSpheres.scc" ), IECore.IndexedIO.OpenMode.Read )
+
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 20 ) :
+			g = l.createChild( "group%d" % i )
+			i0 = g.createChild( "instance0" )
+			i0.writeLink( m )
+			i1 = g.createChild( "instance1" )
+			i1.writeAttribute( IECoreScene.LinkedScene.linkAttribute, IECoreScene.LinkedScene.linkAttributeData( m, 0.0 ), 0.0 )
+			i1.writeAttribute( IECoreScene.LinkedScene.linkAttribute, IECoreScene.LinkedScene.linkAttributeData( m, 0.5 ), 1.0 )
+			i1.writeAttribute( IECoreScene.LinkedScene.linkAttribute, IECoreScene.LinkedScene.linkAttributeData( m, 1.0 ), 2.0 )
+			del i0, i1, g
+
+		del l
+
+		def assertLinksExpanded( l ) :
+
+			for i in range( 0, 20 ) :
+
+				g = l.child( "group%d" % i )
+				self.assertEqual( g.child( "instance0" ).childNames(), m.childNames() )
+				self.assertEqual(
+					g.child( "instance0" ).child( "A" ).readTransformAtSample( 1 ),
+					m.child( "A" ).readTransformAtSample( 1 )
+				)
+
+				A = g.child( "instance1" ).child( "A" )
+				self.assertEqual( A.numTransformSamples(), 3 )
+				self.assertEqual( A.readTransform( 1.0 ), IECore.M44dData( imath.M44d().translate( imath.V3d( 1.5, 0, 0 ) ) ) )
+				self.assertEqual( A.readTransformAtSample( 2 ), IECore.M44dData( imath.M44d().translate( imath.V3d( 2, 0, 0 ) ) ) )
+
+				self.assertEqual(
+					l.scene( [ "group%d" % i, "instance1", "A" ] ).readTransform( 1.0 ),
+					A.readTransform( 1.0 )
+				)
+
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Read )
+		assertLinksExpanded( l )
+
+		IECoreScene.SharedSceneInterfaces.clear()
+
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Read )
+		l.resolveLinks()
+		assertLinksExpanded( l )
+
+		# Resolving twice is harmless.
+		l.child( "group0" ).resolveLinks()
+		assertLinksExpanded( l )
+
+		canceller = IECore.Canceller()
+		canceller.cancel()
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Read )
+		with self.assertRaises( IECore.Cancelled ) :
+			l.resolveLinks( canceller )
+
+		w = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test2.lscc" ), IECore.IndexedIO.OpenMode.Write )
+		with self.assertRaises( RuntimeError ) :
+			w.resolveLinks()
+
+	def testResolvedLinksDontHoldScenes( self ) :
+
+		m = IECoreScene.SceneCache( os.path.join( "test", "IECore", "data", "sccFiles", "animatedSpheres.scc" ), IECore.IndexedIO.OpenMode.Read )
+
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Write )
+		l.createChild( "group" ).createChild( "instance" ).writeLink( m )
+		del l
+
+		IECoreScene.SharedSceneInterfaces.clear()
+
+		l = IECoreScene.LinkedScene( os.path.join( self.tempDir, "test.lscc" ), IECore.IndexedIO.OpenMode.Read )
+		l.resolveLinks()
+		self.assertEqual( IECoreScene.SharedSceneInterfaces.numScenes(), 1 )
+
+		# Clearing SharedSceneInterfaces releases the linked scene, and it is
+		# retrieved from there again the next time the link is visited.
+
+		IECoreScene.SharedSceneInterfaces.clear()
+		self.assertEqual( IECoreScene.SharedSceneInterfaces.numScenes(), 0 )
+
+		self.assertEqual( l.scene( [ "group", "instance" ] ).childNames(), m.childNames() )
+		self.assertEqual( IECoreScene.SharedSceneInterfaces.numScenes(), 1 )
+
+		IECoreScene.SharedSceneInterfaces.clear()
+		self.assertEqual( l.child( "group" ).child( "instance" ).childNames(), m.childNames() )
+		self.assertEqual( IECoreScene.SharedSceneInterfaces.numScenes(), 1 )
+
+		# Locations which aren't links are unaffected.
+		self.assertEqual( l.child( "group" ).childNames(), [ "instance" ] )
+
 	def testPathIsNative( self ):
 
 		targetSceneFile = os.path.join( self.tempDir, "target.scc" )
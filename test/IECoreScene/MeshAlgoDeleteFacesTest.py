@@ -390,5 +390,27 @@ class MeshAlgoDeleteFacesTest( unittest.TestCase ) :
 
 		self.assertRaises( RuntimeError, IECoreScene.MeshAlgo.deleteFaces, planeMesh, primvarDelete  )
 
+	def testLargeMesh( self ) :
+
+		# Large enough to be processed in many parallel chunks.
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ), imath.V2i( 300 ) )
+		mesh["delete"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.IntVectorData( [ 1 if i % 3 == 0 else 0 for i in range( mesh.numFaces() ) ] )
+		)
+
+		facesDeletedMesh = IECoreScene.MeshAlgo.deleteFaces( mesh, mesh["delete"] )
+		self.assertTrue( facesDeletedMesh.arePrimitiveVariablesValid() )
+
+		# MeshSplitter provides an independent implementation to compare against.
+		reference = IECoreScene.MeshAlgo.MeshSplitter( mesh, mesh["delete"] ).mesh( 0 )
+
+		self.assertEqual( facesDeletedMesh.numFaces(), reference.numFaces() )
+		self.assertEqual( facesDeletedMesh.verticesPerFace, reference.verticesPerFace )
+		self.assertEqual( facesDeletedMesh.vertexIds, reference.vertexIds )
+		self.assertEqual( facesDeletedMesh["P"], reference["P"] )
+		self.assertEqual( facesDeletedMesh["N"], reference["N"] )
+		self.assertEqual( facesDeletedMesh["uv"].expandedData(), reference["uv"].expandedData() )
+
 if __name__ == "__main__":
 	unittest.main()
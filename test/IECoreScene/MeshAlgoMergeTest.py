@@ -230,5 +230,26 @@ class MeshAlgoMergeTest( unittest.TestCase ) :
 		self.assertEqual( merged.creaseIds(), IECore.IntVectorData( [ 1, 2, 3, 4, 5, 9, 10, 11, 12, 13, 14, 15 ] ) )
 		self.assertEqual( merged.creaseSharpnesses(), IECore.FloatVectorData( [ 1, 5, 3, 2, 0.5 ] ) )
 
+	def testGeometricInterpretationAndBools( self ) :
+
+		meshes = []
+		for i in range( 0, 100 ) :
+			m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( i ), imath.V2f( i + 1 ) ) )
+			m["flag"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+				IECore.BoolVectorData( [ i % 2 == 0 ] )
+			)
+			meshes.append( m )
+
+		merged = IECoreScene.MeshAlgo.merge( meshes )
+		self.assertTrue( merged.arePrimitiveVariablesValid() )
+		self.assertEqual( merged.numFaces(), 100 )
+		self.assertEqual( merged["N"].data.getInterpretation(), IECore.GeometricData.Interpretation.Normal )
+		self.assertEqual( merged["uv"].data.getInterpretation(), IECore.GeometricData.Interpretation.UV )
+		self.assertEqual( merged["flag"].data, IECore.BoolVectorData( [ i % 2 == 0 for i in range( 0, 100 ) ] ) )
+
+		for i in range( 0, 100 ) :
+			self.assertEqual( merged["P"].data[i*4], imath.V3f( i, i, 0 ) )
+
 if __name__ == "__main__" :
 	unittest.main()
@@ -37,6 +37,7 @@ import IECore
 
 import imath
 import os
+import random
 
 import unittest
 
@@ -292,5 +293,138 @@ class MeshAlgoReorderTest( unittest.TestCase ) :
 		self.assertEqual( m.creaseIds(), IECore.IntVectorData( [ 1, 2, 3, 5, 7 ] ) )
 		self.assertEqual( m.creaseSharpnesses(), IECore.FloatVectorData( creaseSharpnesses ) )
 
+	def testLargeMesh( self ) :
+
+		# Large enough to have overflowed the stack when faces
+		# were visited recursively.
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ), imath.V2i( 300 ) )
+		m["faceIndex"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying, IECore.IntVectorData( range( 0, m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) ) ) )
+
+		m2 = m.copy()
+		IECoreScene.MeshAlgo.reorderVertices( m, 301, 302, 603 )
+		self.assertTrue( m.arePrimitiveVariablesValid() )
+
+		# Face-varying data must follow the vertices it belongs to.
+		uvs = m["uv"].expandedData()
+		faceIndex = m["faceIndex"].data
+		for i, vertexId in enumerate( m.vertexIds ) :
+			p = m["P"].data[vertexId]
+			self.assertEqual( uvs[i], imath.V2f( p.x, p.y ) )
+			self.assertEqual( m2["P"].data[m2.vertexIds[faceIndex[i]]], p )
+
+		IECoreScene.MeshAlgo.reorderVertices( m2, 301, 302, 603, topology = IECoreScene.MeshAlgo.topology( m2 ) )
+		self.assertEqual( m2, m )
+
+		# A topology from a different mesh must be rejected rather than used.
+		otherTopology = IECoreScene.MeshAlgo.topology( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ), imath.V2i( 2 ) ) )
+		with self.assertRaisesRegex( Exception, "MeshTopology .* does not match MeshPrimitive" ) :
+			IECoreScene.MeshAlgo.reorderVertices( m2.copy(), 301, 302, 603, topology = otherTopology )
+
+	@staticmethod
+	def __averageCacheMissRatio( mesh, cacheSize = 16 ) :
+
+		# Simulates a FIFO vertex cache.
+		cache = []
+		misses = 0
+		for v in mesh.vertexIds :
+			if v not in cache :
+				misses += 1
+				cache.append( v )
+				if len( cache ) > cacheSize :
+					cache.pop( 0 )
+
+		return misses / float( mesh.numFaces() )
+
+	def __shuffledMesh( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ), imath.V2i( 30 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+
+		faces = list( range( 0, m.numFaces() ) )
+		random.Random( 0 ).shuffle( faces )
+		vertexIds = [ m.vertexIds[f*3+i] for f in faces for i in range( 0, 3 ) ]
+
+		result = IECoreScene.MeshPrimitive( IECore.IntVectorData( [ 3 ] * len( faces ) ), IECore.IntVectorData( vertexIds ), "linear", m["P"].data.copy() )
+		result["faceId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( faces ) )
+		result["vertexId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( range( 0, result.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) ) ) )
+		result["cornerP"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying, IECore.V3fVectorData( [ m["P"].data[v] for v in vertexIds ] ) )
+		self.assertTrue( result.arePrimitiveVariablesValid() )
+
+		return result
+
+	def __assertSameGeometry( self, mesh, original ) :
+
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+		self.assertEqual( mesh.numFaces(), original.numFaces() )
+		self.assertEqual( sorted( mesh["faceId"].data ), sorted( original["faceId"].data ) )
+		self.assertEqual( sorted( mesh["vertexId"].data ), list( original["vertexId"].data ) )
+
+		for v, originalV in enumerate( mesh["vertexId"].data ) :
+			self.assertEqual( mesh["P"].data[v], original["P"].data[originalV] )
+
+		# Face-varying data must follow the face-vertices it belongs to.
+		for i, v in enumerate( mesh.vertexIds ) :
+			self.assertEqual( mesh["cornerP"].data[i], mesh["P"].data[v] )
+
+		# And each face must reference the same vertices as before.
+		originalFaces = {
+			original["faceId"].data[f] : [ original.vertexIds[f*3+i] for i in range( 0, 3 ) ]
+			for f in range( 0, original.numFaces() )
+		}
+		for f in range( 0, mesh.numFaces() ) :
+			self.assertEqual(
+				[ mesh["vertexId"].data[mesh.vertexIds[f*3+i]] for i in range( 0, 3 ) ],
+				originalFaces[mesh["faceId"].data[f]]
+			)
+
+	def testOptimizeVertexCache( self ) :
+
+		m = self.__shuffledMesh()
+
+		m2 = m.copy()
+		IECoreScene.MeshAlgo.optimizeVertexCache( m2 )
+		self.__assertSameGeometry( m2, m )
+
+		self.assertLess( self.__averageCacheMissRatio( m2 ), 1.0 )
+		self.assertLess( self.__averageCacheMissRatio( m2 ), self.__averageCacheMissRatio( m ) / 2 )
+
+		# Vertices are numbered in order of first use.
+		firstUses = []
+		for v in m2.vertexIds :
+			if v not in firstUses :
+				firstUses.append( v )
+		self.assertEqual( firstUses, list( range( 0, len( firstUses ) ) ) )
+
+		m3 = m.copy()
+		IECoreScene.MeshAlgo.optimizeVertexCache( m3, topology = IECoreScene.MeshAlgo.topology( m3 ) )
+		self.assertEqual( m3, m2 )
+
+		with self.assertRaisesRegex( Exception, "Cache size" ) :
+			IECoreScene.MeshAlgo.optimizeVertexCache( m.copy(), cacheSize = 2 )
+
+		otherTopology = IECoreScene.MeshAlgo.topology( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ) ) )
+		with self.assertRaisesRegex( Exception, "MeshTopology .* does not match MeshPrimitive" ) :
+			IECoreScene.MeshAlgo.optimizeVertexCache( m.copy(), topology = otherTopology )
+
+	def testReorderForLocality( self ) :
+
+		m = self.__shuffledMesh()
+
+		m2 = m.copy()
+		IECoreScene.MeshAlgo.reorderForLocality( m2 )
+		self.__assertSameGeometry( m2, m )
+
+		# Faces are now in spatial order, so make better
+		# use of a cache than the shuffled faces.
+		self.assertLess( self.__averageCacheMissRatio( m2 ), self.__averageCacheMissRatio( m ) )
+
+		# Reordering is stable, so a second pass does nothing.
+		m3 = m2.copy()
+		IECoreScene.MeshAlgo.reorderForLocality( m3 )
+		self.assertEqual( m3, m2 )
+
+		with self.assertRaisesRegex( Exception, "no Vertex \"Pref\" primitive variable" ) :
+			IECoreScene.MeshAlgo.reorderForLocality( m.copy(), "Pref" )
+
 if __name__ == "__main__":
     unittest.main()
@@ -423,5 +423,52 @@ class MeshAlgoResampleTest( unittest.TestCase ) :
 				for v in pv.data :
 					self.assertEqual( v, imath.V2f( 0 ) )
 
+	def testResamplePrimitiveVariables( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 200 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+		for interpolation in ( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) :
+			m[str( interpolation )] = IECoreScene.PrimitiveVariable(
+				interpolation,
+				IECore.V3fVectorData( [ imath.V3f( i, i * 0.5, -i ) for i in range( 0, m.variableSize( interpolation ) ) ] )
+			)
+		names = [ str( i ) for i in ( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) ]
+
+		topology = IECoreScene.MeshAlgo.topology( m )
+		for interpolation in ( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) :
+
+			expected = {}
+			for name in names :
+				p = IECoreScene.PrimitiveVariable( m[name] )
+				IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, p, interpolation )
+				expected[name] = p
+
+				# Results must be identical when the topology is provided.
+				p = IECoreScene.PrimitiveVariable( m[name] )
+				IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, p, interpolation, topology = topology )
+				self.assertEqual( p, expected[name] )
+
+			m2 = m.copy()
+			IECoreScene.MeshAlgo.resamplePrimitiveVariables( m2, names, interpolation )
+			for name in names :
+				self.assertEqual( m2[name], expected[name] )
+				self.assertEqual( m2[name].interpolation, interpolation )
+			self.assertTrue( m2.arePrimitiveVariablesValid() )
+
+		self.assertRaises( Exception, IECoreScene.MeshAlgo.resamplePrimitiveVariables, m.copy(), [ "notAVariable" ], IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+
+	def testMismatchedTopology( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 4 ) )
+		m["v"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.FloatVectorData( [ 1 ] * m.numFaces() ) )
+		topology = IECoreScene.MeshAlgo.topology( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 2 ) ) )
+
+		p = IECoreScene.PrimitiveVariable( m["v"] )
+		with self.assertRaisesRegex( Exception, "MeshTopology .* does not match MeshPrimitive" ) :
+			IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, p, IECoreScene.PrimitiveVariable.Interpolation.Vertex, topology = topology )
+
+		with self.assertRaisesRegex( Exception, "MeshTopology .* does not match MeshPrimitive" ) :
+			IECoreScene.MeshAlgo.resamplePrimitiveVariables( m, [ "v" ], IECoreScene.PrimitiveVariable.Interpolation.Vertex, topology = topology )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -60,6 +60,9 @@ class MeshAlgoSplitTest( unittest.TestCase ) :
 			self.assertEqual( key, m[primVarName].data[0] )
 			result.append( ( key, m ) )
 
+		# The bulk API should give identical results
+		self.assertEqual( splitter.meshes(), [ m for key, m in result ] )
+
 		# While we want to encourage the MeshSplitter API now, I suppose we should still check that
 		# that the segment call works
 		self.assertEqual( result, self.splitAllDeprecated( mesh, primVarName ) )
@@ -48,6 +48,7 @@ from MeshAlgoTriangulateTest import MeshAlgoTriangulateTest
 from MeshAlgoConnectedVerticesTest import MeshAlgoConnectedVerticesTest
 from MeshAlgoNormalsTest import MeshAlgoNormalsTest
 from MeshAlgoSplitTest import MeshAlgoSplitTest
+from MeshAlgoTopologyTest import MeshAlgoTopologyTest
 
 if __name__ == "__main__":
 	unittest.main()
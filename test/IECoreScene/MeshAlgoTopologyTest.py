@@ -0,0 +1,147 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+import imath
+
+import IECore
+import IECoreScene
+
+class MeshAlgoTopologyTest( unittest.TestCase ) :
+
+	def generateTestMesh( self ) :
+
+		#  3_ _2 _5
+		#  |   |\ |
+		#  |_ _|_\|
+		#  0   1  4
+
+		p = IECore.V3fVectorData( [
+			imath.V3f( 0, 0, 0 ), imath.V3f( 2, 0, 0 ), imath.V3f( 2, 2, 0 ),
+			imath.V3f( 0, 2, 0 ), imath.V3f( 3, 0, 0 ), imath.V3f( 3, 2, 0 ),
+		] )
+
+		return IECoreScene.MeshPrimitive( IECore.IntVectorData( [ 4, 3, 3 ] ), IECore.IntVectorData( [ 0, 1, 2, 3, 1, 4, 2, 4, 5, 2 ] ), "linear", p )
+
+	def testTopology( self ) :
+
+		m = self.generateTestMesh()
+		t = IECoreScene.MeshAlgo.MeshTopology( m )
+
+		self.assertEqual( t.numFaces(), 3 )
+		self.assertEqual( t.numVertices(), 6 )
+		self.assertEqual( t.numFaceVertices(), 10 )
+		self.assertEqual( t.numEdges(), 8 )
+
+		self.assertEqual( t.faceOffsets(), IECore.IntVectorData( [ 0, 4, 7, 10 ] ) )
+		self.assertEqual( t.faceVertexFaces(), IECore.IntVectorData( [ 0, 0, 0, 0, 1, 1, 1, 2, 2, 2 ] ) )
+		self.assertEqual( t.vertexFaceVertexOffsets(), IECore.IntVectorData( [ 0, 1, 3, 6, 7, 9, 10 ] ) )
+		self.assertEqual( t.vertexFaceVertices(), IECore.IntVectorData( [ 0, 1, 4, 2, 6, 9, 3, 5, 7, 8 ] ) )
+
+		self.assertEqual(
+			t.edges(),
+			IECore.V2iVectorData( [
+				imath.V2i( 0, 1 ), imath.V2i( 1, 2 ), imath.V2i( 2, 3 ), imath.V2i( 0, 3 ),
+				imath.V2i( 1, 4 ), imath.V2i( 2, 4 ), imath.V2i( 4, 5 ), imath.V2i( 2, 5 )
+			] )
+		)
+		self.assertEqual( t.faceVertexEdges(), IECore.IntVectorData( [ 0, 1, 2, 3, 4, 5, 1, 6, 7, 5 ] ) )
+		self.assertEqual( t.oppositeFaceVertices(), IECore.IntVectorData( [ -1, 6, -1, -1, -1, 9, 1, -1, -1, 5 ] ) )
+
+	def testOppositesAreSymmetric( self ) :
+
+		m = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 12, 8 ) )
+		t = IECoreScene.MeshAlgo.MeshTopology( m )
+
+		opposites = t.oppositeFaceVertices()
+		faceVertexEdges = t.faceVertexEdges()
+		for i, o in enumerate( opposites ) :
+			if o != -1 :
+				self.assertEqual( opposites[o], i )
+				self.assertEqual( faceVertexEdges[o], faceVertexEdges[i] )
+
+	def testMatchesExistingAdjacency( self ) :
+
+		for m in [
+			self.generateTestMesh(),
+			IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 7, 7 ) ),
+			IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) ),
+		] :
+			t = IECoreScene.MeshAlgo.MeshTopology( m )
+			self.assertEqual(
+				IECoreScene.MeshAlgo.connectedVertices( m, topology = t ),
+				IECoreScene.MeshAlgo.connectedVertices( m )
+			)
+			self.assertEqual(
+				IECoreScene.MeshAlgo.correspondingFaceVertices( m, topology = t ),
+				IECoreScene.MeshAlgo.correspondingFaceVertices( m )
+			)
+			self.assertEqual(
+				IECoreScene.MeshAlgo.calculateFaceVaryingNormals( m, thresholdAngle = 30, topology = t ),
+				IECoreScene.MeshAlgo.calculateFaceVaryingNormals( m, thresholdAngle = 30 )
+			)
+
+	def testMismatchedTopology( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 4 ) )
+		m["N"] = IECoreScene.MeshAlgo.calculateNormals( m )
+		t = IECoreScene.MeshAlgo.topology( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 2 ) ) )
+
+		for f, name in [
+			( lambda : IECoreScene.MeshAlgo.connectedVertices( m, topology = t ), "connectedVertices" ),
+			( lambda : IECoreScene.MeshAlgo.correspondingFaceVertices( m, topology = t ), "correspondingFaceVertices" ),
+			( lambda : IECoreScene.MeshAlgo.calculateFaceVaryingNormals( m, thresholdAngle = 30, topology = t ), "calculateFaceVaryingNormals" ),
+			( lambda : IECoreScene.MeshAlgo.calculateTangentsFromFirstEdge( m, topology = t ), "calculateTangentsFromFirstEdge" ),
+			( lambda : IECoreScene.MeshAlgo.calculateTangentsFromTwoEdges( m, topology = t ), "calculateTangentsFromTwoEdges" ),
+		] :
+			with self.assertRaisesRegex( Exception, "MeshAlgo::{} : MeshTopology .* does not match MeshPrimitive".format( name ) ) :
+				f()
+
+	def testCache( self ) :
+
+		m = self.generateTestMesh()
+		t = IECoreScene.MeshAlgo.topology( m )
+		self.assertEqual( t.edges(), IECoreScene.MeshAlgo.MeshTopology( m ).edges() )
+
+		# Meshes with the same topology share the same MeshTopology.
+		m2 = m.copy()
+		m2["P"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 6 ) ] ) )
+		self.assertTrue( IECoreScene.MeshAlgo.topology( m2 ).isSame( t ) )
+
+		m3 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		self.assertFalse( IECoreScene.MeshAlgo.topology( m3 ).isSame( t ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -446,6 +446,111 @@ class TestMeshPrimitiveEvaluator( unittest.TestCase ) :
 		result = meshEvaluator.createResult()
 		self.assertAlmostEqual( meshEvaluator.signedDistance( imath.V3f( 0.23601509630680084, -0.5, 0.23528452217578888), result ), 0 )
 
+	def testLargeMesh( self ) :
+
+		# Enough triangles to give a deep hierarchy, on a surface where
+		# the expected results are known exactly.
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 200 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+		mpe = IECoreScene.MeshPrimitiveEvaluator( m )
+		r = mpe.createResult()
+
+		rand = imath.Rand48( 10 )
+		for i in range( 0, 1000 ) :
+
+			p = imath.V3f( rand.nextf( -1.5, 1.5 ), rand.nextf( -1.5, 1.5 ), rand.nextf( -1, 1 ) )
+			expected = imath.V3f( min( max( p.x, -1 ), 1 ), min( max( p.y, -1 ), 1 ), 0 )
+
+			self.assertTrue( mpe.closestPoint( p, r ) )
+			self.assertTrue( r.point().equalWithAbsError( expected, 1e-5 ) )
+
+			direction = imath.V3f( 0, 0, -1 if p.z > 0 else 1 )
+			hit = mpe.intersectionPoint( p, direction, r )
+			hits = mpe.intersectionPoints( p, direction )
+			missHits = mpe.intersectionPoints( p, -direction )
+			self.assertFalse( missHits )
+
+			if abs( p.x ) < 0.999 and abs( p.y ) < 0.999 :
+				self.assertTrue( hit )
+				self.assertTrue( r.point().equalWithAbsError( expected, 1e-5 ) )
+				self.assertEqual( len( hits ), 1 )
+				self.assertTrue( hits[0].point().equalWithAbsError( expected, 1e-5 ) )
+				self.assertEqual( hits[0].triangleIndex(), r.triangleIndex() )
+				# Hits beyond the maximum distance are ignored.
+				self.assertFalse( mpe.intersectionPoint( p, direction, r, abs( p.z ) * 0.5 ) )
+			elif abs( p.x ) > 1.001 or abs( p.y ) > 1.001 :
+				self.assertFalse( hit )
+				self.assertFalse( hits )
+
+	def testBatchQueries( self ) :
+
+		m = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 30 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+		m["Cs"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.Color3fVectorData( [ imath.Color3f( i ) for i in range( 0, m.numFaces() ) ] )
+		)
+		mpe = IECoreScene.MeshPrimitiveEvaluator( m )
+		r = mpe.createResult()
+
+		rand = imath.Rand48( 1 )
+		points = IECore.V3fVectorData( [ rand.nextSolidSphere( imath.V3f() ) * 2 for i in range( 0, 1000 ) ] )
+		directions = IECore.V3fVectorData( [ rand.nextHollowSphere( imath.V3f() ) for i in range( 0, 1000 ) ] )
+
+		# Closest points
+
+		results = mpe.closestPoints( points, [ "Cs" ] )
+		self.assertEqual( set( results.keys() ), { "success", "P", "N", "uv", "triangleIndex", "barycentricCoordinates", "primitiveVariables" } )
+		self.assertEqual( results["P"].getInterpretation(), IECore.GeometricData.Interpretation.Point )
+
+		for i, p in enumerate( points ) :
+			self.assertTrue( mpe.closestPoint( p, r ) )
+			self.assertTrue( results["success"][i] )
+			self.assertEqual( results["P"][i], r.point() )
+			self.assertEqual( results["N"][i], r.normal() )
+			self.assertEqual( results["uv"][i], r.uv() )
+			self.assertEqual( results["triangleIndex"][i], r.triangleIndex() )
+			self.assertEqual( results["barycentricCoordinates"][i], r.barycentricCoordinates() )
+			self.assertEqual( results["primitiveVariables"]["Cs"][i], r.colorPrimVar( m["Cs"] ) )
+
+		# Rays
+
+		results = mpe.intersectRays( points, directions )
+		for i in range( 0, len( points ) ) :
+			hit = mpe.intersectionPoint( points[i], directions[i], r )
+			self.assertEqual( results["success"][i], hit )
+			if hit :
+				self.assertEqual( results["P"][i], r.point() )
+				self.assertEqual( results["triangleIndex"][i], r.triangleIndex() )
+			else :
+				self.assertEqual( results["triangleIndex"][i], -1 )
+
+		results = mpe.intersectRays( points, directions, maxDistance = 0.01 )
+		for i in range( 0, len( points ) ) :
+			self.assertEqual( results["success"][i], mpe.intersectionPoint( points[i], directions[i], r, 0.01 ) )
+
+		# UVs
+
+		uvs = IECore.V2fVectorData( [ imath.V2f( rand.nextf( 0.01, 0.99 ), rand.nextf( 0.01, 0.99 ) ) for i in range( 0, 100 ) ] )
+		results = mpe.pointsAtUV( uvs )
+		for i, uv in enumerate( uvs ) :
+			self.assertEqual( results["success"][i], mpe.pointAtUV( uv, r ) )
+			if results["success"][i] :
+				self.assertEqual( results["P"][i], r.point() )
+
+		# Errors
+
+		with self.assertRaisesRegex( Exception, 'Primitive variable "notHere" does not exist' ) :
+			mpe.closestPoints( points, [ "notHere" ] )
+
+		with self.assertRaisesRegex( Exception, r"Number of origins \(1000\) does not match number of directions \(1\)" ) :
+			mpe.intersectRays( points, IECore.V3fVectorData( [ imath.V3f( 1, 0, 0 ) ] ) )
+
+		canceller = IECore.Canceller()
+		canceller.cancel()
+		with self.assertRaises( IECore.Cancelled ) :
+			mpe.closestPoints( points, canceller = canceller )
+
 if __name__ == "__main__":
 	unittest.main()
 
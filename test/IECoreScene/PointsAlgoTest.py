@@ -593,6 +593,40 @@ class MergePointsTest( unittest.TestCase ) :
 		self.assertEqual( mergedPoints["foo"].data[6], 0 )
 		self.assertEqual( mergedPoints["foo"].data[7], 0 )
 
+	def testIndexedPrimvarIsExpanded( self ) :
+		pointsA = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 2 )] ) )
+		pointsB = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 4 )] ) )
+		pointsC = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 3 )] ) )
+
+		pointsA["foo"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [1, 2] ) )
+		pointsB["foo"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( [10, 20] ),
+			IECore.IntVectorData( [1, 0, 0, 1] )
+		)
+		pointsC["foo"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [3, 4, 5] ) )
+
+		mergedPoints = IECoreScene.PointsAlgo.mergePoints( [pointsA, pointsB, pointsC] )
+
+		self.assertTrue( mergedPoints.arePrimitiveVariablesValid() )
+		self.assertEqual( mergedPoints["foo"].interpolation, IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+		self.assertIsNone( mergedPoints["foo"].indices )
+		self.assertEqual( mergedPoints["foo"].data, IECore.IntVectorData( [1, 2, 20, 10, 10, 20, 3, 4, 5] ) )
+
+		# Indexed data that needs converting to the type of the first primitive.
+
+		pointsB["foo"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( [10, 20] ),
+			IECore.IntVectorData( [1, 1, 0, 1] )
+		)
+
+		mergedPoints = IECoreScene.PointsAlgo.mergePoints( [pointsA, pointsB, pointsC] )
+
+		self.assertTrue( mergedPoints.arePrimitiveVariablesValid() )
+		self.assertIsNone( mergedPoints["foo"].indices )
+		self.assertEqual( mergedPoints["foo"].data, IECore.IntVectorData( [1, 2, 20, 20, 10, 20, 3, 4, 5] ) )
+
 	def testConvertsTypesIfPossible( self ) :
 		pointsA = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 4 )] ) )
 		pointsB = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 4 )] ) )
@@ -726,6 +760,34 @@ class SegmentPointsTest( unittest.TestCase ) :
 		self.assertEqual( len(segments[0]["P"].data), 25 )
 		self.assertEqual( len(segments[1]["P"].data), 25 )
 
+class ReorderPointsTest( unittest.TestCase ) :
+
+	def testReorderForLocality( self ) :
+
+		positions = [ imath.V3f( ( i * 37 ) % 101, ( i * 53 ) % 97, ( i * 17 ) % 89 ) for i in range( 0, 1000 ) ]
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( positions ) )
+		points["id"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( range( 0, 1000 ) ) )
+		points["s"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.StringVectorData( [ "a", "b" ] ), IECore.IntVectorData( [ i % 2 for i in range( 0, 1000 ) ] ) )
+		points["c"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Constant, IECore.IntData( 10 ) )
+
+		reordered = points.copy()
+		IECoreScene.PointsAlgo.reorderForLocality( reordered )
+		self.assertTrue( reordered.arePrimitiveVariablesValid() )
+		self.assertNotEqual( reordered["id"].data, points["id"].data )
+		self.assertEqual( sorted( reordered["id"].data ), list( range( 0, 1000 ) ) )
+
+		for i, id in enumerate( reordered["id"].data ) :
+			self.assertEqual( reordered["P"].data[i], positions[id] )
+			self.assertEqual( reordered["s"].data[reordered["s"].indices[i]], "ab"[id % 2] )
+
+		# Indexed data is shared, with only the indices reordered.
+		self.assertEqual( reordered["s"].data, points["s"].data )
+		self.assertEqual( reordered["c"], points["c"] )
+
+		# Reordering is stable, so a second pass does nothing.
+		reordered2 = reordered.copy()
+		IECoreScene.PointsAlgo.reorderForLocality( reordered2 )
+		self.assertEqual( reordered2, reordered )
 
 if __name__ == "__main__":
 	unittest.main()
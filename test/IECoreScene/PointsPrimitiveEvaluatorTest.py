@@ -34,6 +34,7 @@
 
 from __future__ import with_statement
 
+import random
 import unittest
 import imath
 
@@ -77,6 +78,35 @@ class PointsPrimitiveEvaluatorTest( unittest.TestCase ) :
 		self.assertEqual( r.colorPrimVar( p["Cs"] ), imath.Color3f( 5, 0, 0 ) )
 		self.assertEqual( r.stringPrimVar( p["names"] ), "a" )
 
+	def testBatchQueries( self ) :
+
+		rand = random.Random( 0 )
+		positions = IECore.V3fVectorData( [ imath.V3f( rand.uniform( -1, 1 ), rand.uniform( -1, 1 ), rand.uniform( -1, 1 ) ) for i in range( 0, 1000 ) ] )
+		p = IECoreScene.PointsPrimitive( positions )
+		p["Cs"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.Color3fVectorData( [ imath.Color3f( i ) for i in range( 0, 1000 ) ] ) )
+
+		e = IECoreScene.PointsPrimitiveEvaluator( p )
+		r = e.createResult()
+
+		queries = IECore.V3fVectorData( [ imath.V3f( rand.uniform( -2, 2 ), rand.uniform( -2, 2 ), rand.uniform( -2, 2 ) ) for i in range( 0, 10000 ) ] )
+		results = e.closestPoints( queries, [ "Cs" ] )
+		self.assertEqual( set( results.keys() ), { "success", "P", "pointIndex", "primitiveVariables" } )
+		for i, q in enumerate( queries ) :
+			self.assertEqual( results["success"][i], e.closestPoint( q, r ) )
+			self.assertEqual( results["P"][i], r.point() )
+			self.assertEqual( results["pointIndex"][i], r.pointIndex() )
+			self.assertEqual( results["primitiveVariables"]["Cs"][i], r.colorPrimVar( p["Cs"] ) )
+
+		# Queries the evaluator doesn't support must raise cleanly,
+		# even though they are made from within a parallel loop.
+
+		uvs = IECore.V2fVectorData( [ imath.V2f( 0.5 ) ] * 10000 )
+		with self.assertRaisesRegex( Exception, "pointAtUV" ) :
+			e.pointsAtUV( uvs )
+
+		with self.assertRaisesRegex( Exception, "intersectionPoint" ) :
+			e.intersectRays( queries, IECore.V3fVectorData( [ imath.V3f( 0, 0, 1 ) ] * len( queries ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
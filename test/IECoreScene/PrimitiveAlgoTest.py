@@ -0,0 +1,132 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Cinesite VFX Ltd. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+import imath
+
+import IECore
+import IECoreScene
+
+class PrimitiveAlgoTest( unittest.TestCase ) :
+
+	def __mesh( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 40, 20 ) )
+		numVertices = mesh.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+
+		mesh["vector"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ) ] * numVertices, IECore.GeometricData.Interpretation.Vector )
+		)
+		mesh["pointD"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3dVectorData( [ imath.V3d( 1, 2, 3 ) ] * numVertices, IECore.GeometricData.Interpretation.Point )
+		)
+		mesh["color"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ) ] * numVertices, IECore.GeometricData.Interpretation.Color )
+		)
+
+		return mesh
+
+	def __assertTransformed( self, mesh, original, matrix ) :
+
+		expected = IECoreScene.TransformOp()(
+			input = original,
+			matrix = IECore.M44fData( matrix ),
+			primVarsToModify = IECore.StringVectorData( [ "P", "N", "vector", "pointD", "color" ] )
+		)
+
+		self.assertEqual( mesh.keys(), expected.keys() )
+		for name in mesh.keys() :
+			a = mesh[name].data
+			b = expected[name].data
+			self.assertEqual( len( a ), len( b ) )
+			for i in range( 0, len( a ) ) :
+				self.assertTrue( a[i].equalWithAbsError( b[i], 0.00001 ), "{} [{}] : {} != {}".format( name, i, a[i], b[i] ) )
+
+	def testTransform( self ) :
+
+		matrix = imath.M44f().translate( imath.V3f( 1, 2, 3 ) ).rotate( imath.V3f( 0.1, 0.2, 0.3 ) ).scale( imath.V3f( 1, 2, 3 ) )
+
+		original = self.__mesh()
+		mesh = original.copy()
+		IECoreScene.PrimitiveAlgo.transform( mesh, matrix )
+
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+		self.__assertTransformed( mesh, original, matrix )
+
+		# Data which isn't transformable is left alone.
+		self.assertEqual( mesh["color"], original["color"] )
+		self.assertEqual( mesh["uv"], original["uv"] )
+
+	def testProjectiveMatrix( self ) :
+
+		matrix = imath.M44f()
+		matrix[0][3] = 0.1
+		matrix[3][3] = 2
+
+		original = self.__mesh()
+		mesh = original.copy()
+		IECoreScene.PrimitiveAlgo.transform( mesh, matrix )
+
+		self.__assertTransformed( mesh, original, matrix )
+
+	def testSharedData( self ) :
+
+		mesh = self.__mesh()
+		p = mesh["P"].data.copy()
+		mesh["P"] = IECoreScene.PrimitiveVariable( mesh["P"].interpolation, p )
+		mesh["Pref"] = IECoreScene.PrimitiveVariable( mesh["P"].interpolation, p )
+
+		IECoreScene.PrimitiveAlgo.transform( mesh, imath.M44f().translate( imath.V3f( 1 ) ) )
+
+		# Data referenced from outside the primitive must be copied
+		# rather than modified in place, and data shared between
+		# primitive variables must be transformed only once for each.
+		self.assertTrue( ( mesh["Pref"].data[0] - p[0] ).equalWithAbsError( imath.V3f( 1 ), 0.00001 ) )
+		self.assertEqual( mesh["P"].data, mesh["Pref"].data )
+		self.assertNotEqual( p, mesh["P"].data )
+
+	def testCancellation( self ) :
+
+		mesh = self.__mesh()
+		canceller = IECore.Canceller()
+		canceller.cancel()
+		with self.assertRaises( IECore.Cancelled ) :
+			IECoreScene.PrimitiveAlgo.transform( mesh, imath.M44f().translate( imath.V3f( 1 ) ), canceller )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -36,6 +36,7 @@
 import unittest
 import tempfile
 import os
+import json
 import shutil
 import IECore
 import IECoreScene
@@ -168,6 +169,255 @@ class SceneAlgoTest( unittest.TestCase ) :
 				self.assertEqual(stats["sets"], 0)
 				self.assertEqual(stats["attributes"], 4096 * 2 )  # default attribute & custom attribute 'foo'
 
+	def testParallelReadAllProfile( self ) :
+
+		self.writeSCC()
+		src = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+
+		profile = IECoreScene.SceneAlgo.ReadProfile()
+		stats = IECoreScene.SceneAlgo.parallelReadAll(
+			src, 1, 2, 1.0,
+			IECoreScene.SceneAlgo.ProcessFlags.Transforms | IECoreScene.SceneAlgo.ProcessFlags.Objects,
+			profile
+		)
+		self.assertEqual( stats["locations"], 6 )
+
+		events = profile.events()
+		# 3 transforms per frame, and 1 object per frame.
+		self.assertEqual( len( events ), 8 )
+		self.assertEqual(
+			sorted( [ e.path for e in events if e.component == IECoreScene.SceneAlgo.ProcessFlags.Objects ] ),
+			[ "/t/s", "/t/s" ]
+		)
+		self.assertEqual( { e.time for e in events }, { 1.0, 2.0 } )
+		self.assertEqual( sorted( [ e.start for e in events ] ), [ e.start for e in events ] )
+
+		for e in events :
+			self.assertGreaterEqual( e.duration, 0 )
+			if e.component == IECoreScene.SceneAlgo.ProcessFlags.Objects :
+				self.assertEqual( e.bytes, IECoreScene.SpherePrimitive( 1 ).memoryUsage() )
+
+		report = profile.report( 2 )
+		self.assertIn( "transform", report )
+		self.assertIn( "object", report )
+		self.assertIn( "/t/s", report )
+
+		traceFile = os.path.join( self.tempDir, "trace.json" )
+		profile.writeChromeTrace( traceFile )
+		with open( traceFile ) as f :
+			trace = json.load( f )
+
+		self.assertEqual( len( trace["traceEvents"] ), 8 )
+		self.assertEqual(
+			sorted( [ e["args"]["location"] for e in trace["traceEvents"] if e["name"] == "object" ] ),
+			[ "/t/s", "/t/s" ]
+		)
+
+		# Profile is cleared by subsequent calls.
+
+		IECoreScene.SceneAlgo.parallelReadAll( src, 1, 1, 1.0, IECoreScene.SceneAlgo.ProcessFlags.Bounds, profile )
+		self.assertEqual( len( profile.events() ), 3 )
+		self.assertEqual( { e.component for e in profile.events() }, { IECoreScene.SceneAlgo.ProcessFlags.Bounds } )
+
+	def testParallelTraverse( self ) :
+
+		self.writeSCC()
+		src = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+
+		visited = {}
+		def visitor( scene, components ) :
+			visited[IECoreScene.SceneInterface.pathToString( scene.path() )] = components.prefetched
+
+		IECoreScene.SceneAlgo.parallelTraverse( src, visitor )
+		self.assertEqual( visited, { "/" : 0, "/t" : 0, "/t/s" : 0 } )
+
+		# Prefetching
+
+		visited = {}
+		options = IECoreScene.SceneAlgo.ParallelTraverseOptions()
+		options.time = 1.0
+		options.prefetch = IECoreScene.SceneAlgo.ProcessFlags.Transforms | IECoreScene.SceneAlgo.ProcessFlags.Attributes | IECoreScene.SceneAlgo.ProcessFlags.Objects
+
+		def prefetchVisitor( scene, components ) :
+			path = IECoreScene.SceneInterface.pathToString( scene.path() )
+			visited[path] = (
+				components.transform,
+				components.attributes,
+				components.object
+			)
+
+		IECoreScene.SceneAlgo.parallelTraverse( src, prefetchVisitor, options )
+		self.assertEqual( visited["/t"][0], IECore.M44dData( imath.M44d().translate( imath.V3d( 1, 0, 0 ) ) ) )
+		self.assertEqual( visited["/t"][1]["wuh"], IECore.BoolData( True ) )
+		self.assertEqual( visited["/t"][2], None )
+		self.assertEqual( visited["/t/s"][1]["glah"], IECore.IntData( 15 ) )
+		self.assertIsInstance( visited["/t/s"][2], IECoreScene.SpherePrimitive )
+
+		# Components kept by the visitor remain valid after the traversal
+
+		kept = {}
+		def keepingVisitor( scene, components ) :
+			kept[IECoreScene.SceneInterface.pathToString( scene.path() )] = components
+
+		IECoreScene.SceneAlgo.parallelTraverse( src, keepingVisitor, options )
+		self.assertEqual( kept["/t"].transform, IECore.M44dData( imath.M44d().translate( imath.V3d( 1, 0, 0 ) ) ) )
+		self.assertEqual( kept["/t/s"].attributes["glah"], IECore.IntData( 15 ) )
+		self.assertIsInstance( kept["/t/s"].object, IECoreScene.SpherePrimitive )
+
+		# Pruning
+
+		visited = {}
+		def pruningVisitor( scene, components ) :
+			visited[IECoreScene.SceneInterface.pathToString( scene.path() )] = True
+			return scene.name() != "t"
+
+		IECoreScene.SceneAlgo.parallelTraverse( src, pruningVisitor )
+		self.assertEqual( set( visited.keys() ), { "/", "/t" } )
+
+		# Depth limit
+
+		visited = {}
+		options = IECoreScene.SceneAlgo.ParallelTraverseOptions()
+		options.maxDepth = 1
+		IECoreScene.SceneAlgo.parallelTraverse( src, pruningVisitor, options )
+		self.assertEqual( set( visited.keys() ), { "/", "/t" } )
+
+		# Exceptions
+
+		def throwingVisitor( scene, components ) :
+			if scene.name() == "s" :
+				raise RuntimeError( "Oops" )
+
+		with self.assertRaisesRegex( RuntimeError, "Oops" ) :
+			IECoreScene.SceneAlgo.parallelTraverse( src, throwingVisitor )
+
+		# Cancellation
+
+		canceller = IECore.Canceller()
+		canceller.cancel()
+		with self.assertRaises( IECore.Cancelled ) :
+			IECoreScene.SceneAlgo.parallelTraverse( src, visitor, canceller = canceller )
+
+	def testParallelTraverseConcurrency( self ) :
+
+		self.writeBigSCC()
+		src = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+
+		for maxConcurrency in ( 0, 1, 4 ) :
+
+			options = IECoreScene.SceneAlgo.ParallelTraverseOptions()
+			options.maxConcurrency = maxConcurrency
+			options.prefetch = IECoreScene.SceneAlgo.ProcessFlags.Bounds
+
+			paths = set()
+			def visitor( scene, components ) :
+				paths.add( IECoreScene.SceneInterface.pathToString( scene.path() ) )
+
+			IECoreScene.SceneAlgo.parallelTraverse( src, visitor, options )
+			self.assertEqual( len( paths ), 4096 + 2 )
+
+	def testDiff( self ) :
+
+		self.writeSCC()
+
+		m = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Write )
+		m.writeAttribute( "w", IECore.BoolData( True ), 1.0 )
+
+		t = m.createChild( "t" )
+		t.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( 1, 0, 0 ) ) ), 1.0 )
+		t.createChild( "u" )
+
+		s = t.createChild( "s" )
+		s.writeObject( IECoreScene.SpherePrimitive( 1 ), 1.0 )
+		s.writeAttribute( "glah", IECore.IntData( 16 ), 1.0 )
+
+		s.writeTags( ["tagA"] )
+
+		del s, t, m
+
+		a = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		b = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+
+		self.assertEqual( IECoreScene.SceneAlgo.diff( a, a, [ 1.0 ] ), [] )
+
+		changes = IECoreScene.SceneAlgo.diff( a, b, [ 1.0 ] )
+		self.assertEqual(
+			[ ( c.type, c.path, c.component, c.name ) for c in changes ],
+			[
+				( IECoreScene.SceneAlgo.SceneChange.Type.Removed, "/", IECoreScene.SceneAlgo.ProcessFlags.Sets, "tagB" ),
+				( IECoreScene.SceneAlgo.SceneChange.Type.Modified, "/t/s", IECoreScene.SceneAlgo.ProcessFlags.Attributes, "glah" ),
+				( IECoreScene.SceneAlgo.SceneChange.Type.Removed, "/t/s", IECoreScene.SceneAlgo.ProcessFlags.Tags, "tagB" ),
+				( IECoreScene.SceneAlgo.SceneChange.Type.Added, "/t/u", IECoreScene.SceneAlgo.ProcessFlags.None_, "" ),
+			]
+		)
+		self.assertEqual( changes[1].time, 1.0 )
+
+		changes = IECoreScene.SceneAlgo.diff( a, b, [ 1.0 ], IECoreScene.SceneAlgo.ProcessFlags.Attributes )
+		self.assertEqual( [ c.path for c in changes ], [ "/t/s", "/t/u" ] )
+
+	def testDiffUsesContentHashes( self ) :
+
+		self.writeSCC()
+		shutil.copy( self.__testFile, self.__testFile2 )
+
+		a = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		b = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+
+		# The hashes used by `hash()` are specific to the file, but
+		# the content hashes match.
+
+		self.assertNotEqual(
+			a.hash( IECoreScene.SceneInterface.HashType.HierarchyHash, 1.0 ),
+			b.hash( IECoreScene.SceneInterface.HashType.HierarchyHash, 1.0 )
+		)
+		self.assertIsNotNone( a.contentHash() )
+		self.assertEqual( a.contentHash(), b.contentHash() )
+		self.assertNotEqual( a.contentHash(), a.child( "t" ).contentHash() )
+		self.assertEqual( IECoreScene.SceneAlgo.diff( a, b, [ 1.0 ] ), [] )
+
+		del a, b
+
+		# Replace the object in the copy behind the back of SceneCache,
+		# leaving the content hashes as they were. `diff()` doesn't see the
+		# change, proving that it skipped the whole scene without loading
+		# anything.
+
+		io = IECore.FileIndexedIO( self.__testFile2, [], IECore.IndexedIO.OpenMode.Append )
+		objectIO = io.directory( [ "root", "children", "t", "children", "s", "object" ] )
+		objectIO.remove( "0" )
+		IECoreScene.SpherePrimitive( 2 ).save( objectIO, "0" )
+		del objectIO, io
+
+		a = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		b = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+
+		self.assertNotEqual( a.child( "t" ).child( "s" ).readObject( 1.0 ), b.child( "t" ).child( "s" ).readObject( 1.0 ) )
+		self.assertEqual( IECoreScene.SceneAlgo.diff( a, b, [ 1.0 ] ), [] )
+
+		del a, b
+
+		# Appending removes the content hashes from the modified locations,
+		# so the change is found again.
+
+		shutil.copy( self.__testFile, self.__testFile2 )
+		m = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Append )
+		m.child( "t" ).child( "s" ).writeAttribute( "glah", IECore.IntData( 16 ), 2.0 )
+		del m
+
+		a = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		b = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+
+		self.assertIsNone( b.contentHash() )
+		self.assertIsNone( b.child( "t" ).child( "s" ).contentHash() )
+
+		changes = IECoreScene.SceneAlgo.diff( a, b, [ 2.0 ] )
+		self.assertEqual(
+			[ ( c.type, c.path, c.component, c.name, c.time ) for c in changes ],
+			[
+				( IECoreScene.SceneAlgo.SceneChange.Type.Modified, "/t/s", IECoreScene.SceneAlgo.ProcessFlags.Attributes, "glah", 2.0 ),
+			]
+		)
+
 	def setUp( self ) :
 		self.tempDir = tempfile.mkdtemp()
 		self.__testFile = os.path.join( self.tempDir, "test.scc" )
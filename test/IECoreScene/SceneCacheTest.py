@@ -53,7 +53,7 @@ class SceneCacheTest( unittest.TestCase ) :
 		self.assertTrue( "scc" in IECoreScene.SceneInterface.supportedExtensions( IECore.IndexedIO.OpenMode.Read ) )
 		self.assertTrue( "scc" in IECoreScene.SceneInterface.supportedExtensions( IECore.IndexedIO.OpenMode.Write ) )
 		self.assertTrue( "scc" in IECoreScene.SceneInterface.supportedExtensions( IECore.IndexedIO.OpenMode.Write + IECore.IndexedIO.OpenMode.Read ) )
-		self.assertFalse( "scc" in IECoreScene.SceneInterface.supportedExtensions( IECore.IndexedIO.OpenMode.Append ) )
+		self.assertTrue( "scc" in IECoreScene.SceneInterface.supportedExtensions( IECore.IndexedIO.OpenMode.Append ) )
 
 	def testFactoryFunction( self ) :
 		# test Write factory function
@@ -68,8 +68,122 @@ class SceneCacheTest( unittest.TestCase ) :
 		self.assertEqual( m.fileName(), os.path.join( self.tempDir, "test.scc" ) )
 		m.readBound( 0.0 )
 
-	def testAppendRaises( self ) :
-		self.assertRaises( RuntimeError, IECoreScene.SceneCache, os.path.join( self.tempDir, "test.scc" ), IECore.IndexedIO.OpenMode.Append )
+	def testAppendToNewFile( self ) :
+
+		fileName = os.path.join( self.tempDir, "test.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Append )
+		m.createChild( "a" ).writeObject( IECoreScene.SpherePrimitive( 1 ), 1.0 )
+		del m
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( m.childNames(), [ "a" ] )
+		self.assertEqual( m.child( "a" ).readObject( 1.0 ), IECoreScene.SpherePrimitive( 1 ) )
+
+	def testAppend( self ) :
+
+		fileName = os.path.join( self.tempDir, "test.scc" )
+
+		def plane( offset ) :
+			mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+			mesh["P"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.V3fVectorData( [ p + imath.V3f( offset, 0, 0 ) for p in mesh["P"].data ], IECore.GeometricData.Interpretation.Point )
+			)
+			return mesh
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		m.writeAttribute( "rootAttr", IECore.IntData( 1 ), 1.0 )
+		a = m.createChild( "a" )
+		a.writeTags( [ "tagA" ] )
+		for frame in ( 1, 2 ) :
+			a.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( frame, 0, 0 ) ) ), frame )
+			a.writeObject( plane( frame ), frame )
+			a.writeAttribute( "frame", IECore.IntData( frame ), frame )
+		m.createChild( "b" ).writeObject( IECoreScene.SpherePrimitive( 1 ), 1.0 )
+		del m, a
+
+		# Append samples to an existing location, and add new locations.
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Append )
+		self.assertRaises( RuntimeError, m.createChild, "a" )
+		a = m.child( "a" )
+		self.assertRaises( RuntimeError, a.writeObject, plane( 1 ), 2.0 )
+		for frame in ( 3, 4 ) :
+			a.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( frame, 0, 0 ) ) ), frame )
+			a.writeObject( plane( frame ), frame )
+			a.writeAttribute( "frame", IECore.IntData( frame ), frame )
+		a.createChild( "c" ).writeObject( IECoreScene.SpherePrimitive( 2 ), 3.0 )
+		m.createChild( "d" ).writeTags( [ "tagD" ] )
+		m.writeSet( "setA", IECore.PathMatcher( [ "/a" ] ) )
+		del m, a
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( m.readAttribute( "rootAttr", 1.0 ), IECore.IntData( 1 ) )
+		self.assertEqual( sorted( m.childNames() ), [ "a", "b", "d" ] )
+
+		a = m.child( "a" )
+		self.assertEqual( a.numObjectSamples(), 4 )
+		self.assertEqual( a.numTransformSamples(), 4 )
+		self.assertEqual( a.numAttributeSamples( "frame" ), 4 )
+		for frame in ( 1, 2, 3, 4 ) :
+			self.assertEqual( a.objectSampleTime( frame - 1 ), frame )
+			self.assertEqual( a.readObjectAtSample( frame - 1 ), plane( frame ) )
+			self.assertEqual( a.readTransformAsMatrixAtSample( frame - 1 ), imath.M44d().translate( imath.V3d( frame, 0, 0 ) ) )
+			self.assertEqual( a.readAttributeAtSample( "frame", frame - 1 ), IECore.IntData( frame ) )
+
+		# Only "P" is animated, in both the original and appended samples.
+		self.assertEqual( a.readAttribute( IECoreScene.SceneCache.animatedObjectPrimVarsAttribute, 0 ), IECore.InternedStringVectorData( [ "P" ] ) )
+
+		self.assertEqual( a.childNames(), [ "c" ] )
+		self.assertEqual( a.child( "c" ).readObject( 3.0 ), IECoreScene.SpherePrimitive( 2 ) )
+		self.assertEqual( m.child( "b" ).readObject( 1.0 ), IECoreScene.SpherePrimitive( 1 ) )
+		self.assertTrue( m.child( "d" ).hasTag( "tagD" ) )
+		self.assertTrue( a.hasTag( "tagA" ) )
+		self.assertTrue( m.hasTag( "tagA", IECoreScene.SceneInterface.DescendantTag ) )
+		self.assertTrue( m.hasTag( "tagD", IECoreScene.SceneInterface.DescendantTag ) )
+		self.assertEqual( m.readSet( "setA" ), IECore.PathMatcher( [ "/a" ] ) )
+
+		# Bounds include both the original and the appended data.
+		for frame in ( 1, 2, 3, 4 ) :
+			bound = m.readBound( frame )
+			self.assertTrue( IECore.BoxAlgo.contains( bound, imath.Box3d( imath.V3d( 2 * frame - 1, -1, 0 ), imath.V3d( 2 * frame + 1, 1, 0 ) ) ) )
+			self.assertTrue( IECore.BoxAlgo.contains( bound, imath.Box3d( imath.V3d( -1 ), imath.V3d( 1 ) ) ) )
+		self.assertTrue( IECore.BoxAlgo.contains( a.readBound( 3.0 ), imath.Box3d( imath.V3d( -2 ), imath.V3d( 2 ) ) ) )
+
+	def testAppendPreservesExistingBounds( self ) :
+
+		fileName = os.path.join( self.tempDir, "test.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		a = m.createChild( "a" )
+		for frame in ( 1, 2 ) :
+			a.writeObject( IECoreScene.SpherePrimitive( frame ), frame )
+		m.createChild( "b" ).writeObject( IECoreScene.SpherePrimitive( 0.5 ), 1.0 )
+		del m, a
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		originalBounds = {
+			( path, frame ) : m.scene( list( path ) ).readBoundAtSample( frame - 1 )
+			for path in ( (), ( "a", ) ) for frame in ( 1, 2 )
+		}
+		del m
+
+		# Append a much larger object. The bounds of the existing
+		# samples must not be extended to include it.
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Append )
+		m.child( "a" ).writeObject( IECoreScene.SpherePrimitive( 100 ), 3.0 )
+		del m
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		for ( path, frame ), bound in originalBounds.items() :
+			self.assertEqual( m.scene( list( path ) ).boundSampleTime( frame - 1 ), frame )
+			self.assertEqual( m.scene( list( path ) ).readBoundAtSample( frame - 1 ), bound )
+
+		for path in ( [], [ "a" ] ) :
+			self.assertEqual( m.scene( path ).numBoundSamples(), 3 )
+			self.assertTrue( IECore.BoxAlgo.contains( m.scene( path ).readBoundAtSample( 2 ), imath.Box3d( imath.V3d( -100 ), imath.V3d( 100 ) ) ) )
 
 	def testReadNonExistentRaises( self ) :
 		self.assertRaises( RuntimeError, IECoreScene.SceneCache, "iDontExist.scc", IECore.IndexedIO.OpenMode.Read )
@@ -148,6 +148,23 @@ class TestSpherePrimitiveEvaluator( unittest.TestCase ) :
 
 
 
+	def testBatchQueries( self ) :
+
+		sphere = IECoreScene.SpherePrimitive( 2 )
+		e = IECoreScene.SpherePrimitiveEvaluator( sphere )
+		r = e.createResult()
+
+		rand = imath.Rand48( 1 )
+		points = IECore.V3fVectorData( [ rand.nextSolidSphere( imath.V3f() ) * 4 for i in range( 0, 100 ) ] )
+
+		results = e.closestPoints( points )
+		self.assertEqual( set( results.keys() ), { "success", "P", "N", "uv", "primitiveVariables" } )
+		for i, p in enumerate( points ) :
+			self.assertEqual( results["success"][i], e.closestPoint( p, r ) )
+			self.assertEqual( results["P"][i], r.point() )
+			self.assertEqual( results["N"][i], r.normal() )
+			self.assertEqual( results["uv"][i], r.uv() )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -35,9 +35,16 @@
 ##########################################################################
 
 import os
+import shutil
+import tempfile
 import unittest
 import imath
 
+try :
+	import openvdb
+except ImportError :
+	import pyopenvdb as openvdb
+
 import IECore
 import IECoreVDB
 from VDBTestCase import VDBTestCase
@@ -272,6 +279,103 @@ class VDBObjectTest( VDBTestCase ) :
 		self.assertNotEqual( o2, o )
 		self.assertEqual( o2, o2 )
 
+	def testFindGridWithBound( self ) :
+
+		sourcePath = os.path.join( self.dataDir, "smoke.vdb" )
+		vdbObject = IECoreVDB.VDBObject( sourcePath )
+		fullLeafCount = IECoreVDB.VDBObject( sourcePath ).findGrid( "density" ).leafCount()
+
+		bound = vdbObject.bound()
+		halfBound = imath.Box3f( bound.min(), bound.center() )
+
+		# Partial loading from file.
+
+		memoryUsage = vdbObject.memoryUsage()
+
+		clipped = vdbObject.findGrid( "density", halfBound )
+		self.assertGreater( clipped.leafCount(), 0 )
+		self.assertLess( clipped.leafCount(), fullLeafCount )
+		self.assertTrue( vdbObject.unmodifiedFromFile() )
+
+		# The partially loaded grid is included in the memory usage,
+		# but only once, however many times it is queried.
+
+		self.assertGreater( vdbObject.memoryUsage(), memoryUsage )
+		memoryUsage = vdbObject.memoryUsage()
+
+		self.assertEqual( vdbObject.findGrid( "density", halfBound ).leafCount(), clipped.leafCount() )
+		self.assertEqual( vdbObject.memoryUsage(), memoryUsage )
+
+		self.assertEqual( vdbObject.findGrid( "density", bound ).leafCount(), fullLeafCount )
+		self.assertEqual( vdbObject.findGrid( "density", imath.Box3f() ).leafCount(), 0 )
+		self.assertIsNone( vdbObject.findGrid( "notAGrid", halfBound ) )
+
+		# Modifying the result must not affect subsequent queries.
+
+		clipped.mapAll( lambda value : value + 1 )
+		self.assertNotEqual(
+			next( vdbObject.findGrid( "density", halfBound ).citerAllValues() ).value,
+			next( clipped.citerAllValues() ).value
+		)
+
+		# Clipping of grids which have already been loaded.
+
+		vdbObject2 = IECoreVDB.VDBObject( sourcePath )
+		vdbObject2.findGrid( "density" )
+		self.assertEqual( vdbObject2.findGrid( "density", halfBound ).leafCount(), clipped.leafCount() )
+
+		# These are cached too, and if the bound contains the whole grid
+		# then the grid is shared rather than copied.
+
+		memoryUsage = vdbObject2.memoryUsage()
+		self.assertEqual( vdbObject2.findGrid( "density", halfBound ).leafCount(), clipped.leafCount() )
+		paddedBound = imath.Box3f( bound.min() - imath.V3f( 1 ), bound.max() + imath.V3f( 1 ) )
+		self.assertEqual( vdbObject2.findGrid( "density", paddedBound ).leafCount(), fullLeafCount )
+		self.assertEqual( vdbObject2.memoryUsage(), memoryUsage )
+
+		# Modifying the grid must not affect subsequent queries.
+
+		vdbObject2.findGrid( "density" ).mapAll( lambda value : value + 1 )
+		self.assertAlmostEqual(
+			next( vdbObject2.findGrid( "density", halfBound ).citerAllValues() ).value,
+			next( vdbObject.findGrid( "density", halfBound ).citerAllValues() ).value + 1,
+			places = 2
+		)
+
+	def testFindGridWithBoundAfterFileRewrite( self ) :
+
+		tempDir = tempfile.mkdtemp()
+		self.addCleanup( shutil.rmtree, tempDir )
+
+		fileName = os.path.join( tempDir, "smoke.vdb" )
+		shutil.copy( os.path.join( self.dataDir, "smoke.vdb" ), fileName )
+
+		vdbObject = IECoreVDB.VDBObject( fileName )
+		bound = vdbObject.bound()
+		halfBound = imath.Box3f( bound.min(), bound.center() )
+		clipped = vdbObject.findGrid( "density", halfBound )
+		del vdbObject
+
+		# Rewrite the file with different values, making sure the
+		# modification time changes even if we're within a second
+		# of the original write.
+
+		grid = IECoreVDB.VDBObject( fileName ).findGrid( "density" )
+		grid.mapAll( lambda value : value + 1 )
+		openvdb.write( fileName, grids = [ grid ] )
+		stat = os.stat( fileName )
+		os.utime( fileName, ( stat.st_atime, stat.st_mtime + 10 ) )
+
+		# Partially loaded grids from the previous file must not be reused.
+
+		rewritten = IECoreVDB.VDBObject( fileName ).findGrid( "density", halfBound )
+		self.assertEqual( rewritten.leafCount(), clipped.leafCount() )
+		self.assertAlmostEqual(
+			next( rewritten.citerAllValues() ).value,
+			next( clipped.citerAllValues() ).value + 1,
+			places = 2
+		)
+
 if __name__ == "__main__":
 	unittest.main()
 